@@ -0,0 +1,132 @@
+/*
+ *  bench_compacting_pool.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Benchmark for the CompactingPool.  Session churn is simulated by
+ *      allocating many keys and releasing most of them at random, after
+ *      which the locked memory held by the pool is reported before and
+ *      after compaction, along with the time compaction takes.  The cost of
+ *      pinning an object to access it is also reported.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <terra/secutil/compacting_pool.h>
+
+using namespace Terra;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/*
+ *  Churn()
+ *
+ *  Description:
+ *      Allocate keys, release all but the given fraction at random, and
+ *      compact the pool, reporting memory use and compaction time.
+ *
+ *  Parameters:
+ *      key_size [in]
+ *          Size of each key in octets.
+ *
+ *      keys [in]
+ *          Number of keys allocated.
+ *
+ *      survivors [in]
+ *          Fraction of keys that remain allocated.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Churn(std::size_t key_size, std::size_t keys, double survivors)
+{
+    SecUtil::CompactingPool pool;
+    std::vector<SecUtil::SecretHandle> handles;
+    std::mt19937 generator(1);
+
+    for (std::size_t i = 0; i < keys; i++)
+    {
+        handles.push_back(pool.Allocate(key_size));
+        auto view = handles.back().Pin();
+        std::fill(view.data(), view.data() + view.size(), 0xa5);
+    }
+
+    std::shuffle(handles.begin(), handles.end(), generator);
+    handles.resize(static_cast<std::size_t>(static_cast<double>(keys) *
+                                            survivors));
+
+    const std::size_t before = pool.LockedBytes();
+    const auto start = Clock::now();
+    const auto statistics = pool.Compact();
+    const double microseconds =
+        std::chrono::duration<double, std::micro>(Clock::now() - start)
+            .count();
+
+    std::cout << std::setw(6) << key_size << " octets, " << std::setw(4)
+              << static_cast<unsigned>(survivors * 100) << "% live: locked "
+              << std::setw(10) << before << " -> " << std::setw(10)
+              << pool.LockedBytes() << " octets, moved " << std::setw(7)
+              << statistics.moved_objects << " in " << std::fixed
+              << std::setprecision(1) << std::setw(8) << microseconds << " us"
+              << std::endl;
+}
+
+} // namespace
+
+int main()
+{
+    for (std::size_t key_size : {32, 256, 1024})
+    {
+        for (double survivors : {0.05, 0.25})
+        {
+            Churn(key_size, 16777216 / key_size, survivors);
+        }
+    }
+
+    // Cost of pinning an object to access it
+    SecUtil::CompactingPool pool;
+    SecUtil::SecretHandle key = pool.Allocate(32);
+    volatile std::uint8_t sink = 0;
+    std::size_t iterations = 0;
+    const auto start = Clock::now();
+
+    while (Clock::now() - start < std::chrono::milliseconds(200))
+    {
+        for (unsigned i = 0; i < 64; i++)
+        {
+            auto view = key.Pin();
+            sink = static_cast<std::uint8_t>(sink ^ view.data()[0]);
+        }
+        iterations += 64;
+    }
+
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    std::cout << "Pin: " << std::fixed << std::setprecision(1)
+              << nanoseconds / static_cast<double>(iterations) << " ns/call"
+              << std::endl;
+
+    return 0;
+}
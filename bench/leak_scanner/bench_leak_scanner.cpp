@@ -0,0 +1,90 @@
+/*
+ *  bench_leak_scanner.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Benchmark for the LeakScanner.  A file of random data is created in
+ *      the directory given on the command line (or the temporary directory)
+ *      and scanned for varying numbers of patterns using varying numbers of
+ *      threads, reporting the throughput of each.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <terra/secutil/leak_scanner.h>
+
+using namespace Terra;
+
+int main(int argc, char *argv[])
+{
+    const std::filesystem::path directory =
+        (argc > 1) ? std::filesystem::path(argv[1])
+                   : std::filesystem::temp_directory_path();
+    const std::filesystem::path path = directory / "secutil_bench_leak_scan";
+    std::mt19937_64 generator(1);
+    std::vector<std::uint8_t> block(1048576);
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        for (std::size_t i = 0; i < 256; i++)
+        {
+            for (auto &octet : block)
+            {
+                octet = static_cast<std::uint8_t>(generator());
+            }
+            file.write(reinterpret_cast<const char *>(block.data()),
+                       static_cast<std::streamsize>(block.size()));
+        }
+    }
+
+    for (std::size_t count : {1, 8, 64})
+    {
+        SecUtil::LeakScanner scanner;
+        std::vector<std::uint8_t> pattern(32);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            for (auto &octet : pattern)
+            {
+                octet = static_cast<std::uint8_t>(generator());
+            }
+            scanner.AddPattern(pattern);
+        }
+
+        // Read the file once so that it is cached
+        scanner.ScanFile(path, 1);
+
+        for (unsigned threads : {1U, 2U, 4U, 8U})
+        {
+            const auto report = scanner.ScanFile(path, threads);
+
+            std::cout << std::left << std::setw(28)
+                      << ("ScanFile (" + std::to_string(count) + " x " +
+                          std::to_string(threads) + " threads)")
+                      << std::right << std::setw(10) << report.bytes_scanned
+                      << " octets" << std::setw(12) << std::fixed
+                      << std::setprecision(1) << report.Throughput() << " MiB/s"
+                      << std::endl;
+        }
+    }
+
+    std::filesystem::remove(path);
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ *  bench_masked_secret.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Benchmark for MaskedSecret access.  Throughput of scoped unmasking and
+ *      remasking, and of unmasking into a separate buffer, is reported for
+ *      several secret sizes alongside memcpy() as a point of reference.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <terra/secutil/masked_secret.h>
+
+using namespace Terra;
+
+namespace
+{
+
+/*
+ *  Measure()
+ *
+ *  Description:
+ *      Repeatedly call the given function until at least 200ms have elapsed
+ *      and report the throughput in MiB/s.
+ *
+ *  Parameters:
+ *      name [in]
+ *          Name of the operation being measured.
+ *
+ *      bytes [in]
+ *          Number of octets processed by each call.
+ *
+ *      function [in]
+ *          The function to call.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Measure(const std::string &name,
+             std::size_t bytes,
+             const std::function<void()> &function)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t iterations = 0;
+    const auto start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+
+    while (elapsed < std::chrono::milliseconds(200))
+    {
+        for (unsigned i = 0; i < 64; i++) function();
+        iterations += 64;
+        elapsed = Clock::now() - start;
+    }
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    const double mib = static_cast<double>(bytes * iterations) / 1048576.0;
+
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(10) << bytes << " octets" << std::setw(12)
+              << std::fixed << std::setprecision(1) << (mib / seconds)
+              << " MiB/s" << std::endl;
+}
+
+} // namespace
+
+int main()
+{
+    volatile std::uint8_t sink = 0;
+
+    for (std::size_t size : {32, 1024, 65536, 1048576})
+    {
+        std::vector<std::uint8_t> a(size, 0x5a);
+        std::vector<std::uint8_t> b(size, 0x5a);
+        SecUtil::MaskedSecret secret(a);
+
+        Measure("memcpy", size, [&]() {
+            std::memcpy(a.data(), b.data(), size);
+        });
+        Measure("Unmask (view and remask)", size, [&]() {
+            auto view = secret.Unmask();
+            sink = view.data()[0];
+        });
+        Measure("UnmaskTo", size, [&]() {
+            secret.UnmaskTo(a);
+        });
+    }
+
+    return 0;
+}
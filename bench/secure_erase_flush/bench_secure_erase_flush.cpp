@@ -0,0 +1,143 @@
+/*
+ *  bench_secure_erase_flush.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Benchmark for SecureEraseFlush().  Buffers of several sizes are
+ *      erased using SecureErase() and each flush method, reporting the cost
+ *      per MiB, along with a batch of small regions erased with one fence
+ *      and with a fence per region.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <terra/secutil/secure_erase.h>
+#include <terra/secutil/secure_erase_flush.h>
+
+using namespace Terra;
+
+namespace
+{
+
+/*
+ *  Measure()
+ *
+ *  Description:
+ *      Repeatedly call the given function until at least 200ms have elapsed
+ *      and report the time per MiB erased in microseconds.
+ *
+ *  Parameters:
+ *      name [in]
+ *          Name of the operation being measured.
+ *
+ *      bytes [in]
+ *          Number of octets erased by each call.
+ *
+ *      function [in]
+ *          The function to call.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Measure(const std::string &name,
+             std::size_t bytes,
+             const std::function<void()> &function)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t iterations = 0;
+    const auto start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+
+    while (elapsed < std::chrono::milliseconds(200))
+    {
+        for (unsigned i = 0; i < 16; i++) function();
+        iterations += 16;
+        elapsed = Clock::now() - start;
+    }
+
+    const double microseconds =
+        std::chrono::duration<double, std::micro>(elapsed).count();
+    const double mib = static_cast<double>(bytes) * iterations / 1048576.0;
+
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(10) << bytes << " octets" << std::setw(12)
+              << std::fixed << std::setprecision(1) << microseconds / mib
+              << " us/MiB" << std::endl;
+}
+
+} // namespace
+
+int main()
+{
+    using SecUtil::EraseFlushMethod;
+
+    if (!SecUtil::EraseFlushSupported())
+    {
+        std::cout << "Cache flushing is not supported; erasing only"
+                  << std::endl;
+    }
+
+    for (std::size_t size : {256, 4096, 65536, 1048576, 16777216})
+    {
+        std::vector<std::uint8_t> buffer(size, 0x5a);
+
+        Measure("SecureErase", size, [&]() {
+            SecUtil::SecureErase(buffer.data(), size);
+        });
+        Measure("NonTemporal", size, [&]() {
+            SecUtil::SecureEraseFlush(buffer.data(),
+                                      size,
+                                      EraseFlushMethod::NonTemporal);
+        });
+        Measure("CacheFlush", size, [&]() {
+            SecUtil::SecureEraseFlush(buffer.data(),
+                                      size,
+                                      EraseFlushMethod::CacheFlush);
+        });
+        Measure("Automatic", size, [&]() {
+            SecUtil::SecureEraseFlush(buffer.data(), size);
+        });
+    }
+
+    // Many small regions, as when erasing the fields of a key schedule
+    constexpr std::size_t Region_Count = 64;
+    constexpr std::size_t Region_Size = 48;
+    std::vector<std::uint8_t> buffer(Region_Count * 256, 0x5a);
+    std::vector<SecUtil::EraseRegion> regions;
+
+    for (std::size_t i = 0; i < Region_Count; i++)
+    {
+        regions.push_back({buffer.data() + i * 256, Region_Size});
+    }
+
+    Measure("Batched regions", Region_Count * Region_Size, [&]() {
+        SecUtil::SecureEraseFlush(regions);
+    });
+    Measure("Fence per region", Region_Count * Region_Size, [&]() {
+        for (const auto &region : regions)
+        {
+            SecUtil::SecureEraseFlush(region.buffer, region.length);
+        }
+    });
+
+    return 0;
+}
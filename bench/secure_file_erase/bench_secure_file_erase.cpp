@@ -0,0 +1,69 @@
+/*
+ *  bench_secure_file_erase.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Benchmark for SecureEraseFile().  Files of several sizes are created
+ *      in the directory given on the command line (or the temporary
+ *      directory) and erased using varying numbers of threads, reporting the
+ *      throughput of each.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <terra/secutil/secure_file_erase.h>
+
+using namespace Terra;
+
+int main(int argc, char *argv[])
+{
+    const std::filesystem::path directory =
+        (argc > 1) ? std::filesystem::path(argv[1])
+                   : std::filesystem::temp_directory_path();
+    const std::filesystem::path path = directory / "secutil_bench_erase";
+    const std::vector<char> block(1048576, 0x5a);
+
+    for (std::size_t mib : {16, 256})
+    {
+        for (unsigned threads : {1U, 2U, 4U, 8U})
+        {
+            {
+                std::ofstream file(path, std::ios::binary);
+                for (std::size_t i = 0; i < mib; i++)
+                {
+                    file.write(block.data(),
+                               static_cast<std::streamsize>(block.size()));
+                }
+            }
+
+            const auto result = SecUtil::SecureEraseFile(path, threads);
+
+            std::cout << std::left << std::setw(28)
+                      << ("SecureEraseFile (" + std::to_string(result.threads) +
+                          (result.threads == 1 ? " thread)" : " threads)"))
+                      << std::right << std::setw(10) << result.bytes_overwritten
+                      << " octets" << std::setw(12) << std::fixed
+                      << std::setprecision(1) << result.Throughput() << " MiB/s"
+                      << (result.memory_backed ? " (memory)" : "")
+                      << (result.hole_punched ? " (hole punched)" : "")
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ *  bench_secure_pages.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Benchmark comparing the SecurePages erase methods.  For blocks of
+ *      several sizes, the time taken by Erase() is reported for each
+ *      method, along with the time to write to every page afterward (which
+ *      for discarded pages includes faulting them in again) and the time
+ *      to destroy a block.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <terra/secutil/secure_pages.h>
+
+using namespace Terra;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/*
+ *  Touch()
+ *
+ *  Description:
+ *      Write to every page of a block.
+ *
+ *  Parameters:
+ *      pages [in]
+ *          The block.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Touch(SecUtil::SecurePages &pages)
+{
+    const std::size_t page_size = SecUtil::SecurePages::PageSize();
+
+    for (std::size_t i = 0; i < pages.capacity(); i += page_size)
+    {
+        pages.data()[i] = 0xa5;
+    }
+}
+
+/*
+ *  Measure()
+ *
+ *  Description:
+ *      Repeatedly erase and rewrite a block of the given size until at
+ *      least 200ms have elapsed, then repeatedly create and destroy blocks,
+ *      reporting the mean time of each step.
+ *
+ *  Parameters:
+ *      name [in]
+ *          Name of the erase method.
+ *
+ *      bytes [in]
+ *          Size of the block.
+ *
+ *      method [in]
+ *          The erase method to measure.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Measure(const std::string &name,
+             std::size_t bytes,
+             SecUtil::PageEraseMethod method)
+{
+    std::size_t iterations = 0;
+    auto erase_time = Clock::duration::zero();
+    auto touch_time = Clock::duration::zero();
+
+    {
+        SecUtil::SecurePages pages(bytes, method);
+        Touch(pages);
+
+        const auto start = Clock::now();
+        while (Clock::now() - start < std::chrono::milliseconds(200))
+        {
+            const auto before = Clock::now();
+            pages.Erase();
+            const auto erased = Clock::now();
+            Touch(pages);
+            touch_time += Clock::now() - erased;
+            erase_time += erased - before;
+            iterations++;
+        }
+    }
+
+    std::size_t releases = 0;
+    auto release_time = Clock::duration::zero();
+
+    const auto start = Clock::now();
+    while (Clock::now() - start < std::chrono::milliseconds(200))
+    {
+        SecUtil::SecurePages pages(bytes, method);
+        Touch(pages);
+
+        const auto before = Clock::now();
+        pages = SecUtil::SecurePages();
+        release_time += Clock::now() - before;
+        releases++;
+    }
+
+    const auto mean = [](Clock::duration total, std::size_t count)
+    {
+        return std::chrono::duration<double, std::micro>(total).count() /
+               static_cast<double>(count);
+    };
+
+    std::cout << std::left << std::setw(10) << name << std::right
+              << std::setw(10) << bytes << " octets" << std::fixed
+              << std::setprecision(1) << std::setw(10)
+              << mean(erase_time, iterations) << " us erase" << std::setw(10)
+              << mean(touch_time, iterations) << " us rewrite"
+              << std::setw(10) << mean(release_time, releases)
+              << " us destroy" << std::endl;
+}
+
+} // namespace
+
+int main()
+{
+    for (std::size_t size : {65536, 1048576, 4194304, 16777216, 67108864})
+    {
+        Measure("Overwrite", size, SecUtil::PageEraseMethod::Overwrite);
+        Measure("Discard", size, SecUtil::PageEraseMethod::Discard);
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ *  bench_secure_pool.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Benchmark for the SecurePool.  The cost of allocating, writing, and
+ *      freeing a block from the pool is compared with the heap, both with
+ *      and without erasure, and the cost of creating and destroying a
+ *      coroutine is compared with and without SecureCoroutinePromise.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <terra/secutil/secure_pool.h>
+#include <terra/secutil/secure_coroutine.h>
+#include <terra/secutil/secure_erase.h>
+
+using namespace Terra;
+
+namespace
+{
+
+/*
+ *  Measure()
+ *
+ *  Description:
+ *      Repeatedly call the given function until at least 200ms have elapsed
+ *      and report the time per call in nanoseconds.
+ *
+ *  Parameters:
+ *      name [in]
+ *          Name of the operation being measured.
+ *
+ *      bytes [in]
+ *          Number of octets allocated by each call.
+ *
+ *      function [in]
+ *          The function to call.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Measure(const std::string &name,
+             std::size_t bytes,
+             const std::function<void()> &function)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t iterations = 0;
+    const auto start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+
+    while (elapsed < std::chrono::milliseconds(200))
+    {
+        for (unsigned i = 0; i < 64; i++) function();
+        iterations += 64;
+        elapsed = Clock::now() - start;
+    }
+
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(elapsed).count();
+
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(10) << bytes << " octets" << std::setw(12)
+              << std::fixed << std::setprecision(1)
+              << (nanoseconds / static_cast<double>(iterations)) << " ns/call"
+              << std::endl;
+}
+
+// Coroutine type whose frame allocation is determined by the Base class
+template<typename Base>
+struct Task
+{
+    struct promise_type : Base
+    {
+        int value = 0;
+
+        Task get_return_object()
+        {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(int v) { value = v; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+struct HeapPromise
+{
+};
+
+template<typename Base>
+Task<Base> Compute(int seed)
+{
+    std::uint8_t key[128];
+
+    for (auto &octet : key) octet = static_cast<std::uint8_t>(seed++);
+
+    int sum = 0;
+    for (auto octet : key) sum += octet;
+
+    co_return sum;
+}
+
+} // namespace
+
+int main()
+{
+    volatile int sink = 0;
+
+    for (std::size_t size : {64, 512, 4096})
+    {
+        Measure("new/delete", size, [&]() {
+            auto *p = new std::uint8_t[size];
+            std::memset(p, 0xa5, size);
+            sink = p[size - 1];
+            delete[] p;
+        });
+        Measure("new/SecureErase/delete", size, [&]() {
+            auto *p = new std::uint8_t[size];
+            std::memset(p, 0xa5, size);
+            sink = p[size - 1];
+            SecUtil::SecureErase(p, size);
+            delete[] p;
+        });
+        Measure("SecurePool", size, [&]() {
+            auto *p = static_cast<std::uint8_t *>(
+                SecUtil::DefaultSecurePool().Allocate(size));
+            std::memset(p, 0xa5, size);
+            sink = p[size - 1];
+            SecUtil::DefaultSecurePool().Deallocate(p);
+        });
+    }
+
+    Measure("Coroutine (heap)", 0, [&]() {
+        auto task = Compute<HeapPromise>(sink);
+        task.handle.resume();
+        sink = task.handle.promise().value;
+        task.handle.destroy();
+    });
+    Measure("Coroutine (SecurePool)", 0, [&]() {
+        auto task = Compute<SecUtil::SecureCoroutinePromise>(sink);
+        task.handle.resume();
+        sink = task.handle.promise().value;
+        task.handle.destroy();
+    });
+
+    // Release the memory left behind by a spike of allocations
+    {
+        SecUtil::SecurePool pool;
+        std::vector<void *> blocks;
+
+        for (std::size_t i = 0; i < 65536; i++)
+        {
+            auto *p = static_cast<std::uint8_t *>(pool.Allocate(256));
+            std::memset(p, 0xa5, 256);
+            blocks.push_back(p);
+        }
+        for (auto *p : blocks) pool.Deallocate(p);
+
+        const std::size_t retained = pool.RetainedBytes();
+        const auto start = std::chrono::steady_clock::now();
+        const std::size_t released = pool.Trim(std::chrono::seconds(0));
+        const double microseconds = std::chrono::duration<double, std::micro>(
+                                        std::chrono::steady_clock::now() - start)
+                                        .count();
+
+        std::cout << "Trim: retained " << retained << " octets, released "
+                  << released << " octets in " << std::fixed
+                  << std::setprecision(1) << microseconds << " us" << std::endl;
+    }
+
+    return 0;
+}
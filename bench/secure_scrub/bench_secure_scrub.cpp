@@ -0,0 +1,148 @@
+/*
+ *  bench_secure_scrub.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Benchmark for stack and vector register scrubbing.  The cost of each
+ *      call to ScrubStack() is reported for several depths, along with
+ *      ClearVectorRegisters() and the overhead ScrubAfter() adds to a
+ *      function that uses a few KiB of stack, so that scrubbing may be
+ *      applied selectively on hot paths.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <terra/secutil/secure_scrub.h>
+
+using namespace Terra;
+
+namespace
+{
+
+/*
+ *  Measure()
+ *
+ *  Description:
+ *      Repeatedly call the given function until at least 200ms have elapsed
+ *      and report the time per call in nanoseconds.
+ *
+ *  Parameters:
+ *      name [in]
+ *          Name of the operation being measured.
+ *
+ *      bytes [in]
+ *          Number of octets of stack scrubbed by each call.
+ *
+ *      function [in]
+ *          The function to call.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Measure(const std::string &name,
+             std::size_t bytes,
+             const std::function<void()> &function)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t iterations = 0;
+    const auto start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+
+    while (elapsed < std::chrono::milliseconds(200))
+    {
+        for (unsigned i = 0; i < 64; i++) function();
+        iterations += 64;
+        elapsed = Clock::now() - start;
+    }
+
+    const double nanoseconds =
+        std::chrono::duration<double, std::nano>(elapsed).count();
+
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(10) << bytes << " octets" << std::setw(12)
+              << std::fixed << std::setprecision(1)
+              << (nanoseconds / static_cast<double>(iterations)) << " ns/call"
+              << std::endl;
+}
+
+/*
+ *  Work()
+ *
+ *  Description:
+ *      Stand-in for a sensitive function, using a 2 KiB buffer on the stack.
+ *
+ *  Parameters:
+ *      seed [in]
+ *          Value from which the buffer contents are derived.
+ *
+ *  Returns:
+ *      A value computed from the buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+#if defined(_MSC_VER)
+__declspec(noinline)
+#else
+__attribute__((noinline))
+#endif
+std::uint32_t Work(std::uint32_t seed)
+{
+    volatile std::uint32_t state[512];
+
+    for (std::size_t i = 0; i < 512; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        state[i] = seed;
+    }
+
+    std::uint32_t result = 0;
+    for (std::size_t i = 0; i < 512; i++) result ^= state[i];
+
+    return result;
+}
+
+} // namespace
+
+int main()
+{
+    volatile std::uint32_t sink = 0;
+
+    for (std::size_t size : {256, 1024, 4096, 16384, 65536})
+    {
+        Measure("ScrubStack", size, [&]() { SecUtil::ScrubStack(size); });
+    }
+
+    Measure("ClearVectorRegisters", 0, []() {
+        SecUtil::ClearVectorRegisters();
+    });
+
+    Measure("Direct call", 0, [&]() { sink = Work(sink); });
+
+    for (std::size_t size : {2048, 4096, 8192})
+    {
+        Measure("ScrubAfter", size, [&]() {
+            sink = SecUtil::ScrubAfter(size, Work, sink);
+        });
+    }
+
+    return 0;
+}
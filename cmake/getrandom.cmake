@@ -0,0 +1,18 @@
+#
+# Check for existence of getrandom
+#
+# This was introduced in glibc 2.25 in 2017 and is also present on FreeBSD
+#
+
+include(CheckCXXSourceCompiles)
+
+# Check to see if getrandom() is present
+check_cxx_source_compiles("
+    #include <sys/random.h>
+    #include <array>
+    int main()
+    {
+        std::array<char, 32> buffer{};
+        return getrandom(buffer.data(), buffer.size(), 0) < 0;
+    }
+" HAVE_GETRANDOM)
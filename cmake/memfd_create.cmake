@@ -0,0 +1,18 @@
+#
+# Check for existence of memfd_create
+#
+# This was introduced in Linux 3.17 and glibc 2.27 in 2018
+#
+
+include(CheckCXXSourceCompiles)
+
+# Check to see if memfd_create() and file sealing are present
+check_cxx_source_compiles("
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    int main()
+    {
+        int fd = memfd_create(\"test\", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        return fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW);
+    }
+" HAVE_MEMFD_CREATE)
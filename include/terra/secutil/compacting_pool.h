@@ -0,0 +1,204 @@
+/*
+ *  compacting_pool.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the CompactingPool, a pool of locked secure memory
+ *      whose objects may be moved so that fragmented chunks can be released.
+ *
+ *      In a SecurePool, a few long-lived secrets scattered across chunks
+ *      keep every one of those chunks mapped and locked, even when the
+ *      chunks are otherwise empty.  Objects in a CompactingPool are instead
+ *      reached through a SecretHandle, which refers to an entry in the
+ *      pool's handle table rather than to the memory itself.  Compact()
+ *      moves live objects out of the least occupied chunks into free blocks
+ *      of the most occupied chunks of the same size class and releases the
+ *      chunks it empties:
+ *
+ *          CompactingPool pool;
+ *          SecretHandle key = pool.Allocate(32);
+ *          {
+ *              auto view = key.Pin();
+ *              Generate(view.data(), view.size());
+ *          }   // The object may be moved again here
+ *          ...
+ *          pool.Compact();
+ *
+ *      The address of an object is available only through a View, which
+ *      pins the object in place until the view is destroyed.  Pinned
+ *      objects are not moved, so a chunk holding one is not released.  A
+ *      View may outlive its handle, in which case the object is freed when
+ *      the View is destroyed.
+ *
+ *      Each object is moved by a single pass that copies it and erases the
+ *      source, so no secret is left behind in the vacated block.  As every
+ *      block is also erased when its handle is released, emptied chunks hold
+ *      only zeros and are unmapped without being overwritten again.
+ *
+ *      Objects use the same size classes as SecurePool and may be no larger
+ *      than Max_Pool_Block.  The pool and its handles may be used from any
+ *      thread; operations on the pool are serialized by a mutex, including
+ *      each Pin() and the destruction of each View.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+#include "secure_pages.h"
+#include "secure_pool.h"
+
+namespace Terra::SecUtil
+{
+
+class CompactingPool;
+
+// Counters describing the work done by CompactingPool::Compact()
+struct CompactionStatistics
+{
+    std::size_t moved_objects;
+    std::size_t moved_bytes;
+    std::size_t pinned_objects;
+    std::size_t released_chunks;
+    std::size_t released_bytes;
+};
+
+// Owner of an object allocated from a CompactingPool
+class SecretHandle
+{
+    public:
+        // Scoped view of the object that prevents it from being moved
+        class View
+        {
+            public:
+                View(const View &) = delete;
+                View(View &&other) noexcept;
+                ~View();
+
+                View &operator=(const View &) = delete;
+                View &operator=(View &&) = delete;
+
+                std::uint8_t *data() noexcept { return buffer; }
+                std::size_t size() const noexcept { return length; }
+                std::span<std::uint8_t> Span() noexcept
+                {
+                    return {buffer, length};
+                }
+
+            protected:
+                friend class SecretHandle;
+                View(CompactingPool *pool,
+                     std::uint32_t index,
+                     std::uint8_t *buffer,
+                     std::size_t length) noexcept;
+
+                CompactingPool *pool;
+                std::uint32_t index;
+                std::uint8_t *buffer;
+                std::size_t length;
+        };
+
+        SecretHandle() noexcept;
+        SecretHandle(const SecretHandle &) = delete;
+        SecretHandle(SecretHandle &&other) noexcept;
+        ~SecretHandle();
+
+        SecretHandle &operator=(const SecretHandle &) = delete;
+        SecretHandle &operator=(SecretHandle &&other) noexcept;
+
+        void Reset() noexcept;
+
+        std::size_t size() const noexcept { return length; }
+        bool empty() const noexcept { return length == 0; }
+
+        View Pin();
+
+    protected:
+        friend class CompactingPool;
+        SecretHandle(CompactingPool *pool,
+                     std::uint32_t index,
+                     std::size_t length) noexcept;
+
+        CompactingPool *pool;
+        std::uint32_t index;
+        std::size_t length;
+};
+
+class CompactingPool
+{
+    public:
+        explicit CompactingPool(
+            std::size_t chunk_size = Default_Pool_Chunk_Size);
+        CompactingPool(const CompactingPool &) = delete;
+        ~CompactingPool() = default;
+
+        CompactingPool &operator=(const CompactingPool &) = delete;
+
+        [[nodiscard]] SecretHandle Allocate(std::size_t size);
+        CompactionStatistics Compact() noexcept;
+
+        std::size_t ReservedBytes() const;
+        std::size_t LockedBytes() const;
+        std::size_t InUseBytes() const;
+
+    protected:
+        friend class SecretHandle;
+
+        // Marks a block owned by no handle
+        static constexpr std::uint32_t No_Owner = 0xffffffff;
+
+        struct Chunk
+        {
+            SecurePages pages;
+            std::size_t size_class;
+            std::size_t capacity;
+            std::size_t live;
+            std::size_t pinned;
+            std::vector<std::uint32_t> owners;
+            std::vector<std::uint32_t> free_blocks;
+        };
+
+        // Location of the object referred to by a handle
+        struct Entry
+        {
+            Chunk *chunk;
+            std::uint32_t block;
+            std::size_t size;
+            std::size_t pins;
+            bool released;
+        };
+
+        std::uint8_t *Address(const Entry &entry) const noexcept;
+        std::uint8_t *Pin(std::uint32_t index);
+        void Unpin(std::uint32_t index) noexcept;
+        void Release(std::uint32_t index) noexcept;
+        void Free(std::uint32_t index) noexcept;
+        void CompactClass(std::vector<std::unique_ptr<Chunk>> &chunks,
+                          CompactionStatistics &statistics) noexcept;
+
+        const std::size_t chunk_size;
+        mutable std::mutex mutex;
+        std::array<std::vector<std::unique_ptr<Chunk>>,
+                   SecurePool::Size_Classes> classes;
+        std::vector<Entry> entries;
+        std::vector<std::uint32_t> free_entries;
+        std::size_t reserved_bytes;
+        std::size_t locked_bytes;
+        std::size_t in_use_bytes;
+};
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,349 @@
+/*
+ *  constant_time.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This header file defines functions that operate on secret data in
+ *      constant time.  Specifically, these are "cmov" style operations
+ *      where a secret condition or a secret index determines the result:
+ *
+ *          ConstantTimeSelect()  - select one of two integers
+ *          ConditionalCopy()     - copy a buffer only if a condition is true
+ *          ConditionalSwap()     - swap two buffers only if a condition is true
+ *          ConstantTimeLookup()  - copy a table entry selected by an index
+ *
+ *      None of these functions contain branches or memory accesses that
+ *      depend on the condition, the index, or the buffer contents.  For
+ *      ConstantTimeLookup(), every table entry is read regardless of the
+ *      index, so the cost is proportional to the size of the table.
+ *
+ *      The template overloads accept std::span and any contiguous container,
+ *      including SecureArray, SecureVector, and the SecureString types.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <concepts>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Terra::SecUtil
+{
+
+// Concept for contiguous containers that may be read in constant time
+template<typename T>
+concept ConstantTimeReadable =
+    std::ranges::contiguous_range<T> && std::ranges::sized_range<T> &&
+    std::is_trivially_copyable_v<std::ranges::range_value_t<T>>;
+
+// Concept for contiguous containers that may be written in constant time
+template<typename T>
+concept ConstantTimeWritable =
+    ConstantTimeReadable<T> &&
+    !std::is_const_v<
+        std::remove_reference_t<std::ranges::range_reference_t<T>>>;
+
+/*
+ *  ConstantTimeMask()
+ *
+ *  Description:
+ *      Produce a mask having all bits set if the condition is true or all
+ *      bits clear if the condition is false.
+ *
+ *  Parameters:
+ *      condition [in]
+ *          The (secret) condition.
+ *
+ *  Returns:
+ *      The mask value.
+ *
+ *  Comments:
+ *      An optimization barrier prevents the compiler from recognizing that
+ *      the mask has only two possible values and substituting a branch.
+ */
+template<std::unsigned_integral T>
+constexpr T ConstantTimeMask(bool condition) noexcept
+{
+    T mask = T(0) - static_cast<T>(condition);
+
+#if defined(__GNUC__) || defined(__clang__)
+    if (!std::is_constant_evaluated()) __asm__("" : "+r"(mask));
+#endif
+
+    return mask;
+}
+
+/*
+ *  ConstantTimeSelect()
+ *
+ *  Description:
+ *      Select one of two unsigned integer values without branching.
+ *
+ *  Parameters:
+ *      condition [in]
+ *          The (secret) condition.
+ *
+ *      if_true [in]
+ *          The value to return if the condition is true.
+ *
+ *      if_false [in]
+ *          The value to return if the condition is false.
+ *
+ *  Returns:
+ *      Either if_true or if_false, depending on the condition.
+ *
+ *  Comments:
+ *      None.
+ */
+template<std::unsigned_integral T>
+constexpr T ConstantTimeSelect(bool condition, T if_true, T if_false) noexcept
+{
+    const T mask = ConstantTimeMask<T>(condition);
+
+    return static_cast<T>(if_false ^ ((if_false ^ if_true) & mask));
+}
+
+/*
+ *  ConditionalCopy()
+ *
+ *  Description:
+ *      Copy the source buffer to the destination buffer if the condition is
+ *      true, leaving the destination unchanged otherwise.  The destination
+ *      is read and written in either case.
+ *
+ *  Parameters:
+ *      condition [in]
+ *          The (secret) condition.
+ *
+ *      destination [out]
+ *          Pointer to the destination buffer.
+ *
+ *      source [in]
+ *          Pointer to the source buffer.
+ *
+ *      length [in]
+ *          Number of octets in each buffer.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The buffers may be identical, but they must not otherwise overlap.
+ */
+void ConditionalCopy(bool condition,
+                     void *destination,
+                     const void *source,
+                     std::size_t length) noexcept;
+
+/*
+ *  ConditionalSwap()
+ *
+ *  Description:
+ *      Swap the contents of two buffers if the condition is true, leaving
+ *      both buffers unchanged otherwise.  Both buffers are read and written
+ *      in either case.
+ *
+ *  Parameters:
+ *      condition [in]
+ *          The (secret) condition.
+ *
+ *      buffer1 [in/out]
+ *          Pointer to the first buffer.
+ *
+ *      buffer2 [in/out]
+ *          Pointer to the second buffer.
+ *
+ *      length [in]
+ *          Number of octets in each buffer.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The buffers must not overlap.
+ */
+void ConditionalSwap(bool condition,
+                     void *buffer1,
+                     void *buffer2,
+                     std::size_t length) noexcept;
+
+/*
+ *  ConstantTimeLookup()
+ *
+ *  Description:
+ *      Copy the table entry at the given (secret) index into the destination
+ *      buffer.  Every entry in the table is read so that the memory access
+ *      pattern does not depend on the index.
+ *
+ *  Parameters:
+ *      destination [out]
+ *          Pointer to the buffer into which the entry is copied.  This must
+ *          be entry_size octets in length.
+ *
+ *      table [in]
+ *          Pointer to the table of entries.
+ *
+ *      entry_size [in]
+ *          Size of each table entry in octets.
+ *
+ *      entries [in]
+ *          Number of entries in the table.
+ *
+ *      index [in]
+ *          The (secret) index of the entry to copy.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If the index is not less than the number of entries, the destination
+ *      is filled with zeros.
+ */
+void ConstantTimeLookup(void *destination,
+                        const void *table,
+                        std::size_t entry_size,
+                        std::size_t entries,
+                        std::size_t index) noexcept;
+
+/*
+ *  ConditionalCopy()
+ *
+ *  Description:
+ *      Copy the contents of the source container to the destination
+ *      container if the condition is true.
+ *
+ *  Parameters:
+ *      condition [in]
+ *          The (secret) condition.
+ *
+ *      destination [out]
+ *          The destination container (e.g., SecureArray or std::span).
+ *
+ *      source [in]
+ *          The source container.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the container sizes differ.
+ */
+template<typename T, ConstantTimeReadable U>
+    requires ConstantTimeWritable<T> &&
+             std::same_as<std::ranges::range_value_t<T>,
+                          std::ranges::range_value_t<U>>
+void ConditionalCopy(bool condition, T &&destination, const U &source)
+{
+    using ValueType = std::ranges::range_value_t<U>;
+
+    if (std::ranges::size(destination) != std::ranges::size(source))
+    {
+        throw std::invalid_argument("Container sizes differ");
+    }
+
+    ConditionalCopy(condition,
+                    std::ranges::data(destination),
+                    std::ranges::data(source),
+                    std::ranges::size(source) * sizeof(ValueType));
+}
+
+/*
+ *  ConditionalSwap()
+ *
+ *  Description:
+ *      Swap the contents of two containers if the condition is true.
+ *
+ *  Parameters:
+ *      condition [in]
+ *          The (secret) condition.
+ *
+ *      values1 [in/out]
+ *          The first container (e.g., SecureArray or std::span).
+ *
+ *      values2 [in/out]
+ *          The second container.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the container sizes differ.
+ */
+template<typename T, typename U>
+    requires ConstantTimeWritable<T> && ConstantTimeWritable<U> &&
+             std::same_as<std::ranges::range_value_t<T>,
+                          std::ranges::range_value_t<U>>
+void ConditionalSwap(bool condition, T &&values1, U &&values2)
+{
+    using ValueType = std::ranges::range_value_t<T>;
+
+    if (std::ranges::size(values1) != std::ranges::size(values2))
+    {
+        throw std::invalid_argument("Container sizes differ");
+    }
+
+    ConditionalSwap(condition,
+                    std::ranges::data(values1),
+                    std::ranges::data(values2),
+                    std::ranges::size(values1) * sizeof(ValueType));
+}
+
+/*
+ *  ConstantTimeLookup()
+ *
+ *  Description:
+ *      Copy the table entry at the given (secret) index into the destination
+ *      container, where each entry in the table is the same size as the
+ *      destination container.
+ *
+ *  Parameters:
+ *      destination [out]
+ *          The destination container (e.g., SecureArray or std::span).
+ *
+ *      table [in]
+ *          The table, holding a whole number of entries laid out contiguously.
+ *
+ *      index [in]
+ *          The (secret) index of the entry to copy.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the table size is not a
+ *      multiple of the destination size.
+ */
+template<typename T, ConstantTimeReadable U>
+    requires ConstantTimeWritable<T> &&
+             std::same_as<std::ranges::range_value_t<T>,
+                          std::ranges::range_value_t<U>>
+void ConstantTimeLookup(T &&destination, const U &table, std::size_t index)
+{
+    using ValueType = std::ranges::range_value_t<U>;
+
+    const std::size_t entry_length = std::ranges::size(destination);
+
+    if ((entry_length == 0) || (std::ranges::size(table) % entry_length))
+    {
+        throw std::invalid_argument("Table is not a whole number of entries");
+    }
+
+    ConstantTimeLookup(std::ranges::data(destination),
+                       std::ranges::data(table),
+                       entry_length * sizeof(ValueType),
+                       std::ranges::size(table) / entry_length,
+                       index);
+}
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,147 @@
+/*
+ *  keystore.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines a simple keystore file format along with objects to
+ *      write and read it.  A keystore holds any number of records (e.g.,
+ *      keys), each identified by a 64-bit key identifier.
+ *
+ *      The file begins with a header, followed by an index and then the
+ *      record data.  The index is an open-addressing hash table that is
+ *      memory-mapped when the keystore is opened, so opening a keystore is
+ *      fast regardless of the number of records and lookup by key
+ *      identifier takes constant time.  Records are read from the file only
+ *      when requested, directly into a SecureVector.
+ *
+ *      Loaded records are held in a cache of bounded size.  When the cache is
+ *      full, the least recently used record is evicted and erased once no
+ *      caller holds a reference to it.
+ *
+ *      All values in the file are stored in little-endian order:
+ *
+ *          Header (32 octets):
+ *              magic (8 octets, "TRSKEYS1")
+ *              version (4 octets, presently 1)
+ *              reserved (4 octets, zero)
+ *              bucket count (8 octets, a power of two)
+ *              record count (8 octets)
+ *
+ *          Index (bucket count entries of 24 octets):
+ *              key identifier (8 octets)
+ *              record offset from the start of the file (8 octets)
+ *              record length (4 octets)
+ *              flags (4 octets, 1 if the bucket is occupied)
+ *
+ *          Records (concatenated record data)
+ *
+ *      The keystore file itself is not encrypted; records should be stored
+ *      in wrapped (encrypted) form if the file requires protection at rest.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "secure_vector.h"
+
+namespace Terra::SecUtil
+{
+
+// A record loaded from a keystore
+using KeystoreRecord = std::shared_ptr<const SecureVector<std::uint8_t>>;
+
+class KeystoreWriter
+{
+    public:
+        KeystoreWriter() = default;
+        ~KeystoreWriter() = default;
+
+        void Add(std::uint64_t key_id, std::span<const std::uint8_t> record);
+        std::size_t size() const noexcept { return entries.size(); }
+
+        void Write(const std::filesystem::path &path) const;
+
+    protected:
+        struct Entry
+        {
+            std::uint64_t key_id;
+            std::size_t offset;
+            std::size_t length;
+        };
+
+        std::vector<Entry> entries;
+        std::unordered_set<std::uint64_t> key_ids;
+        SecureVector<std::uint8_t> data;
+};
+
+class Keystore
+{
+    public:
+        static constexpr std::size_t Default_Cache_Capacity = 1024;
+
+        explicit Keystore(const std::filesystem::path &path,
+                          std::size_t cache_capacity = Default_Cache_Capacity);
+        Keystore(const Keystore &) = delete;
+        ~Keystore();
+
+        Keystore &operator=(const Keystore &) = delete;
+
+        KeystoreRecord Find(std::uint64_t key_id);
+        bool Contains(std::uint64_t key_id) const noexcept;
+        std::size_t size() const noexcept
+        {
+            return static_cast<std::size_t>(record_count);
+        }
+
+        std::size_t CachedRecords() const;
+        void Evict(std::uint64_t key_id);
+        void ClearCache();
+
+    protected:
+        struct Location
+        {
+            std::uint64_t offset;
+            std::uint32_t length;
+        };
+
+        struct CacheEntry
+        {
+            KeystoreRecord record;
+            std::list<std::uint64_t>::iterator position;
+        };
+
+        bool Lookup(std::uint64_t key_id, Location &location) const noexcept;
+
+        std::intptr_t handle;
+        std::intptr_t mapping;
+        const std::uint8_t *index;
+        std::size_t mapped_length;
+        std::uint64_t file_size;
+        std::uint64_t bucket_count;
+        std::uint64_t record_count;
+        std::size_t cache_capacity;
+
+        mutable std::mutex cache_mutex;
+        std::list<std::uint64_t> lru;
+        std::unordered_map<std::uint64_t, CacheEntry> cache;
+};
+
+} // namespace Terra::SecUtil
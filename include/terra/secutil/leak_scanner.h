@@ -0,0 +1,199 @@
+/*
+ *  leak_scanner.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the LeakScanner, which audits whether secrets were
+ *      actually erased.  A test plants canary values in secure storage,
+ *      erases it, and then searches the memory of the process, a core file,
+ *      or any other file for the canaries:
+ *
+ *          LeakScanner scanner;
+ *          scanner.AddPattern(canary);
+ *          auto report = scanner.ScanProcess(pid, 0);
+ *          for (const auto &match : report.matches) { ... }
+ *
+ *      The report lists each memory mapping (or core file segment) examined
+ *      and every location at which a canary was found, so the mappings that
+ *      still hold secrets can be identified.
+ *
+ *      Patterns are grouped by length, first octet, and last octet.  Each
+ *      group is located by comparing 16 positions at a time against its
+ *      first and last octets using SSE2 or NEON instructions, and candidates
+ *      are then compared in full.  As the cost of this grows with the number
+ *      of groups, a larger set of patterns is instead located by consulting
+ *      a table of the first two octets of every pattern at each position.
+ *      Files are memory-mapped, and the image is divided into pieces that
+ *      are searched by several threads in parallel.
+ *
+ *      Patterns are held in inverted form so that scanning the scanner's own
+ *      process does not find the scanner's copy of each pattern.
+ *
+ *  Portability Issues:
+ *      ScanProcess() is supported only on Linux and requires permission to
+ *      read /proc/<pid>/mem (i.e., the same permission as ptrace).
+ *      ScanCoreFile() accepts 64-bit little-endian ELF core files.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Terra::SecUtil
+{
+
+// Shortest pattern the LeakScanner will search for
+inline constexpr std::size_t Min_Leak_Pattern = 4;
+
+// A memory mapping, core file segment, or file that was examined
+struct LeakRegion
+{
+    std::uint64_t start;
+    std::uint64_t end;
+    std::string permissions;
+    std::string name;
+    std::size_t matches;
+    bool readable;
+};
+
+// The location at which a pattern was found
+struct LeakMatch
+{
+    std::size_t pattern;
+    std::size_t region;
+    std::uint64_t address;
+};
+
+// Results of a scan
+struct LeakReport
+{
+    std::vector<LeakRegion> regions;
+    std::vector<LeakMatch> matches;
+    std::uint64_t bytes_scanned;
+    std::chrono::nanoseconds elapsed;
+
+    bool Clean() const noexcept { return matches.empty(); }
+
+    /*
+     *  LeakReport::Throughput()
+     *
+     *  Description:
+     *      Return the rate at which the image was scanned.
+     *
+     *  Parameters:
+     *      None.
+     *
+     *  Returns:
+     *      The throughput in MiB/s, or zero if no time elapsed.
+     *
+     *  Comments:
+     *      None.
+     */
+    double Throughput() const noexcept
+    {
+        const double seconds =
+            std::chrono::duration<double>(elapsed).count();
+
+        if (seconds <= 0.0) return 0.0;
+
+        return static_cast<double>(bytes_scanned) / 1048576.0 / seconds;
+    }
+};
+
+class LeakScanner
+{
+    public:
+        LeakScanner() : longest{0} {}
+        ~LeakScanner() = default;
+
+        std::size_t AddPattern(std::span<const std::uint8_t> pattern);
+        std::size_t PatternCount() const noexcept { return inverted.size(); }
+
+        std::vector<LeakMatch> Scan(std::span<const std::uint8_t> data,
+                                    std::uint64_t address = 0) const;
+        LeakReport ScanFile(const std::filesystem::path &path,
+                            unsigned threads = 0) const;
+        LeakReport ScanCoreFile(const std::filesystem::path &path,
+                                unsigned threads = 0) const;
+        LeakReport ScanProcess(int pid, unsigned threads = 0) const;
+
+    protected:
+        // Patterns sharing a length, first octet, and last octet
+        struct Group
+        {
+            std::size_t length;
+            std::uint8_t first;
+            std::uint8_t last;
+            std::vector<std::size_t> patterns;
+        };
+
+        // A portion of an image to search
+        struct Piece
+        {
+            std::size_t region;
+            std::uint64_t offset;
+            std::uint64_t address;
+            std::uint64_t length;
+            std::uint64_t available;
+        };
+
+        // Produces the octets of a piece for the given worker thread
+        using Fetcher = std::function<std::span<const std::uint8_t>(
+            const Piece &piece,
+            unsigned worker)>;
+
+        void Search(std::span<const std::uint8_t> data,
+                    std::size_t positions,
+                    std::size_t region,
+                    std::uint64_t address,
+                    std::vector<LeakMatch> &matches) const;
+
+        void SearchGroup(const Group &group,
+                         std::span<const std::uint8_t> data,
+                         std::size_t begin,
+                         std::size_t end,
+                         std::size_t region,
+                         std::uint64_t address,
+                         std::vector<LeakMatch> &matches) const;
+
+        void SearchPrefixes(std::span<const std::uint8_t> data,
+                            std::size_t positions,
+                            std::size_t region,
+                            std::uint64_t address,
+                            std::vector<LeakMatch> &matches) const;
+
+        bool Matches(std::span<const std::uint8_t> data,
+                     std::size_t position,
+                     std::size_t index) const noexcept;
+
+        std::vector<Piece> Divide(const std::vector<LeakRegion> &regions,
+                                  const std::vector<std::uint64_t> &offsets)
+            const;
+
+        void SearchPieces(const std::vector<Piece> &pieces,
+                          unsigned threads,
+                          const Fetcher &fetch,
+                          LeakReport &report) const;
+
+        std::size_t longest;
+        std::vector<std::vector<std::uint8_t>> inverted;
+        std::vector<Group> groups;
+        std::vector<std::uint64_t> prefix_filter;
+        std::vector<std::pair<std::uint16_t, std::size_t>> prefix_patterns;
+};
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,124 @@
+/*
+ *  masked_secret.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the MaskedSecret object, which holds a secret in
+ *      memory XORed with a per-process random pad.  The pad is held in locked
+ *      memory (see SecurePages) that is excluded from core dumps, so the
+ *      masked form that sits in ordinary heap memory, swap, or a core file
+ *      reveals nothing without the pad.  If the locked memory limit does not
+ *      permit the pad to be locked, it is used unlocked and IsPadLocked()
+ *      returns false.
+ *
+ *      The secret is accessed through a scoped view:
+ *
+ *          MaskedSecret key(key_octets);
+ *          {
+ *              auto view = key.Unmask();
+ *              Encrypt(view.data(), ...);
+ *          }   // The secret is remasked here
+ *
+ *      Unmasking and remasking operate in place using SIMD instructions where
+ *      available, so the cost of access is close to that of memcpy().  Each
+ *      time the secret is remasked, a different region of the pad is used,
+ *      so the masked form changes with every access.
+ *
+ *      The pad is 4096 octets in length.  A secret longer than the pad is
+ *      masked with the pad repeated, which is sufficient to defeat memory
+ *      scrapers but is not a substitute for encryption.
+ *
+ *      The secret and its masking state are held on the heap, so a
+ *      MaskedSecret may be moved while unmasked and the view follows the
+ *      secret to its new owner.  A MaskedSecret may not be copied or assigned
+ *      to while unmasked.
+ *
+ *  Portability Issues:
+ *      A MaskedSecret is not thread-safe while unmasked; concurrent access
+ *      to the same object requires external synchronization.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include "secure_vector.h"
+
+namespace Terra::SecUtil
+{
+
+class MaskedSecret
+{
+    protected:
+        // The masked secret and the pad offset with which it is masked
+        struct State
+        {
+            SecureVector<std::uint8_t> masked;
+            std::size_t offset = 0;
+            bool unmasked = false;
+        };
+
+    public:
+        // Scoped view of the unmasked secret that remasks on destruction
+        class View
+        {
+            public:
+                View(const View &) = delete;
+                View(View &&other) noexcept;
+                ~View();
+
+                View &operator=(const View &) = delete;
+                View &operator=(View &&) = delete;
+
+                std::uint8_t *data() noexcept;
+                std::size_t size() const noexcept;
+                std::span<std::uint8_t> Span() noexcept
+                {
+                    return {data(), size()};
+                }
+
+            protected:
+                friend class MaskedSecret;
+                View(State *state, std::size_t next_offset) noexcept;
+
+                State *state;
+                std::size_t next_offset;
+        };
+
+        MaskedSecret() noexcept;
+        explicit MaskedSecret(std::span<const std::uint8_t> secret);
+        MaskedSecret(const MaskedSecret &other);
+        MaskedSecret(MaskedSecret &&other) noexcept;
+        ~MaskedSecret() = default;
+
+        MaskedSecret &operator=(const MaskedSecret &other);
+        MaskedSecret &operator=(MaskedSecret &&other) noexcept;
+
+        void Assign(std::span<const std::uint8_t> secret);
+        void Clear() noexcept;
+
+        std::size_t size() const noexcept
+        {
+            return state ? state->masked.size() : 0;
+        }
+        bool empty() const noexcept { return size() == 0; }
+        bool IsUnmasked() const noexcept { return state && state->unmasked; }
+
+        View Unmask();
+        void UnmaskTo(std::span<std::uint8_t> destination) const;
+
+        static bool IsPadLocked();
+
+    protected:
+        std::unique_ptr<State> state;
+};
+
+} // namespace Terra::SecUtil
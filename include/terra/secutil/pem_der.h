@@ -0,0 +1,184 @@
+/*
+ *  pem_der.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines objects for parsing key containers.  PemDecoder is a
+ *      streaming parser for the PEM textual encoding (RFC 7468) that decodes
+ *      the base64 body of each block directly into a SecureVector, and
+ *      DerReader walks DER-encoded (ITU-T X.690) structures such as PKCS #8
+ *      private keys, returning spans over the input rather than copies.
+ *
+ *      The PEM decoder accepts input in chunks of any size, so a file
+ *      holding any number of blocks may be parsed as it is read:
+ *
+ *          PemDecoder decoder;
+ *          decoder.Consume(chunk);             // Chunk is erased
+ *          ...
+ *          decoder.Finish();
+ *          while (auto block = decoder.Next()) { ... }
+ *
+ *      The base64 body is gathered into a small internal buffer and decoded
+ *      a few kilobytes at a time using the vectorized, constant-time
+ *      Base64Decode() function.  No intermediate copy of the decoded data is
+ *      made, and all internal buffers are erased.
+ *
+ *      Malformed input results in a std::invalid_argument exception.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "secure_array.h"
+#include "secure_string.h"
+#include "secure_vector.h"
+
+namespace Terra::SecUtil
+{
+
+// A decoded PEM block (e.g., label "PRIVATE KEY" and its DER encoding)
+struct PemBlock
+{
+    std::string label;
+    SecureVector<std::uint8_t> data;
+};
+
+class PemDecoder
+{
+    public:
+        static constexpr std::size_t Max_Line_Length = 65536;
+
+        PemDecoder();
+        PemDecoder(const PemDecoder &) = delete;
+        ~PemDecoder() = default;
+
+        PemDecoder &operator=(const PemDecoder &) = delete;
+
+        void Update(std::string_view text);
+        void Consume(std::span<char> text);
+        void Finish();
+
+        std::optional<PemBlock> Next();
+        std::size_t Available() const noexcept { return blocks.size(); }
+
+    protected:
+        static constexpr std::size_t Staging_Size = 4096;
+
+        void ProcessLine(std::string_view line);
+        void Stage(std::string_view line);
+        void Flush(bool final);
+        void Reset() noexcept;
+
+        bool in_block;
+        bool padded;
+        std::string label;
+        SecureString pending;
+        SecureArray<char, Staging_Size> staging;
+        std::size_t staged;
+        SecureVector<std::uint8_t> data;
+        std::deque<PemBlock> blocks;
+};
+
+/*
+ *  DecodePem()
+ *
+ *  Description:
+ *      Decode all PEM blocks in the given text.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The PEM text to decode.
+ *
+ *  Returns:
+ *      The decoded blocks in the order in which they appear.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text is malformed.
+ */
+std::vector<PemBlock> DecodePem(std::string_view text);
+
+/*
+ *  LoadPemFile()
+ *
+ *  Description:
+ *      Read and decode all PEM blocks in the given file.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to read.
+ *
+ *  Returns:
+ *      The decoded blocks in the order in which they appear.
+ *
+ *  Comments:
+ *      The file is read in chunks using a SecureFileReader, so the text is
+ *      never held in memory in its entirety and each chunk is erased once
+ *      decoded.  This will throw std::system_error if the file cannot be
+ *      read or std::invalid_argument if the contents are malformed.
+ */
+std::vector<PemBlock> LoadPemFile(const std::filesystem::path &path);
+
+// Commonly used DER tags (universal class)
+inline constexpr std::uint8_t Der_Integer = 0x02;
+inline constexpr std::uint8_t Der_Bit_String = 0x03;
+inline constexpr std::uint8_t Der_Octet_String = 0x04;
+inline constexpr std::uint8_t Der_Null = 0x05;
+inline constexpr std::uint8_t Der_Object_Identifier = 0x06;
+inline constexpr std::uint8_t Der_Sequence = 0x30;
+inline constexpr std::uint8_t Der_Set = 0x31;
+
+// A DER element, whose value refers to the data being read
+struct DerElement
+{
+    std::uint8_t tag;
+    std::span<const std::uint8_t> value;
+
+    bool Constructed() const noexcept { return (tag & 0x20) != 0; }
+};
+
+class DerReader
+{
+    public:
+        explicit DerReader(std::span<const std::uint8_t> input) noexcept :
+            input{input},
+            position{0}
+        {
+        }
+        ~DerReader() = default;
+
+        DerElement Peek() const;
+        DerElement Next();
+        DerElement Next(std::uint8_t tag);
+        DerReader Enter(std::uint8_t tag = Der_Sequence);
+
+        std::size_t Remaining() const noexcept
+        {
+            return input.size() - position;
+        }
+        bool AtEnd() const noexcept { return position == input.size(); }
+
+    protected:
+        DerElement Parse(std::size_t &offset) const;
+
+        std::span<const std::uint8_t> input;
+        std::size_t position;
+};
+
+} // namespace Terra::SecUtil
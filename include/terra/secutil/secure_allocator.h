@@ -26,7 +26,9 @@
 #include <cstddef>
 #include <limits>
 #include <new>
+#include <type_traits>
 #include "secure_erase.h"
+#include "wipe_registry.h"
 
 namespace Terra::SecUtil
 {
@@ -74,7 +76,12 @@ struct SecureAllocator
         }
 
         // Attempt to allocate the requested memory (exception on failure)
-        return static_cast<T *>(::operator new(sizeof(T) * n));
+        T *p = static_cast<T *>(::operator new(sizeof(T) * n));
+
+        // Register the memory to be wiped on abnormal termination
+        if (!std::is_constant_evaluated()) RegisterSecureRegion(p, sizeof(T) * n);
+
+        return p;
     }
 
     /*
@@ -101,6 +108,9 @@ struct SecureAllocator
         // If the pointer is nullptr, just return
         if (p == nullptr) return;
 
+        // Remove the memory from the wipe registry
+        if (!std::is_constant_evaluated()) DeregisterSecureRegion(p, sizeof(T) * n);
+
         // Securely erase the allocated memory before deletion
         if (n > 0) SecureErase(p, sizeof(T) * n);
 
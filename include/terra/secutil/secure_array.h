@@ -1,7 +1,7 @@
 /*
  *  secure_array.h
  *
- *  Copyright (C) 2024, 2025
+ *  Copyright (C) 2024, 2025, 2026
  *  Terrapane Corporation
  *  All Rights Reserved
  *
@@ -19,6 +19,9 @@
  *      characters for security-related functions like encryption,
  *      authentication, password generation, and the like.
  *
+ *      If the wipe registry is enabled (see wipe_registry.h), each SecureArray
+ *      is registered when constructed and deregistered when destroyed.
+ *
  *  Portability Issues:
  *      None.
  */
@@ -30,6 +33,7 @@
 #include <algorithm>
 #include <type_traits>
 #include "secure_erase.h"
+#include "wipe_registry.h"
 
 namespace Terra::SecUtil
 {
@@ -40,6 +44,8 @@ class SecureArray : public std::array<T, N>
 {
     public:
         using std::array<T, N>::array;
+        SecureArray() = default;
+        SecureArray(const SecureArray &other) : std::array<T, N>(other) {}
         SecureArray(std::initializer_list<T> list)
         {
             // Ensure the initializer list is not too large
@@ -56,9 +62,34 @@ class SecureArray : public std::array<T, N>
         }
         virtual ~SecureArray()
         {
+            DeregisterSecureRegion(std::array<T, N>::data(),
+                                   std::array<T, N>::size() * sizeof(T));
             SecureErase(std::array<T, N>::data(),
                         std::array<T, N>::size() * sizeof(T));
         }
+
+        SecureArray &operator=(const SecureArray &) = default;
+
+    protected:
+        // Registers the array with the wipe registry when constructed; being
+        // a member with a default initializer, it keeps the defaulted (not
+        // user-provided) default constructor above, so value-initialization
+        // still zeroes the array and default-initialization does not
+        struct Registration
+        {
+            Registration(const void *address, std::size_t length) noexcept
+            {
+                RegisterSecureRegion(address, length);
+            }
+            Registration(const Registration &) = delete;
+            Registration &operator=(const Registration &) noexcept
+            {
+                return *this;
+            }
+        };
+
+        [[no_unique_address]] Registration registration{this->data(),
+                                                        N * sizeof(T)};
 };
 
 } // namespace Terra::SecUtil
@@ -0,0 +1,107 @@
+/*
+ *  secure_compare.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This header file defines functions that will compare two blocks of
+ *      memory in constant time.  Unlike operator==() or memcmp(), these
+ *      functions do not return as soon as a difference is found, so the
+ *      time required to perform the comparison reveals nothing about where
+ *      (or whether) the contents differ.  These are intended to be used
+ *      when comparing secrets such as message authentication codes, tokens,
+ *      or password hashes.
+ *
+ *      The template overload accepts any contiguous container, including
+ *      SecureArray, SecureVector, and the SecureString types.  Only the
+ *      content of the containers is treated as secret; if the two containers
+ *      differ in length, the function returns false immediately.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ranges>
+#include <concepts>
+#include <type_traits>
+
+namespace Terra::SecUtil
+{
+
+// Concept for contiguous containers whose elements may be compared bytewise
+template<typename T>
+concept SecureComparable =
+    std::ranges::contiguous_range<T> && std::ranges::sized_range<T> &&
+    std::is_trivially_copyable_v<std::ranges::range_value_t<T>>;
+
+/*
+ *  SecureCompare()
+ *
+ *  Description:
+ *      This function will compare two blocks of memory in constant time.
+ *
+ *  Parameters:
+ *      buffer1 [in]
+ *          Pointer to the first buffer to compare.
+ *
+ *      buffer2 [in]
+ *          Pointer to the second buffer to compare.
+ *
+ *      length [in]
+ *          Number of octets to compare.
+ *
+ *  Returns:
+ *      True if the buffers contain the same octets, false otherwise.
+ *
+ *  Comments:
+ *      The time taken depends only on the length, not on the content.
+ */
+bool SecureCompare(const void *buffer1,
+                   const void *buffer2,
+                   std::size_t length) noexcept;
+
+/*
+ *  SecureCompare()
+ *
+ *  Description:
+ *      This function will compare the contents of two contiguous containers
+ *      (e.g., SecureArray, SecureVector, SecureString, or std::span) in
+ *      constant time.
+ *
+ *  Parameters:
+ *      values1 [in]
+ *          The first container to compare.
+ *
+ *      values2 [in]
+ *          The second container to compare.
+ *
+ *  Returns:
+ *      True if the containers have the same length and content, false
+ *      otherwise.
+ *
+ *  Comments:
+ *      The lengths of the containers are not considered secret.
+ */
+template<SecureComparable T, SecureComparable U>
+    requires std::same_as<std::ranges::range_value_t<T>,
+                          std::ranges::range_value_t<U>>
+bool SecureCompare(const T &values1, const U &values2) noexcept
+{
+    using ValueType = std::ranges::range_value_t<T>;
+
+    if (std::ranges::size(values1) != std::ranges::size(values2)) return false;
+
+    return SecureCompare(std::ranges::data(values1),
+                         std::ranges::data(values2),
+                         std::ranges::size(values1) * sizeof(ValueType));
+}
+
+} // namespace Terra::SecUtil
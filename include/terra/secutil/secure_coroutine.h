@@ -0,0 +1,87 @@
+/*
+ *  secure_coroutine.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines a base class for coroutine promise types that
+ *      allocates coroutine frames from the DefaultSecurePool().
+ *
+ *      Local variables of a coroutine, including any keys, live in its frame,
+ *      which is ordinarily allocated on the heap and freed without being
+ *      erased.  Deriving a promise type from SecureCoroutinePromise causes
+ *      the frame to be allocated from the pool, erased when the coroutine is
+ *      destroyed, and recycled for the next coroutine of similar size:
+ *
+ *          struct promise_type : SecUtil::SecureCoroutinePromise
+ *          {
+ *              ...
+ *          };
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include "secure_pool.h"
+
+namespace Terra::SecUtil
+{
+
+struct SecureCoroutinePromise
+{
+    /*
+     *  SecureCoroutinePromise::operator new()
+     *
+     *  Description:
+     *      Allocate a coroutine frame.
+     *
+     *  Parameters:
+     *      size [in]
+     *          The size of the frame in octets.
+     *
+     *  Returns:
+     *      A pointer to the frame.
+     *
+     *  Comments:
+     *      This will throw std::bad_alloc if memory cannot be allocated.
+     */
+    static void *operator new(std::size_t size)
+    {
+        return DefaultSecurePool().Allocate(size);
+    }
+
+    /*
+     *  SecureCoroutinePromise::operator delete()
+     *
+     *  Description:
+     *      Erase and free a coroutine frame.
+     *
+     *  Parameters:
+     *      frame [in]
+     *          The frame to free.
+     *
+     *      size [in]
+     *          The size of the frame in octets.
+     *
+     *  Returns:
+     *      Nothing.
+     *
+     *  Comments:
+     *      The pool records the size of each block, so the size is unused.
+     */
+    static void operator delete(void *frame,
+                                [[maybe_unused]] std::size_t size) noexcept
+    {
+        DefaultSecurePool().Deallocate(frame);
+    }
+};
+
+} // namespace Terra::SecUtil
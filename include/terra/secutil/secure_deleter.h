@@ -1,7 +1,7 @@
 /*
  *  secure_deleter.h
  *
- *  Copyright (C) 2025
+ *  Copyright (C) 2025, 2026
  *  Terrapane Corporation
  *  All Rights Reserved
  *
@@ -34,6 +34,10 @@
  *          auto foo = MakeUniqueSecureObject<Object>(param, param);
  *          auto foo = MakeSharedSecureObject<Object>(param, param);
  *
+ *      Memory allocated by these helper functions is registered with the
+ *      wipe registry (see wipe_registry.h), if enabled, and the deleters
+ *      remove it from the registry before erasing it.
+ *
  *  Portability Issues:
  *      None.
  */
@@ -43,6 +47,7 @@
 #include <cstddef>
 #include <memory>
 #include "secure_erase.h"
+#include "wipe_registry.h"
 
 namespace Terra::SecUtil
 {
@@ -62,6 +67,9 @@ struct SecureArrayDeleter
     // Invoked to delete allocated memory
     void operator()(T *array) const noexcept
     {
+        // Remove the array from the wipe registry
+        DeregisterSecureRegion(array, size * sizeof(T));
+
         // Securely erase memory
         SecureErase(reinterpret_cast<void *>(array), size * sizeof(T));
 
@@ -83,6 +91,9 @@ struct SecureObjectDeleter
     // Invoked to delete allocated memory
     void operator()(T *object) const noexcept
     {
+        // Remove the object from the wipe registry
+        DeregisterSecureRegion(object, sizeof(T));
+
         // Securely erase memory
         SecureErase(reinterpret_cast<void *>(object), sizeof(T));
 
@@ -113,9 +124,13 @@ template<typename T>
 std::unique_ptr<T[], SecureArrayDeleter<T>> MakeUniqueSecureArray(
                                                             std::size_t size)
 {
-    return std::unique_ptr<T[], SecureArrayDeleter<T>>(
+    std::unique_ptr<T[], SecureArrayDeleter<T>> array(
         new T[size],
         SecureArrayDeleter<T>{size});
+
+    RegisterSecureRegion(array.get(), size * sizeof(T));
+
+    return array;
 }
 
 /*
@@ -139,7 +154,11 @@ std::unique_ptr<T[], SecureArrayDeleter<T>> MakeUniqueSecureArray(
 template<typename T>
 std::shared_ptr<T[]> MakeSharedSecureArray(size_t size)
 {
-    return std::shared_ptr<T[]>(new T[size], SecureArrayDeleter<T>{size});
+    std::shared_ptr<T[]> array(new T[size], SecureArrayDeleter<T>{size});
+
+    RegisterSecureRegion(array.get(), size * sizeof(T));
+
+    return array;
 }
 
 /*
@@ -165,9 +184,13 @@ template<typename T, typename... Args>
 std::unique_ptr<T, SecureObjectDeleter<T>> MakeUniqueSecureObject(
                                                                 Args &&...args)
 {
-    return std::unique_ptr<T, SecureObjectDeleter<T>>(
+    std::unique_ptr<T, SecureObjectDeleter<T>> object(
         new T(std::forward<Args>(args)...),
         SecureObjectDeleter<T>());
+
+    RegisterSecureRegion(object.get(), sizeof(T));
+
+    return object;
 }
 
 /*
@@ -192,8 +215,12 @@ std::unique_ptr<T, SecureObjectDeleter<T>> MakeUniqueSecureObject(
 template<typename T, typename... Args>
 std::shared_ptr<T> MakeSharedSecureObject(Args &&...args)
 {
-    return std::shared_ptr<T>(new T(std::forward<Args>(args)...),
+    std::shared_ptr<T> object(new T(std::forward<Args>(args)...),
                               SecureObjectDeleter<T>());
+
+    RegisterSecureRegion(object.get(), sizeof(T));
+
+    return object;
 }
 
 } // namespace Terra::SecUtil
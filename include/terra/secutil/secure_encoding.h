@@ -0,0 +1,265 @@
+/*
+ *  secure_encoding.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This header file defines functions to encode binary data as
+ *      hexadecimal or base64 (RFC 4648) text and to decode such text back
+ *      into binary data.  The output is written either into a caller-supplied
+ *      buffer of exactly the required size or directly into a SecureString
+ *      or SecureVector, so no intermediate buffers holding secret data are
+ *      ever allocated.
+ *
+ *      All of these functions execute in constant time with respect to the
+ *      data being encoded or decoded.  Rather than using lookup tables, which
+ *      may leak information through cache timing, characters are computed
+ *      arithmetically several at a time using SIMD instructions (hex) or
+ *      64-bit SIMD-within-a-register operations (base64).  When decoding,
+ *      invalid characters are detected without branching and reported only
+ *      after the entire input has been processed.  The lengths of the input
+ *      and output are not considered secret.
+ *
+ *      Base64 text must include padding and must not contain whitespace.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "secure_string.h"
+#include "secure_vector.h"
+
+namespace Terra::SecUtil
+{
+
+/*
+ *  HexEncode()
+ *
+ *  Description:
+ *      Encode the given data as hexadecimal text into the given buffer.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to encode.
+ *
+ *      text [out]
+ *          The buffer into which the text is written, which must be exactly
+ *          twice the length of the data.
+ *
+ *      uppercase [in]
+ *          True if uppercase hexadecimal digits should be produced.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text buffer is not the
+ *      required size.
+ */
+void HexEncode(std::span<const std::uint8_t> data,
+               std::span<char> text,
+               bool uppercase = false);
+
+/*
+ *  HexEncode()
+ *
+ *  Description:
+ *      Encode the given data as hexadecimal text.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to encode.
+ *
+ *      uppercase [in]
+ *          True if uppercase hexadecimal digits should be produced.
+ *
+ *  Returns:
+ *      A SecureString holding the hexadecimal text.
+ *
+ *  Comments:
+ *      None.
+ */
+SecureString HexEncode(std::span<const std::uint8_t> data,
+                       bool uppercase = false);
+
+/*
+ *  HexDecode()
+ *
+ *  Description:
+ *      Decode the given hexadecimal text into the given buffer.  Both
+ *      uppercase and lowercase digits are accepted.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The hexadecimal text to decode.
+ *
+ *      data [out]
+ *          The buffer into which the data is written, which must be exactly
+ *          half the length of the text.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text has an odd length,
+ *      if the data buffer is not the required size, or if the text contains
+ *      an invalid character.  In the latter case, the data buffer is erased.
+ */
+void HexDecode(std::string_view text, std::span<std::uint8_t> data);
+
+/*
+ *  HexDecode()
+ *
+ *  Description:
+ *      Decode the given hexadecimal text.  Both uppercase and lowercase
+ *      digits are accepted.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The hexadecimal text to decode.
+ *
+ *  Returns:
+ *      A SecureVector holding the decoded data.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text is not valid.
+ */
+SecureVector<std::uint8_t> HexDecode(std::string_view text);
+
+/*
+ *  Base64EncodedLength()
+ *
+ *  Description:
+ *      Return the length of the base64 text produced when encoding data of
+ *      the given length.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the data to encode.
+ *
+ *  Returns:
+ *      The length of the base64 text, including padding.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr std::size_t Base64EncodedLength(std::size_t length) noexcept
+{
+    return ((length + 2) / 3) * 4;
+}
+
+/*
+ *  Base64DecodedLength()
+ *
+ *  Description:
+ *      Return the length of the data produced when decoding the given base64
+ *      text.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The base64 text to be decoded.
+ *
+ *  Returns:
+ *      The length of the decoded data.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the length of the text is
+ *      not a multiple of four.  Only the padding characters are examined.
+ */
+std::size_t Base64DecodedLength(std::string_view text);
+
+/*
+ *  Base64Encode()
+ *
+ *  Description:
+ *      Encode the given data as base64 text into the given buffer.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to encode.
+ *
+ *      text [out]
+ *          The buffer into which the text is written, which must be exactly
+ *          Base64EncodedLength(data.size()) octets in length.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text buffer is not the
+ *      required size.
+ */
+void Base64Encode(std::span<const std::uint8_t> data, std::span<char> text);
+
+/*
+ *  Base64Encode()
+ *
+ *  Description:
+ *      Encode the given data as base64 text.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to encode.
+ *
+ *  Returns:
+ *      A SecureString holding the base64 text.
+ *
+ *  Comments:
+ *      None.
+ */
+SecureString Base64Encode(std::span<const std::uint8_t> data);
+
+/*
+ *  Base64Decode()
+ *
+ *  Description:
+ *      Decode the given base64 text into the given buffer.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The base64 text to decode.
+ *
+ *      data [out]
+ *          The buffer into which the data is written, which must be exactly
+ *          Base64DecodedLength(text) octets in length.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text is malformed, if
+ *      the data buffer is not the required size, or if the text contains
+ *      an invalid character.  In the latter case, the data buffer is erased.
+ */
+void Base64Decode(std::string_view text, std::span<std::uint8_t> data);
+
+/*
+ *  Base64Decode()
+ *
+ *  Description:
+ *      Decode the given base64 text.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The base64 text to decode.
+ *
+ *  Returns:
+ *      A SecureVector holding the decoded data.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text is not valid.
+ */
+SecureVector<std::uint8_t> Base64Decode(std::string_view text);
+
+} // namespace Terra::SecUtil
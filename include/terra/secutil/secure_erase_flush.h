@@ -0,0 +1,140 @@
+/*
+ *  secure_erase_flush.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines functions that erase memory and ensure the zeros
+ *      reach main memory.  SecureErase() writes zeros that may remain only
+ *      in the processor's caches for some time, while main memory continues
+ *      to hold the secret and could be recovered by a cold boot attack or
+ *      by reading memory through a DMA-capable device.
+ *
+ *      SecureEraseFlush() erases memory using one of two methods:
+ *
+ *          NonTemporal - Whole cache lines are written using non-temporal
+ *                        (streaming) stores, which bypass the cache and
+ *                        evict any cached copy of each line.
+ *
+ *          CacheFlush  - The memory is erased normally and each cache line
+ *                        is then written back and evicted using clflushopt
+ *                        (or clflush where it is unavailable).
+ *
+ *      Automatic selects NonTemporal for larger regions and CacheFlush for
+ *      smaller ones.  Partial cache lines at either end of a region are
+ *      always erased normally and flushed.
+ *
+ *      The writes and flushes are weakly ordered, so a single store fence
+ *      completes them.  When erasing several regions, pass all of them in
+ *      one call so that only one fence is issued:
+ *
+ *          EraseRegion regions[] = {{key, key_size}, {iv, iv_size}};
+ *          SecureEraseFlush(regions);
+ *
+ *  Portability Issues:
+ *      On x86, both methods are supported.  On 64-bit ARM with GCC or
+ *      Clang, memory is erased and each line is cleaned and invalidated to
+ *      the point of coherency (DC CIVAC) for either method.  Elsewhere,
+ *      memory is erased with SecureErase() but not flushed, which
+ *      EraseFlushSupported() reports.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace Terra::SecUtil
+{
+
+// Method used to ensure erased memory reaches main memory
+enum class EraseFlushMethod
+{
+    Automatic,
+    NonTemporal,
+    CacheFlush
+};
+
+// A region of memory to erase
+struct EraseRegion
+{
+    void *buffer;
+    std::size_t length;
+};
+
+/*
+ *  SecureEraseFlush()
+ *
+ *  Description:
+ *      Erase memory and flush the zeros from the cache to main memory.
+ *
+ *  Parameters:
+ *      buffer [in]
+ *          Pointer to buffer to erase.
+ *
+ *      length [in]
+ *          Number of octets to set to zero.
+ *
+ *      method [in]
+ *          The method used to bypass or flush the cache.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The memory has reached main memory (or the persistence domain) when
+ *      this function returns.
+ */
+void SecureEraseFlush(void *buffer,
+                      std::size_t length,
+                      EraseFlushMethod method = EraseFlushMethod::Automatic);
+
+/*
+ *  SecureEraseFlush()
+ *
+ *  Description:
+ *      Erase several regions of memory and flush the zeros from the cache to
+ *      main memory, issuing a single fence once all are erased.
+ *
+ *  Parameters:
+ *      regions [in]
+ *          The regions to erase.  Regions having a null pointer or zero
+ *          length are ignored.
+ *
+ *      method [in]
+ *          The method used to bypass or flush the cache.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SecureEraseFlush(std::span<const EraseRegion> regions,
+                      EraseFlushMethod method = EraseFlushMethod::Automatic);
+
+/*
+ *  EraseFlushSupported()
+ *
+ *  Description:
+ *      Determine whether SecureEraseFlush() is able to flush the cache on
+ *      this platform.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if erased memory is flushed to main memory, false if it is only
+ *      erased.
+ *
+ *  Comments:
+ *      None.
+ */
+bool EraseFlushSupported() noexcept;
+
+} // namespace Terra::SecUtil
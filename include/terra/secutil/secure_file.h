@@ -0,0 +1,134 @@
+/*
+ *  secure_file.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This header file defines functions and an object that read files
+ *      (e.g., private keys) directly into secure storage, without passing
+ *      through std::string, std::vector, or stream buffers that are never
+ *      erased.
+ *
+ *      LoadSecureFile() reads a file into a SecureVector sized in advance,
+ *      so the file is read with as few system calls as possible and the
+ *      vector is never reallocated.
+ *
+ *      LoadSecureFilePages() reads a file into SecurePages, which is locked
+ *      before any data is read so that the contents are never written to
+ *      swap.  When requested and supported by the file system, the file is
+ *      read with direct I/O (O_DIRECT), bypassing the page cache entirely.
+ *      Otherwise, the kernel is advised to drop the file's cached pages once
+ *      the file has been read.
+ *
+ *      SecureFileReader reads large files (e.g., keystores) in fixed-size
+ *      chunks into a single reused secure buffer that is erased when the
+ *      reader is destroyed.
+ *
+ *      All functions throw std::system_error if the file cannot be read.
+ *
+ *  Portability Issues:
+ *      Direct I/O is used on Linux (O_DIRECT) and Windows
+ *      (FILE_FLAG_NO_BUFFERING).  On other systems, or on file systems that
+ *      do not support it (e.g., tmpfs), the file is read normally.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include "secure_pages.h"
+#include "secure_vector.h"
+
+namespace Terra::SecUtil
+{
+
+/*
+ *  LoadSecureFile()
+ *
+ *  Description:
+ *      Read the entire contents of the given file into a SecureVector.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to read.
+ *
+ *  Returns:
+ *      The contents of the file.
+ *
+ *  Comments:
+ *      For regular files, the vector is sized exactly before reading.  Other
+ *      files (e.g., pipes) are read in chunks; any storage released as the
+ *      vector grows is erased by the SecureAllocator.  This will throw
+ *      std::system_error if the file cannot be read.
+ */
+SecureVector<std::uint8_t> LoadSecureFile(const std::filesystem::path &path);
+
+/*
+ *  LoadSecureFilePages()
+ *
+ *  Description:
+ *      Read the entire contents of the given regular file into SecurePages.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to read.
+ *
+ *      lock [in]
+ *          If true, the memory is locked before reading and a
+ *          std::system_error exception is thrown if it cannot be locked.
+ *
+ *      direct [in]
+ *          If true, attempt to read the file using direct I/O so that the
+ *          contents do not enter the page cache.
+ *
+ *  Returns:
+ *      The contents of the file.
+ *
+ *  Comments:
+ *      This will throw std::system_error if the file cannot be read, or
+ *      std::invalid_argument if the path does not refer to a regular file.
+ */
+SecurePages LoadSecureFilePages(const std::filesystem::path &path,
+                                bool lock = true,
+                                bool direct = true);
+
+class SecureFileReader
+{
+    public:
+        static constexpr std::size_t Default_Chunk_Size = 65536;
+
+        explicit SecureFileReader(const std::filesystem::path &path,
+                                  std::size_t chunk_size = Default_Chunk_Size,
+                                  bool lock = false,
+                                  bool direct = false);
+        SecureFileReader(const SecureFileReader &) = delete;
+        SecureFileReader(SecureFileReader &&other) noexcept;
+        ~SecureFileReader();
+
+        SecureFileReader &operator=(const SecureFileReader &) = delete;
+        SecureFileReader &operator=(SecureFileReader &&other) noexcept;
+
+        std::span<const std::uint8_t> Next();
+
+        std::uint64_t Position() const noexcept { return position; }
+        bool IsDirect() const noexcept { return direct_io; }
+
+    protected:
+        void Close() noexcept;
+
+        std::intptr_t handle;
+        SecurePages buffer;
+        std::size_t valid;
+        std::uint64_t position;
+        bool direct_io;
+        bool end_of_file;
+};
+
+} // namespace Terra::SecUtil
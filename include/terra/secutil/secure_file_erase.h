@@ -0,0 +1,149 @@
+/*
+ *  secure_file_erase.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines functions that erase files holding secrets, such
+ *      as large intermediate values spilled to temporary storage.
+ *
+ *      SecureEraseFile() overwrites the data in a file with zeros, written in
+ *      large aligned chunks from a zeroed secure buffer and optionally by
+ *      several threads in parallel.  It then flushes the file to storage,
+ *      deallocates its blocks (punching a hole over the whole file), and
+ *      removes it.  Only the regions of a sparse file that hold data are
+ *      overwritten.
+ *
+ *      Files on tmpfs, including those created with memfd_create(), reside
+ *      only in memory.  For these, flushing and hole punching are skipped
+ *      and the file is truncated once overwritten, which releases its
+ *      pages.  The overwrite is still performed, as released pages are not
+ *      cleared until the kernel reuses them.  Files on hugetlbfs are also
+ *      memory-backed, but that file system does not support write(), so
+ *      they are instead mapped and erased by a single thread with
+ *      SecureErase() before being truncated.
+ *
+ *      The time taken and resulting throughput are reported so that callers
+ *      can choose the number of threads to use:
+ *
+ *          auto result = SecureEraseFile(path, 4);
+ *          log << result.Throughput() << " MiB/s";
+ *
+ *      Overwriting cannot reach copies of the data that the storage device
+ *      or file system keeps elsewhere, such as blocks remapped by an SSD's
+ *      flash translation layer or older versions kept by a copy-on-write
+ *      file system or snapshot.  Such storage should be encrypted.
+ *
+ *  Portability Issues:
+ *      Hole punching and the tmpfs fast path are available only on Linux.
+ *      Elsewhere, the file is overwritten, flushed, and removed.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace Terra::SecUtil
+{
+
+// Size of each write made when overwriting a file
+inline constexpr std::size_t File_Erase_Chunk_Size = 1048576;
+
+// Outcome of erasing a file
+struct FileEraseResult
+{
+    std::uint64_t bytes_overwritten;
+    std::chrono::nanoseconds elapsed;
+    unsigned threads;
+    bool memory_backed;
+    bool hole_punched;
+
+    /*
+     *  FileEraseResult::Throughput()
+     *
+     *  Description:
+     *      Return the rate at which the file was erased.
+     *
+     *  Parameters:
+     *      None.
+     *
+     *  Returns:
+     *      The throughput in MiB/s, or zero if no time elapsed.
+     *
+     *  Comments:
+     *      The elapsed time includes flushing and deallocating the file.
+     */
+    double Throughput() const noexcept
+    {
+        const double seconds =
+            std::chrono::duration<double>(elapsed).count();
+
+        if (seconds <= 0.0) return 0.0;
+
+        return static_cast<double>(bytes_overwritten) / 1048576.0 / seconds;
+    }
+};
+
+/*
+ *  SecureEraseFile()
+ *
+ *  Description:
+ *      Overwrite the contents of the given file with zeros, deallocate its
+ *      storage, and remove it.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to erase.
+ *
+ *      threads [in]
+ *          The number of threads to use to overwrite the file.  Zero
+ *          selects the number of hardware threads.
+ *
+ *  Returns:
+ *      A description of the work performed.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the path does not refer to
+ *      a regular file or std::system_error if the file cannot be erased.
+ *      The file is not removed if an error occurs.
+ */
+FileEraseResult SecureEraseFile(const std::filesystem::path &path,
+                                unsigned threads = 1);
+
+/*
+ *  SecureEraseFileContents()
+ *
+ *  Description:
+ *      Overwrite the contents of an open file with zeros, deallocate its
+ *      storage, and truncate it to zero length.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file, which must be writable: a file descriptor or, on
+ *          Windows, a HANDLE.  The handle remains open.
+ *
+ *      threads [in]
+ *          The number of threads to use to overwrite the file.  Zero
+ *          selects the number of hardware threads.
+ *
+ *  Returns:
+ *      A description of the work performed.
+ *
+ *  Comments:
+ *      This is intended for files that have no name, such as those created
+ *      with memfd_create() or O_TMPFILE.  This will throw
+ *      std::invalid_argument if the handle does not refer to a regular file
+ *      or std::system_error if the file cannot be erased.
+ */
+FileEraseResult SecureEraseFileContents(std::intptr_t handle,
+                                        unsigned threads = 1);
+
+} // namespace Terra::SecUtil
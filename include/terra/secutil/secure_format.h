@@ -0,0 +1,415 @@
+/*
+ *  secure_format.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This header file defines functions that format text with std::format
+ *      directly into a SecureString (or SecureWString) or a caller-supplied
+ *      buffer.  The formatted length is computed first, so the output is
+ *      written in place without creating std::string temporaries that would
+ *      never be erased.  For example:
+ *
+ *          SecureString header = SecureFormat("Bearer {}", token);
+ *          SecureFormatTo(connection, ";password={}", password);
+ *
+ *      This file also defines std::formatter specializations for the secure
+ *      string types and for SecureVector and SecureArray of octets, which are
+ *      formatted as hexadecimal.  The "r" format specification replaces the
+ *      value with "[REDACTED]", which is useful when logging:
+ *
+ *          log << std::format("user={} password={:r}", user, password);
+ *
+ *  Portability Issues:
+ *      Requires a standard library that provides <format> (e.g., GCC 13 or
+ *      later).  Including this header with one that does not is an error.
+ */
+
+#pragma once
+
+#include <version>
+
+#if !defined(__cpp_lib_format)
+#error "secure_format.h requires a standard library that provides <format>"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include "secure_array.h"
+#include "secure_string.h"
+#include "secure_vector.h"
+
+namespace Terra::SecUtil
+{
+
+/*
+ *  SecureFormatTo()
+ *
+ *  Description:
+ *      Append formatted text to the given SecureString.
+ *
+ *  Parameters:
+ *      target [in/out]
+ *          The string to which the formatted text is appended.
+ *
+ *      format [in]
+ *          The format string.
+ *
+ *      args [in]
+ *          The arguments to format.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The string is grown at most once; any storage released as it grows
+ *      is erased by the SecureAllocator.
+ */
+template<typename... Args>
+void SecureFormatTo(SecureString &target,
+                    std::format_string<const Args &...> format,
+                    const Args &...args)
+{
+    const std::size_t length = std::formatted_size(format, args...);
+    const std::size_t offset = target.size();
+
+    target.resize(offset + length);
+    std::format_to_n(target.data() + offset,
+                     static_cast<std::ptrdiff_t>(length),
+                     format,
+                     args...);
+}
+
+/*
+ *  SecureFormatTo()
+ *
+ *  Description:
+ *      Append formatted text to the given SecureWString.
+ *
+ *  Parameters:
+ *      target [in/out]
+ *          The string to which the formatted text is appended.
+ *
+ *      format [in]
+ *          The format string.
+ *
+ *      args [in]
+ *          The arguments to format.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The string is grown at most once; any storage released as it grows
+ *      is erased by the SecureAllocator.
+ */
+template<typename... Args>
+void SecureFormatTo(SecureWString &target,
+                    std::wformat_string<const Args &...> format,
+                    const Args &...args)
+{
+    const std::size_t length = std::formatted_size(format, args...);
+    const std::size_t offset = target.size();
+
+    target.resize(offset + length);
+    std::format_to_n(target.data() + offset,
+                     static_cast<std::ptrdiff_t>(length),
+                     format,
+                     args...);
+}
+
+/*
+ *  SecureFormatTo()
+ *
+ *  Description:
+ *      Write formatted text into the given buffer.
+ *
+ *  Parameters:
+ *      buffer [out]
+ *          The buffer into which the formatted text is written.  No
+ *          terminating null character is written.
+ *
+ *      format [in]
+ *          The format string.
+ *
+ *      args [in]
+ *          The arguments to format.
+ *
+ *  Returns:
+ *      The number of characters written.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the buffer is too small, in
+ *      which case nothing is written.
+ */
+template<typename... Args>
+std::size_t SecureFormatTo(std::span<char> buffer,
+                           std::format_string<const Args &...> format,
+                           const Args &...args)
+{
+    const std::size_t length = std::formatted_size(format, args...);
+
+    if (length > buffer.size())
+    {
+        throw std::invalid_argument("Format buffer is too small");
+    }
+
+    std::format_to_n(buffer.data(),
+                     static_cast<std::ptrdiff_t>(length),
+                     format,
+                     args...);
+
+    return length;
+}
+
+/*
+ *  SecureFormat()
+ *
+ *  Description:
+ *      Format text into a new SecureString.
+ *
+ *  Parameters:
+ *      format [in]
+ *          The format string.
+ *
+ *      args [in]
+ *          The arguments to format.
+ *
+ *  Returns:
+ *      The formatted text.
+ *
+ *  Comments:
+ *      The string is allocated exactly once.
+ */
+template<typename... Args>
+SecureString SecureFormat(std::format_string<const Args &...> format,
+                          const Args &...args)
+{
+    SecureString result;
+
+    SecureFormatTo(result, format, args...);
+
+    return result;
+}
+
+/*
+ *  SecureFormat()
+ *
+ *  Description:
+ *      Format text into a new SecureWString.
+ *
+ *  Parameters:
+ *      format [in]
+ *          The format string.
+ *
+ *      args [in]
+ *          The arguments to format.
+ *
+ *  Returns:
+ *      The formatted text.
+ *
+ *  Comments:
+ *      The string is allocated exactly once.
+ */
+template<typename... Args>
+SecureWString SecureFormat(std::wformat_string<const Args &...> format,
+                           const Args &...args)
+{
+    SecureWString result;
+
+    SecureFormatTo(result, format, args...);
+
+    return result;
+}
+
+// Text substituted for a value formatted with the "r" specification
+template<typename CharT>
+inline constexpr CharT Redacted_Text[] = {
+    CharT('['), CharT('R'), CharT('E'), CharT('D'), CharT('A'),
+    CharT('C'), CharT('T'), CharT('E'), CharT('D'), CharT(']')};
+
+/*
+ *  ParseRedaction()
+ *
+ *  Description:
+ *      Determine whether the format specification is exactly "r".
+ *
+ *  Parameters:
+ *      context [in]
+ *          The format parse context.
+ *
+ *  Returns:
+ *      True if the specification is "r", false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename CharT>
+constexpr bool ParseRedaction(std::basic_format_parse_context<CharT> &context)
+{
+    auto it = context.begin();
+
+    if ((it == context.end()) || (*it != CharT('r'))) return false;
+    ++it;
+
+    return (it == context.end()) || (*it == CharT('}'));
+}
+
+// Formatter for secure strings, which writes the string or redacts; the
+// standard library declares formatter<basic_string<CharT, Traits, Alloc>>,
+// so the secure string types are fully specialized using this as a base
+template<typename CharT>
+class SecureStringFormatter :
+    public std::formatter<std::basic_string_view<CharT>, CharT>
+{
+    public:
+        using Base = std::formatter<std::basic_string_view<CharT>, CharT>;
+
+        constexpr auto parse(std::basic_format_parse_context<CharT> &context)
+        {
+            redact = ParseRedaction(context);
+            if (!redact) return Base::parse(context);
+
+            auto it = context.begin();
+            return ++it;
+        }
+
+        template<typename FormatContext>
+        auto format(const SecureBasicString<CharT> &value,
+                    FormatContext &context) const
+        {
+            if (redact)
+            {
+                auto out = context.out();
+                for (const CharT c : Redacted_Text<CharT>) *out++ = c;
+                return out;
+            }
+
+            return Base::format(std::basic_string_view<CharT>(value), context);
+        }
+
+    protected:
+        bool redact = false;
+};
+
+// Formatter for octet containers, which writes hexadecimal or redacts
+template<typename CharT>
+class SecureOctetsFormatter
+{
+    public:
+        constexpr auto parse(std::basic_format_parse_context<CharT> &context)
+        {
+            auto it = context.begin();
+
+            if ((it != context.end()) && (*it != CharT('}')))
+            {
+                if (*it == CharT('r'))
+                {
+                    redact = true;
+                }
+                else if (*it == CharT('X'))
+                {
+                    uppercase = true;
+                }
+                else if (*it != CharT('x'))
+                {
+                    throw std::format_error("Invalid format specification");
+                }
+
+                ++it;
+            }
+
+            if ((it != context.end()) && (*it != CharT('}')))
+            {
+                throw std::format_error("Invalid format specification");
+            }
+
+            return it;
+        }
+
+        template<typename FormatContext>
+        auto format(std::span<const std::uint8_t> octets,
+                    FormatContext &context) const
+        {
+            auto out = context.out();
+
+            if (redact)
+            {
+                for (const CharT c : Redacted_Text<CharT>) *out++ = c;
+                return out;
+            }
+
+            // Convert without table lookups or branches on the secret
+            const int letter_offset = (uppercase ? 'A' : 'a') - '0' - 10;
+
+            for (const std::uint8_t octet : octets)
+            {
+                for (const int nibble : {octet >> 4, octet & 0x0f})
+                {
+                    const int adjust = ((9 - nibble) >> 8) & letter_offset;
+                    *out++ = static_cast<CharT>('0' + nibble + adjust);
+                }
+            }
+
+            return out;
+        }
+
+    protected:
+        bool redact = false;
+        bool uppercase = false;
+};
+
+} // namespace Terra::SecUtil
+
+// Formatter for SecureString
+template<>
+struct std::formatter<Terra::SecUtil::SecureString, char> :
+    Terra::SecUtil::SecureStringFormatter<char>
+{
+};
+
+// Formatter for SecureWString
+template<>
+struct std::formatter<Terra::SecUtil::SecureWString, wchar_t> :
+    Terra::SecUtil::SecureStringFormatter<wchar_t>
+{
+};
+
+// Formatter for SecureVector<std::uint8_t>
+template<typename CharT>
+struct std::formatter<Terra::SecUtil::SecureVector<std::uint8_t>, CharT> :
+    Terra::SecUtil::SecureOctetsFormatter<CharT>
+{
+    template<typename FormatContext>
+    auto format(const Terra::SecUtil::SecureVector<std::uint8_t> &value,
+                FormatContext &context) const
+    {
+        return Terra::SecUtil::SecureOctetsFormatter<CharT>::format(
+            std::span<const std::uint8_t>(value),
+            context);
+    }
+};
+
+// Formatter for SecureArray<std::uint8_t, N>
+template<std::size_t N, typename CharT>
+struct std::formatter<Terra::SecUtil::SecureArray<std::uint8_t, N>, CharT> :
+    Terra::SecUtil::SecureOctetsFormatter<CharT>
+{
+    template<typename FormatContext>
+    auto format(const Terra::SecUtil::SecureArray<std::uint8_t, N> &value,
+                FormatContext &context) const
+    {
+        return Terra::SecUtil::SecureOctetsFormatter<CharT>::format(
+            std::span<const std::uint8_t>(value),
+            context);
+    }
+};
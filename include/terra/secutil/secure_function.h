@@ -0,0 +1,403 @@
+/*
+ *  secure_function.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines SecureFunction, a move-only, type-erased callable
+ *      wrapper similar to std::function that may safely hold callables
+ *      capturing secrets by value:
+ *
+ *          SecureFunction<void(std::span<const std::uint8_t>)> callback =
+ *              [key = std::move(key)](auto data) { ... };
+ *
+ *      The callable is stored within the SecureFunction object if it fits in
+ *      the inline storage (Default_Function_Storage octets by default) and
+ *      can be moved without throwing, so callbacks on a hot path do not
+ *      allocate memory.  Larger callables are allocated using the
+ *      SecureAllocator.  Either way, the memory that held the callable is
+ *      erased when the SecureFunction is destroyed, assigned, or moved from.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "secure_allocator.h"
+#include "secure_erase.h"
+
+namespace Terra::SecUtil
+{
+
+// Default size of the storage within a SecureFunction for the callable
+inline constexpr std::size_t Default_Function_Storage = 128;
+
+template<typename Signature,
+         std::size_t Storage_Size = Default_Function_Storage>
+class SecureFunction;
+
+template<typename R, typename... Args, std::size_t Storage_Size>
+class SecureFunction<R(Args...), Storage_Size>
+{
+    public:
+        using result_type = R;
+
+        SecureFunction() noexcept : operations{nullptr} {}
+        SecureFunction(std::nullptr_t) noexcept : operations{nullptr} {}
+
+        /*
+         *  SecureFunction::SecureFunction()
+         *
+         *  Description:
+         *      Construct a SecureFunction holding the given callable.
+         *
+         *  Parameters:
+         *      function [in]
+         *          The callable to store, which is moved or copied.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      A null function pointer produces an empty SecureFunction.  This
+         *      will throw std::bad_alloc if a large callable cannot be
+         *      allocated or any exception thrown by the callable's
+         *      constructor.
+         */
+        template<typename F>
+            requires(!std::is_same_v<std::remove_cvref_t<F>, SecureFunction> &&
+                     std::is_invocable_r_v<R, std::decay_t<F> &, Args...>)
+        SecureFunction(F &&function) : operations{nullptr}
+        {
+            using Target = std::decay_t<F>;
+
+            static_assert(alignof(Target) <= alignof(std::max_align_t),
+                          "Over-aligned callables are not supported");
+
+            // Function references decay to pointers, but are never null
+            if constexpr (std::is_pointer_v<std::remove_cvref_t<F>> ||
+                          std::is_member_pointer_v<std::remove_cvref_t<F>>)
+            {
+                if (function == nullptr) return;
+            }
+
+            if constexpr (Fits<Target>())
+            {
+                ::new (static_cast<void *>(storage)) Target(
+                    std::forward<F>(function));
+                operations = &Local_Operations<Target>;
+            }
+            else
+            {
+                SecureAllocator<Target> allocator;
+                Target *target = allocator.allocate(1);
+
+                try
+                {
+                    ::new (static_cast<void *>(target)) Target(
+                        std::forward<F>(function));
+                }
+                catch (...)
+                {
+                    allocator.deallocate(target, 1);
+                    throw;
+                }
+                ::new (static_cast<void *>(storage)) Target *(target);
+                operations = &Remote_Operations<Target>;
+            }
+        }
+
+        /*
+         *  SecureFunction::SecureFunction()
+         *
+         *  Description:
+         *      Move constructor.
+         *
+         *  Parameters:
+         *      other [in]
+         *          The SecureFunction from which to move.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      The other SecureFunction is left empty and its storage erased.
+         */
+        SecureFunction(SecureFunction &&other) noexcept : operations{nullptr}
+        {
+            MoveFrom(other);
+        }
+
+        SecureFunction(const SecureFunction &) = delete;
+
+        ~SecureFunction() { Reset(); }
+
+        /*
+         *  SecureFunction::operator=()
+         *
+         *  Description:
+         *      Move assignment operator.
+         *
+         *  Parameters:
+         *      other [in]
+         *          The SecureFunction from which to move.
+         *
+         *  Returns:
+         *      A reference to this object.
+         *
+         *  Comments:
+         *      The callable previously held is destroyed and its storage
+         *      erased.  The other SecureFunction is left empty.
+         */
+        SecureFunction &operator=(SecureFunction &&other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+
+            return *this;
+        }
+
+        /*
+         *  SecureFunction::operator=()
+         *
+         *  Description:
+         *      Replace the callable held with the given callable.
+         *
+         *  Parameters:
+         *      function [in]
+         *          The new callable.
+         *
+         *  Returns:
+         *      A reference to this object.
+         *
+         *  Comments:
+         *      The callable previously held is destroyed and its storage
+         *      erased only once the new callable has been constructed.
+         */
+        template<typename F>
+            requires(!std::is_same_v<std::remove_cvref_t<F>, SecureFunction> &&
+                     std::is_invocable_r_v<R, std::decay_t<F> &, Args...>)
+        SecureFunction &operator=(F &&function)
+        {
+            return *this = SecureFunction(std::forward<F>(function));
+        }
+
+        SecureFunction &operator=(std::nullptr_t) noexcept
+        {
+            Reset();
+            return *this;
+        }
+
+        SecureFunction &operator=(const SecureFunction &) = delete;
+
+        explicit operator bool() const noexcept
+        {
+            return operations != nullptr;
+        }
+
+        bool IsInline() const noexcept
+        {
+            return (operations != nullptr) && operations->local;
+        }
+
+        /*
+         *  SecureFunction::operator()()
+         *
+         *  Description:
+         *      Call the callable held.
+         *
+         *  Parameters:
+         *      args [in]
+         *          Arguments passed to the callable.
+         *
+         *  Returns:
+         *      The value returned by the callable.
+         *
+         *  Comments:
+         *      This will throw std::bad_function_call if the SecureFunction is
+         *      empty.
+         */
+        R operator()(Args... args) const
+        {
+            if (operations == nullptr) throw std::bad_function_call();
+
+            return operations->invoke(storage, std::forward<Args>(args)...);
+        }
+
+    protected:
+        // Functions that operate on the stored callable
+        struct Operations
+        {
+            R (*invoke)(void *target, Args &&...args);
+            void (*relocate)(void *destination, void *source) noexcept;
+            void (*destroy)(void *target) noexcept;
+            std::size_t size;
+            bool local;
+        };
+
+        /*
+         *  SecureFunction::Fits()
+         *
+         *  Description:
+         *      Determine whether a callable type may be stored inline.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      True if the callable fits in the inline storage and can be
+         *      moved without throwing.
+         *
+         *  Comments:
+         *      None.
+         */
+        template<typename Target>
+        static constexpr bool Fits() noexcept
+        {
+            return (sizeof(Target) <= Storage_Size) &&
+                   std::is_nothrow_move_constructible_v<Target>;
+        }
+
+        /*
+         *  SecureFunction::Invoke()
+         *
+         *  Description:
+         *      Call the given callable.
+         *
+         *  Parameters:
+         *      target [in]
+         *          The callable.
+         *
+         *      args [in]
+         *          Arguments passed to the callable.
+         *
+         *  Returns:
+         *      The value returned by the callable.
+         *
+         *  Comments:
+         *      None.
+         */
+        template<typename Target>
+        static R Invoke(Target &target, Args &&...args)
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                std::invoke(target, std::forward<Args>(args)...);
+            }
+            else
+            {
+                return std::invoke(target, std::forward<Args>(args)...);
+            }
+        }
+
+        // Operations on a callable stored inline
+        template<typename Target>
+        static constexpr Operations Local_Operations{
+            [](void *target, Args &&...args) -> R
+            {
+                return Invoke(*static_cast<Target *>(target),
+                              std::forward<Args>(args)...);
+            },
+            [](void *destination, void *source) noexcept
+            {
+                Target *from = static_cast<Target *>(source);
+                ::new (destination) Target(std::move(*from));
+                from->~Target();
+            },
+            [](void *target) noexcept
+            {
+                static_cast<Target *>(target)->~Target();
+            },
+            sizeof(Target),
+            true};
+
+        // Operations on a callable allocated using the SecureAllocator
+        template<typename Target>
+        static constexpr Operations Remote_Operations{
+            [](void *target, Args &&...args) -> R
+            {
+                return Invoke(**static_cast<Target **>(target),
+                              std::forward<Args>(args)...);
+            },
+            [](void *destination, void *source) noexcept
+            {
+                ::new (destination) Target *(*static_cast<Target **>(source));
+            },
+            [](void *target) noexcept
+            {
+                Target *pointer = *static_cast<Target **>(target);
+                pointer->~Target();
+                SecureAllocator<Target>().deallocate(pointer, 1);
+            },
+            sizeof(Target *),
+            false};
+
+        /*
+         *  SecureFunction::Reset()
+         *
+         *  Description:
+         *      Destroy the callable held, if any, and erase its storage.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      None.
+         */
+        void Reset() noexcept
+        {
+            if (operations == nullptr) return;
+
+            operations->destroy(storage);
+            SecureErase(storage, operations->size);
+            operations = nullptr;
+        }
+
+        /*
+         *  SecureFunction::MoveFrom()
+         *
+         *  Description:
+         *      Take the callable held by another SecureFunction.
+         *
+         *  Parameters:
+         *      other [in]
+         *          The SecureFunction from which to move.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      This object must be empty.  The other object's storage is
+         *      erased and it is left empty.
+         */
+        void MoveFrom(SecureFunction &other) noexcept
+        {
+            if (other.operations == nullptr) return;
+
+            other.operations->relocate(storage, other.storage);
+            SecureErase(other.storage, other.operations->size);
+            operations = std::exchange(other.operations, nullptr);
+        }
+
+        const Operations *operations;
+        alignas(std::max_align_t) mutable unsigned char storage[Storage_Size];
+};
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,111 @@
+/*
+ *  secure_pages.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the SecurePages object, which owns a page-aligned
+ *      block of memory obtained directly from the operating system rather
+ *      than from the heap.  The memory may be locked so that it is never
+ *      written to swap, it is excluded from core dumps where the operating
+ *      system allows, and it is securely erased before being returned to
+ *      the operating system when the object is destroyed.
+ *
+ *      SecurePages is intended for secrets that warrant stronger protection
+ *      than SecureAllocator provides, and for buffers that must be page
+ *      aligned (e.g., for direct I/O).  Since each object occupies at least
+ *      one page, it is not suited to large numbers of small secrets.
+ *
+ *      By default, memory is erased by overwriting it with zeros.  Large
+ *      blocks may instead use PageEraseMethod::Discard, which asks the
+ *      kernel to drop the pages (madvise(MADV_DONTNEED) on Linux, or simply
+ *      unmapping them when the object is destroyed).  Subsequent reads of a
+ *      discarded page see zeros, and the cost is largely independent of the
+ *      size of the block, but the threat model differs: the physical pages
+ *      are returned to the kernel still holding the secret, and they are
+ *      cleared only when the kernel next hands them out (or immediately if
+ *      the kernel is configured with init_on_free=1).  Until then, the
+ *      secret cannot be read by this or any other process, but it remains
+ *      exposed to the kernel, a hypervisor, DMA-capable devices, and
+ *      physical attacks such as cold boot.  Applications concerned with
+ *      those attackers should use the default method.  Locked memory
+ *      cannot be discarded while the mapping is kept, so Erase() overwrites
+ *      locked blocks regardless of the method.
+ *
+ *  Portability Issues:
+ *      The amount of memory that may be locked is typically limited by the
+ *      operating system (e.g., RLIMIT_MEMLOCK on Linux).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Terra::SecUtil
+{
+
+// How memory is erased by Erase() and when the object is destroyed
+enum class PageEraseMethod
+{
+    Overwrite,
+    Discard
+};
+
+class SecurePages
+{
+    public:
+        SecurePages() noexcept;
+        explicit SecurePages(
+            std::size_t size,
+            PageEraseMethod method = PageEraseMethod::Overwrite);
+        SecurePages(const SecurePages &) = delete;
+        SecurePages(SecurePages &&other) noexcept;
+        ~SecurePages();
+
+        SecurePages &operator=(const SecurePages &) = delete;
+        SecurePages &operator=(SecurePages &&other) noexcept;
+
+        bool Lock() noexcept;
+        void Unlock() noexcept;
+        bool IsLocked() const noexcept { return locked; }
+
+        void Erase() noexcept;
+        PageEraseMethod EraseMethod() const noexcept { return erase_method; }
+        void SetEraseMethod(PageEraseMethod method) noexcept
+        {
+            erase_method = method;
+        }
+
+        std::uint8_t *data() noexcept { return buffer; }
+        const std::uint8_t *data() const noexcept { return buffer; }
+        std::size_t size() const noexcept { return length; }
+        std::size_t capacity() const noexcept { return mapped_length; }
+        bool empty() const noexcept { return length == 0; }
+
+        std::span<std::uint8_t> Span() noexcept { return {buffer, length}; }
+        std::span<const std::uint8_t> Span() const noexcept
+        {
+            return {buffer, length};
+        }
+
+        static std::size_t PageSize() noexcept;
+
+    protected:
+        friend class SecureReclaimer;
+        void Release() noexcept;
+
+        std::uint8_t *buffer;
+        std::size_t length;
+        std::size_t mapped_length;
+        bool locked;
+        PageEraseMethod erase_method;
+};
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,164 @@
+/*
+ *  secure_pool.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines a pool of secure memory blocks grouped by size
+ *      class, intended for objects of varying size that are allocated and
+ *      freed frequently, such as coroutine frames holding keys.
+ *
+ *      Each size class carves blocks from chunks of SecurePages, which are
+ *      locked into memory if possible.  A block is erased when freed and
+ *      placed on its chunk's free list for reuse by the next allocation of
+ *      the same size class, so once the pool has grown to its working size,
+ *      allocations do not reach the heap.  Requests larger than
+ *      Max_Pool_Block are served by the SecureAllocator.
+ *
+ *          void *p = pool.Allocate(size);
+ *          ...
+ *          pool.Deallocate(p);
+ *
+ *      Blocks are aligned to alignof(std::max_align_t) and may be freed from
+ *      any thread.  Blocks must be freed before the pool is destroyed.
+ *
+ *      A pool otherwise keeps the memory it needed at its peak.  Chunks in
+ *      which every block is free hold nothing but erased memory, so they
+ *      may be returned to the operating system without erasing them again.
+ *      Trim() unmaps chunks that have been idle for at least the decay time
+ *      given to the constructor, measured from the first Trim() to find
+ *      them idle, and StartScavenger() starts a thread that does so
+ *      periodically, releasing an idle chunk between one and two decay
+ *      times after it last held a block.  RetainedBytes() and
+ *      ReleasedBytes() report the memory in idle chunks and the memory
+ *      returned so far.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "secure_pages.h"
+
+namespace Terra::SecUtil
+{
+
+// Largest allocation served from a size class
+inline constexpr std::size_t Max_Pool_Block = 8192;
+
+// Default size of the chunks from which blocks are carved
+inline constexpr std::size_t Default_Pool_Chunk_Size = 65536;
+
+// Default time a chunk must remain idle before it is returned to the system
+inline constexpr std::chrono::seconds Default_Pool_Decay{10};
+
+class SecurePool
+{
+    public:
+        explicit SecurePool(
+            std::size_t chunk_size = Default_Pool_Chunk_Size,
+            std::chrono::nanoseconds decay = Default_Pool_Decay);
+        SecurePool(const SecurePool &) = delete;
+        ~SecurePool();
+
+        SecurePool &operator=(const SecurePool &) = delete;
+
+        [[nodiscard]] void *Allocate(std::size_t size);
+        void Deallocate(void *p) noexcept;
+
+        std::size_t ReservedBytes() const noexcept;
+        std::size_t InUseBytes() const noexcept;
+        std::size_t RetainedBytes() const noexcept;
+        std::size_t ReleasedBytes() const noexcept;
+
+        std::size_t Trim() noexcept;
+        std::size_t Trim(std::chrono::nanoseconds idle) noexcept;
+        void StartScavenger();
+        void StopScavenger() noexcept;
+
+        // Number of size classes, which run from 32 to Max_Pool_Block octets
+        static constexpr std::size_t Size_Classes = 17;
+
+        static std::size_t ClassIndex(std::size_t size) noexcept;
+        static std::size_t ClassSize(std::size_t index) noexcept;
+
+    protected:
+
+        struct Chunk
+        {
+            SecurePages pages;
+            std::size_t size_class;
+            std::size_t capacity;
+            std::size_t carved;
+            std::size_t outstanding;
+            std::uint8_t *free_list;
+            bool available;
+            std::chrono::steady_clock::time_point idle_since;
+        };
+
+        // Precedes each block, keeping the block suitably aligned
+        struct alignas(std::max_align_t) BlockHeader
+        {
+            Chunk *chunk;
+            std::size_t size;
+        };
+
+        // Counters are modified only while holding the mutex
+        struct SizeClass
+        {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<Chunk>> chunks;
+            std::vector<Chunk *> available;
+            std::atomic<std::size_t> reserved_bytes;
+            std::atomic<std::size_t> in_use_bytes;
+            std::atomic<std::size_t> retained_bytes;
+            std::atomic<std::size_t> released_bytes;
+        };
+
+        void Scavenge() noexcept;
+
+        std::size_t chunk_size;
+        const std::chrono::nanoseconds decay;
+        std::array<SizeClass, Size_Classes> classes;
+        std::atomic<std::size_t> large_bytes;
+        std::mutex scavenger_mutex;
+        std::condition_variable scavenger_wake;
+        bool scavenger_stopping;
+        std::thread scavenger;
+};
+
+/*
+ *  DefaultSecurePool()
+ *
+ *  Description:
+ *      Return the process-wide secure pool.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the pool, which is created on first use.
+ *
+ *  Comments:
+ *      The pool is destroyed during static destruction, so blocks held by
+ *      static objects must be freed before then.
+ */
+SecurePool &DefaultSecurePool();
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,139 @@
+/*
+ *  secure_random.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This header file defines functions that fill memory with random
+ *      octets from the operating system's cryptographically secure random
+ *      number generator.  These are intended to be used to generate keys,
+ *      nonces, and the like directly into secure containers such as
+ *      SecureArray and SecureVector.
+ *
+ *      To avoid a system call for every small request, each thread keeps a
+ *      buffer of random octets obtained from the operating system.  Octets
+ *      are securely erased from that buffer as they are consumed and the
+ *      remaining octets are erased when the thread exits.  Should the process
+ *      fork, the child discards any buffered octets so that parent and child
+ *      never produce the same output.  Large requests bypass the buffer and
+ *      are filled directly by the operating system.
+ *
+ *  Portability Issues:
+ *      On Linux and FreeBSD, getrandom() is used; on other Unix-like systems
+ *      arc4random_buf() or /dev/urandom is used.  On Windows,
+ *      BCryptGenRandom() is used.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <array>
+#include <vector>
+#include <type_traits>
+
+namespace Terra::SecUtil
+{
+
+/*
+ *  SecureRandom()
+ *
+ *  Description:
+ *      This function will fill the given buffer with random octets.
+ *
+ *  Parameters:
+ *      buffer [out]
+ *          Pointer to buffer to fill.
+ *
+ *      length [in]
+ *          Number of random octets to produce.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function will throw std::system_error if the operating system
+ *      fails to provide random data.
+ */
+void SecureRandom(void *buffer, std::size_t length);
+
+/*
+ *  SecureRandom()
+ *
+ *  Description:
+ *      This function will fill the given span of values with random octets.
+ *
+ *  Parameters:
+ *      values [out]
+ *          A span of values of the type T.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function will throw std::system_error if the operating system
+ *      fails to provide random data.
+ */
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+void SecureRandom(std::span<T> values)
+{
+    SecureRandom(values.data(), values.size() * sizeof(T));
+}
+
+/*
+ *  SecureRandom()
+ *
+ *  Description:
+ *      This function will fill the given array (including SecureArray) with
+ *      random octets.
+ *
+ *  Parameters:
+ *      array [out]
+ *          An array of elements of the type T.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function will throw std::system_error if the operating system
+ *      fails to provide random data.
+ */
+template<typename T, std::size_t N>
+    requires std::is_trivially_copyable_v<T>
+void SecureRandom(std::array<T, N> &array)
+{
+    SecureRandom(array.data(), array.size() * sizeof(T));
+}
+
+/*
+ *  SecureRandom()
+ *
+ *  Description:
+ *      This function will fill the given vector (including SecureVector) with
+ *      random octets.  The size of the vector is not changed.
+ *
+ *  Parameters:
+ *      vector [out]
+ *          A vector of elements of the type T.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function will throw std::system_error if the operating system
+ *      fails to provide random data.
+ */
+template<typename T, typename Allocator>
+    requires std::is_trivially_copyable_v<T>
+void SecureRandom(std::vector<T, Allocator> &vector)
+{
+    SecureRandom(vector.data(), vector.size() * sizeof(T));
+}
+
+} // namespace Terra::SecUtil
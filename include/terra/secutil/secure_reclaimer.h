@@ -0,0 +1,147 @@
+/*
+ *  secure_reclaimer.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the SecureReclaimer, which moves the cost of
+ *      erasing large SecurePages blocks off the thread that frees them.
+ *      Erasing many megabytes can take a millisecond or more, which is
+ *      unwelcome on a latency-sensitive request thread.
+ *
+ *      A block passed to Reclaim() is made inaccessible (PROT_NONE) so that
+ *      its contents cannot be read through a stale pointer, and is queued.
+ *      A background thread erases each queued block in order, after which
+ *      the block is kept for reuse by Acquire() or returned to the
+ *      operating system once the cache limit is reached:
+ *
+ *          SecureReclaimer reclaimer;
+ *          SecurePages pages = reclaimer.Acquire(16 * 1048576);
+ *          ...
+ *          reclaimer.Reclaim(std::move(pages));
+ *
+ *      The time a secret remains in memory after being freed is bounded by
+ *      the deadline given to the constructor.  If the queue already holds
+ *      more than the background thread can erase within the deadline, the
+ *      block is instead erased by the calling thread.  A block reclaimed
+ *      while the queue is empty is always queued, as erasing it on the
+ *      calling thread would take just as long.  Statistics() reports
+ *      the queue depth and how long blocks remained in the queue.
+ *
+ *      Queued blocks are removed from the wipe registry (since they cannot
+ *      be written) and are excluded from core dumps.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "secure_pages.h"
+
+namespace Terra::SecUtil
+{
+
+// Default time within which a reclaimed block is erased
+inline constexpr std::chrono::milliseconds Default_Reclaim_Deadline{10};
+
+// Default number of octets of erased blocks kept for reuse
+inline constexpr std::size_t Default_Reclaim_Cache = 67108864;
+
+// Counters describing the work of a SecureReclaimer
+struct ReclaimerStatistics
+{
+    std::size_t queue_depth;
+    std::size_t queued_bytes;
+    std::size_t cached_blocks;
+    std::size_t cached_bytes;
+    std::uint64_t reclaimed_blocks;
+    std::uint64_t reclaimed_bytes;
+    std::uint64_t inline_erasures;
+    std::uint64_t reused_blocks;
+    std::uint64_t deadline_misses;
+    std::chrono::nanoseconds max_residency;
+    std::chrono::nanoseconds total_residency;
+
+    /*
+     *  ReclaimerStatistics::MeanResidency()
+     *
+     *  Description:
+     *      Return the average time blocks remained queued before being
+     *      erased by the background thread.
+     *
+     *  Parameters:
+     *      None.
+     *
+     *  Returns:
+     *      The mean residency, or zero if no blocks have been erased.
+     *
+     *  Comments:
+     *      None.
+     */
+    std::chrono::nanoseconds MeanResidency() const noexcept
+    {
+        if (reclaimed_blocks == 0) return std::chrono::nanoseconds::zero();
+
+        return total_residency / static_cast<std::int64_t>(reclaimed_blocks);
+    }
+};
+
+class SecureReclaimer
+{
+    public:
+        explicit SecureReclaimer(
+            std::chrono::nanoseconds deadline = Default_Reclaim_Deadline,
+            std::size_t cache_limit = Default_Reclaim_Cache);
+        SecureReclaimer(const SecureReclaimer &) = delete;
+        ~SecureReclaimer();
+
+        SecureReclaimer &operator=(const SecureReclaimer &) = delete;
+
+        void Reclaim(SecurePages &&pages) noexcept;
+        SecurePages Acquire(std::size_t size);
+        void Drain();
+        void Trim() noexcept;
+
+        ReclaimerStatistics Statistics() const;
+
+    protected:
+        // A block awaiting erasure
+        struct Entry
+        {
+            SecurePages pages;
+            std::chrono::steady_clock::time_point queued;
+        };
+
+        void Run() noexcept;
+        bool Protect(SecurePages &pages, bool accessible) noexcept;
+        void Unmap(SecurePages &pages) noexcept;
+
+        const std::chrono::nanoseconds deadline;
+        const std::size_t cache_limit;
+        double erase_rate;
+        bool stopping;
+        bool erasing;
+        ReclaimerStatistics statistics;
+        std::deque<Entry> queue;
+        std::vector<SecurePages> cache;
+        mutable std::mutex mutex;
+        std::condition_variable work;
+        std::condition_variable idle;
+        std::thread thread;
+};
+
+} // namespace Terra::SecUtil
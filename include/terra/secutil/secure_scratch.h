@@ -0,0 +1,175 @@
+/*
+ *  secure_scratch.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines a per-thread arena of secure scratch memory for
+ *      short-lived working buffers, such as per-thread cryptographic state,
+ *      that would otherwise be held in thread_local SecureArray objects whose
+ *      erasure depends on the order in which thread-local destructors run.
+ *
+ *      Each thread's arena is a block of SecurePages created on first use.
+ *      AcquireScratch() hands out a ScratchBuffer from the arena by simply
+ *      advancing an offset, so no memory is allocated once the arena exists.
+ *      A ScratchBuffer erases its contents when it is destroyed, returning
+ *      the space to the arena, and the entire arena is erased in a single
+ *      operation when the thread exits:
+ *
+ *          ScratchBuffer state = AcquireScratch(sizeof(CipherState));
+ *
+ *      Space is reclaimed immediately when buffers are released in reverse
+ *      order of acquisition, and in any case once no buffer is outstanding.
+ *      Requests that do not fit in the remaining space are satisfied from a
+ *      SecureVector instead.
+ *
+ *      A ScratchBuffer must be used and destroyed on the thread that
+ *      acquired it.  If a thread's arena is destroyed before a buffer taken
+ *      from it (e.g., a buffer held by another thread_local object), the
+ *      buffer is simply abandoned, since the arena was already erased.  A
+ *      buffer destroyed on another thread is likewise abandoned, leaving
+ *      both threads' arenas intact, and is erased with its arena.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "secure_vector.h"
+
+namespace Terra::SecUtil
+{
+
+// Default size of each thread's scratch arena in octets
+inline constexpr std::size_t Default_Scratch_Capacity = 65536;
+
+struct ScratchArena;
+
+class ScratchBuffer
+{
+    public:
+        ScratchBuffer() noexcept;
+        ScratchBuffer(const ScratchBuffer &) = delete;
+        ScratchBuffer(ScratchBuffer &&other) noexcept;
+        ~ScratchBuffer();
+
+        ScratchBuffer &operator=(const ScratchBuffer &) = delete;
+        ScratchBuffer &operator=(ScratchBuffer &&other) noexcept;
+
+        std::uint8_t *data() noexcept { return buffer; }
+        const std::uint8_t *data() const noexcept { return buffer; }
+        std::size_t size() const noexcept { return length; }
+        bool empty() const noexcept { return length == 0; }
+
+        std::span<std::uint8_t> Span() noexcept { return {buffer, length}; }
+        std::span<const std::uint8_t> Span() const noexcept
+        {
+            return {buffer, length};
+        }
+
+        bool IsOverflow() const noexcept { return !overflow.empty(); }
+
+    protected:
+        friend ScratchBuffer AcquireScratch(std::size_t size,
+                                            std::size_t alignment);
+
+        void Release() noexcept;
+
+        ScratchArena *arena;
+        std::uint8_t *buffer;
+        std::size_t length;
+        std::size_t previous_offset;
+        SecureVector<std::uint8_t> overflow;
+};
+
+/*
+ *  AcquireScratch()
+ *
+ *  Description:
+ *      Acquire a buffer from the calling thread's scratch arena.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the buffer in octets.
+ *
+ *      alignment [in]
+ *          The required alignment of the buffer, which must be a power of
+ *          two.
+ *
+ *  Returns:
+ *      A buffer of the requested size whose contents are zero.
+ *
+ *  Comments:
+ *      The arena is created on the first call made by each thread.  This
+ *      will throw std::invalid_argument if the alignment is not a power of
+ *      two or std::system_error if the arena cannot be created.
+ */
+ScratchBuffer AcquireScratch(std::size_t size,
+                             std::size_t alignment =
+                                 alignof(std::max_align_t));
+
+/*
+ *  SetScratchCapacity()
+ *
+ *  Description:
+ *      Set the size of scratch arenas created after this call.
+ *
+ *  Parameters:
+ *      capacity [in]
+ *          The arena size in octets, which is rounded up to a multiple of
+ *          the page size.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Arenas that already exist are unaffected, so this would normally be
+ *      called before any threads use scratch memory.
+ */
+void SetScratchCapacity(std::size_t capacity) noexcept;
+
+/*
+ *  ScratchCapacity()
+ *
+ *  Description:
+ *      Return the size of the calling thread's scratch arena.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The arena size in octets, or zero if the thread has not yet used
+ *      scratch memory.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t ScratchCapacity() noexcept;
+
+/*
+ *  ScratchInUse()
+ *
+ *  Description:
+ *      Return the amount of the calling thread's scratch arena in use.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of octets in use, including alignment padding.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t ScratchInUse() noexcept;
+
+} // namespace Terra::SecUtil
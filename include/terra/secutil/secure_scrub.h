@@ -0,0 +1,197 @@
+/*
+ *  secure_scrub.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines functions that erase secrets left behind on the
+ *      stack and in vector registers by functions that have returned, which
+ *      SecureErase() cannot reach.  Cryptographic routines commonly spill
+ *      keys and intermediate state into their stack frames and leave them in
+ *      SIMD registers.
+ *
+ *      ScrubStack() erases a given number of octets of the stack below the
+ *      caller's frame, which is where the frames of functions the caller
+ *      previously called resided.  ClearVectorRegisters() zeroes the vector
+ *      registers that the calling convention does not require to be
+ *      preserved.  ScrubAfter() calls a function and then does both:
+ *
+ *          auto tag = ScrubAfter(8192, [&]() { return Sign(key, message); });
+ *
+ *      The cost of scrubbing is proportional to the number of octets
+ *      scrubbed, so it should be no larger than needed.  MeasureStackUsage()
+ *      may be used to estimate how deep a function's stack usage extends.
+ *
+ *  Portability Issues:
+ *      Vector registers are cleared on x86-64 (SSE, AVX, and AVX-512) and
+ *      AArch64; on other architectures, ClearVectorRegisters() does nothing.
+ *      With Microsoft Visual C++, which has no x64 inline assembly,
+ *      registers are cleared only on processors supporting AVX.
+ *      Stack scrubbing assumes the stack grows downward, as it does on all
+ *      supported platforms.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Terra::SecUtil
+{
+
+// Largest number of octets scrubbed by a single call to ScrubStack()
+inline constexpr std::size_t Max_Stack_Scrub = 262144;
+
+/*
+ *  ScrubStack()
+ *
+ *  Description:
+ *      Erase the given number of octets of stack below the caller's frame.
+ *
+ *  Parameters:
+ *      bytes [in]
+ *          The number of octets to erase, which is limited to
+ *          Max_Stack_Scrub.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The caller must have sufficient stack space available below its
+ *      frame for the octets to be erased.
+ */
+void ScrubStack(std::size_t bytes) noexcept;
+
+/*
+ *  ClearVectorRegisters()
+ *
+ *  Description:
+ *      Zero the vector registers that are not preserved across calls.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Registers that the calling convention requires to be preserved
+ *      (e.g., xmm6-xmm15 on Windows or the lower halves of v8-v15 on
+ *      AArch64) hold the caller's values and are restored rather than
+ *      cleared.  On x86-64, AVX and AVX-512 registers are cleared only if
+ *      the processor supports them.
+ */
+void ClearVectorRegisters() noexcept;
+
+/*
+ *  ScrubAfter()
+ *
+ *  Description:
+ *      Call the given function, then erase the stack it may have used and
+ *      clear the vector registers.
+ *
+ *  Parameters:
+ *      stack_bytes [in]
+ *          The number of octets of stack to erase below the caller's frame.
+ *
+ *      function [in]
+ *          The function to call.
+ *
+ *      args [in]
+ *          Arguments passed to the function.
+ *
+ *  Returns:
+ *      The value returned by the function, if any.
+ *
+ *  Comments:
+ *      The stack and registers are scrubbed even if the function throws.
+ */
+template<typename F, typename... Args>
+decltype(auto) ScrubAfter(std::size_t stack_bytes, F &&function, Args &&...args)
+{
+    // Scrub as this object is destroyed, including during unwinding
+    struct Scrubber
+    {
+        std::size_t bytes;
+        ~Scrubber()
+        {
+            ScrubStack(bytes);
+            ClearVectorRegisters();
+        }
+    } scrubber{stack_bytes};
+
+    if constexpr (std::is_void_v<std::invoke_result_t<F, Args...>>)
+    {
+        std::forward<F>(function)(std::forward<Args>(args)...);
+    }
+    else
+    {
+        return std::forward<F>(function)(std::forward<Args>(args)...);
+    }
+}
+
+/*
+ *  PaintStack()
+ *
+ *  Description:
+ *      Fill the given number of octets of stack below the caller's frame
+ *      with a known pattern or, afterward, determine how many of those
+ *      octets were overwritten.  Used by MeasureStackUsage().
+ *
+ *  Parameters:
+ *      bytes [in]
+ *          The number of octets to paint or examine, which is limited to
+ *          Max_Stack_Scrub.
+ *
+ *      measure [in]
+ *          False to paint the stack, true to measure.
+ *
+ *  Returns:
+ *      When measuring, the distance in octets from the top of the painted
+ *      region to the lowest octet overwritten; otherwise, zero.
+ *
+ *  Comments:
+ *      Both calls must be made from the same function so that the painted
+ *      region is at the same location.
+ */
+std::size_t PaintStack(std::size_t bytes, bool measure) noexcept;
+
+/*
+ *  MeasureStackUsage()
+ *
+ *  Description:
+ *      Estimate the stack depth used by the given function.
+ *
+ *  Parameters:
+ *      limit [in]
+ *          The maximum depth to examine in octets, which is limited to
+ *          Max_Stack_Scrub.
+ *
+ *      function [in]
+ *          The function to call.
+ *
+ *  Returns:
+ *      The approximate number of octets of stack used by the function.
+ *
+ *  Comments:
+ *      This is a diagnostic intended to choose the number of octets given to
+ *      ScrubAfter(), which should include some margin.  The result may be
+ *      slightly low, as the frame of the painting function itself is not
+ *      painted, and may vary with the inputs and with compiler options.
+ */
+template<typename F>
+std::size_t MeasureStackUsage(std::size_t limit, F &&function)
+{
+    PaintStack(limit, false);
+    std::forward<F>(function)();
+
+    return PaintStack(limit, true);
+}
+
+} // namespace Terra::SecUtil
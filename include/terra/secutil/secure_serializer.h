@@ -0,0 +1,467 @@
+/*
+ *  secure_serializer.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the SecureSerializer and SecureDeserializer objects,
+ *      which serialize secure containers (e.g., SecureVector, SecureString,
+ *      and SecureArray) into a length-prefixed binary form suitable for IPC.
+ *
+ *      Values are written in batches.  Each batch consists of a field count,
+ *      the length of each field, and then the fields themselves:
+ *
+ *          count (4 octets)
+ *          length of each field in octets (4 octets each)
+ *          field data (concatenated)
+ *
+ *      All counts and lengths are little-endian.  Field data is copied as
+ *      stored in memory, so containers of multi-octet elements should only
+ *      be exchanged between processes having the same byte order.
+ *
+ *      The serializer computes the size of a batch first and writes it
+ *      directly into a SecureVector, growing it at most once per batch.  The
+ *      deserializer reads from a span over the serialized data and returns
+ *      spans referring to that data, so fields may be used without copying;
+ *      alternatively, fields may be read directly into secure containers.
+ *
+ *          SecureSerializer serializer;
+ *          serializer.Write(key_id, key, password);
+ *
+ *          SecureDeserializer deserializer(serializer.Span());
+ *          deserializer.Read(key_id, key, password);
+ *
+ *      Malformed input results in a std::invalid_argument exception.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "secure_erase.h"
+#include "secure_vector.h"
+
+namespace Terra::SecUtil
+{
+
+// Concept for contiguous containers that may be serialized bytewise
+template<typename T>
+concept SecureSerializable =
+    std::ranges::contiguous_range<T> && std::ranges::sized_range<T> &&
+    std::is_trivially_copyable_v<std::ranges::range_value_t<T>>;
+
+// Concept for contiguous containers into which fields may be deserialized
+template<typename T>
+concept SecureDeserializable =
+    SecureSerializable<T> &&
+    !std::is_const_v<std::remove_reference_t<
+        std::ranges::range_reference_t<T>>>;
+
+class SecureSerializer
+{
+    public:
+        SecureSerializer() = default;
+        explicit SecureSerializer(std::size_t reserve)
+        {
+            buffer.reserve(reserve);
+        }
+        ~SecureSerializer() = default;
+
+        /*
+         *  SecureSerializer::Write()
+         *
+         *  Description:
+         *      Append the given values to the serialized data as one batch.
+         *
+         *  Parameters:
+         *      values [in]
+         *          The values to serialize.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      This will throw std::invalid_argument if any value is longer
+         *      than 2^32 - 1 octets, in which case nothing is appended.
+         */
+        template<SecureSerializable... T>
+            requires (sizeof...(T) > 0)
+        void Write(const T &...values)
+        {
+            // Validate before growing the buffer so a failure appends nothing
+            CheckFieldSizes(values...);
+
+            const std::size_t offset = buffer.size();
+            const std::size_t length = SerializedSize(values...);
+
+            // Grow geometrically so repeated batches reallocate rarely
+            if (buffer.capacity() - offset < length)
+            {
+                buffer.reserve(std::max(offset + length, buffer.capacity() * 2));
+            }
+            buffer.resize(offset + length);
+
+            Serialize(std::span<std::uint8_t>(buffer).subspan(offset),
+                      values...);
+        }
+
+        /*
+         *  SecureSerializer::SerializedSize()
+         *
+         *  Description:
+         *      Compute the number of octets required to serialize the given
+         *      values as one batch.
+         *
+         *  Parameters:
+         *      values [in]
+         *          The values to serialize.
+         *
+         *  Returns:
+         *      The serialized length in octets.
+         *
+         *  Comments:
+         *      None.
+         */
+        template<SecureSerializable... T>
+        static constexpr std::size_t SerializedSize(const T &...values) noexcept
+        {
+            return Prefix_Size * (1 + sizeof...(T)) + (FieldSize(values) + ...
+                                                       + 0);
+        }
+
+        /*
+         *  SecureSerializer::Serialize()
+         *
+         *  Description:
+         *      Serialize the given values as one batch into the given buffer.
+         *
+         *  Parameters:
+         *      destination [out]
+         *          The buffer into which the batch is written.
+         *
+         *      values [in]
+         *          The values to serialize.
+         *
+         *  Returns:
+         *      The number of octets written.
+         *
+         *  Comments:
+         *      This will throw std::invalid_argument if the buffer is too
+         *      small or any value is longer than 2^32 - 1 octets.
+         */
+        template<SecureSerializable... T>
+        static std::size_t Serialize(std::span<std::uint8_t> destination,
+                                     const T &...values)
+        {
+            const std::size_t length = SerializedSize(values...);
+
+            if (destination.size() < length)
+            {
+                throw std::invalid_argument("Serialization buffer is too small");
+            }
+            CheckFieldSizes(values...);
+
+            std::uint8_t *prefix = destination.data();
+            std::uint8_t *field = prefix + Prefix_Size * (1 + sizeof...(T));
+
+            // Write all length prefixes, then all field data
+            StorePrefix(prefix, sizeof...(T));
+            prefix += Prefix_Size;
+            (
+                [&]()
+                {
+                    const std::size_t size = FieldSize(values);
+                    StorePrefix(prefix, size);
+                    prefix += Prefix_Size;
+                    if (size > 0)
+                    {
+                        std::memcpy(field, std::ranges::data(values), size);
+                    }
+                    field += size;
+                }(),
+                ...);
+
+            return length;
+        }
+
+        std::span<const std::uint8_t> Span() const noexcept { return buffer; }
+        std::size_t size() const noexcept { return buffer.size(); }
+
+        /*
+         *  SecureSerializer::Clear()
+         *
+         *  Description:
+         *      Erase the serialized data, retaining the allocated buffer.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      None.
+         */
+        void Clear()
+        {
+            SecureErase(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+
+        /*
+         *  SecureSerializer::Release()
+         *
+         *  Description:
+         *      Take ownership of the serialized data, leaving the serializer
+         *      empty.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      The serialized data.
+         *
+         *  Comments:
+         *      None.
+         */
+        SecureVector<std::uint8_t> Release() noexcept
+        {
+            return std::exchange(buffer, SecureVector<std::uint8_t>{});
+        }
+
+        static constexpr std::size_t Prefix_Size = 4;
+        static constexpr std::size_t Max_Field_Size =
+            std::numeric_limits<std::uint32_t>::max();
+
+    protected:
+        template<SecureSerializable T>
+        static constexpr std::size_t FieldSize(const T &value) noexcept
+        {
+            return std::ranges::size(value) *
+                   sizeof(std::ranges::range_value_t<T>);
+        }
+
+        template<SecureSerializable... T>
+        static void CheckFieldSizes(const T &...values)
+        {
+            if (((FieldSize(values) > Max_Field_Size) || ...))
+            {
+                throw std::invalid_argument("Serialized field is too large");
+            }
+        }
+
+        static void StorePrefix(std::uint8_t *p, std::size_t value) noexcept
+        {
+            for (std::size_t i = 0; i < Prefix_Size; i++, value >>= 8)
+            {
+                p[i] = static_cast<std::uint8_t>(value);
+            }
+        }
+
+        SecureVector<std::uint8_t> buffer;
+};
+
+class SecureDeserializer
+{
+    public:
+        explicit SecureDeserializer(std::span<const std::uint8_t> input) noexcept :
+            input{input},
+            position{0}
+        {
+        }
+        ~SecureDeserializer() = default;
+
+        /*
+         *  SecureDeserializer::ReadBatch()
+         *
+         *  Description:
+         *      Read a batch of N fields.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      Spans referring to each field within the serialized data.
+         *
+         *  Comments:
+         *      This will throw std::invalid_argument if the next batch does
+         *      not hold exactly N fields or is truncated, in which case the
+         *      read position is unchanged.
+         */
+        template<std::size_t N>
+        std::array<std::span<const std::uint8_t>, N> ReadBatch()
+        {
+            constexpr std::size_t Header_Size =
+                SecureSerializer::Prefix_Size * (1 + N);
+            std::array<std::span<const std::uint8_t>, N> fields{};
+
+            if (Remaining() < Header_Size)
+            {
+                throw std::invalid_argument("Serialized data is truncated");
+            }
+
+            const std::uint8_t *prefix = input.data() + position;
+
+            if (LoadPrefix(prefix) != N)
+            {
+                throw std::invalid_argument("Unexpected serialized field count");
+            }
+            prefix += SecureSerializer::Prefix_Size;
+
+            std::size_t offset = position + Header_Size;
+
+            for (auto &field : fields)
+            {
+                const std::size_t length = LoadPrefix(prefix);
+                prefix += SecureSerializer::Prefix_Size;
+
+                if (input.size() - offset < length)
+                {
+                    throw std::invalid_argument("Serialized data is truncated");
+                }
+
+                field = input.subspan(offset, length);
+                offset += length;
+            }
+
+            position = offset;
+
+            return fields;
+        }
+
+        /*
+         *  SecureDeserializer::Read()
+         *
+         *  Description:
+         *      Read a batch holding a single field.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      A span referring to the field within the serialized data.
+         *
+         *  Comments:
+         *      This will throw std::invalid_argument if the data is malformed.
+         */
+        std::span<const std::uint8_t> Read()
+        {
+            return ReadBatch<1>()[0];
+        }
+
+        /*
+         *  SecureDeserializer::Read()
+         *
+         *  Description:
+         *      Read a batch of fields into the given containers, which would
+         *      typically have been written by SecureSerializer::Write() with
+         *      the same types.
+         *
+         *  Parameters:
+         *      values [out]
+         *          The containers into which the fields are read.  Resizable
+         *          containers (e.g., SecureVector) are resized to fit; the
+         *          size of other containers (e.g., SecureArray) must match.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      This will throw std::invalid_argument if the data is malformed
+         *      or a field does not fit its container, in which case no
+         *      container is modified and the read position is unchanged.
+         */
+        template<SecureDeserializable... T>
+            requires (sizeof...(T) > 0)
+        void Read(T &...values)
+        {
+            const std::size_t start = position;
+            const auto fields = ReadBatch<sizeof...(T)>();
+            std::size_t i = 0;
+
+            if (!(Fits(values, fields[i++]) && ...))
+            {
+                position = start;
+                throw std::invalid_argument("Serialized field does not fit");
+            }
+
+            i = 0;
+            (Assign(values, fields[i++]), ...);
+        }
+
+        std::size_t Remaining() const noexcept
+        {
+            return input.size() - position;
+        }
+        bool AtEnd() const noexcept { return position == input.size(); }
+
+    protected:
+        template<SecureDeserializable T>
+        static bool Fits(const T &value,
+                         std::span<const std::uint8_t> field) noexcept
+        {
+            using V = std::ranges::range_value_t<T>;
+
+            if ((field.size() % sizeof(V)) != 0) return false;
+
+            if constexpr (requires(T &t) { t.resize(std::size_t{}); })
+            {
+                return true;
+            }
+            else
+            {
+                return std::ranges::size(value) == field.size() / sizeof(V);
+            }
+        }
+
+        template<SecureDeserializable T>
+        static void Assign(T &value, std::span<const std::uint8_t> field)
+        {
+            using V = std::ranges::range_value_t<T>;
+
+            if constexpr (requires(T &t) { t.resize(std::size_t{}); })
+            {
+                value.resize(field.size() / sizeof(V));
+            }
+
+            if (!field.empty())
+            {
+                std::memcpy(std::ranges::data(value), field.data(), field.size());
+            }
+        }
+
+        static std::size_t LoadPrefix(const std::uint8_t *p) noexcept
+        {
+            std::size_t value = 0;
+
+            for (std::size_t i = SecureSerializer::Prefix_Size; i > 0; i--)
+            {
+                value = (value << 8) | p[i - 1];
+            }
+
+            return value;
+        }
+
+        std::span<const std::uint8_t> input;
+        std::size_t position;
+};
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,568 @@
+/*
+ *  secure_stream.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines SecureBasicStreamBuf, a stream buffer that holds its
+ *      contents in a SecureVector, and a family of string streams built on
+ *      it.  They behave like std::stringbuf and std::stringstream, except
+ *      that every buffer released as the stream grows is erased, and the
+ *      final contents are erased when the stream is destroyed.  This allows
+ *      existing iostream-based parsers to read or produce secrets without
+ *      leaving copies in memory:
+ *
+ *          SecureStringStream stream(key_file_contents);
+ *          SecureString line;
+ *          while (std::getline(stream, line)) { ... }
+ *
+ *      The buffer may be pre-sized with reserve() so that it never grows,
+ *      and the contents may be accessed with view() to avoid copying.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include "secure_erase.h"
+#include "secure_string.h"
+#include "secure_vector.h"
+
+namespace Terra::SecUtil
+{
+
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+class SecureBasicStreamBuf : public std::basic_streambuf<CharT, Traits>
+{
+    public:
+        using char_type = CharT;
+        using traits_type = Traits;
+        using int_type = typename Traits::int_type;
+        using pos_type = typename Traits::pos_type;
+        using off_type = typename Traits::off_type;
+
+        explicit SecureBasicStreamBuf(std::ios_base::openmode mode =
+                                          std::ios_base::in |
+                                          std::ios_base::out) :
+            mode{mode},
+            high{0}
+        {
+            Synchronize(0, 0);
+        }
+        explicit SecureBasicStreamBuf(std::basic_string_view<CharT, Traits> text,
+                                      std::ios_base::openmode mode =
+                                          std::ios_base::in |
+                                          std::ios_base::out) :
+            mode{mode},
+            high{0}
+        {
+            str(text);
+        }
+        SecureBasicStreamBuf(const SecureBasicStreamBuf &) = delete;
+        ~SecureBasicStreamBuf() override = default;
+
+        SecureBasicStreamBuf &operator=(const SecureBasicStreamBuf &) = delete;
+
+        /*
+         *  SecureBasicStreamBuf::reserve()
+         *
+         *  Description:
+         *      Ensure the buffer can hold at least the given number of
+         *      characters without growing.
+         *
+         *  Parameters:
+         *      capacity [in]
+         *          The number of characters to accommodate.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      The read and write positions are retained.
+         */
+        void reserve(std::size_t capacity)
+        {
+            if (capacity > storage.size()) Grow(capacity);
+        }
+
+        std::size_t capacity() const noexcept { return storage.size(); }
+        std::size_t size() const noexcept { return End(); }
+
+        /*
+         *  SecureBasicStreamBuf::view()
+         *
+         *  Description:
+         *      Return a view of the buffer contents.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      A view of the characters written to the buffer, which remains
+         *      valid until the buffer is next modified.
+         *
+         *  Comments:
+         *      None.
+         */
+        std::basic_string_view<CharT, Traits> view() const noexcept
+        {
+            return {storage.data(), End()};
+        }
+
+        /*
+         *  SecureBasicStreamBuf::str()
+         *
+         *  Description:
+         *      Return a copy of the buffer contents.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      The characters written to the buffer.
+         *
+         *  Comments:
+         *      None.
+         */
+        SecureBasicString<CharT, Traits> str() const
+        {
+            const auto contents = view();
+            return {contents.begin(), contents.end()};
+        }
+
+        /*
+         *  SecureBasicStreamBuf::str()
+         *
+         *  Description:
+         *      Replace the buffer contents with the given text.
+         *
+         *  Parameters:
+         *      text [in]
+         *          The new buffer contents.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      The read position is set to the beginning.  The write position
+         *      is set to the end if the buffer was opened with ios_base::ate
+         *      or ios_base::app, and to the beginning otherwise.  Previous
+         *      contents are erased.
+         */
+        void str(std::basic_string_view<CharT, Traits> text)
+        {
+            if (text.size() > storage.size())
+            {
+                SecureVector<CharT> larger(text.size());
+
+                Traits::copy(larger.data(), text.data(), text.size());
+                storage.swap(larger);
+            }
+            else
+            {
+                // The text may refer to this buffer, so it is moved first
+                if (!text.empty())
+                {
+                    Traits::move(storage.data(), text.data(), text.size());
+                }
+                SecureErase(storage.data() + text.size(),
+                            (storage.size() - text.size()) * sizeof(CharT));
+            }
+            high = text.size();
+
+            const bool at_end =
+                (mode & (std::ios_base::ate | std::ios_base::app)) != 0;
+            Synchronize(0, at_end ? high : 0);
+        }
+
+        /*
+         *  SecureBasicStreamBuf::Clear()
+         *
+         *  Description:
+         *      Erase the buffer contents and reset the read and write
+         *      positions, retaining the allocated buffer.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      None.
+         */
+        void Clear() noexcept
+        {
+            SecureErase(storage.data(), storage.size() * sizeof(CharT));
+            high = 0;
+            Synchronize(0, 0);
+        }
+
+    protected:
+        int_type underflow() override
+        {
+            if (!(mode & std::ios_base::in)) return Traits::eof();
+
+            // Make characters written since the last read visible
+            const std::size_t end = End();
+            high = end;
+            this->setg(storage.data(), this->gptr(), storage.data() + end);
+
+            if (this->gptr() < this->egptr())
+            {
+                return Traits::to_int_type(*this->gptr());
+            }
+
+            return Traits::eof();
+        }
+
+        int_type overflow(int_type c) override
+        {
+            if (!(mode & std::ios_base::out)) return Traits::eof();
+            if (Traits::eq_int_type(c, Traits::eof())) return Traits::not_eof(c);
+
+            if (this->pptr() == this->epptr()) Grow(NextCapacity(1));
+
+            *this->pptr() = Traits::to_char_type(c);
+            this->pbump(1);
+
+            return c;
+        }
+
+        int_type pbackfail(int_type c) override
+        {
+            if (this->eback() == this->gptr()) return Traits::eof();
+
+            if (Traits::eq_int_type(c, Traits::eof()))
+            {
+                this->gbump(-1);
+                return Traits::not_eof(c);
+            }
+
+            // Only overwrite the character if the buffer is writable
+            if (!Traits::eq(Traits::to_char_type(c), this->gptr()[-1]) &&
+                !(mode & std::ios_base::out))
+            {
+                return Traits::eof();
+            }
+
+            this->gbump(-1);
+            *this->gptr() = Traits::to_char_type(c);
+
+            return c;
+        }
+
+        std::streamsize showmanyc() override
+        {
+            if (!(mode & std::ios_base::in)) return -1;
+
+            const std::size_t end = End();
+            const std::size_t position =
+                static_cast<std::size_t>(this->gptr() - this->eback());
+
+            return (end > position) ?
+                       static_cast<std::streamsize>(end - position) :
+                       -1;
+        }
+
+        std::streamsize xsputn(const CharT *s, std::streamsize count) override
+        {
+            if (!(mode & std::ios_base::out) || (count <= 0)) return 0;
+
+            const auto length = static_cast<std::size_t>(count);
+            const auto available =
+                static_cast<std::size_t>(this->epptr() - this->pptr());
+
+            // Grow once for the whole write rather than once per overflow
+            if (available < length) Grow(NextCapacity(length - available));
+
+            Traits::copy(this->pptr(), s, length);
+            Advance(length);
+
+            return count;
+        }
+
+        pos_type seekoff(off_type offset,
+                         std::ios_base::seekdir direction,
+                         std::ios_base::openmode which =
+                             std::ios_base::in | std::ios_base::out) override
+        {
+            const bool in = (which & mode & std::ios_base::in) != 0;
+            const bool out = (which & mode & std::ios_base::out) != 0;
+
+            // Seeking both relative to the current position is ambiguous
+            if ((!in && !out) ||
+                (in && out && (direction == std::ios_base::cur)))
+            {
+                return pos_type(off_type(-1));
+            }
+
+            const std::size_t end = End();
+            off_type base = 0;
+
+            if (direction == std::ios_base::cur)
+            {
+                base = in ? off_type(this->gptr() - this->eback()) :
+                            off_type(this->pptr() - this->pbase());
+            }
+            else if (direction == std::ios_base::end)
+            {
+                base = off_type(end);
+            }
+
+            const off_type position = base + offset;
+            if ((position < 0) || (position > off_type(end)))
+            {
+                return pos_type(off_type(-1));
+            }
+
+            high = end;
+            Synchronize(in ? static_cast<std::size_t>(position) :
+                             static_cast<std::size_t>(this->gptr() -
+                                                      this->eback()),
+                        out ? static_cast<std::size_t>(position) :
+                              static_cast<std::size_t>(this->pptr() -
+                                                       this->pbase()));
+
+            return pos_type(position);
+        }
+
+        pos_type seekpos(pos_type position,
+                         std::ios_base::openmode which =
+                             std::ios_base::in | std::ios_base::out) override
+        {
+            return seekoff(off_type(position), std::ios_base::beg, which);
+        }
+
+        // Length of the contents, including characters not yet made readable
+        std::size_t End() const noexcept
+        {
+            if (!(mode & std::ios_base::out)) return high;
+
+            return std::max(high,
+                            static_cast<std::size_t>(this->pptr() -
+                                                     this->pbase()));
+        }
+
+        std::size_t NextCapacity(std::size_t additional) const noexcept
+        {
+            const std::size_t required = storage.size() + additional;
+
+            return std::max({required, storage.size() * 2, std::size_t{64}});
+        }
+
+        // Move to a larger buffer; the old one is erased as it is released
+        void Grow(std::size_t capacity)
+        {
+            const std::size_t end = End();
+            const auto get = static_cast<std::size_t>(this->gptr() -
+                                                      this->eback());
+            const auto put = static_cast<std::size_t>(this->pptr() -
+                                                      this->pbase());
+            SecureVector<CharT> larger(capacity);
+
+            if (end > 0) Traits::copy(larger.data(), storage.data(), end);
+            storage.swap(larger);
+            high = end;
+
+            Synchronize(get, put);
+        }
+
+        // Set the get and put areas over the storage at the given positions
+        void Synchronize(std::size_t get, std::size_t put)
+        {
+            CharT *base = storage.data();
+
+            if (mode & std::ios_base::in)
+            {
+                this->setg(base, base + get, base + high);
+            }
+            else
+            {
+                this->setg(base, base, base);
+            }
+
+            if (mode & std::ios_base::out)
+            {
+                this->setp(base, base + storage.size());
+                Advance(put);
+            }
+            else
+            {
+                this->setp(nullptr, nullptr);
+            }
+        }
+
+        // Advance the put pointer, which pbump() limits to int offsets
+        void Advance(std::size_t count)
+        {
+            while (count > 0)
+            {
+                const std::size_t step =
+                    std::min(count, static_cast<std::size_t>(INT_MAX));
+                this->pbump(static_cast<int>(step));
+                count -= step;
+            }
+        }
+
+        std::ios_base::openmode mode;
+        std::size_t high;
+        SecureVector<CharT> storage;
+};
+
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+class SecureBasicIStringStream : public std::basic_istream<CharT, Traits>
+{
+    public:
+        explicit SecureBasicIStringStream(std::ios_base::openmode mode =
+                                              std::ios_base::in) :
+            std::basic_istream<CharT, Traits>(nullptr),
+            buffer(mode | std::ios_base::in)
+        {
+            this->rdbuf(&buffer);
+        }
+        explicit SecureBasicIStringStream(
+            std::basic_string_view<CharT, Traits> text,
+            std::ios_base::openmode mode = std::ios_base::in) :
+            std::basic_istream<CharT, Traits>(nullptr),
+            buffer(text, mode | std::ios_base::in)
+        {
+            this->rdbuf(&buffer);
+        }
+        ~SecureBasicIStringStream() override = default;
+
+        SecureBasicStreamBuf<CharT, Traits> *rdbuf() const noexcept
+        {
+            return const_cast<SecureBasicStreamBuf<CharT, Traits> *>(&buffer);
+        }
+        void reserve(std::size_t capacity) { buffer.reserve(capacity); }
+        std::basic_string_view<CharT, Traits> view() const noexcept
+        {
+            return buffer.view();
+        }
+        SecureBasicString<CharT, Traits> str() const { return buffer.str(); }
+        void str(std::basic_string_view<CharT, Traits> text)
+        {
+            buffer.str(text);
+        }
+        void Clear() noexcept { buffer.Clear(); }
+
+    protected:
+        using std::basic_istream<CharT, Traits>::rdbuf;
+
+        SecureBasicStreamBuf<CharT, Traits> buffer;
+};
+
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+class SecureBasicOStringStream : public std::basic_ostream<CharT, Traits>
+{
+    public:
+        explicit SecureBasicOStringStream(std::ios_base::openmode mode =
+                                              std::ios_base::out) :
+            std::basic_ostream<CharT, Traits>(nullptr),
+            buffer(mode | std::ios_base::out)
+        {
+            this->rdbuf(&buffer);
+        }
+        explicit SecureBasicOStringStream(
+            std::basic_string_view<CharT, Traits> text,
+            std::ios_base::openmode mode = std::ios_base::out) :
+            std::basic_ostream<CharT, Traits>(nullptr),
+            buffer(text, mode | std::ios_base::out)
+        {
+            this->rdbuf(&buffer);
+        }
+        ~SecureBasicOStringStream() override = default;
+
+        SecureBasicStreamBuf<CharT, Traits> *rdbuf() const noexcept
+        {
+            return const_cast<SecureBasicStreamBuf<CharT, Traits> *>(&buffer);
+        }
+        void reserve(std::size_t capacity) { buffer.reserve(capacity); }
+        std::basic_string_view<CharT, Traits> view() const noexcept
+        {
+            return buffer.view();
+        }
+        SecureBasicString<CharT, Traits> str() const { return buffer.str(); }
+        void str(std::basic_string_view<CharT, Traits> text)
+        {
+            buffer.str(text);
+        }
+        void Clear() noexcept { buffer.Clear(); }
+
+    protected:
+        using std::basic_ostream<CharT, Traits>::rdbuf;
+
+        SecureBasicStreamBuf<CharT, Traits> buffer;
+};
+
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+class SecureBasicStringStream : public std::basic_iostream<CharT, Traits>
+{
+    public:
+        explicit SecureBasicStringStream(std::ios_base::openmode mode =
+                                             std::ios_base::in |
+                                             std::ios_base::out) :
+            std::basic_iostream<CharT, Traits>(nullptr),
+            buffer(mode)
+        {
+            this->rdbuf(&buffer);
+        }
+        explicit SecureBasicStringStream(
+            std::basic_string_view<CharT, Traits> text,
+            std::ios_base::openmode mode = std::ios_base::in |
+                                           std::ios_base::out) :
+            std::basic_iostream<CharT, Traits>(nullptr),
+            buffer(text, mode)
+        {
+            this->rdbuf(&buffer);
+        }
+        ~SecureBasicStringStream() override = default;
+
+        SecureBasicStreamBuf<CharT, Traits> *rdbuf() const noexcept
+        {
+            return const_cast<SecureBasicStreamBuf<CharT, Traits> *>(&buffer);
+        }
+        void reserve(std::size_t capacity) { buffer.reserve(capacity); }
+        std::basic_string_view<CharT, Traits> view() const noexcept
+        {
+            return buffer.view();
+        }
+        SecureBasicString<CharT, Traits> str() const { return buffer.str(); }
+        void str(std::basic_string_view<CharT, Traits> text)
+        {
+            buffer.str(text);
+        }
+        void Clear() noexcept { buffer.Clear(); }
+
+    protected:
+        using std::basic_iostream<CharT, Traits>::rdbuf;
+
+        SecureBasicStreamBuf<CharT, Traits> buffer;
+};
+
+using SecureStreamBuf = SecureBasicStreamBuf<char>;
+using SecureWStreamBuf = SecureBasicStreamBuf<wchar_t>;
+using SecureIStringStream = SecureBasicIStringStream<char>;
+using SecureWIStringStream = SecureBasicIStringStream<wchar_t>;
+using SecureOStringStream = SecureBasicOStringStream<char>;
+using SecureWOStringStream = SecureBasicOStringStream<wchar_t>;
+using SecureStringStream = SecureBasicStringStream<char>;
+using SecureWStringStream = SecureBasicStringStream<wchar_t>;
+
+} // namespace Terra::SecUtil
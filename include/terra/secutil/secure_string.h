@@ -1,7 +1,7 @@
 /*
  *  secure_string.h
  *
- *  Copyright (C) 2024
+ *  Copyright (C) 2024, 2026
  *  Terrapane Corporation
  *  All Rights Reserved
  *
@@ -33,5 +33,7 @@ using SecureBasicString = std::basic_string<CharT,
 using SecureString = SecureBasicString<char>;
 using SecureWString = SecureBasicString<wchar_t>;
 using SecureU8String = SecureBasicString<char8_t>;
+using SecureU16String = SecureBasicString<char16_t>;
+using SecureU32String = SecureBasicString<char32_t>;
 
 } // namespace Terra::SecUtil
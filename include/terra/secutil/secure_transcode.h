@@ -0,0 +1,281 @@
+/*
+ *  secure_transcode.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This header file defines functions to convert text between the UTF-8,
+ *      UTF-16, and UTF-32 encodings, writing directly into a secure string
+ *      type.  For example:
+ *
+ *          SecureU16String utf16 = SecureTranscode<char16_t>(secure_string);
+ *          SecureWString wide = SecureTranscode<wchar_t>(secure_string);
+ *
+ *      The encoding is determined by the size of the character type: char
+ *      and char8_t hold UTF-8, char16_t holds UTF-16, and char32_t holds
+ *      UTF-32.  The wchar_t type holds UTF-16 on Windows and UTF-32 elsewhere.
+ *
+ *      The exact length of the output is computed before any output is
+ *      written, so the target string is allocated exactly once and never
+ *      reallocated.  Runs of ASCII characters are converted several at a time
+ *      using SIMD instructions where available.  Invalid input (e.g., an
+ *      unpaired surrogate or an overlong UTF-8 sequence) results in a
+ *      std::invalid_argument exception.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <type_traits>
+#include "secure_string.h"
+
+namespace Terra::SecUtil
+{
+
+// Unicode encoding forms
+enum class UnicodeEncoding
+{
+    UTF8,
+    UTF16,
+    UTF32
+};
+
+// Concept for character types that hold a Unicode encoding form
+template<typename CharT>
+concept UnicodeCharacter =
+    std::is_same_v<CharT, char> || std::is_same_v<CharT, char8_t> ||
+    std::is_same_v<CharT, char16_t> || std::is_same_v<CharT, char32_t> ||
+    std::is_same_v<CharT, wchar_t>;
+
+/*
+ *  UnicodeEncodingOf()
+ *
+ *  Description:
+ *      Return the Unicode encoding form held by the given character type.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The Unicode encoding form.
+ *
+ *  Comments:
+ *      None.
+ */
+template<UnicodeCharacter CharT>
+constexpr UnicodeEncoding UnicodeEncodingOf() noexcept
+{
+    if constexpr (sizeof(CharT) == 1)
+    {
+        return UnicodeEncoding::UTF8;
+    }
+    else if constexpr (sizeof(CharT) == 2)
+    {
+        return UnicodeEncoding::UTF16;
+    }
+    else
+    {
+        return UnicodeEncoding::UTF32;
+    }
+}
+
+/*
+ *  TranscodedLength()
+ *
+ *  Description:
+ *      Validate the given text and compute the number of code units required
+ *      to represent it in the target encoding.
+ *
+ *  Parameters:
+ *      source [in]
+ *          Pointer to the text to convert.
+ *
+ *      source_length [in]
+ *          Number of code units in the source text.
+ *
+ *      source_encoding [in]
+ *          The encoding of the source text.
+ *
+ *      target_encoding [in]
+ *          The encoding into which the text is to be converted.
+ *
+ *  Returns:
+ *      The number of code units required in the target encoding.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the source is invalid.
+ */
+std::size_t TranscodedLength(const void *source,
+                             std::size_t source_length,
+                             UnicodeEncoding source_encoding,
+                             UnicodeEncoding target_encoding);
+
+/*
+ *  Transcode()
+ *
+ *  Description:
+ *      Convert the given text into the target encoding.
+ *
+ *  Parameters:
+ *      source [in]
+ *          Pointer to the text to convert.
+ *
+ *      source_length [in]
+ *          Number of code units in the source text.
+ *
+ *      source_encoding [in]
+ *          The encoding of the source text.
+ *
+ *      target [out]
+ *          Pointer to the buffer into which the converted text is written.
+ *
+ *      target_length [in]
+ *          Number of code units in the target buffer, which must be exactly
+ *          the value returned by TranscodedLength().
+ *
+ *      target_encoding [in]
+ *          The encoding into which the text is to be converted.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the source is invalid or if
+ *      the target buffer is not the required length.
+ */
+void Transcode(const void *source,
+               std::size_t source_length,
+               UnicodeEncoding source_encoding,
+               void *target,
+               std::size_t target_length,
+               UnicodeEncoding target_encoding);
+
+/*
+ *  TranscodedLength()
+ *
+ *  Description:
+ *      Validate the given text and compute the number of characters of type
+ *      TargetCharT required to represent it.
+ *
+ *  Parameters:
+ *      source [in]
+ *          The text to convert.
+ *
+ *  Returns:
+ *      The number of TargetCharT characters required.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the source is invalid.
+ */
+template<UnicodeCharacter TargetCharT, UnicodeCharacter SourceCharT>
+std::size_t TranscodedLength(std::basic_string_view<SourceCharT> source)
+{
+    return TranscodedLength(source.data(),
+                            source.size(),
+                            UnicodeEncodingOf<SourceCharT>(),
+                            UnicodeEncodingOf<TargetCharT>());
+}
+
+/*
+ *  SecureTranscode()
+ *
+ *  Description:
+ *      Convert the given text into the given target buffer.
+ *
+ *  Parameters:
+ *      source [in]
+ *          The text to convert.
+ *
+ *      target [out]
+ *          The buffer into which the converted text is written, which must
+ *          be exactly TranscodedLength<TargetCharT>(source) in length.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the source is invalid or if
+ *      the target buffer is not the required length.
+ */
+template<UnicodeCharacter TargetCharT, UnicodeCharacter SourceCharT>
+void SecureTranscode(std::basic_string_view<SourceCharT> source,
+                     std::span<TargetCharT> target)
+{
+    Transcode(source.data(),
+              source.size(),
+              UnicodeEncodingOf<SourceCharT>(),
+              target.data(),
+              target.size(),
+              UnicodeEncodingOf<TargetCharT>());
+}
+
+/*
+ *  SecureTranscode()
+ *
+ *  Description:
+ *      Convert the given text into a secure string of the target type.
+ *
+ *  Parameters:
+ *      source [in]
+ *          The text to convert.
+ *
+ *  Returns:
+ *      The converted text as a SecureBasicString<TargetCharT>.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the source is invalid.
+ */
+template<UnicodeCharacter TargetCharT, UnicodeCharacter SourceCharT>
+SecureBasicString<TargetCharT> SecureTranscode(
+                                    std::basic_string_view<SourceCharT> source)
+{
+    SecureBasicString<TargetCharT> target(
+        TranscodedLength<TargetCharT>(source),
+        TargetCharT{});
+
+    SecureTranscode(source, std::span<TargetCharT>(target));
+
+    return target;
+}
+
+/*
+ *  SecureTranscode()
+ *
+ *  Description:
+ *      Convert the given string (e.g., a SecureString) into a secure string
+ *      of the target type.
+ *
+ *  Parameters:
+ *      source [in]
+ *          The text to convert.
+ *
+ *  Returns:
+ *      The converted text as a SecureBasicString<TargetCharT>.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the source is invalid.
+ */
+template<UnicodeCharacter TargetCharT,
+         UnicodeCharacter SourceCharT,
+         typename Traits,
+         typename Allocator>
+SecureBasicString<TargetCharT> SecureTranscode(
+            const std::basic_string<SourceCharT, Traits, Allocator> &source)
+{
+    return SecureTranscode<TargetCharT>(
+        std::basic_string_view<SourceCharT>(source.data(), source.size()));
+}
+
+} // namespace Terra::SecUtil
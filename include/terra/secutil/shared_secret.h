@@ -0,0 +1,105 @@
+/*
+ *  shared_secret.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the SharedSecret object, which places a secret in
+ *      a sealed, anonymous shared memory file (memfd) so that it may be
+ *      shared with other processes by passing a file descriptor (e.g., over
+ *      a Unix domain socket using SCM_RIGHTS) rather than copying the secret
+ *      through socket buffers.
+ *
+ *      The creating process writes the secret once.  Each process maps the
+ *      secret read-only, without copying.  The memory file is sealed so that
+ *      it cannot be resized, so a mapping can never be invalidated by
+ *      another process.  It is not sealed against writes, though: every
+ *      owner must update the reference count, and the last owner must map
+ *      the secret writable to erase it.  Read-only mappings only guard
+ *      against accidental modification; any process holding a descriptor
+ *      can rewrite the secret or the reference count.  Share descriptors
+ *      only with processes trusted with the secret.
+ *
+ *      Ownership is reference counted across processes by a counter held in
+ *      the first page of the memory file.  Export() returns a new file
+ *      descriptor and counts it as an owner; the receiver takes ownership of
+ *      that descriptor with Import().  When the last owner releases the
+ *      secret, the secret is erased and its pages are released.
+ *
+ *          // Broker
+ *          auto secret = SharedSecret::Create(key);
+ *          int fd = secret.Export();
+ *          SendDescriptor(socket, fd);
+ *          close(fd);
+ *
+ *          // Worker
+ *          auto secret = SharedSecret::Import(ReceiveDescriptor(socket));
+ *          Decrypt(secret.Span(), ...);
+ *
+ *      If an exported descriptor cannot be delivered, it should be passed to
+ *      Import() and the resulting object destroyed so that the reference
+ *      count remains correct.
+ *
+ *      If an owning process terminates without releasing the secret (e.g.,
+ *      it crashes or calls _exit()), the reference count never reaches zero
+ *      and the secret is not erased.  The kernel frees the pages once the
+ *      last descriptor is closed, but does not erase them first.
+ *
+ *  Portability Issues:
+ *      This requires memfd_create() and file sealing, which are available on
+ *      Linux (3.17 or later).  On other systems, Create() and Import() throw
+ *      std::system_error.  Secret memory (memfd_secret()) is not used, as it
+ *      does not support sealing.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Terra::SecUtil
+{
+
+class SharedSecret
+{
+    public:
+        SharedSecret() noexcept;
+        SharedSecret(const SharedSecret &) = delete;
+        SharedSecret(SharedSecret &&other) noexcept;
+        ~SharedSecret();
+
+        SharedSecret &operator=(const SharedSecret &) = delete;
+        SharedSecret &operator=(SharedSecret &&other) noexcept;
+
+        static SharedSecret Create(std::span<const std::uint8_t> secret);
+        static SharedSecret Import(int fd);
+
+        int Export() const;
+
+        const std::uint8_t *data() const noexcept { return secret; }
+        std::size_t size() const noexcept { return length; }
+        bool empty() const noexcept { return length == 0; }
+        std::span<const std::uint8_t> Span() const noexcept
+        {
+            return {secret, length};
+        }
+
+        int Handle() const noexcept { return fd; }
+
+    protected:
+        void Release() noexcept;
+
+        int fd;
+        void *header;
+        const std::uint8_t *secret;
+        std::size_t length;
+        std::size_t mapped_length;
+};
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,253 @@
+/*
+ *  wipe_registry.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines an optional registry of live secure memory regions
+ *      that may be erased all at once when a process terminates abnormally.
+ *      Ordinarily, when a process crashes or receives SIGTERM, secrets held
+ *      in live SecureVector or SecureArray objects remain in memory until
+ *      the operating system reclaims the pages.
+ *
+ *      The registry is disabled by default.  Once enabled, the
+ *      SecureAllocator, SecureArray, SecurePages, and the secure deleter
+ *      helper functions (e.g., MakeUniqueSecureArray()) register each region
+ *      when created and deregister it before it is erased and freed:
+ *
+ *          EnableWipeRegistry();
+ *          InstallWipeHandlers();
+ *
+ *      The registry is a fixed-size, open-addressing hash table.
+ *      Registration and deregistration are lock-free and examine at most a
+ *      small, fixed number of slots, so both take constant time.  If no free
+ *      slot is found, the region is simply not registered and is counted as
+ *      dropped.  While the registry is disabled, registration costs only a
+ *      single atomic load.
+ *
+ *      WipeRegisteredRegions() erases every registered region and is
+ *      async-signal-safe.  InstallWipeHandlers() arranges for it to be
+ *      called when a fatal or termination signal is received and at
+ *      std::quick_exit().  Wiping is a best-effort measure: a region being
+ *      freed concurrently by another thread may be erased as it is freed.
+ *
+ *  Portability Issues:
+ *      On Windows, only the signals defined by the C standard are handled.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Terra::SecUtil
+{
+
+// Default number of slots in the registry (a power of two)
+inline constexpr std::size_t Default_Wipe_Registry_Capacity = 65536;
+
+namespace Internal
+{
+
+// Set once the registry is enabled; tested inline by the registration
+// functions so that, while the registry is disabled, they cost only a
+// single atomic load rather than a function call
+extern std::atomic<bool> wipe_registry_enabled;
+
+// Addresses are passed as integers, since the memory is never accessed
+// (and may not yet be initialized)
+void RegisterRegion(std::uintptr_t address, std::size_t length) noexcept;
+void DeregisterRegion(std::uintptr_t address, std::size_t length) noexcept;
+
+} // namespace Internal
+
+/*
+ *  EnableWipeRegistry()
+ *
+ *  Description:
+ *      Allocate the registry and begin registering secure memory regions.
+ *
+ *  Parameters:
+ *      capacity [in]
+ *          The number of slots in the registry, which is rounded up to a
+ *          power of two.  Since slots are examined only near the position
+ *          given by the hash of an address, the capacity should be well
+ *          above the number of regions expected to be live at once.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Regions created before the registry is enabled are not registered.
+ *      Calls after the first have no effect.  This will throw
+ *      std::bad_alloc if the registry cannot be allocated.
+ */
+void EnableWipeRegistry(
+    std::size_t capacity = Default_Wipe_Registry_Capacity);
+
+/*
+ *  WipeRegistryEnabled()
+ *
+ *  Description:
+ *      Determine whether the registry has been enabled.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if the registry is enabled, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool WipeRegistryEnabled() noexcept;
+
+/*
+ *  RegisterSecureRegion()
+ *
+ *  Description:
+ *      Register a region of memory to be erased by WipeRegisteredRegions().
+ *
+ *  Parameters:
+ *      address [in]
+ *          The start of the region.
+ *
+ *      length [in]
+ *          The length of the region in octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This does nothing if the registry is not enabled or the region is
+ *      empty.  The region must be deregistered with the same address and
+ *      length before the memory is freed.
+ */
+inline void RegisterSecureRegion(const void *address,
+                                 std::size_t length) noexcept
+{
+    if (Internal::wipe_registry_enabled.load(std::memory_order_relaxed))
+    {
+        Internal::RegisterRegion(reinterpret_cast<std::uintptr_t>(address),
+                                 length);
+    }
+}
+
+/*
+ *  DeregisterSecureRegion()
+ *
+ *  Description:
+ *      Remove a region previously registered with RegisterSecureRegion().
+ *
+ *  Parameters:
+ *      address [in]
+ *          The start of the region.
+ *
+ *      length [in]
+ *          The length of the region in octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This does nothing if the region is not registered.
+ */
+inline void DeregisterSecureRegion(const void *address,
+                                   std::size_t length) noexcept
+{
+    if (Internal::wipe_registry_enabled.load(std::memory_order_relaxed))
+    {
+        Internal::DeregisterRegion(
+            reinterpret_cast<std::uintptr_t>(address),
+            length);
+    }
+}
+
+/*
+ *  WipeRegisteredRegions()
+ *
+ *  Description:
+ *      Erase every registered region.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function is async-signal-safe.  Regions remain registered, so
+ *      it is intended to be called only as the process terminates.
+ */
+void WipeRegisteredRegions() noexcept;
+
+/*
+ *  InstallWipeHandlers()
+ *
+ *  Description:
+ *      Install signal handlers that call WipeRegisteredRegions() and then
+ *      restore the default disposition of the signal and raise it again,
+ *      and register WipeRegisteredRegions() with std::at_quick_exit().
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Handlers are installed for SIGABRT, SIGBUS, SIGFPE, SIGHUP, SIGILL,
+ *      SIGINT, SIGQUIT, SIGSEGV, SIGTERM, and SIGTRAP where defined, but
+ *      only for those signals whose disposition is presently the default
+ *      (which terminates the process).  Signals that are ignored (e.g.,
+ *      SIGHUP under nohup) or handled by the application are left alone,
+ *      since the process continues to run after receiving them.  Install
+ *      application handlers first and call WipeRegisteredRegions() from
+ *      them if they terminate the process.  Calls after the first have no
+ *      effect.  This will throw std::system_error if a handler cannot be
+ *      installed.
+ */
+void InstallWipeHandlers();
+
+/*
+ *  RegisteredRegions()
+ *
+ *  Description:
+ *      Count the regions presently registered.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of registered regions.
+ *
+ *  Comments:
+ *      This examines every slot, so it is intended only for diagnostics.
+ */
+std::size_t RegisteredRegions() noexcept;
+
+/*
+ *  DroppedRegions()
+ *
+ *  Description:
+ *      Return the number of regions that could not be registered because
+ *      no free slot was found.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of dropped registrations.
+ *
+ *  Comments:
+ *      A non-zero value suggests the registry capacity should be increased.
+ */
+std::size_t DroppedRegions() noexcept;
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,856 @@
+/*
+ *  compacting_pool.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the CompactingPool and SecretHandle objects.
+ *
+ *      Each chunk records the handle owning each of its blocks and keeps a
+ *      list of its free blocks, so free blocks hold only zeros (unlike
+ *      SecurePool, no link is stored in them).  Compaction sorts the chunks
+ *      of a size class so that chunks with pinned objects come first,
+ *      followed by the rest in order of decreasing occupancy.  The leading
+ *      chunks needed to hold every live object are kept, and the objects in
+ *      the remaining chunks are moved into the free blocks of the kept
+ *      chunks, which always have room for them.  Since the chunks remain in
+ *      that order, later allocations fill the most occupied chunks first.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SECUTIL_COMPACTING_POOL_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SECUTIL_COMPACTING_POOL_NEON
+#endif
+#include <terra/secutil/compacting_pool.h>
+#include <terra/secutil/secure_erase.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Objects are moved in units of this many octets
+constexpr std::size_t Move_Unit = 16;
+
+/*
+ *  MoveAndErase()
+ *
+ *  Description:
+ *      Copy an object to a new location and erase the original in the same
+ *      pass over the memory.
+ *
+ *  Parameters:
+ *      destination [out]
+ *          The new location, which must not overlap the source.
+ *
+ *      source [in/out]
+ *          The object to move, which is left zero-filled.
+ *
+ *      length [in]
+ *          Number of octets to move, which is a multiple of Move_Unit.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void MoveAndErase(std::uint8_t *destination,
+                  std::uint8_t *source,
+                  std::size_t length) noexcept
+{
+#if defined(SECUTIL_COMPACTING_POOL_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+
+    for (std::size_t i = 0; i < length; i += Move_Unit)
+    {
+        auto *from = reinterpret_cast<__m128i *>(source + i);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i),
+                         _mm_loadu_si128(from));
+        _mm_storeu_si128(from, zero);
+    }
+#elif defined(SECUTIL_COMPACTING_POOL_NEON)
+    const uint8x16_t zero = vdupq_n_u8(0);
+
+    for (std::size_t i = 0; i < length; i += Move_Unit)
+    {
+        vst1q_u8(destination + i, vld1q_u8(source + i));
+        vst1q_u8(source + i, zero);
+    }
+#else
+    for (std::size_t i = 0; i < length; i++)
+    {
+        destination[i] = source[i];
+        source[i] = 0;
+    }
+#endif
+
+#if !defined(_MSC_VER)
+    // Ensure the erasure is not removed as dead, like explicit_bzero()
+    asm volatile("" : : "r"(source) : "memory");
+#endif
+}
+
+} // namespace
+
+/*
+ *  SecretHandle::View::View()
+ *
+ *  Description:
+ *      Constructor for a view of a pinned object.
+ *
+ *  Parameters:
+ *      pool [in]
+ *          The pool holding the object, or nullptr for an empty view.
+ *
+ *      index [in]
+ *          The handle table index of the object.
+ *
+ *      buffer [in]
+ *          The address of the object.
+ *
+ *      length [in]
+ *          The size of the object.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The object must already be pinned.
+ */
+SecretHandle::View::View(CompactingPool *pool,
+                         std::uint32_t index,
+                         std::uint8_t *buffer,
+                         std::size_t length) noexcept :
+    pool{pool},
+    index{index},
+    buffer{buffer},
+    length{length}
+{
+}
+
+/*
+ *  SecretHandle::View::View()
+ *
+ *  Description:
+ *      Move constructor.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The view from which the pin is taken.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SecretHandle::View::View(View &&other) noexcept :
+    pool{std::exchange(other.pool, nullptr)},
+    index{other.index},
+    buffer{std::exchange(other.buffer, nullptr)},
+    length{std::exchange(other.length, 0)}
+{
+}
+
+/*
+ *  SecretHandle::View::~View()
+ *
+ *  Description:
+ *      Unpin the object so that it may again be moved.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SecretHandle::View::~View()
+{
+    if (pool != nullptr) pool->Unpin(index);
+}
+
+/*
+ *  SecretHandle::SecretHandle()
+ *
+ *  Description:
+ *      Default constructor, which creates an empty handle.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SecretHandle::SecretHandle() noexcept : pool{nullptr}, index{0}, length{0}
+{
+}
+
+/*
+ *  SecretHandle::SecretHandle()
+ *
+ *  Description:
+ *      Constructor used by the CompactingPool for a newly allocated object.
+ *
+ *  Parameters:
+ *      pool [in]
+ *          The pool holding the object.
+ *
+ *      index [in]
+ *          The handle table index of the object.
+ *
+ *      length [in]
+ *          The size of the object.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SecretHandle::SecretHandle(CompactingPool *pool,
+                           std::uint32_t index,
+                           std::size_t length) noexcept :
+    pool{pool},
+    index{index},
+    length{length}
+{
+}
+
+/*
+ *  SecretHandle::SecretHandle()
+ *
+ *  Description:
+ *      Move constructor.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The handle from which ownership is taken.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The other handle is left empty.
+ */
+SecretHandle::SecretHandle(SecretHandle &&other) noexcept :
+    pool{std::exchange(other.pool, nullptr)},
+    index{std::exchange(other.index, 0)},
+    length{std::exchange(other.length, 0)}
+{
+}
+
+/*
+ *  SecretHandle::~SecretHandle()
+ *
+ *  Description:
+ *      Erase the object and return its block to the pool.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SecretHandle::~SecretHandle()
+{
+    Reset();
+}
+
+/*
+ *  SecretHandle::operator=()
+ *
+ *  Description:
+ *      Move assignment operator.  Any object presently owned is erased and
+ *      released before taking ownership of the other handle's object.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The handle from which ownership is taken.
+ *
+ *  Returns:
+ *      A reference to this handle.
+ *
+ *  Comments:
+ *      The other handle is left empty.
+ */
+SecretHandle &SecretHandle::operator=(SecretHandle &&other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+
+        pool = std::exchange(other.pool, nullptr);
+        index = std::exchange(other.index, 0);
+        length = std::exchange(other.length, 0);
+    }
+
+    return *this;
+}
+
+/*
+ *  SecretHandle::Reset()
+ *
+ *  Description:
+ *      Erase the object and return its block to the pool, leaving the
+ *      handle empty.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If a view of the object exists, the object is freed when the last
+ *      view is destroyed.
+ */
+void SecretHandle::Reset() noexcept
+{
+    if (pool == nullptr) return;
+
+    pool->Release(index);
+
+    pool = nullptr;
+    index = 0;
+    length = 0;
+}
+
+/*
+ *  SecretHandle::Pin()
+ *
+ *  Description:
+ *      Pin the object in place and return a view of it.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A view of the object, which is empty if the handle is empty.  The
+ *      object will not be moved until the view is destroyed.
+ *
+ *  Comments:
+ *      An object may be pinned by several views at once.
+ */
+SecretHandle::View SecretHandle::Pin()
+{
+    if (pool == nullptr) return View(nullptr, 0, nullptr, 0);
+
+    return View(pool, index, pool->Pin(index), length);
+}
+
+/*
+ *  CompactingPool::CompactingPool()
+ *
+ *  Description:
+ *      Constructor for the CompactingPool object.
+ *
+ *  Parameters:
+ *      chunk_size [in]
+ *          The size in octets of the chunks from which blocks are taken.
+ *          Chunks are always large enough to hold at least one block.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      No memory is reserved until the first allocation.  All handles must
+ *      be released before the pool is destroyed.
+ */
+CompactingPool::CompactingPool(std::size_t chunk_size) :
+    chunk_size{chunk_size},
+    classes{},
+    reserved_bytes{0},
+    locked_bytes{0},
+    in_use_bytes{0}
+{
+}
+
+/*
+ *  CompactingPool::Allocate()
+ *
+ *  Description:
+ *      Allocate a zero-filled object from the pool.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the object in octets.
+ *
+ *  Returns:
+ *      A handle owning the object, which is empty if size is zero.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the size exceeds
+ *      Max_Pool_Block, or std::bad_alloc if memory cannot be allocated.
+ */
+SecretHandle CompactingPool::Allocate(std::size_t size)
+{
+    if (size == 0) return SecretHandle();
+
+    if (size > Max_Pool_Block)
+    {
+        throw std::invalid_argument("Object is too large for the pool");
+    }
+
+    const std::size_t class_index = SecurePool::ClassIndex(size);
+    const std::size_t stride = SecurePool::ClassSize(class_index);
+    auto &chunks = classes[class_index];
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Take a block from the first chunk having one, else create a chunk
+    auto it = std::find_if(chunks.begin(),
+                           chunks.end(),
+                           [](const std::unique_ptr<Chunk> &chunk)
+                           { return !chunk->free_blocks.empty(); });
+    if (it == chunks.end())
+    {
+        auto chunk = std::make_unique<Chunk>();
+
+        try
+        {
+            chunk->pages = SecurePages(std::max(chunk_size, stride));
+        }
+        catch (const std::system_error &)
+        {
+            throw std::bad_alloc();
+        }
+        chunk->pages.Lock();
+        chunk->size_class = class_index;
+        chunk->capacity = chunk->pages.capacity() / stride;
+        chunk->live = 0;
+        chunk->pinned = 0;
+        chunk->owners.assign(chunk->capacity, No_Owner);
+
+        // Blocks are taken from the back, lowest address first
+        chunk->free_blocks.reserve(chunk->capacity);
+        for (std::size_t block = chunk->capacity; block > 0; block--)
+        {
+            chunk->free_blocks.push_back(static_cast<std::uint32_t>(block - 1));
+        }
+
+        chunks.reserve(chunks.size() + 1);
+
+        reserved_bytes += chunk->pages.capacity();
+        if (chunk->pages.IsLocked()) locked_bytes += chunk->pages.capacity();
+
+        chunks.push_back(std::move(chunk));
+        it = chunks.end() - 1;
+    }
+
+    // Obtain a handle table entry; space to free it is reserved here so
+    // that releasing the handle cannot fail
+    std::uint32_t index;
+    if (free_entries.empty())
+    {
+        if (entries.size() >= No_Owner)
+        {
+            throw std::length_error("Handle table is full");
+        }
+        free_entries.reserve(entries.size() + 1);
+        entries.push_back({});
+        index = static_cast<std::uint32_t>(entries.size() - 1);
+    }
+    else
+    {
+        index = free_entries.back();
+        free_entries.pop_back();
+    }
+
+    Chunk *chunk = it->get();
+    const std::uint32_t block = chunk->free_blocks.back();
+    chunk->free_blocks.pop_back();
+    chunk->owners[block] = index;
+    chunk->live++;
+    in_use_bytes += size;
+
+    entries[index] = {chunk, block, size, 0, false};
+
+    return SecretHandle(this, index, size);
+}
+
+/*
+ *  CompactingPool::Compact()
+ *
+ *  Description:
+ *      Move objects out of sparsely occupied chunks and release the chunks
+ *      left empty.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of objects moved and chunks released.
+ *
+ *  Comments:
+ *      Each size class is compacted into the fewest chunks able to hold
+ *      its objects, apart from chunks holding pinned objects, which are
+ *      kept.  Chunks that are already empty are also released.  The pool
+ *      is locked for the duration.
+ */
+CompactionStatistics CompactingPool::Compact() noexcept
+{
+    CompactionStatistics statistics{};
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto &chunks : classes) CompactClass(chunks, statistics);
+
+    statistics.pinned_objects = static_cast<std::size_t>(
+        std::count_if(entries.begin(),
+                      entries.end(),
+                      [](const Entry &entry) { return entry.pins > 0; }));
+
+    return statistics;
+}
+
+/*
+ *  CompactingPool::ReservedBytes()
+ *
+ *  Description:
+ *      Return the amount of memory reserved by the pool.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of octets in chunks.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t CompactingPool::ReservedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return reserved_bytes;
+}
+
+/*
+ *  CompactingPool::LockedBytes()
+ *
+ *  Description:
+ *      Return the amount of memory the pool has locked.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of octets in chunks that are locked.
+ *
+ *  Comments:
+ *      This is less than ReservedBytes() if the locked memory limit was
+ *      reached.
+ */
+std::size_t CompactingPool::LockedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return locked_bytes;
+}
+
+/*
+ *  CompactingPool::InUseBytes()
+ *
+ *  Description:
+ *      Return the amount of memory allocated from the pool.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The sum of the sizes requested for objects not yet released.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t CompactingPool::InUseBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return in_use_bytes;
+}
+
+/*
+ *  CompactingPool::Address()
+ *
+ *  Description:
+ *      Return the present address of an object.
+ *
+ *  Parameters:
+ *      entry [in]
+ *          The handle table entry for the object.
+ *
+ *  Returns:
+ *      The address of the object.
+ *
+ *  Comments:
+ *      The mutex must be held.
+ */
+std::uint8_t *CompactingPool::Address(const Entry &entry) const noexcept
+{
+    return entry.chunk->pages.data() +
+           entry.block * SecurePool::ClassSize(entry.chunk->size_class);
+}
+
+/*
+ *  CompactingPool::Pin()
+ *
+ *  Description:
+ *      Prevent an object from being moved.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The handle table index of the object.
+ *
+ *  Returns:
+ *      The address of the object.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint8_t *CompactingPool::Pin(std::uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Entry &entry = entries[index];
+
+    if (entry.pins++ == 0) entry.chunk->pinned++;
+
+    return Address(entry);
+}
+
+/*
+ *  CompactingPool::Unpin()
+ *
+ *  Description:
+ *      Remove a pin placed by Pin().
+ *
+ *  Parameters:
+ *      index [in]
+ *          The handle table index of the object.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If the handle was released while the object was pinned, the object
+ *      is freed once the last pin is removed.
+ */
+void CompactingPool::Unpin(std::uint32_t index) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Entry &entry = entries[index];
+
+    if (--entry.pins > 0) return;
+
+    entry.chunk->pinned--;
+    if (entry.released) Free(index);
+}
+
+/*
+ *  CompactingPool::Release()
+ *
+ *  Description:
+ *      Release the object owned by a handle.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The handle table index of the object.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If the object is pinned (e.g., the handle was a temporary from which
+ *      a View was taken), it is freed only once the last View is destroyed,
+ *      so the View remains valid.
+ */
+void CompactingPool::Release(std::uint32_t index) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Entry &entry = entries[index];
+
+    if (entry.pins > 0)
+    {
+        entry.released = true;
+        return;
+    }
+
+    Free(index);
+}
+
+/*
+ *  CompactingPool::Free()
+ *
+ *  Description:
+ *      Erase an object and return its block and handle table entry to the
+ *      pool.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The handle table index of the object.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The mutex must be held and the object must not be pinned.  Only the
+ *      octets of the object are erased, since the remainder of the block
+ *      was erased when the block was last freed.  An emptied chunk is kept
+ *      until the next compaction.
+ */
+void CompactingPool::Free(std::uint32_t index) noexcept
+{
+    Entry &entry = entries[index];
+    Chunk *chunk = entry.chunk;
+
+    SecureErase(Address(entry), entry.size);
+
+    // Neither list can grow beyond the space reserved for it
+    chunk->owners[entry.block] = No_Owner;
+    chunk->free_blocks.push_back(entry.block);
+    chunk->live--;
+    in_use_bytes -= entry.size;
+
+    entry = {};
+    free_entries.push_back(index);
+}
+
+/*
+ *  CompactingPool::CompactClass()
+ *
+ *  Description:
+ *      Compact the chunks of one size class.
+ *
+ *  Parameters:
+ *      chunks [in/out]
+ *          The chunks of the size class.
+ *
+ *      statistics [in/out]
+ *          Counters to which the work done is added.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The mutex must be held.
+ */
+void CompactingPool::CompactClass(std::vector<std::unique_ptr<Chunk>> &chunks,
+                                  CompactionStatistics &statistics) noexcept
+{
+    if (chunks.empty()) return;
+
+    const std::size_t capacity = chunks.front()->capacity;
+    const std::size_t stride =
+        SecurePool::ClassSize(chunks.front()->size_class);
+    std::size_t live = 0;
+    std::size_t pinned_chunks = 0;
+
+    for (const auto &chunk : chunks)
+    {
+        live += chunk->live;
+        if (chunk->pinned > 0) pinned_chunks++;
+    }
+
+    std::sort(chunks.begin(),
+              chunks.end(),
+              [](const std::unique_ptr<Chunk> &a, const std::unique_ptr<Chunk> &b)
+              {
+                  if ((a->pinned > 0) != (b->pinned > 0)) return a->pinned > 0;
+                  return a->live > b->live;
+              });
+
+    // Objects in chunks beyond those kept are moved; the kept chunks have
+    // enough free blocks to receive them all
+    const std::size_t keep =
+        std::max((live + capacity - 1) / capacity, pinned_chunks);
+    std::size_t target = 0;
+
+    for (std::size_t source = keep; source < chunks.size(); source++)
+    {
+        Chunk &from = *chunks[source];
+
+        for (std::size_t block = 0; (block < from.capacity) && (from.live > 0);
+             block++)
+        {
+            const std::uint32_t owner = from.owners[block];
+
+            if (owner == No_Owner) continue;
+
+            while (chunks[target]->free_blocks.empty()) target++;
+
+            Chunk &to = *chunks[target];
+            Entry &entry = entries[owner];
+            const std::uint32_t destination = to.free_blocks.back();
+            const std::size_t length =
+                (entry.size + Move_Unit - 1) / Move_Unit * Move_Unit;
+
+            MoveAndErase(to.pages.data() + destination * stride,
+                         from.pages.data() + block * stride,
+                         length);
+
+            to.free_blocks.pop_back();
+            to.owners[destination] = owner;
+            to.live++;
+            from.owners[block] = No_Owner;
+            from.live--;
+
+            entry.chunk = &to;
+            entry.block = destination;
+
+            statistics.moved_objects++;
+            statistics.moved_bytes += entry.size;
+        }
+    }
+
+    // Empty chunks hold only erased blocks, so are not erased again
+    std::erase_if(chunks,
+                  [&](std::unique_ptr<Chunk> &chunk)
+                  {
+                      if (chunk->live > 0) return false;
+
+                      const std::size_t length = chunk->pages.capacity();
+
+                      reserved_bytes -= length;
+                      if (chunk->pages.IsLocked()) locked_bytes -= length;
+                      statistics.released_chunks++;
+                      statistics.released_bytes += length;
+
+                      chunk->pages.SetEraseMethod(PageEraseMethod::Discard);
+
+                      return true;
+                  });
+}
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,367 @@
+/*
+ *  constant_time.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module contains the constant-time conditional copy, conditional
+ *      swap, and table lookup functions.  Each is implemented by blending
+ *      buffers with a mask derived from the secret condition, so the same
+ *      instructions and memory accesses are executed regardless of the
+ *      condition.  Where SIMD instructions are available (SSE2 on x86 and
+ *      NEON on ARM), 16 octets are processed per instruction.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SECUTIL_CONSTANT_TIME_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SECUTIL_CONSTANT_TIME_NEON
+#endif
+#include <terra/secutil/constant_time.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+/*
+ *  EqualMask()
+ *
+ *  Description:
+ *      Produce a mask having all bits set if the two values are equal or
+ *      all bits clear otherwise, without branching.
+ *
+ *  Parameters:
+ *      a [in]
+ *          The first value.
+ *
+ *      b [in]
+ *          The second value.
+ *
+ *  Returns:
+ *      The mask value.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::uint64_t EqualMask(std::uint64_t a, std::uint64_t b) noexcept
+{
+    const std::uint64_t difference = a ^ b;
+
+    // The high bit of (d | -d) is set if and only if d is non-zero
+    std::uint64_t mask = ((difference | (0 - difference)) >> 63) - 1;
+
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__("" : "+r"(mask));
+#endif
+
+    return mask;
+}
+
+/*
+ *  BlendMasked()
+ *
+ *  Description:
+ *      For every octet, compute destination ^= (destination ^ source) & mask,
+ *      which copies source to destination when the mask is all ones.  When
+ *      accumulate is true, compute destination |= source & mask instead.
+ *
+ *  Parameters:
+ *      destination [in/out]
+ *          The destination buffer.
+ *
+ *      source [in]
+ *          The source buffer.
+ *
+ *      length [in]
+ *          Number of octets in each buffer.
+ *
+ *      mask [in]
+ *          Either all bits set or all bits clear.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The accumulate flag is not secret.
+ */
+template<bool Accumulate>
+void BlendMasked(std::uint8_t *destination,
+                 const std::uint8_t *source,
+                 std::size_t length,
+                 std::uint64_t mask) noexcept
+{
+#if defined(SECUTIL_CONSTANT_TIME_SSE2)
+    const __m128i vmask = _mm_set1_epi64x(static_cast<long long>(mask));
+
+    for (; length >= 16; length -= 16, destination += 16, source += 16)
+    {
+        auto *d = reinterpret_cast<__m128i *>(destination);
+        const __m128i a = _mm_loadu_si128(d);
+        const __m128i b =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+
+        if constexpr (Accumulate)
+        {
+            _mm_storeu_si128(d, _mm_or_si128(a, _mm_and_si128(b, vmask)));
+        }
+        else
+        {
+            _mm_storeu_si128(
+                d,
+                _mm_xor_si128(a, _mm_and_si128(_mm_xor_si128(a, b), vmask)));
+        }
+    }
+#elif defined(SECUTIL_CONSTANT_TIME_NEON)
+    const uint8x16_t vmask = vreinterpretq_u8_u64(vdupq_n_u64(mask));
+
+    for (; length >= 16; length -= 16, destination += 16, source += 16)
+    {
+        const uint8x16_t a = vld1q_u8(destination);
+        const uint8x16_t b = vld1q_u8(source);
+
+        if constexpr (Accumulate)
+        {
+            vst1q_u8(destination, vorrq_u8(a, vandq_u8(b, vmask)));
+        }
+        else
+        {
+            vst1q_u8(destination, vbslq_u8(vmask, b, a));
+        }
+    }
+#endif
+
+    for (; length >= 8; length -= 8, destination += 8, source += 8)
+    {
+        std::uint64_t a;
+        std::uint64_t b;
+
+        std::memcpy(&a, destination, sizeof(a));
+        std::memcpy(&b, source, sizeof(b));
+
+        if constexpr (Accumulate)
+        {
+            a |= b & mask;
+        }
+        else
+        {
+            a ^= (a ^ b) & mask;
+        }
+
+        std::memcpy(destination, &a, sizeof(a));
+    }
+
+    const auto octet_mask = static_cast<std::uint8_t>(mask);
+
+    for (; length > 0; length--, destination++, source++)
+    {
+        if constexpr (Accumulate)
+        {
+            *destination |= *source & octet_mask;
+        }
+        else
+        {
+            *destination ^= (*destination ^ *source) & octet_mask;
+        }
+    }
+}
+
+} // namespace
+
+/*
+ *  ConditionalCopy()
+ *
+ *  Description:
+ *      Copy the source buffer to the destination buffer if the condition is
+ *      true, leaving the destination unchanged otherwise.  The destination
+ *      is read and written in either case.
+ *
+ *  Parameters:
+ *      condition [in]
+ *          The (secret) condition.
+ *
+ *      destination [out]
+ *          Pointer to the destination buffer.
+ *
+ *      source [in]
+ *          Pointer to the source buffer.
+ *
+ *      length [in]
+ *          Number of octets in each buffer.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The buffers may be identical, but they must not otherwise overlap.
+ */
+void ConditionalCopy(bool condition,
+                     void *destination,
+                     const void *source,
+                     std::size_t length) noexcept
+{
+    if (length == 0) return;
+
+    BlendMasked<false>(static_cast<std::uint8_t *>(destination),
+                       static_cast<const std::uint8_t *>(source),
+                       length,
+                       ConstantTimeMask<std::uint64_t>(condition));
+}
+
+/*
+ *  ConditionalSwap()
+ *
+ *  Description:
+ *      Swap the contents of two buffers if the condition is true, leaving
+ *      both buffers unchanged otherwise.  Both buffers are read and written
+ *      in either case.
+ *
+ *  Parameters:
+ *      condition [in]
+ *          The (secret) condition.
+ *
+ *      buffer1 [in/out]
+ *          Pointer to the first buffer.
+ *
+ *      buffer2 [in/out]
+ *          Pointer to the second buffer.
+ *
+ *      length [in]
+ *          Number of octets in each buffer.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The buffers must not overlap.
+ */
+void ConditionalSwap(bool condition,
+                     void *buffer1,
+                     void *buffer2,
+                     std::size_t length) noexcept
+{
+    auto *p = static_cast<std::uint8_t *>(buffer1);
+    auto *q = static_cast<std::uint8_t *>(buffer2);
+    const std::uint64_t mask = ConstantTimeMask<std::uint64_t>(condition);
+
+#if defined(SECUTIL_CONSTANT_TIME_SSE2)
+    const __m128i vmask = _mm_set1_epi64x(static_cast<long long>(mask));
+
+    for (; length >= 16; length -= 16, p += 16, q += 16)
+    {
+        auto *a = reinterpret_cast<__m128i *>(p);
+        auto *b = reinterpret_cast<__m128i *>(q);
+        const __m128i x = _mm_loadu_si128(a);
+        const __m128i y = _mm_loadu_si128(b);
+        const __m128i t = _mm_and_si128(_mm_xor_si128(x, y), vmask);
+
+        _mm_storeu_si128(a, _mm_xor_si128(x, t));
+        _mm_storeu_si128(b, _mm_xor_si128(y, t));
+    }
+#elif defined(SECUTIL_CONSTANT_TIME_NEON)
+    const uint8x16_t vmask = vreinterpretq_u8_u64(vdupq_n_u64(mask));
+
+    for (; length >= 16; length -= 16, p += 16, q += 16)
+    {
+        const uint8x16_t x = vld1q_u8(p);
+        const uint8x16_t y = vld1q_u8(q);
+        const uint8x16_t t = vandq_u8(veorq_u8(x, y), vmask);
+
+        vst1q_u8(p, veorq_u8(x, t));
+        vst1q_u8(q, veorq_u8(y, t));
+    }
+#endif
+
+    for (; length >= 8; length -= 8, p += 8, q += 8)
+    {
+        std::uint64_t x;
+        std::uint64_t y;
+
+        std::memcpy(&x, p, sizeof(x));
+        std::memcpy(&y, q, sizeof(y));
+
+        const std::uint64_t t = (x ^ y) & mask;
+        x ^= t;
+        y ^= t;
+
+        std::memcpy(p, &x, sizeof(x));
+        std::memcpy(q, &y, sizeof(y));
+    }
+
+    const auto octet_mask = static_cast<std::uint8_t>(mask);
+
+    for (; length > 0; length--, p++, q++)
+    {
+        const auto t = static_cast<std::uint8_t>((*p ^ *q) & octet_mask);
+        *p ^= t;
+        *q ^= t;
+    }
+}
+
+/*
+ *  ConstantTimeLookup()
+ *
+ *  Description:
+ *      Copy the table entry at the given (secret) index into the destination
+ *      buffer.  Every entry in the table is read so that the memory access
+ *      pattern does not depend on the index.
+ *
+ *  Parameters:
+ *      destination [out]
+ *          Pointer to the buffer into which the entry is copied.  This must
+ *          be entry_size octets in length.
+ *
+ *      table [in]
+ *          Pointer to the table of entries.
+ *
+ *      entry_size [in]
+ *          Size of each table entry in octets.
+ *
+ *      entries [in]
+ *          Number of entries in the table.
+ *
+ *      index [in]
+ *          The (secret) index of the entry to copy.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If the index is not less than the number of entries, the destination
+ *      is filled with zeros.
+ */
+void ConstantTimeLookup(void *destination,
+                        const void *table,
+                        std::size_t entry_size,
+                        std::size_t entries,
+                        std::size_t index) noexcept
+{
+    auto *d = static_cast<std::uint8_t *>(destination);
+    const auto *t = static_cast<const std::uint8_t *>(table);
+
+    if (entry_size == 0) return;
+
+    // Accumulate the selected entry into a zeroed destination
+    std::memset(d, 0, entry_size);
+
+    for (std::size_t i = 0; i < entries; i++, t += entry_size)
+    {
+        BlendMasked<true>(d, t, entry_size, EqualMask(i, index));
+    }
+}
+
+} // namespace Terra::SecUtil
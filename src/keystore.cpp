@@ -0,0 +1,863 @@
+/*
+ *  keystore.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the keystore writer and reader.  The reader
+ *      maps only the header and index of the keystore file; records are read
+ *      individually with positioned reads into SecureVector objects.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <terra/secutil/keystore.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Keystore file format constants
+constexpr char Keystore_Magic[8] = {'T', 'R', 'S', 'K', 'E', 'Y', 'S', '1'};
+constexpr std::uint32_t Keystore_Version = 1;
+constexpr std::size_t Header_Size = 32;
+constexpr std::size_t Index_Entry_Size = 24;
+constexpr std::uint32_t Bucket_Occupied = 1;
+
+// Value of a handle that does not refer to an open file or mapping
+constexpr std::intptr_t Invalid_Handle = -1;
+
+/*
+ *  StoreLE32()
+ *
+ *  Description:
+ *      Store a 32-bit value in little-endian order.
+ *
+ *  Parameters:
+ *      p [out]
+ *          Where to store the value.
+ *
+ *      value [in]
+ *          The value to store.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void StoreLE32(std::uint8_t *p, std::uint32_t value) noexcept
+{
+    for (std::size_t i = 0; i < 4; i++, value >>= 8)
+    {
+        p[i] = static_cast<std::uint8_t>(value);
+    }
+}
+
+/*
+ *  StoreLE64()
+ *
+ *  Description:
+ *      Store a 64-bit value in little-endian order.
+ *
+ *  Parameters:
+ *      p [out]
+ *          Where to store the value.
+ *
+ *      value [in]
+ *          The value to store.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void StoreLE64(std::uint8_t *p, std::uint64_t value) noexcept
+{
+    for (std::size_t i = 0; i < 8; i++, value >>= 8)
+    {
+        p[i] = static_cast<std::uint8_t>(value);
+    }
+}
+
+/*
+ *  LoadLE32()
+ *
+ *  Description:
+ *      Load a 32-bit value stored in little-endian order.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Where the value is stored.
+ *
+ *  Returns:
+ *      The value.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint32_t LoadLE32(const std::uint8_t *p) noexcept
+{
+    std::uint32_t value = 0;
+
+    for (std::size_t i = 4; i > 0; i--) value = (value << 8) | p[i - 1];
+
+    return value;
+}
+
+/*
+ *  LoadLE64()
+ *
+ *  Description:
+ *      Load a 64-bit value stored in little-endian order.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Where the value is stored.
+ *
+ *  Returns:
+ *      The value.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint64_t LoadLE64(const std::uint8_t *p) noexcept
+{
+    std::uint64_t value = 0;
+
+    for (std::size_t i = 8; i > 0; i--) value = (value << 8) | p[i - 1];
+
+    return value;
+}
+
+/*
+ *  HashKeyId()
+ *
+ *  Description:
+ *      Mix the bits of the key identifier so that sequential identifiers are
+ *      distributed evenly across the index.
+ *
+ *  Parameters:
+ *      key_id [in]
+ *          The key identifier.
+ *
+ *  Returns:
+ *      The hash value.
+ *
+ *  Comments:
+ *      This is the MurmurHash3 64-bit finalizer.
+ */
+std::uint64_t HashKeyId(std::uint64_t key_id) noexcept
+{
+    key_id ^= key_id >> 33;
+    key_id *= 0xff51afd7ed558ccdULL;
+    key_id ^= key_id >> 33;
+    key_id *= 0xc4ceb9fe1a85ec53ULL;
+    key_id ^= key_id >> 33;
+
+    return key_id;
+}
+
+/*
+ *  ThrowSystemError()
+ *
+ *  Description:
+ *      Throw a std::system_error for the most recent operating system error.
+ *
+ *  Parameters:
+ *      what [in]
+ *          Description of the operation that failed.
+ *
+ *  Returns:
+ *      Does not return.
+ *
+ *  Comments:
+ *      None.
+ */
+[[noreturn]] void ThrowSystemError(const char *what)
+{
+#if defined(_WIN32)
+    throw std::system_error(static_cast<int>(GetLastError()),
+                            std::system_category(),
+                            what);
+#else
+    throw std::system_error(errno, std::generic_category(), what);
+#endif
+}
+
+/*
+ *  CloseFileHandle()
+ *
+ *  Description:
+ *      Close the given file handle.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The handle to close.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void CloseFileHandle(std::intptr_t handle) noexcept
+{
+    if (handle == Invalid_Handle) return;
+
+#if defined(_WIN32)
+    ::CloseHandle(reinterpret_cast<HANDLE>(handle));
+#else
+    close(static_cast<int>(handle));
+#endif
+}
+
+/*
+ *  ReadAt()
+ *
+ *  Description:
+ *      Read exactly the given number of octets from the given file offset.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      buffer [out]
+ *          The buffer into which data is read.
+ *
+ *      length [in]
+ *          The number of octets to read.
+ *
+ *      offset [in]
+ *          The offset within the file.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::system_error on failure or if the end of the file
+ *      is reached first.  Positioned reads allow concurrent use.
+ */
+void ReadAt(std::intptr_t handle,
+            std::uint8_t *buffer,
+            std::size_t length,
+            std::uint64_t offset)
+{
+    while (length > 0)
+    {
+#if defined(_WIN32)
+        OVERLAPPED overlapped{};
+        DWORD result = 0;
+
+        overlapped.Offset = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        if (!::ReadFile(reinterpret_cast<HANDLE>(handle),
+                        buffer,
+                        static_cast<DWORD>(
+                            std::min<std::size_t>(length, 0x40000000)),
+                        &result,
+                        &overlapped))
+        {
+            ThrowSystemError("Unable to read keystore");
+        }
+#else
+        const ssize_t result = pread(static_cast<int>(handle),
+                                     buffer,
+                                     length,
+                                     static_cast<off_t>(offset));
+
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            ThrowSystemError("Unable to read keystore");
+        }
+#endif
+
+        if (result == 0)
+        {
+            throw std::system_error(std::make_error_code(std::errc::io_error),
+                                    "Unexpected end of keystore");
+        }
+
+        buffer += result;
+        length -= static_cast<std::size_t>(result);
+        offset += static_cast<std::uint64_t>(result);
+    }
+}
+
+/*
+ *  WriteAll()
+ *
+ *  Description:
+ *      Write the entire buffer to the given file.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      buffer [in]
+ *          The data to write.
+ *
+ *      length [in]
+ *          The number of octets to write.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Data is written directly from the caller's buffer, without passing
+ *      through a stream buffer that would not be erased.  This will throw
+ *      std::system_error on failure.
+ */
+void WriteAll(std::intptr_t handle, const std::uint8_t *buffer, std::size_t length)
+{
+    while (length > 0)
+    {
+#if defined(_WIN32)
+        DWORD result = 0;
+
+        if (!::WriteFile(reinterpret_cast<HANDLE>(handle),
+                         buffer,
+                         static_cast<DWORD>(
+                             std::min<std::size_t>(length, 0x40000000)),
+                         &result,
+                         nullptr))
+        {
+            ThrowSystemError("Unable to write keystore");
+        }
+#else
+        const ssize_t result = write(static_cast<int>(handle), buffer, length);
+
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            ThrowSystemError("Unable to write keystore");
+        }
+#endif
+
+        buffer += result;
+        length -= static_cast<std::size_t>(result);
+    }
+}
+
+} // namespace
+
+/*
+ *  KeystoreWriter::Add()
+ *
+ *  Description:
+ *      Add a record to the keystore being written.
+ *
+ *  Parameters:
+ *      key_id [in]
+ *          The identifier of the record, which must be unique.
+ *
+ *      record [in]
+ *          The record data, which is copied into secure storage.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the key identifier was
+ *      already added or the record is longer than 2^32 - 1 octets.
+ */
+void KeystoreWriter::Add(std::uint64_t key_id,
+                         std::span<const std::uint8_t> record)
+{
+    if (record.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::invalid_argument("Keystore record is too large");
+    }
+
+    if (!key_ids.insert(key_id).second)
+    {
+        throw std::invalid_argument("Duplicate keystore key identifier");
+    }
+
+    entries.push_back({key_id, data.size(), record.size()});
+    data.insert(data.end(), record.begin(), record.end());
+}
+
+/*
+ *  KeystoreWriter::Write()
+ *
+ *  Description:
+ *      Write the keystore to the given file.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to write.  The keystore is written to a temporary file
+ *          that then replaces this file, so readers never observe a
+ *          partially written keystore.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      On Unix-like systems, the file is created readable only by its owner.
+ *      This will throw std::system_error on failure.
+ */
+void KeystoreWriter::Write(const std::filesystem::path &path) const
+{
+    // Use a load factor of at most one half
+    std::uint64_t bucket_count = 1;
+    while (bucket_count < entries.size() * 2) bucket_count <<= 1;
+
+    const std::size_t index_end = Header_Size + static_cast<std::size_t>(
+                                                    bucket_count) *
+                                                    Index_Entry_Size;
+
+    // The header and index contain no secrets
+    std::vector<std::uint8_t> index(index_end, 0);
+
+    std::memcpy(index.data(), Keystore_Magic, sizeof(Keystore_Magic));
+    StoreLE32(index.data() + 8, Keystore_Version);
+    StoreLE64(index.data() + 16, bucket_count);
+    StoreLE64(index.data() + 24, entries.size());
+
+    for (const auto &entry : entries)
+    {
+        std::uint64_t bucket = HashKeyId(entry.key_id) & (bucket_count - 1);
+        std::uint8_t *p = nullptr;
+
+        while (true)
+        {
+            p = index.data() + Header_Size +
+                static_cast<std::size_t>(bucket) * Index_Entry_Size;
+            if (LoadLE32(p + 20) != Bucket_Occupied) break;
+            bucket = (bucket + 1) & (bucket_count - 1);
+        }
+
+        StoreLE64(p, entry.key_id);
+        StoreLE64(p + 8, index_end + entry.offset);
+        StoreLE32(p + 16, static_cast<std::uint32_t>(entry.length));
+        StoreLE32(p + 20, Bucket_Occupied);
+    }
+
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileW(temporary.c_str(),
+                              GENERIC_WRITE,
+                              0,
+                              nullptr,
+                              CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) ThrowSystemError("Unable to create keystore");
+    const auto handle = reinterpret_cast<std::intptr_t>(file);
+#else
+    const int fd = open(temporary.c_str(),
+                        O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                        0600);
+    if (fd < 0) ThrowSystemError("Unable to create keystore");
+    const auto handle = static_cast<std::intptr_t>(fd);
+#endif
+
+    try
+    {
+        WriteAll(handle, index.data(), index.size());
+        WriteAll(handle, data.data(), data.size());
+
+#if defined(_WIN32)
+        if (!FlushFileBuffers(file)) ThrowSystemError("Unable to flush keystore");
+#else
+        if (fsync(fd) != 0) ThrowSystemError("Unable to flush keystore");
+#endif
+    }
+    catch (...)
+    {
+        CloseFileHandle(handle);
+        std::error_code error;
+        std::filesystem::remove(temporary, error);
+        throw;
+    }
+
+    CloseFileHandle(handle);
+
+    std::filesystem::rename(temporary, path);
+}
+
+/*
+ *  Keystore::Keystore()
+ *
+ *  Description:
+ *      Open the given keystore file and map its index.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The keystore file.
+ *
+ *      cache_capacity [in]
+ *          The maximum number of records held in the cache.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::system_error if the file cannot be read, or
+ *      std::invalid_argument if it is not a valid keystore.
+ */
+Keystore::Keystore(const std::filesystem::path &path,
+                   std::size_t cache_capacity) :
+    handle{Invalid_Handle},
+    mapping{Invalid_Handle},
+    index{nullptr},
+    mapped_length{0},
+    file_size{0},
+    bucket_count{0},
+    record_count{0},
+    cache_capacity{cache_capacity}
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileW(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) ThrowSystemError("Unable to open keystore");
+    handle = reinterpret_cast<std::intptr_t>(file);
+#else
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) ThrowSystemError("Unable to open keystore");
+    handle = fd;
+#endif
+
+    try
+    {
+        std::uint8_t header[Header_Size];
+
+#if defined(_WIN32)
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) ThrowSystemError("Unable to stat keystore");
+        file_size = static_cast<std::uint64_t>(size.QuadPart);
+#else
+        struct stat status;
+        if (fstat(fd, &status) != 0) ThrowSystemError("Unable to stat keystore");
+        file_size = static_cast<std::uint64_t>(status.st_size);
+#endif
+
+        if (file_size < Header_Size)
+        {
+            throw std::invalid_argument("Invalid keystore file");
+        }
+
+        ReadAt(handle, header, Header_Size, 0);
+
+        bucket_count = LoadLE64(header + 16);
+        record_count = LoadLE64(header + 24);
+
+        if ((std::memcmp(header, Keystore_Magic, sizeof(Keystore_Magic)) != 0) ||
+            (LoadLE32(header + 8) != Keystore_Version) ||
+            (bucket_count == 0) ||
+            ((bucket_count & (bucket_count - 1)) != 0) ||
+            (bucket_count > (file_size - Header_Size) / Index_Entry_Size) ||
+            (record_count > bucket_count))
+        {
+            throw std::invalid_argument("Invalid keystore file");
+        }
+
+        mapped_length = Header_Size +
+                        static_cast<std::size_t>(bucket_count) * Index_Entry_Size;
+
+#if defined(_WIN32)
+        HANDLE file_mapping =
+            CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (file_mapping == nullptr) ThrowSystemError("Unable to map keystore");
+        mapping = reinterpret_cast<std::intptr_t>(file_mapping);
+
+        const void *p =
+            MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, mapped_length);
+        if (p == nullptr) ThrowSystemError("Unable to map keystore");
+#else
+        void *p = mmap(nullptr, mapped_length, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) ThrowSystemError("Unable to map keystore");
+
+#if defined(MADV_RANDOM)
+        madvise(p, mapped_length, MADV_RANDOM);
+#endif
+#endif
+
+        index = static_cast<const std::uint8_t *>(p) + Header_Size;
+    }
+    catch (...)
+    {
+#if defined(_WIN32)
+        if (mapping != Invalid_Handle)
+        {
+            ::CloseHandle(reinterpret_cast<HANDLE>(mapping));
+        }
+#endif
+        CloseFileHandle(handle);
+        throw;
+    }
+}
+
+/*
+ *  Keystore::~Keystore()
+ *
+ *  Description:
+ *      Unmap the index and close the keystore file.  Cached records are
+ *      erased once no caller holds a reference to them.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+Keystore::~Keystore()
+{
+    const void *p = index - Header_Size;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(p);
+    ::CloseHandle(reinterpret_cast<HANDLE>(mapping));
+#else
+    munmap(const_cast<void *>(p), mapped_length);
+#endif
+
+    CloseFileHandle(handle);
+}
+
+/*
+ *  Keystore::Find()
+ *
+ *  Description:
+ *      Find the record having the given key identifier, loading it from the
+ *      file if it is not already cached.
+ *
+ *  Parameters:
+ *      key_id [in]
+ *          The identifier of the record.
+ *
+ *  Returns:
+ *      The record, or nullptr if there is no record with that identifier.
+ *
+ *  Comments:
+ *      This may be called concurrently from multiple threads.  This will
+ *      throw std::system_error if the record cannot be read, or
+ *      std::invalid_argument if the index entry refers to data outside the
+ *      file.
+ */
+KeystoreRecord Keystore::Find(std::uint64_t key_id)
+{
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+
+        auto it = cache.find(key_id);
+        if (it != cache.end())
+        {
+            lru.splice(lru.begin(), lru, it->second.position);
+            return it->second.record;
+        }
+    }
+
+    Location location;
+
+    if (!Lookup(key_id, location)) return nullptr;
+
+    if ((location.offset < mapped_length) || (location.offset > file_size) ||
+        (location.length > file_size - location.offset))
+    {
+        throw std::invalid_argument("Keystore record is outside the file");
+    }
+
+    // Read outside the lock so that other lookups are not blocked
+    auto record = std::make_shared<SecureVector<std::uint8_t>>(location.length);
+    ReadAt(handle, record->data(), record->size(), location.offset);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    // Another thread may have loaded the same record concurrently
+    auto it = cache.find(key_id);
+    if (it != cache.end())
+    {
+        lru.splice(lru.begin(), lru, it->second.position);
+        return it->second.record;
+    }
+
+    lru.push_front(key_id);
+    cache.emplace(key_id, CacheEntry{record, lru.begin()});
+
+    while (cache.size() > cache_capacity)
+    {
+        cache.erase(lru.back());
+        lru.pop_back();
+    }
+
+    return record;
+}
+
+/*
+ *  Keystore::Contains()
+ *
+ *  Description:
+ *      Determine whether the keystore holds a record with the given key
+ *      identifier, without loading the record.
+ *
+ *  Parameters:
+ *      key_id [in]
+ *          The identifier of the record.
+ *
+ *  Returns:
+ *      True if the record exists, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool Keystore::Contains(std::uint64_t key_id) const noexcept
+{
+    Location location;
+
+    return Lookup(key_id, location);
+}
+
+/*
+ *  Keystore::CachedRecords()
+ *
+ *  Description:
+ *      Return the number of records presently held in the cache.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of cached records.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Keystore::CachedRecords() const
+{
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    return cache.size();
+}
+
+/*
+ *  Keystore::Evict()
+ *
+ *  Description:
+ *      Remove the record having the given key identifier from the cache.
+ *
+ *  Parameters:
+ *      key_id [in]
+ *          The identifier of the record.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The record is erased once no caller holds a reference to it.
+ */
+void Keystore::Evict(std::uint64_t key_id)
+{
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    auto it = cache.find(key_id);
+    if (it == cache.end()) return;
+
+    lru.erase(it->second.position);
+    cache.erase(it);
+}
+
+/*
+ *  Keystore::ClearCache()
+ *
+ *  Description:
+ *      Remove all records from the cache.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Records are erased once no caller holds a reference to them.
+ */
+void Keystore::ClearCache()
+{
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    cache.clear();
+    lru.clear();
+}
+
+/*
+ *  Keystore::Lookup()
+ *
+ *  Description:
+ *      Locate the given key identifier in the memory-mapped index.
+ *
+ *  Parameters:
+ *      key_id [in]
+ *          The identifier of the record.
+ *
+ *      location [out]
+ *          The offset and length of the record, if found.
+ *
+ *  Returns:
+ *      True if the record was found, false otherwise.
+ *
+ *  Comments:
+ *      Since the load factor is at most one half, the expected number of
+ *      buckets examined is small and independent of the number of records.
+ */
+bool Keystore::Lookup(std::uint64_t key_id, Location &location) const noexcept
+{
+    std::uint64_t bucket = HashKeyId(key_id) & (bucket_count - 1);
+
+    for (std::uint64_t probes = 0; probes < bucket_count; probes++)
+    {
+        const std::uint8_t *p =
+            index + static_cast<std::size_t>(bucket) * Index_Entry_Size;
+
+        if (LoadLE32(p + 20) != Bucket_Occupied) return false;
+
+        if (LoadLE64(p) == key_id)
+        {
+            location.offset = LoadLE64(p + 8);
+            location.length = LoadLE32(p + 16);
+            return true;
+        }
+
+        bucket = (bucket + 1) & (bucket_count - 1);
+    }
+
+    return false;
+}
+
+} // namespace Terra::SecUtil
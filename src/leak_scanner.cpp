@@ -0,0 +1,1414 @@
+/*
+ *  leak_scanner.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the LeakScanner.  Each image (a file, the
+ *      segments of a core file, or the mappings of a process) is divided into
+ *      pieces of Scan_Piece_Size octets, and each thread takes the next piece
+ *      from a shared counter.  A piece is extended by the length of the
+ *      longest pattern less one so that matches spanning two pieces are
+ *      found, but only matches starting within the piece are reported.
+ *
+ *      Files are memory-mapped.  Process memory is read from /proc/<pid>/mem
+ *      into a buffer for each thread; when a process scans itself, any part
+ *      of a piece that overlaps those buffers is cleared before searching so
+ *      that data copied by one thread is not reported again by another.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SECUTIL_LEAK_SCANNER_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SECUTIL_LEAK_SCANNER_NEON
+#endif
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <terra/secutil/leak_scanner.h>
+#include <terra/secutil/secure_pages.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Size of the portion of an image searched by a thread at one time
+constexpr std::uint64_t Scan_Piece_Size = 4194304;
+
+// Size of the block of a piece searched for each group in turn
+constexpr std::size_t Search_Block_Size = 16384;
+
+// Number of groups beyond which the table of prefixes is used instead
+constexpr std::size_t Max_Vector_Groups = 16;
+
+// ELF constants needed to read core files
+constexpr std::size_t Elf_Header_Size = 64;
+constexpr std::size_t Elf_Program_Header_Size = 56;
+constexpr std::uint16_t Elf_Type_Core = 4;
+constexpr std::uint32_t Elf_Segment_Load = 1;
+constexpr std::uint32_t Elf_Segment_Note = 4;
+constexpr std::uint32_t Elf_Note_File = 0x46494c45;
+
+/*
+ *  ThrowSystemError()
+ *
+ *  Description:
+ *      Throw a std::system_error for the most recent operating system error.
+ *
+ *  Parameters:
+ *      what [in]
+ *          Description of the operation that failed.
+ *
+ *  Returns:
+ *      Does not return.
+ *
+ *  Comments:
+ *      None.
+ */
+[[noreturn]] void ThrowSystemError(const char *what)
+{
+#if defined(_WIN32)
+    throw std::system_error(static_cast<int>(GetLastError()),
+                            std::system_category(),
+                            what);
+#else
+    throw std::system_error(errno, std::generic_category(), what);
+#endif
+}
+
+/*
+ *  LoadLE16()
+ *
+ *  Description:
+ *      Load a 16-bit value stored in little-endian order.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Where the value is stored.
+ *
+ *  Returns:
+ *      The value.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint16_t LoadLE16(const std::uint8_t *p) noexcept
+{
+    return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+/*
+ *  LoadLE32()
+ *
+ *  Description:
+ *      Load a 32-bit value stored in little-endian order.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Where the value is stored.
+ *
+ *  Returns:
+ *      The value.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint32_t LoadLE32(const std::uint8_t *p) noexcept
+{
+    std::uint32_t value = 0;
+
+    for (std::size_t i = 4; i > 0; i--) value = (value << 8) | p[i - 1];
+
+    return value;
+}
+
+/*
+ *  LoadLE64()
+ *
+ *  Description:
+ *      Load a 64-bit value stored in little-endian order.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Where the value is stored.
+ *
+ *  Returns:
+ *      The value.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint64_t LoadLE64(const std::uint8_t *p) noexcept
+{
+    std::uint64_t value = 0;
+
+    for (std::size_t i = 8; i > 0; i--) value = (value << 8) | p[i - 1];
+
+    return value;
+}
+
+/*
+ *  ThreadCount()
+ *
+ *  Description:
+ *      Determine the number of threads with which to search.
+ *
+ *  Parameters:
+ *      requested [in]
+ *          The number of threads requested, where zero selects the number of
+ *          hardware threads.
+ *
+ *      pieces [in]
+ *          The number of pieces to search.
+ *
+ *  Returns:
+ *      The number of threads to use, which is at least one.
+ *
+ *  Comments:
+ *      None.
+ */
+unsigned ThreadCount(unsigned requested, std::size_t pieces) noexcept
+{
+    if (requested == 0) requested = std::thread::hardware_concurrency();
+
+    return static_cast<unsigned>(
+        std::clamp<std::size_t>(pieces, 1, std::max(requested, 1U)));
+}
+
+// A file mapped into memory for reading
+class MappedFile
+{
+    public:
+        explicit MappedFile(const std::filesystem::path &path);
+        MappedFile(const MappedFile &) = delete;
+        ~MappedFile();
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        std::span<const std::uint8_t> Span() const noexcept
+        {
+            return {data, length};
+        }
+
+    protected:
+        const std::uint8_t *data;
+        std::size_t length;
+};
+
+/*
+ *  MappedFile::MappedFile()
+ *
+ *  Description:
+ *      Map the given file into memory for reading.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to map.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      An empty file is not mapped.  This will throw std::system_error if
+ *      the file cannot be mapped.
+ */
+MappedFile::MappedFile(const std::filesystem::path &path) :
+    data{nullptr},
+    length{0}
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileW(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) ThrowSystemError("Unable to open file");
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        const DWORD error = GetLastError();
+        CloseHandle(file);
+        throw std::system_error(static_cast<int>(error),
+                                std::system_category(),
+                                "Unable to stat file");
+    }
+
+    length = static_cast<std::size_t>(size.QuadPart);
+    if (length == 0)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    // The view holds a reference to the mapping, which holds the file
+    HANDLE mapping =
+        CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const DWORD error = GetLastError();
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        throw std::system_error(static_cast<int>(error),
+                                std::system_category(),
+                                "Unable to map file");
+    }
+
+    data = static_cast<const std::uint8_t *>(
+        MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+    if (data == nullptr) ThrowSystemError("Unable to map file");
+#else
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) ThrowSystemError("Unable to open file");
+
+    struct stat status;
+    if (fstat(fd, &status) != 0)
+    {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "Unable to stat file");
+    }
+
+    length = static_cast<std::size_t>(status.st_size);
+    if (length == 0)
+    {
+        close(fd);
+        return;
+    }
+
+    void *p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    const int error = errno;
+    close(fd);
+    if (p == MAP_FAILED)
+    {
+        throw std::system_error(error, std::generic_category(), "Unable to map file");
+    }
+
+#if defined(MADV_SEQUENTIAL)
+    madvise(p, length, MADV_SEQUENTIAL);
+#endif
+
+    data = static_cast<const std::uint8_t *>(p);
+#endif
+}
+
+/*
+ *  MappedFile::~MappedFile()
+ *
+ *  Description:
+ *      Unmap the file.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+MappedFile::~MappedFile()
+{
+    if (data == nullptr) return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<std::uint8_t *>(data), length);
+#endif
+}
+
+/*
+ *  CoreFileNames()
+ *
+ *  Description:
+ *      Read the names of the mapped files recorded in an NT_FILE note.
+ *
+ *  Parameters:
+ *      image [in]
+ *          The core file.
+ *
+ *      offset [in]
+ *          The offset of the PT_NOTE segment.
+ *
+ *      length [in]
+ *          The length of the PT_NOTE segment.
+ *
+ *      regions [in/out]
+ *          The regions to name.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The segment bounds have been validated.  Malformed notes are ignored,
+ *      as the names are informational.
+ */
+void CoreFileNames(std::span<const std::uint8_t> image,
+                   std::uint64_t offset,
+                   std::uint64_t length,
+                   std::vector<LeakRegion> &regions)
+{
+    auto notes = image.subspan(static_cast<std::size_t>(offset),
+                               static_cast<std::size_t>(length));
+
+    while (notes.size() >= 12)
+    {
+        const std::uint64_t name_size = LoadLE32(notes.data());
+        const std::uint64_t descriptor_size = LoadLE32(notes.data() + 4);
+        const std::uint32_t type = LoadLE32(notes.data() + 8);
+        const std::uint64_t descriptor_offset = 12 + ((name_size + 3) & ~3ULL);
+        const std::uint64_t next =
+            descriptor_offset + ((descriptor_size + 3) & ~3ULL);
+
+        if (descriptor_offset + descriptor_size > notes.size()) return;
+
+        if (type == Elf_Note_File)
+        {
+            auto descriptor =
+                notes.subspan(static_cast<std::size_t>(descriptor_offset),
+                              static_cast<std::size_t>(descriptor_size));
+
+            if (descriptor.size() < 16) return;
+
+            const std::uint64_t count = LoadLE64(descriptor.data());
+            if (count > (descriptor.size() - 16) / 24) return;
+
+            auto names = descriptor.subspan(
+                16 + static_cast<std::size_t>(count) * 24);
+
+            for (std::uint64_t i = 0; i < count; i++)
+            {
+                const std::uint8_t *entry = descriptor.data() + 16 + i * 24;
+                const std::uint64_t start = LoadLE64(entry);
+                const std::uint64_t end = LoadLE64(entry + 8);
+
+                const auto terminator = std::find(names.begin(), names.end(), 0);
+                if (terminator == names.end()) return;
+
+                const std::string name(names.begin(), terminator);
+                names = names.subspan(
+                    static_cast<std::size_t>(terminator - names.begin()) + 1);
+
+                for (auto &region : regions)
+                {
+                    if ((region.start >= start) && (region.start < end))
+                    {
+                        region.name = name;
+                    }
+                }
+            }
+        }
+
+        if (next >= notes.size()) return;
+        notes = notes.subspan(static_cast<std::size_t>(next));
+    }
+}
+
+#if defined(__linux__)
+
+/*
+ *  ReadProcessMemory()
+ *
+ *  Description:
+ *      Read memory from a process.
+ *
+ *  Parameters:
+ *      fd [in]
+ *          The process's open /proc/<pid>/mem file.
+ *
+ *      buffer [out]
+ *          Where to place the octets read.
+ *
+ *      length [in]
+ *          The number of octets to read.
+ *
+ *      address [in]
+ *          The address from which to read.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::system_error if the memory cannot be read.
+ */
+void ReadProcessMemory(int fd,
+                       std::uint8_t *buffer,
+                       std::size_t length,
+                       std::uint64_t address)
+{
+    std::size_t total = 0;
+
+    while (total < length)
+    {
+        // The offset is treated as unsigned for this file
+        const ssize_t result = pread(fd,
+                                     buffer + total,
+                                     length - total,
+                                     static_cast<off_t>(address + total));
+
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            ThrowSystemError("Unable to read process memory");
+        }
+        if (result == 0)
+        {
+            throw std::system_error(std::make_error_code(std::errc::io_error),
+                                    "Unable to read process memory");
+        }
+
+        total += static_cast<std::size_t>(result);
+    }
+}
+
+/*
+ *  ProcessMappings()
+ *
+ *  Description:
+ *      Read the memory mappings of a process.
+ *
+ *  Parameters:
+ *      pid [in]
+ *          The process identifier.
+ *
+ *  Returns:
+ *      The mappings, in address order.
+ *
+ *  Comments:
+ *      Mappings that do not permit reading are marked as unreadable.  This
+ *      will throw std::system_error if the mappings cannot be read.
+ */
+std::vector<LeakRegion> ProcessMappings(int pid)
+{
+    std::vector<LeakRegion> regions;
+    std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+    std::string line;
+
+    if (!maps)
+    {
+        throw std::system_error(std::make_error_code(std::errc::no_such_process),
+                                "Unable to read process mappings");
+    }
+
+    // Each line is "start-end permissions offset device inode [name]"
+    while (std::getline(maps, line))
+    {
+        LeakRegion region{};
+        std::size_t position = 0;
+
+        try
+        {
+            region.start = std::stoull(line, &position, 16);
+            line.erase(0, position + 1);
+            region.end = std::stoull(line, &position, 16);
+        }
+        catch (const std::exception &)
+        {
+            continue;
+        }
+
+        std::size_t field = position;
+        for (std::size_t i = 0; i < 4; i++)
+        {
+            field = line.find_first_not_of(' ', field);
+            if (field == std::string::npos) break;
+
+            const std::size_t field_end = line.find(' ', field);
+            if (i == 0) region.permissions = line.substr(field, field_end - field);
+            field = field_end;
+        }
+        if (field != std::string::npos)
+        {
+            field = line.find_first_not_of(' ', field);
+            if (field != std::string::npos) region.name = line.substr(field);
+        }
+
+        region.readable = !region.permissions.empty() &&
+                          (region.permissions[0] == 'r') &&
+                          (region.end > region.start);
+
+        regions.push_back(std::move(region));
+    }
+
+    return regions;
+}
+
+#endif
+
+} // namespace
+
+/*
+ *  LeakScanner::AddPattern()
+ *
+ *  Description:
+ *      Add a pattern for which to search.
+ *
+ *  Parameters:
+ *      pattern [in]
+ *          The octets to find, typically a canary value planted in secure
+ *          storage.
+ *
+ *  Returns:
+ *      The index of the pattern, which is reported with each match.
+ *
+ *  Comments:
+ *      The caller should erase its own copy of the pattern before scanning.
+ *      This will throw std::invalid_argument if the pattern is shorter than
+ *      Min_Leak_Pattern octets.
+ */
+std::size_t LeakScanner::AddPattern(std::span<const std::uint8_t> pattern)
+{
+    if (pattern.size() < Min_Leak_Pattern)
+    {
+        throw std::invalid_argument("Leak pattern is too short");
+    }
+
+    std::vector<std::uint8_t> stored(pattern.size());
+    std::transform(pattern.begin(),
+                   pattern.end(),
+                   stored.begin(),
+                   [](std::uint8_t octet)
+                   { return static_cast<std::uint8_t>(~octet); });
+
+    const std::size_t index = inverted.size();
+    inverted.push_back(std::move(stored));
+
+    const std::uint8_t first = pattern.front();
+    const std::uint8_t last = pattern.back();
+
+    auto group = std::find_if(groups.begin(),
+                              groups.end(),
+                              [&](const Group &candidate)
+                              {
+                                  return (candidate.length == pattern.size()) &&
+                                         (candidate.first == first) &&
+                                         (candidate.last == last);
+                              });
+
+    if (group == groups.end())
+    {
+        groups.push_back({pattern.size(), first, last, {}});
+        group = groups.end() - 1;
+    }
+    group->patterns.push_back(index);
+
+    // Record the first two octets for searching large sets of patterns
+    const auto prefix = static_cast<std::uint16_t>(pattern[0] | (pattern[1] << 8));
+
+    if (prefix_filter.empty()) prefix_filter.resize(65536 / 64);
+    prefix_filter[prefix >> 6] |= std::uint64_t{1} << (prefix & 63);
+    prefix_patterns.insert(
+        std::upper_bound(prefix_patterns.begin(),
+                         prefix_patterns.end(),
+                         std::make_pair(prefix, index)),
+        {prefix, index});
+
+    longest = std::max(longest, pattern.size());
+
+    return index;
+}
+
+/*
+ *  LeakScanner::Scan()
+ *
+ *  Description:
+ *      Search a buffer for the patterns.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The octets to search.
+ *
+ *      address [in]
+ *          The address to report for the first octet of the buffer.
+ *
+ *  Returns:
+ *      The matches found, ordered by address and pattern.  The region of
+ *      each match is zero.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<LeakMatch> LeakScanner::Scan(std::span<const std::uint8_t> data,
+                                         std::uint64_t address) const
+{
+    std::vector<LeakMatch> matches;
+
+    Search(data, data.size(), 0, address, matches);
+
+    std::sort(matches.begin(),
+              matches.end(),
+              [](const LeakMatch &a, const LeakMatch &b)
+              {
+                  return (a.address != b.address) ? (a.address < b.address)
+                                                  : (a.pattern < b.pattern);
+              });
+
+    return matches;
+}
+
+/*
+ *  LeakScanner::ScanFile()
+ *
+ *  Description:
+ *      Search a file for the patterns.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to search, such as a swap file or raw memory dump.
+ *
+ *      threads [in]
+ *          The number of threads to use.  Zero selects the number of
+ *          hardware threads.
+ *
+ *  Returns:
+ *      The results of the scan.  The report holds a single region spanning
+ *      the file, and each match address is an offset into the file.
+ *
+ *  Comments:
+ *      This will throw std::system_error if the file cannot be read.
+ */
+LeakReport LeakScanner::ScanFile(const std::filesystem::path &path,
+                                 unsigned threads) const
+{
+    const auto start = std::chrono::steady_clock::now();
+    LeakReport report{};
+    const MappedFile file(path);
+    const auto image = file.Span();
+
+    report.regions.push_back({0, image.size(), "r", path.string(), 0, true});
+
+    const auto pieces = Divide(report.regions, {0});
+
+    SearchPieces(pieces,
+                 ThreadCount(threads, pieces.size()),
+                 [&](const Piece &piece, unsigned)
+                 {
+                     return image.subspan(
+                         static_cast<std::size_t>(piece.offset),
+                         static_cast<std::size_t>(piece.available));
+                 },
+                 report);
+
+    report.elapsed = std::chrono::steady_clock::now() - start;
+
+    return report;
+}
+
+/*
+ *  LeakScanner::ScanCoreFile()
+ *
+ *  Description:
+ *      Search the memory segments of a core file for the patterns.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The core file to search.
+ *
+ *      threads [in]
+ *          The number of threads to use.  Zero selects the number of
+ *          hardware threads.
+ *
+ *  Returns:
+ *      The results of the scan.  Each PT_LOAD segment is a region spanning
+ *      the part of the segment present in the file, named using the NT_FILE
+ *      note if present, and match addresses are virtual addresses in the
+ *      process that produced the core file.  Segments not present in the
+ *      file are reported as unreadable.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the file is not a 64-bit
+ *      little-endian ELF core file or std::system_error if the file cannot
+ *      be read.
+ */
+LeakReport LeakScanner::ScanCoreFile(const std::filesystem::path &path,
+                                     unsigned threads) const
+{
+    const auto start = std::chrono::steady_clock::now();
+    LeakReport report{};
+    std::vector<std::uint64_t> offsets;
+    const MappedFile file(path);
+    const auto image = file.Span();
+    const std::uint8_t *header = image.data();
+
+    if ((image.size() < Elf_Header_Size) ||
+        (std::memcmp(header, "\x7f" "ELF", 4) != 0) ||
+        (LoadLE16(header + 16) != Elf_Type_Core))
+    {
+        throw std::invalid_argument("Not an ELF core file");
+    }
+    if ((header[4] != 2) || (header[5] != 1))
+    {
+        throw std::invalid_argument("Unsupported ELF core file");
+    }
+
+    const std::uint64_t program_offset = LoadLE64(header + 32);
+    const std::uint64_t entry_size = LoadLE16(header + 54);
+    const std::uint64_t entry_count = LoadLE16(header + 56);
+
+    if ((entry_size < Elf_Program_Header_Size) ||
+        (program_offset > image.size()) ||
+        (entry_count > (image.size() - program_offset) / entry_size))
+    {
+        throw std::invalid_argument("Invalid ELF core file");
+    }
+
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> notes;
+
+    for (std::uint64_t i = 0; i < entry_count; i++)
+    {
+        const std::uint8_t *entry = header + program_offset + i * entry_size;
+        const std::uint32_t type = LoadLE32(entry);
+        const std::uint32_t flags = LoadLE32(entry + 4);
+        const std::uint64_t offset = LoadLE64(entry + 8);
+        const std::uint64_t address = LoadLE64(entry + 16);
+        const std::uint64_t file_size = LoadLE64(entry + 32);
+
+        if ((type != Elf_Segment_Load) && (type != Elf_Segment_Note)) continue;
+
+        if ((file_size > image.size()) || (offset > image.size() - file_size) ||
+            (address > std::numeric_limits<std::uint64_t>::max() - file_size))
+        {
+            throw std::invalid_argument("Invalid ELF core file");
+        }
+
+        if (type == Elf_Segment_Note)
+        {
+            notes.emplace_back(offset, file_size);
+            continue;
+        }
+
+        std::string permissions = "---";
+        if (flags & 4) permissions[0] = 'r';
+        if (flags & 2) permissions[1] = 'w';
+        if (flags & 1) permissions[2] = 'x';
+
+        report.regions.push_back({address,
+                                  address + file_size,
+                                  permissions,
+                                  {},
+                                  0,
+                                  file_size > 0});
+        offsets.push_back(offset);
+    }
+
+    for (const auto &[offset, length] : notes)
+    {
+        CoreFileNames(image, offset, length, report.regions);
+    }
+
+    const auto pieces = Divide(report.regions, offsets);
+
+    SearchPieces(pieces,
+                 ThreadCount(threads, pieces.size()),
+                 [&](const Piece &piece, unsigned)
+                 {
+                     return image.subspan(
+                         static_cast<std::size_t>(piece.offset),
+                         static_cast<std::size_t>(piece.available));
+                 },
+                 report);
+
+    report.elapsed = std::chrono::steady_clock::now() - start;
+
+    return report;
+}
+
+/*
+ *  LeakScanner::ScanProcess()
+ *
+ *  Description:
+ *      Search the memory of a running process for the patterns.
+ *
+ *  Parameters:
+ *      pid [in]
+ *          The process identifier, which may be that of the calling
+ *          process.
+ *
+ *      threads [in]
+ *          The number of threads to use.  Zero selects the number of
+ *          hardware threads.
+ *
+ *  Returns:
+ *      The results of the scan.  Each memory mapping is a region, and match
+ *      addresses are virtual addresses in the process.  Mappings that do not
+ *      permit reading, or that could not be read, are reported as
+ *      unreadable.
+ *
+ *  Comments:
+ *      The process is not stopped, so memory that changes during the scan
+ *      may or may not be examined.  This will throw std::system_error if the
+ *      process memory cannot be opened, including on platforms other than
+ *      Linux.
+ */
+LeakReport LeakScanner::ScanProcess([[maybe_unused]] int pid,
+                                    [[maybe_unused]] unsigned threads) const
+{
+#if defined(__linux__)
+    const auto start = std::chrono::steady_clock::now();
+    LeakReport report{};
+    const std::string memory = "/proc/" + std::to_string(pid) + "/mem";
+
+    const int fd = open(memory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) ThrowSystemError("Unable to open process memory");
+
+    try
+    {
+        report.regions = ProcessMappings(pid);
+
+        std::vector<std::uint64_t> offsets;
+        for (const auto &region : report.regions) offsets.push_back(region.start);
+
+        const auto pieces = Divide(report.regions, offsets);
+        threads = ThreadCount(threads, pieces.size());
+
+        std::vector<SecurePages> buffers;
+        for (unsigned i = 0; i < threads; i++)
+        {
+            buffers.emplace_back(
+                static_cast<std::size_t>(Scan_Piece_Size) + longest);
+        }
+
+        const bool scanning_self = (pid == getpid());
+
+        SearchPieces(
+            pieces,
+            threads,
+            [&](const Piece &piece, unsigned worker)
+            {
+                std::uint8_t *data = buffers[worker].data();
+                const auto length = static_cast<std::size_t>(piece.available);
+
+                ReadProcessMemory(fd, data, length, piece.address);
+
+                // Do not search copies made into the scanner's own buffers
+                if (scanning_self)
+                {
+                    const std::uint64_t end = piece.address + length;
+
+                    for (const auto &buffer : buffers)
+                    {
+                        const auto first = std::max(
+                            piece.address,
+                            reinterpret_cast<std::uint64_t>(buffer.data()));
+                        const auto last = std::min(
+                            end,
+                            reinterpret_cast<std::uint64_t>(buffer.data()) +
+                                buffer.size());
+
+                        if (first < last)
+                        {
+                            std::memset(data + (first - piece.address),
+                                        0,
+                                        static_cast<std::size_t>(last - first));
+                        }
+                    }
+                }
+
+                return std::span<const std::uint8_t>(data, length);
+            },
+            report);
+    }
+    catch (...)
+    {
+        close(fd);
+        throw;
+    }
+
+    close(fd);
+
+    report.elapsed = std::chrono::steady_clock::now() - start;
+
+    return report;
+#else
+    throw std::system_error(
+        std::make_error_code(std::errc::function_not_supported),
+        "Process memory scanning is not supported on this platform");
+#endif
+}
+
+/*
+ *  LeakScanner::Search()
+ *
+ *  Description:
+ *      Search a buffer for the patterns.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The octets to search.
+ *
+ *      positions [in]
+ *          The number of positions at which a match may start.  Matches
+ *          may extend beyond these positions to the end of the buffer.
+ *
+ *      region [in]
+ *          The region to report for each match.
+ *
+ *      address [in]
+ *          The address of the first octet of the buffer.
+ *
+ *      matches [in/out]
+ *          The list to which matches are appended.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      With few groups, the buffer is searched in blocks small enough to
+ *      remain in the cache while each group is searched in turn.
+ */
+void LeakScanner::Search(std::span<const std::uint8_t> data,
+                         std::size_t positions,
+                         std::size_t region,
+                         std::uint64_t address,
+                         std::vector<LeakMatch> &matches) const
+{
+    if (groups.size() > Max_Vector_Groups)
+    {
+        SearchPrefixes(data, positions, region, address, matches);
+        return;
+    }
+
+    for (std::size_t begin = 0; begin < positions; begin += Search_Block_Size)
+    {
+        const std::size_t end = std::min(positions, begin + Search_Block_Size);
+
+        for (const auto &group : groups)
+        {
+            SearchGroup(group, data, begin, end, region, address, matches);
+        }
+    }
+}
+
+/*
+ *  LeakScanner::SearchGroup()
+ *
+ *  Description:
+ *      Search part of a buffer for the patterns in a group.
+ *
+ *  Parameters:
+ *      group [in]
+ *          The group of patterns for which to search.
+ *
+ *      data [in]
+ *          The octets to search.
+ *
+ *      begin [in]
+ *          The first position at which a match may start.
+ *
+ *      end [in]
+ *          The position beyond the last at which a match may start.
+ *
+ *      region [in]
+ *          The region to report for each match.
+ *
+ *      address [in]
+ *          The address of the first octet of the buffer.
+ *
+ *      matches [in/out]
+ *          The list to which matches are appended.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The first and last octets are compared at 16 positions at a time,
+ *      and only candidates matching both are compared in full.
+ */
+void LeakScanner::SearchGroup(const Group &group,
+                              std::span<const std::uint8_t> data,
+                              std::size_t begin,
+                              std::size_t end,
+                              std::size_t region,
+                              std::uint64_t address,
+                              std::vector<LeakMatch> &matches) const
+{
+    if (data.size() < group.length) return;
+
+    const std::size_t limit = std::min(end, data.size() - group.length + 1);
+    const std::uint8_t *first = data.data();
+    const std::uint8_t *last = data.data() + group.length - 1;
+    std::size_t position = begin;
+
+    auto verify = [&](std::size_t candidate)
+    {
+        for (const std::size_t index : group.patterns)
+        {
+            if (Matches(data, candidate, index))
+            {
+                matches.push_back({index, region, address + candidate});
+            }
+        }
+    };
+
+#if defined(SECUTIL_LEAK_SCANNER_SSE2)
+    const __m128i first_octet = _mm_set1_epi8(static_cast<char>(group.first));
+    const __m128i last_octet = _mm_set1_epi8(static_cast<char>(group.last));
+
+    for (; position + 16 <= limit; position += 16)
+    {
+        const __m128i a = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(first + position));
+        const __m128i b = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(last + position));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, first_octet),
+                          _mm_cmpeq_epi8(b, last_octet))));
+
+        while (mask != 0)
+        {
+            verify(position + static_cast<std::size_t>(std::countr_zero(mask)));
+            mask &= mask - 1;
+        }
+    }
+#elif defined(SECUTIL_LEAK_SCANNER_NEON)
+    const uint8x16_t first_octet = vdupq_n_u8(group.first);
+    const uint8x16_t last_octet = vdupq_n_u8(group.last);
+
+    for (; position + 16 <= limit; position += 16)
+    {
+        const uint8x16_t equal =
+            vandq_u8(vceqq_u8(vld1q_u8(first + position), first_octet),
+                     vceqq_u8(vld1q_u8(last + position), last_octet));
+
+        // Narrow each octet of the comparison to four bits of the mask
+        std::uint64_t mask = vget_lane_u64(
+            vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)),
+            0);
+
+        while (mask != 0)
+        {
+            const auto bit = static_cast<std::size_t>(std::countr_zero(mask));
+            verify(position + bit / 4);
+            mask &= ~(std::uint64_t{0xf} << (bit & ~std::size_t{3}));
+        }
+    }
+#endif
+
+    for (; position < limit; position++)
+    {
+        if ((first[position] == group.first) && (last[position] == group.last))
+        {
+            verify(position);
+        }
+    }
+}
+
+/*
+ *  LeakScanner::SearchPrefixes()
+ *
+ *  Description:
+ *      Search a buffer for the patterns using the table of the first two
+ *      octets of each pattern.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The octets to search.
+ *
+ *      positions [in]
+ *          The number of positions at which a match may start.
+ *
+ *      region [in]
+ *          The region to report for each match.
+ *
+ *      address [in]
+ *          The address of the first octet of the buffer.
+ *
+ *      matches [in/out]
+ *          The list to which matches are appended.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The cost is independent of the number of patterns, apart from the
+ *      candidates that must be compared in full.
+ */
+void LeakScanner::SearchPrefixes(std::span<const std::uint8_t> data,
+                                 std::size_t positions,
+                                 std::size_t region,
+                                 std::uint64_t address,
+                                 std::vector<LeakMatch> &matches) const
+{
+    if (data.size() < Min_Leak_Pattern) return;
+
+    const std::size_t limit =
+        std::min(positions, data.size() - Min_Leak_Pattern + 1);
+    const std::uint64_t *filter = prefix_filter.data();
+
+    for (std::size_t position = 0; position < limit; position++)
+    {
+        const auto prefix = static_cast<std::uint16_t>(
+            data[position] | (data[position + 1] << 8));
+
+        if (!((filter[prefix >> 6] >> (prefix & 63)) & 1)) continue;
+
+        auto candidate = std::lower_bound(
+            prefix_patterns.begin(),
+            prefix_patterns.end(),
+            prefix,
+            [](const auto &entry, std::uint16_t value)
+            { return entry.first < value; });
+
+        for (; (candidate != prefix_patterns.end()) &&
+               (candidate->first == prefix);
+             candidate++)
+        {
+            if (Matches(data, position, candidate->second))
+            {
+                matches.push_back({candidate->second, region, address + position});
+            }
+        }
+    }
+}
+
+/*
+ *  LeakScanner::Matches()
+ *
+ *  Description:
+ *      Determine whether a pattern is found at the given position.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The octets searched.
+ *
+ *      position [in]
+ *          The position at which the pattern may start.
+ *
+ *      index [in]
+ *          The index of the pattern.
+ *
+ *  Returns:
+ *      True if the pattern is found at the position.
+ *
+ *  Comments:
+ *      The pattern is compared in inverted form so that no copy of it is
+ *      written to memory.
+ */
+bool LeakScanner::Matches(std::span<const std::uint8_t> data,
+                          std::size_t position,
+                          std::size_t index) const noexcept
+{
+    const auto &pattern = inverted[index];
+
+    if (data.size() - position < pattern.size()) return false;
+
+    for (std::size_t i = 0; i < pattern.size(); i++)
+    {
+        if (data[position + i] != static_cast<std::uint8_t>(~pattern[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ *  LeakScanner::Divide()
+ *
+ *  Description:
+ *      Divide the readable regions of an image into pieces.
+ *
+ *  Parameters:
+ *      regions [in]
+ *          The regions of the image.
+ *
+ *      offsets [in]
+ *          The location of each region within the image.
+ *
+ *  Returns:
+ *      The pieces to search.
+ *
+ *  Comments:
+ *      Each piece extends beyond its length by the length of the longest
+ *      pattern less one, or to the end of the region if nearer.
+ */
+std::vector<LeakScanner::Piece> LeakScanner::Divide(
+    const std::vector<LeakRegion> &regions,
+    const std::vector<std::uint64_t> &offsets) const
+{
+    std::vector<Piece> pieces;
+    const std::uint64_t overlap = (longest > 0) ? longest - 1 : 0;
+
+    for (std::size_t i = 0; i < regions.size(); i++)
+    {
+        if (!regions[i].readable) continue;
+
+        const std::uint64_t size = regions[i].end - regions[i].start;
+
+        for (std::uint64_t position = 0; position < size;
+             position += Scan_Piece_Size)
+        {
+            const std::uint64_t remaining = size - position;
+            const std::uint64_t length = std::min(remaining, Scan_Piece_Size);
+
+            pieces.push_back({i,
+                              offsets[i] + position,
+                              regions[i].start + position,
+                              length,
+                              std::min(remaining, length + overlap)});
+        }
+    }
+
+    return pieces;
+}
+
+/*
+ *  LeakScanner::SearchPieces()
+ *
+ *  Description:
+ *      Search the given pieces using several threads and record the results.
+ *
+ *  Parameters:
+ *      pieces [in]
+ *          The pieces to search.
+ *
+ *      threads [in]
+ *          The number of threads to use, including the calling thread.
+ *
+ *      fetch [in]
+ *          Produces the octets of a piece.  It may throw std::system_error
+ *          if the piece cannot be read, in which case its region is marked
+ *          as unreadable.
+ *
+ *      report [in/out]
+ *          The report, whose regions are already populated.  Matches and
+ *          counts are recorded here.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Matches are collected by each thread and merged when it finishes.
+ *      If any other error occurs, the remaining pieces are abandoned and the
+ *      first exception thrown is rethrown.
+ */
+void LeakScanner::SearchPieces(const std::vector<Piece> &pieces,
+                               unsigned threads,
+                               const Fetcher &fetch,
+                               LeakReport &report) const
+{
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex report_mutex;
+    std::exception_ptr error;
+
+    auto worker = [&](unsigned id)
+    {
+        std::vector<LeakMatch> matches;
+        std::uint64_t scanned = 0;
+
+        try
+        {
+            std::size_t index;
+
+            while (!failed.load(std::memory_order_relaxed) &&
+                   ((index = next.fetch_add(1, std::memory_order_relaxed)) <
+                    pieces.size()))
+            {
+                const Piece &piece = pieces[index];
+                std::span<const std::uint8_t> data;
+
+                try
+                {
+                    data = fetch(piece, id);
+                }
+                catch (const std::system_error &)
+                {
+                    std::lock_guard<std::mutex> lock(report_mutex);
+                    report.regions[piece.region].readable = false;
+                    continue;
+                }
+
+                Search(data,
+                       static_cast<std::size_t>(piece.length),
+                       piece.region,
+                       piece.address,
+                       matches);
+                scanned += piece.length;
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(report_mutex);
+            if (!error) error = std::current_exception();
+            failed.store(true, std::memory_order_relaxed);
+        }
+
+        std::lock_guard<std::mutex> lock(report_mutex);
+        report.bytes_scanned += scanned;
+        try
+        {
+            report.matches.insert(report.matches.end(),
+                                  matches.begin(),
+                                  matches.end());
+        }
+        catch (...)
+        {
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+
+    try
+    {
+        for (unsigned i = 1; i < threads; i++) workers.emplace_back(worker, i);
+    }
+    catch (...)
+    {
+        // Continue with the threads that were started
+    }
+
+    worker(0);
+    for (auto &thread : workers) thread.join();
+
+    if (error) std::rethrow_exception(error);
+
+    std::sort(report.matches.begin(),
+              report.matches.end(),
+              [](const LeakMatch &a, const LeakMatch &b)
+              {
+                  if (a.region != b.region) return a.region < b.region;
+                  if (a.address != b.address) return a.address < b.address;
+                  return a.pattern < b.pattern;
+              });
+
+    for (const auto &match : report.matches) report.regions[match.region].matches++;
+}
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,724 @@
+/*
+ *  masked_secret.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the MaskedSecret object.  The process-wide pad
+ *      is created on first use in locked memory and filled with random
+ *      octets.  Masking and unmasking are the same operation (XOR with the
+ *      pad starting at a per-secret offset), performed 16 octets at a time
+ *      using SSE2 on x86 and NEON on ARM.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SECUTIL_MASKED_SECRET_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SECUTIL_MASKED_SECRET_NEON
+#endif
+#include <terra/secutil/masked_secret.h>
+#include <terra/secutil/secure_erase.h>
+#include <terra/secutil/secure_pages.h>
+#include <terra/secutil/secure_random.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Length of the process-wide pad (must be a power of two)
+constexpr std::size_t Pad_Size = 4096;
+
+/*
+ *  Pad()
+ *
+ *  Description:
+ *      Return the process-wide pad, creating it on first use.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The pages holding the Pad_Size octets of the pad.
+ *
+ *  Comments:
+ *      If the pad cannot be locked (e.g., because the locked memory limit
+ *      has been reached), the pad is still used, but may be written to swap;
+ *      MaskedSecret::IsPadLocked() reports whether this is the case.  This
+ *      will throw std::system_error if the pad cannot be created.
+ */
+const SecurePages &Pad()
+{
+    static const SecurePages pad = []()
+    {
+        SecurePages pages(Pad_Size);
+
+        // Failure is reported through MaskedSecret::IsPadLocked()
+        static_cast<void>(pages.Lock());
+        SecureRandom(pages.data(), pages.size());
+
+        return pages;
+    }();
+
+    return pad;
+}
+
+/*
+ *  MaskPad()
+ *
+ *  Description:
+ *      Return the process-wide pad, creating it on first use.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A pointer to the Pad_Size octets of the pad.
+ *
+ *  Comments:
+ *      This will throw std::system_error if the pad cannot be created.
+ */
+const std::uint8_t *MaskPad()
+{
+    return Pad().data();
+}
+
+/*
+ *  RandomOffset()
+ *
+ *  Description:
+ *      Select a random offset into the pad.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      An offset in the range [0, Pad_Size).
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t RandomOffset()
+{
+    std::uint16_t value;
+
+    SecureRandom(&value, sizeof(value));
+
+    return value & (Pad_Size - 1);
+}
+
+/*
+ *  XorBlock()
+ *
+ *  Description:
+ *      Compute destination[i] = source[i] ^ pad[i] for each octet.
+ *
+ *  Parameters:
+ *      destination [out]
+ *          The destination buffer, which may be the same as source.
+ *
+ *      source [in]
+ *          The source buffer.
+ *
+ *      pad [in]
+ *          The pad octets.
+ *
+ *      length [in]
+ *          Number of octets to process.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void XorBlock(std::uint8_t *destination,
+              const std::uint8_t *source,
+              const std::uint8_t *pad,
+              std::size_t length) noexcept
+{
+#if defined(SECUTIL_MASKED_SECRET_SSE2)
+    for (; length >= 64; length -= 64, destination += 64, source += 64, pad += 64)
+    {
+        for (std::size_t i = 0; i < 64; i += 16)
+        {
+            const __m128i a =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+            const __m128i b =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(pad + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i),
+                             _mm_xor_si128(a, b));
+        }
+    }
+
+    for (; length >= 16; length -= 16, destination += 16, source += 16, pad += 16)
+    {
+        const __m128i a =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pad));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination),
+                         _mm_xor_si128(a, b));
+    }
+#elif defined(SECUTIL_MASKED_SECRET_NEON)
+    for (; length >= 16; length -= 16, destination += 16, source += 16, pad += 16)
+    {
+        vst1q_u8(destination, veorq_u8(vld1q_u8(source), vld1q_u8(pad)));
+    }
+#endif
+
+    for (; length >= 8; length -= 8, destination += 8, source += 8, pad += 8)
+    {
+        std::uint64_t a;
+        std::uint64_t b;
+
+        std::memcpy(&a, source, sizeof(a));
+        std::memcpy(&b, pad, sizeof(b));
+        a ^= b;
+        std::memcpy(destination, &a, sizeof(a));
+    }
+
+    for (; length > 0; length--) *destination++ = *source++ ^ *pad++;
+}
+
+/*
+ *  ApplyPad()
+ *
+ *  Description:
+ *      XOR the given buffer with the pad, starting at the given pad offset
+ *      and wrapping around to the start of the pad as needed.
+ *
+ *  Parameters:
+ *      destination [out]
+ *          The destination buffer, which may be the same as source.
+ *
+ *      source [in]
+ *          The source buffer.
+ *
+ *      length [in]
+ *          Number of octets to process.
+ *
+ *      offset [in]
+ *          Offset into the pad of the octet applied to source[0].
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Since XOR is its own inverse, this both masks and unmasks.
+ */
+void ApplyPad(std::uint8_t *destination,
+              const std::uint8_t *source,
+              std::size_t length,
+              std::size_t offset)
+{
+    const std::uint8_t *pad = MaskPad();
+
+    while (length > 0)
+    {
+        const std::size_t chunk = std::min(length, Pad_Size - offset);
+
+        XorBlock(destination, source, pad + offset, chunk);
+
+        destination += chunk;
+        source += chunk;
+        length -= chunk;
+        offset = 0;
+    }
+}
+
+/*
+ *  Remask()
+ *
+ *  Description:
+ *      Change the pad offset of the masked buffer in place without exposing
+ *      the plaintext, by applying the old and new pad regions together.
+ *
+ *  Parameters:
+ *      buffer [in/out]
+ *          The buffer to remask.
+ *
+ *      length [in]
+ *          Number of octets in the buffer.
+ *
+ *      old_offset [in]
+ *          The offset with which the buffer is presently masked.
+ *
+ *      new_offset [in]
+ *          The offset with which the buffer is to be masked.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The pad must already exist, as this function may not throw.
+ */
+void Remask(std::uint8_t *buffer,
+            std::size_t length,
+            std::size_t old_offset,
+            std::size_t new_offset) noexcept
+{
+    if (length == 0) return;
+
+    const std::uint8_t *pad = MaskPad();
+
+    // Apply both pad regions to each octet in a single pass
+    for (std::size_t i = 0; i < length; i++)
+    {
+        buffer[i] ^= pad[(old_offset + i) & (Pad_Size - 1)] ^
+                     pad[(new_offset + i) & (Pad_Size - 1)];
+    }
+}
+
+} // namespace
+
+/*
+ *  MaskedSecret::View::View()
+ *
+ *  Description:
+ *      Constructor for the view, called by MaskedSecret::Unmask() after the
+ *      secret has been unmasked in place.
+ *
+ *  Parameters:
+ *      state [in]
+ *          The state of the secret being viewed, which remains in place if
+ *          the MaskedSecret is moved.
+ *
+ *      next_offset [in]
+ *          The pad offset to use when the secret is remasked.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+MaskedSecret::View::View(State *state, std::size_t next_offset) noexcept :
+    state{state},
+    next_offset{next_offset}
+{
+}
+
+/*
+ *  MaskedSecret::View::View()
+ *
+ *  Description:
+ *      Move constructor for the view.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The view from which responsibility for remasking is taken.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+MaskedSecret::View::View(View &&other) noexcept :
+    state{std::exchange(other.state, nullptr)},
+    next_offset{other.next_offset}
+{
+}
+
+/*
+ *  MaskedSecret::View::~View()
+ *
+ *  Description:
+ *      Remask the secret in place using a new pad offset.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Any changes made to the secret through the view are retained.
+ */
+MaskedSecret::View::~View()
+{
+    if (state == nullptr) return;
+
+    ApplyPad(state->masked.data(),
+             state->masked.data(),
+             state->masked.size(),
+             next_offset);
+    state->offset = next_offset;
+    state->unmasked = false;
+}
+
+/*
+ *  MaskedSecret::View::data()
+ *
+ *  Description:
+ *      Return a pointer to the unmasked secret.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A pointer to the secret, or nullptr if the view was moved.
+ *
+ *  Comments:
+ *      The secret may be modified through the returned pointer.
+ */
+std::uint8_t *MaskedSecret::View::data() noexcept
+{
+    return (state != nullptr) ? state->masked.data() : nullptr;
+}
+
+/*
+ *  MaskedSecret::View::size()
+ *
+ *  Description:
+ *      Return the length of the unmasked secret.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The length of the secret in octets, or zero if the view was moved.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MaskedSecret::View::size() const noexcept
+{
+    return (state != nullptr) ? state->masked.size() : 0;
+}
+
+/*
+ *  MaskedSecret::MaskedSecret()
+ *
+ *  Description:
+ *      Default constructor, which creates an empty secret.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      No state is allocated until a secret is assigned or unmasked.
+ */
+MaskedSecret::MaskedSecret() noexcept
+{
+}
+
+/*
+ *  MaskedSecret::MaskedSecret()
+ *
+ *  Description:
+ *      Construct a masked copy of the given secret.
+ *
+ *  Parameters:
+ *      secret [in]
+ *          The secret to store.  The caller remains responsible for erasing
+ *          the original.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+MaskedSecret::MaskedSecret(std::span<const std::uint8_t> secret) :
+    MaskedSecret()
+{
+    Assign(secret);
+}
+
+/*
+ *  MaskedSecret::MaskedSecret()
+ *
+ *  Description:
+ *      Copy constructor.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The secret to copy, which must not be unmasked.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::logic_error if the other secret is unmasked.
+ */
+MaskedSecret::MaskedSecret(const MaskedSecret &other) : MaskedSecret()
+{
+    *this = other;
+}
+
+/*
+ *  MaskedSecret::MaskedSecret()
+ *
+ *  Description:
+ *      Move constructor.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The secret to move.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The other secret is left empty.  If the other secret is unmasked, its
+ *      view now refers to this secret.
+ */
+MaskedSecret::MaskedSecret(MaskedSecret &&other) noexcept :
+    state{std::move(other.state)}
+{
+}
+
+/*
+ *  MaskedSecret::operator=()
+ *
+ *  Description:
+ *      Copy assignment operator.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The secret to copy.  Neither secret may be unmasked.
+ *
+ *  Returns:
+ *      A reference to this object.
+ *
+ *  Comments:
+ *      This will throw std::logic_error if either secret is unmasked.
+ */
+MaskedSecret &MaskedSecret::operator=(const MaskedSecret &other)
+{
+    if (this == &other) return *this;
+
+    if (IsUnmasked() || other.IsUnmasked())
+    {
+        throw std::logic_error("Cannot copy an unmasked secret");
+    }
+
+    if (!other.state)
+    {
+        Clear();
+        return *this;
+    }
+
+    // The copy is remasked so the two do not share a masked representation
+    auto copy = std::make_unique<State>();
+
+    copy->masked = other.state->masked;
+    copy->offset = RandomOffset();
+    Remask(copy->masked.data(),
+           copy->masked.size(),
+           other.state->offset,
+           copy->offset);
+
+    state = std::move(copy);
+
+    return *this;
+}
+
+/*
+ *  MaskedSecret::operator=()
+ *
+ *  Description:
+ *      Move assignment operator.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The secret to move.  This secret must not be unmasked.
+ *
+ *  Returns:
+ *      A reference to this object.
+ *
+ *  Comments:
+ *      The other secret is left empty.  If the other secret is unmasked, its
+ *      view now refers to this secret.  Assigning to a secret that is
+ *      unmasked would leave its view referring to released memory, so this
+ *      calls std::terminate().
+ */
+MaskedSecret &MaskedSecret::operator=(MaskedSecret &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (IsUnmasked()) std::terminate();
+
+        state = std::move(other.state);
+    }
+
+    return *this;
+}
+
+/*
+ *  MaskedSecret::Assign()
+ *
+ *  Description:
+ *      Replace the stored secret with a masked copy of the given secret.
+ *
+ *  Parameters:
+ *      secret [in]
+ *          The secret to store.  The caller remains responsible for erasing
+ *          the original.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The plaintext is masked as it is copied, so it never exists in the
+ *      object's storage.  This will throw std::logic_error if the secret is
+ *      presently unmasked.
+ */
+void MaskedSecret::Assign(std::span<const std::uint8_t> secret)
+{
+    if (IsUnmasked()) throw std::logic_error("Cannot assign an unmasked secret");
+
+    if (!state) state = std::make_unique<State>();
+
+    const std::size_t new_offset = RandomOffset();
+
+    // Resizing would leave unmasked plaintext in freed memory, so allocate
+    SecureVector<std::uint8_t> buffer(secret.size());
+    ApplyPad(buffer.data(), secret.data(), secret.size(), new_offset);
+
+    state->masked = std::move(buffer);
+    state->offset = new_offset;
+}
+
+/*
+ *  MaskedSecret::Clear()
+ *
+ *  Description:
+ *      Erase the stored secret, leaving this object empty.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void MaskedSecret::Clear() noexcept
+{
+    if (!state) return;
+
+    SecureErase(state->masked.data(), state->masked.size());
+    state->masked.clear();
+}
+
+/*
+ *  MaskedSecret::Unmask()
+ *
+ *  Description:
+ *      Unmask the secret in place, returning a view through which it may be
+ *      accessed.  The secret is remasked when the view is destroyed.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A view of the unmasked secret.
+ *
+ *  Comments:
+ *      This will throw std::logic_error if the secret is already unmasked.
+ *      The MaskedSecret may be moved while the view exists, but must not be
+ *      copied or assigned to.
+ */
+MaskedSecret::View MaskedSecret::Unmask()
+{
+    if (IsUnmasked()) throw std::logic_error("Secret is already unmasked");
+
+    if (!state) state = std::make_unique<State>();
+
+    // Select the next offset now, since the view's destructor cannot throw
+    const std::size_t next_offset = RandomOffset();
+
+    ApplyPad(state->masked.data(),
+             state->masked.data(),
+             state->masked.size(),
+             state->offset);
+    state->unmasked = true;
+
+    return View(state.get(), next_offset);
+}
+
+/*
+ *  MaskedSecret::UnmaskTo()
+ *
+ *  Description:
+ *      Write the unmasked secret into the given buffer, leaving the stored
+ *      secret masked.
+ *
+ *  Parameters:
+ *      destination [out]
+ *          The buffer into which the secret is written, which must be
+ *          exactly size() octets in length.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the buffer length differs
+ *      from the secret length, or std::logic_error if the secret is
+ *      presently unmasked.  The caller is responsible for erasing the
+ *      destination buffer.
+ */
+void MaskedSecret::UnmaskTo(std::span<std::uint8_t> destination) const
+{
+    if (destination.size() != size())
+    {
+        throw std::invalid_argument("Destination length differs from secret");
+    }
+
+    if (IsUnmasked()) throw std::logic_error("Secret is already unmasked");
+
+    if (!state) return;
+
+    ApplyPad(destination.data(),
+             state->masked.data(),
+             state->masked.size(),
+             state->offset);
+}
+
+/*
+ *  MaskedSecret::IsPadLocked()
+ *
+ *  Description:
+ *      Determine whether the process-wide pad is held in locked memory.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if the pad is locked, false if the operating system refused to
+ *      lock it, in which case the pad may be written to swap.
+ *
+ *  Comments:
+ *      The pad is created if it does not yet exist.  This will throw
+ *      std::system_error if the pad cannot be created.
+ */
+bool MaskedSecret::IsPadLocked()
+{
+    return Pad().IsLocked();
+}
+
+} // namespace Terra::SecUtil
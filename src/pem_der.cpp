@@ -0,0 +1,706 @@
+/*
+ *  pem_der.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the PemDecoder and DerReader objects and the
+ *      related functions to decode PEM text and files.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <terra/secutil/pem_der.h>
+#include <terra/secutil/secure_encoding.h>
+#include <terra/secutil/secure_erase.h>
+#include <terra/secutil/secure_file.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Encapsulation boundaries (RFC 7468)
+constexpr std::string_view Begin_Prefix = "-----BEGIN ";
+constexpr std::string_view End_Prefix = "-----END ";
+constexpr std::string_view Boundary_Suffix = "-----";
+
+/*
+ *  TrimLine()
+ *
+ *  Description:
+ *      Remove trailing whitespace, including any carriage return, from the
+ *      given line.
+ *
+ *  Parameters:
+ *      line [in]
+ *          The line to trim.
+ *
+ *  Returns:
+ *      The trimmed line.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string_view TrimLine(std::string_view line) noexcept
+{
+    while (!line.empty() &&
+           ((line.back() == ' ') || (line.back() == '\t') ||
+            (line.back() == '\r')))
+    {
+        line.remove_suffix(1);
+    }
+
+    return line;
+}
+
+/*
+ *  BoundaryLabel()
+ *
+ *  Description:
+ *      Determine whether the line is an encapsulation boundary with the
+ *      given prefix and, if so, extract the label.
+ *
+ *  Parameters:
+ *      line [in]
+ *          The line to examine.
+ *
+ *      prefix [in]
+ *          The boundary prefix (i.e., "-----BEGIN " or "-----END ").
+ *
+ *      label [out]
+ *          The label, if the line is a boundary.
+ *
+ *  Returns:
+ *      True if the line is a boundary, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool BoundaryLabel(std::string_view line,
+                   std::string_view prefix,
+                   std::string_view &label) noexcept
+{
+    if ((line.size() < prefix.size() + Boundary_Suffix.size()) ||
+        !line.starts_with(prefix) || !line.ends_with(Boundary_Suffix))
+    {
+        return false;
+    }
+
+    label = line.substr(prefix.size(),
+                        line.size() - prefix.size() - Boundary_Suffix.size());
+
+    return true;
+}
+
+/*
+ *  CollectBlocks()
+ *
+ *  Description:
+ *      Finish decoding and return all decoded blocks.
+ *
+ *  Parameters:
+ *      decoder [in/out]
+ *          The decoder from which blocks are taken.
+ *
+ *  Returns:
+ *      The decoded blocks.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<PemBlock> CollectBlocks(PemDecoder &decoder)
+{
+    std::vector<PemBlock> blocks;
+
+    decoder.Finish();
+
+    blocks.reserve(decoder.Available());
+    while (auto block = decoder.Next()) blocks.push_back(std::move(*block));
+
+    return blocks;
+}
+
+} // namespace
+
+/*
+ *  PemDecoder::PemDecoder()
+ *
+ *  Description:
+ *      Constructor for the PemDecoder object.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+PemDecoder::PemDecoder() :
+    in_block{false},
+    padded{false},
+    staging{},
+    staged{0}
+{
+}
+
+/*
+ *  PemDecoder::Update()
+ *
+ *  Description:
+ *      Decode the next portion of PEM text.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The next portion of text, which may begin or end anywhere
+ *          (including within a line).
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Text outside of encapsulation boundaries is ignored.  This will throw
+ *      std::invalid_argument if the text is malformed, in which case the
+ *      decoder is reset and any partially decoded block is erased.
+ */
+void PemDecoder::Update(std::string_view text)
+{
+    try
+    {
+        while (!text.empty())
+        {
+            const std::size_t end = text.find('\n');
+
+            // Retain a partial line until the remainder arrives
+            if (end == std::string_view::npos)
+            {
+                if (pending.size() + text.size() > Max_Line_Length)
+                {
+                    throw std::invalid_argument("PEM line is too long");
+                }
+                pending.append(text);
+                break;
+            }
+
+            if (pending.empty())
+            {
+                ProcessLine(text.substr(0, end));
+            }
+            else
+            {
+                pending.append(text.substr(0, end));
+                ProcessLine(pending);
+                SecureErase(pending.data(), pending.size());
+                pending.clear();
+            }
+
+            text.remove_prefix(end + 1);
+        }
+    }
+    catch (...)
+    {
+        Reset();
+        throw;
+    }
+}
+
+/*
+ *  PemDecoder::Consume()
+ *
+ *  Description:
+ *      Decode the next portion of PEM text and then erase it.
+ *
+ *  Parameters:
+ *      text [in/out]
+ *          The next portion of text, which is erased once decoded.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The text is erased even if an exception is thrown.
+ */
+void PemDecoder::Consume(std::span<char> text)
+{
+    try
+    {
+        Update({text.data(), text.size()});
+    }
+    catch (...)
+    {
+        SecureErase(text.data(), text.size());
+        throw;
+    }
+
+    SecureErase(text.data(), text.size());
+}
+
+/*
+ *  PemDecoder::Finish()
+ *
+ *  Description:
+ *      Complete decoding, processing any final line that lacks a line
+ *      terminator.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text ended within a
+ *      block, in which case the partially decoded block is erased.
+ */
+void PemDecoder::Finish()
+{
+    try
+    {
+        if (!pending.empty())
+        {
+            ProcessLine(pending);
+            SecureErase(pending.data(), pending.size());
+            pending.clear();
+        }
+
+        if (in_block) throw std::invalid_argument("PEM block is truncated");
+    }
+    catch (...)
+    {
+        Reset();
+        throw;
+    }
+}
+
+/*
+ *  PemDecoder::Next()
+ *
+ *  Description:
+ *      Take the next decoded block.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The next block, or no value if no complete block is available.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<PemBlock> PemDecoder::Next()
+{
+    if (blocks.empty()) return std::nullopt;
+
+    PemBlock block = std::move(blocks.front());
+    blocks.pop_front();
+
+    return block;
+}
+
+/*
+ *  PemDecoder::ProcessLine()
+ *
+ *  Description:
+ *      Process one complete line of PEM text.
+ *
+ *  Parameters:
+ *      line [in]
+ *          The line, excluding the line feed.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void PemDecoder::ProcessLine(std::string_view line)
+{
+    std::string_view boundary_label;
+
+    line = TrimLine(line);
+
+    if (!in_block)
+    {
+        if (BoundaryLabel(line, Begin_Prefix, boundary_label))
+        {
+            label = boundary_label;
+            in_block = true;
+            padded = false;
+        }
+        return;
+    }
+
+    if (BoundaryLabel(line, End_Prefix, boundary_label))
+    {
+        if (boundary_label != label)
+        {
+            throw std::invalid_argument("PEM end label does not match");
+        }
+
+        Flush(true);
+        blocks.push_back({std::move(label), std::move(data)});
+        label.clear();
+        data = {};
+        in_block = false;
+        return;
+    }
+
+    // Legacy encapsulated headers (e.g., Proc-Type) are not supported
+    if (line.find(':') != std::string_view::npos)
+    {
+        throw std::invalid_argument("PEM headers are not supported");
+    }
+
+    Stage(line);
+}
+
+/*
+ *  PemDecoder::Stage()
+ *
+ *  Description:
+ *      Append the base64 characters in the given line to the staging buffer,
+ *      decoding the buffer each time it fills.
+ *
+ *  Parameters:
+ *      line [in]
+ *          A line from the body of a block.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Whitespace within the line is ignored.
+ */
+void PemDecoder::Stage(std::string_view line)
+{
+    for (const char c : line)
+    {
+        if ((c == ' ') || (c == '\t')) continue;
+
+        staging[staged++] = c;
+        if (staged == Staging_Size) Flush(false);
+    }
+}
+
+/*
+ *  PemDecoder::Flush()
+ *
+ *  Description:
+ *      Decode the staged base64 text, appending to the block data.
+ *
+ *  Parameters:
+ *      final [in]
+ *          True if this is the end of the block, in which case all staged
+ *          text is decoded; otherwise, any trailing partial quantum of fewer
+ *          than four characters is retained.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text is not valid
+ *      base64 or if data follows padding.
+ */
+void PemDecoder::Flush(bool final)
+{
+    const std::size_t length = final ? staged : staged - (staged % 4);
+
+    if (length == 0) return;
+
+    if (padded)
+    {
+        throw std::invalid_argument("PEM data follows base64 padding");
+    }
+
+    const std::string_view text(staging.data(), length);
+    const std::size_t offset = data.size();
+
+    // Any storage released as the data grows is erased by SecureAllocator
+    data.resize(offset + Base64DecodedLength(text));
+    Base64Decode(text, std::span<std::uint8_t>(data).subspan(offset));
+    padded = (text.back() == '=');
+
+    // Move the partial quantum to the front and erase the rest
+    std::memmove(staging.data(), staging.data() + length, staged - length);
+    SecureErase(staging.data() + (staged - length), length);
+    staged -= length;
+}
+
+/*
+ *  PemDecoder::Reset()
+ *
+ *  Description:
+ *      Discard all state, erasing any partially decoded data.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Blocks already decoded remain available.
+ */
+void PemDecoder::Reset() noexcept
+{
+    SecureErase(pending.data(), pending.size());
+    pending.clear();
+    SecureErase(staging.data(), staging.size());
+    staged = 0;
+    SecureErase(data.data(), data.size());
+    data.clear();
+    label.clear();
+    in_block = false;
+    padded = false;
+}
+
+/*
+ *  DecodePem()
+ *
+ *  Description:
+ *      Decode all PEM blocks in the given text.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The PEM text to decode.
+ *
+ *  Returns:
+ *      The decoded blocks in the order in which they appear.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text is malformed.
+ */
+std::vector<PemBlock> DecodePem(std::string_view text)
+{
+    PemDecoder decoder;
+
+    decoder.Update(text);
+
+    return CollectBlocks(decoder);
+}
+
+/*
+ *  LoadPemFile()
+ *
+ *  Description:
+ *      Read and decode all PEM blocks in the given file.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to read.
+ *
+ *  Returns:
+ *      The decoded blocks in the order in which they appear.
+ *
+ *  Comments:
+ *      The SecureFileReader erases each chunk as the next is read.  This
+ *      will throw std::system_error if the file cannot be read or
+ *      std::invalid_argument if the contents are malformed.
+ */
+std::vector<PemBlock> LoadPemFile(const std::filesystem::path &path)
+{
+    SecureFileReader reader(path);
+    PemDecoder decoder;
+
+    for (auto chunk = reader.Next(); !chunk.empty(); chunk = reader.Next())
+    {
+        decoder.Update({reinterpret_cast<const char *>(chunk.data()),
+                        chunk.size()});
+    }
+
+    return CollectBlocks(decoder);
+}
+
+/*
+ *  DerReader::Peek()
+ *
+ *  Description:
+ *      Return the next element without advancing.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The next element.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the element is malformed.
+ */
+DerElement DerReader::Peek() const
+{
+    std::size_t offset = position;
+
+    return Parse(offset);
+}
+
+/*
+ *  DerReader::Next()
+ *
+ *  Description:
+ *      Return the next element and advance past it.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The next element.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the element is malformed,
+ *      in which case the read position is unchanged.
+ */
+DerElement DerReader::Next()
+{
+    return Parse(position);
+}
+
+/*
+ *  DerReader::Next()
+ *
+ *  Description:
+ *      Return the next element, which must have the given tag, and advance
+ *      past it.
+ *
+ *  Parameters:
+ *      tag [in]
+ *          The expected tag.
+ *
+ *  Returns:
+ *      The next element.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the element is malformed or
+ *      has a different tag, in which case the read position is unchanged.
+ */
+DerElement DerReader::Next(std::uint8_t tag)
+{
+    std::size_t offset = position;
+    const DerElement element = Parse(offset);
+
+    if (element.tag != tag)
+    {
+        throw std::invalid_argument("Unexpected DER tag");
+    }
+
+    position = offset;
+
+    return element;
+}
+
+/*
+ *  DerReader::Enter()
+ *
+ *  Description:
+ *      Advance past the next element, which must be a constructed element
+ *      (e.g., a SEQUENCE) with the given tag, and return a reader over its
+ *      contents.
+ *
+ *  Parameters:
+ *      tag [in]
+ *          The expected tag.
+ *
+ *  Returns:
+ *      A reader over the contents of the element.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the element is malformed,
+ *      has a different tag, or is not constructed.
+ */
+DerReader DerReader::Enter(std::uint8_t tag)
+{
+    if ((tag & 0x20) == 0)
+    {
+        throw std::invalid_argument("DER tag is not constructed");
+    }
+
+    return DerReader(Next(tag).value);
+}
+
+/*
+ *  DerReader::Parse()
+ *
+ *  Description:
+ *      Parse the element at the given offset.
+ *
+ *  Parameters:
+ *      offset [in/out]
+ *          The offset of the element, which is advanced past the element
+ *          only if it is parsed successfully.
+ *
+ *  Returns:
+ *      The element.
+ *
+ *  Comments:
+ *      Only the low tag number form and definite, minimally encoded lengths
+ *      are accepted, as required by DER.  This will throw
+ *      std::invalid_argument if the element is malformed.
+ */
+DerElement DerReader::Parse(std::size_t &offset) const
+{
+    std::size_t next = offset;
+
+    if (input.size() - next < 2)
+    {
+        throw std::invalid_argument("DER element is truncated");
+    }
+
+    const std::uint8_t tag = input[next++];
+    if ((tag & 0x1f) == 0x1f)
+    {
+        throw std::invalid_argument("DER high tag numbers are not supported");
+    }
+
+    std::size_t length = input[next++];
+    if (length & 0x80)
+    {
+        const std::size_t count = length & 0x7f;
+
+        if (count == 0)
+        {
+            throw std::invalid_argument("DER does not permit indefinite length");
+        }
+        if ((count > sizeof(std::size_t)) || (input.size() - next < count))
+        {
+            throw std::invalid_argument("DER element is truncated");
+        }
+        if (input[next] == 0)
+        {
+            throw std::invalid_argument("DER length is not minimally encoded");
+        }
+
+        length = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            length = (length << 8) | input[next++];
+        }
+
+        if (length < 0x80)
+        {
+            throw std::invalid_argument("DER length is not minimally encoded");
+        }
+    }
+
+    if (input.size() - next < length)
+    {
+        throw std::invalid_argument("DER element is truncated");
+    }
+
+    const DerElement element{tag, input.subspan(next, length)};
+    offset = next + length;
+
+    return element;
+}
+
+} // namespace Terra::SecUtil
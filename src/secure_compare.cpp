@@ -0,0 +1,167 @@
+/*
+ *  secure_compare.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module contains code that will compare memory in constant time.
+ *      The differences between the two buffers are accumulated using
+ *      exclusive-or and inclusive-or operations without any data-dependent
+ *      branches.  Where SIMD instructions are available (SSE2 on x86 and
+ *      NEON on ARM), 64 octets are processed per iteration using four vector
+ *      accumulators so that long buffers are compared at memory bandwidth.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SECUTIL_COMPARE_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SECUTIL_COMPARE_NEON
+#endif
+#include <terra/secutil/secure_compare.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+/*
+ *  Load64()
+ *
+ *  Description:
+ *      Load a 64-bit word from a potentially unaligned memory location.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to the memory from which to load the word.
+ *
+ *  Returns:
+ *      The 64-bit word.
+ *
+ *  Comments:
+ *      The compiler will reduce the memcpy() call to a single load.
+ */
+inline std::uint64_t Load64(const std::uint8_t *p) noexcept
+{
+    std::uint64_t value;
+
+    std::memcpy(&value, p, sizeof(value));
+
+    return value;
+}
+
+} // namespace
+
+/*
+ *  SecureCompare()
+ *
+ *  Description:
+ *      This function will compare two blocks of memory in constant time.
+ *
+ *  Parameters:
+ *      buffer1 [in]
+ *          Pointer to the first buffer to compare.
+ *
+ *      buffer2 [in]
+ *          Pointer to the second buffer to compare.
+ *
+ *      length [in]
+ *          Number of octets to compare.
+ *
+ *  Returns:
+ *      True if the buffers contain the same octets, false otherwise.
+ *
+ *  Comments:
+ *      The time taken depends only on the length, not on the content.
+ */
+bool SecureCompare(const void *buffer1,
+                   const void *buffer2,
+                   std::size_t length) noexcept
+{
+    const auto *p = static_cast<const std::uint8_t *>(buffer1);
+    const auto *q = static_cast<const std::uint8_t *>(buffer2);
+    std::uint64_t difference{0};
+
+    // Nothing to compare if the length is zero
+    if (length == 0) return true;
+
+#if defined(SECUTIL_COMPARE_SSE2)
+    if (length >= 64)
+    {
+        __m128i acc0 = _mm_setzero_si128();
+        __m128i acc1 = _mm_setzero_si128();
+        __m128i acc2 = _mm_setzero_si128();
+        __m128i acc3 = _mm_setzero_si128();
+
+        for (; length >= 64; length -= 64, p += 64, q += 64)
+        {
+            const auto *a = reinterpret_cast<const __m128i *>(p);
+            const auto *b = reinterpret_cast<const __m128i *>(q);
+
+            acc0 = _mm_or_si128(acc0, _mm_xor_si128(_mm_loadu_si128(a + 0),
+                                                    _mm_loadu_si128(b + 0)));
+            acc1 = _mm_or_si128(acc1, _mm_xor_si128(_mm_loadu_si128(a + 1),
+                                                    _mm_loadu_si128(b + 1)));
+            acc2 = _mm_or_si128(acc2, _mm_xor_si128(_mm_loadu_si128(a + 2),
+                                                    _mm_loadu_si128(b + 2)));
+            acc3 = _mm_or_si128(acc3, _mm_xor_si128(_mm_loadu_si128(a + 3),
+                                                    _mm_loadu_si128(b + 3)));
+        }
+
+        // Fold the vector accumulators into the scalar difference
+        acc0 = _mm_or_si128(_mm_or_si128(acc0, acc1), _mm_or_si128(acc2, acc3));
+        acc0 = _mm_or_si128(acc0, _mm_unpackhi_epi64(acc0, acc0));
+        std::uint64_t folded;
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(&folded), acc0);
+        difference |= folded;
+    }
+#elif defined(SECUTIL_COMPARE_NEON)
+    if (length >= 64)
+    {
+        uint8x16_t acc0 = vdupq_n_u8(0);
+        uint8x16_t acc1 = vdupq_n_u8(0);
+        uint8x16_t acc2 = vdupq_n_u8(0);
+        uint8x16_t acc3 = vdupq_n_u8(0);
+
+        for (; length >= 64; length -= 64, p += 64, q += 64)
+        {
+            acc0 = vorrq_u8(acc0, veorq_u8(vld1q_u8(p + 0), vld1q_u8(q + 0)));
+            acc1 = vorrq_u8(acc1, veorq_u8(vld1q_u8(p + 16), vld1q_u8(q + 16)));
+            acc2 = vorrq_u8(acc2, veorq_u8(vld1q_u8(p + 32), vld1q_u8(q + 32)));
+            acc3 = vorrq_u8(acc3, veorq_u8(vld1q_u8(p + 48), vld1q_u8(q + 48)));
+        }
+
+        // Fold the vector accumulators into the scalar difference
+        acc0 = vorrq_u8(vorrq_u8(acc0, acc1), vorrq_u8(acc2, acc3));
+        const uint64x2_t wide = vreinterpretq_u64_u8(acc0);
+        difference |= vgetq_lane_u64(wide, 0) | vgetq_lane_u64(wide, 1);
+    }
+#endif
+
+    // Compare any remaining 64-bit words
+    for (; length >= 8; length -= 8, p += 8, q += 8)
+    {
+        difference |= Load64(p) ^ Load64(q);
+    }
+
+    // Compare any remaining octets
+    for (; length > 0; length--) difference |= *p++ ^ *q++;
+
+    // Reduce the difference to a single bit without branching
+    return ((difference | (0 - difference)) >> 63) == 0;
+}
+
+} // namespace Terra::SecUtil
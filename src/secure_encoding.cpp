@@ -0,0 +1,788 @@
+/*
+ *  secure_encoding.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module contains constant-time hexadecimal and base64 encoding
+ *      and decoding functions.
+ *
+ *      Hexadecimal text is processed 16 octets at a time using SSE2 (x86) or
+ *      NEON (ARM) instructions, with a branchless scalar path for the
+ *      remainder and for other processors.
+ *
+ *      Base64 text is processed 8 characters (6 octets) at a time by holding
+ *      one character per octet of a 64-bit word and performing range checks
+ *      and offset arithmetic on all eight lanes at once.  Every value in a
+ *      lane stays below 256, so no carry ever propagates between lanes.
+ *      Since SSE2 lacks a byte shuffle instruction, this approach is used on
+ *      all processors.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SECUTIL_ENCODING_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SECUTIL_ENCODING_NEON
+#endif
+#include <terra/secutil/secure_encoding.h>
+#include <terra/secutil/secure_erase.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Replicate an octet value into every lane of a 64-bit word
+constexpr std::uint64_t Lanes(std::uint8_t value) noexcept
+{
+    return 0x0101010101010101ULL * value;
+}
+
+/*
+ *  LanesAtLeast()
+ *
+ *  Description:
+ *      For each 8-bit lane holding a value less than 128, produce 1 in the
+ *      lane if the value is at least the given threshold and 0 otherwise.
+ *
+ *  Parameters:
+ *      lanes [in]
+ *          The lanes to test, each holding a value less than 128.
+ *
+ *      threshold [in]
+ *          The threshold, which must be between 1 and 128.
+ *
+ *  Returns:
+ *      The lanes, each holding either 0 or 1.
+ *
+ *  Comments:
+ *      Since each lane sum is at most 254, no carry crosses lanes.
+ */
+constexpr std::uint64_t LanesAtLeast(std::uint64_t lanes,
+                                     unsigned threshold) noexcept
+{
+    return ((lanes + Lanes(static_cast<std::uint8_t>(128 - threshold))) >>
+            7) & Lanes(1);
+}
+
+/*
+ *  LanesInRange()
+ *
+ *  Description:
+ *      For each 8-bit lane holding a value less than 128, produce 1 in the
+ *      lane if the value is between first and last (inclusive).
+ *
+ *  Parameters:
+ *      lanes [in]
+ *          The lanes to test, each holding a value less than 128.
+ *
+ *      first [in]
+ *          The first value in the range.
+ *
+ *      last [in]
+ *          The last value in the range.
+ *
+ *  Returns:
+ *      The lanes, each holding either 0 or 1.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr std::uint64_t LanesInRange(std::uint64_t lanes,
+                                     unsigned first,
+                                     unsigned last) noexcept
+{
+    return LanesAtLeast(lanes, first) &
+           (LanesAtLeast(lanes, last + 1) ^ Lanes(1));
+}
+
+/*
+ *  HexDigit()
+ *
+ *  Description:
+ *      Convert a 4-bit value into a hexadecimal digit without branching.
+ *
+ *  Parameters:
+ *      nibble [in]
+ *          The value to convert (0 to 15).
+ *
+ *      alpha_offset [in]
+ *          The distance from '0' + 10 to 'a' (39) or to 'A' (7).
+ *
+ *  Returns:
+ *      The hexadecimal digit.
+ *
+ *  Comments:
+ *      None.
+ */
+inline char HexDigit(unsigned nibble, unsigned alpha_offset) noexcept
+{
+    // All bits are set in the mask if the nibble is greater than 9
+    const unsigned mask = static_cast<unsigned>((9 - static_cast<int>(nibble))
+                                                >> 8);
+
+    return static_cast<char>(nibble + '0' + (mask & alpha_offset));
+}
+
+/*
+ *  HexValue()
+ *
+ *  Description:
+ *      Convert a hexadecimal digit into a 4-bit value without branching.
+ *
+ *  Parameters:
+ *      digit [in]
+ *          The hexadecimal digit.
+ *
+ *      invalid [in/out]
+ *          Accumulates a non-zero value if the digit is not valid.
+ *
+ *  Returns:
+ *      The 4-bit value, or 0 if the digit is invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+inline unsigned HexValue(char digit, unsigned &invalid) noexcept
+{
+    const unsigned c = static_cast<unsigned char>(digit);
+
+    // Values and masks assuming a decimal digit
+    const unsigned number = c ^ 0x30;
+    const unsigned number_mask = (number - 10) >> 8;
+
+    // Values and masks assuming a letter 'A' through 'F' in either case
+    const unsigned alpha = (c & ~0x20U) - 55;
+    const unsigned alpha_mask = ((alpha - 10) ^ (alpha - 16)) >> 8;
+
+    invalid |= ~(number_mask | alpha_mask) & 0xff;
+
+    return ((number & number_mask) | (alpha & alpha_mask)) & 0x0f;
+}
+
+/*
+ *  Base64EncodeBlock()
+ *
+ *  Description:
+ *      Encode 6 octets as 8 base64 characters.
+ *
+ *  Parameters:
+ *      data [in]
+ *          Pointer to 6 octets to encode.
+ *
+ *      text [out]
+ *          Pointer to the 8 characters to produce.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void Base64EncodeBlock(const std::uint8_t *data, char *text) noexcept
+{
+    std::uint64_t bits = 0;
+    std::uint64_t lanes = 0;
+
+    // Assemble 48 bits in big endian order
+    for (unsigned i = 0; i < 6; i++) bits = (bits << 8) | data[i];
+
+    // Place each 6-bit value into its own lane, first value in lowest lane
+    for (unsigned i = 0; i < 8; i++)
+    {
+        lanes |= ((bits >> (42 - 6 * i)) & 0x3f) << (8 * i);
+    }
+
+    // Determine the alphabet range for each lane
+    const std::uint64_t at_least_26 = LanesAtLeast(lanes, 26);
+    const std::uint64_t at_least_52 = LanesAtLeast(lanes, 52);
+    const std::uint64_t at_least_62 = LanesAtLeast(lanes, 62);
+    const std::uint64_t at_least_63 = LanesAtLeast(lanes, 63);
+
+    // Map 0..25 to 'A'..'Z', 26..51 to 'a'..'z', 52..61 to '0'..'9',
+    // 62 to '+', and 63 to '/'; no lane underflows or exceeds 255
+    const std::uint64_t base = lanes + Lanes(65) + at_least_26 * 6;
+    const std::uint64_t adjust = at_least_52 * 75 + at_least_62 * 15 -
+                                 at_least_63 * 3;
+    const std::uint64_t characters = base - adjust;
+
+    for (unsigned i = 0; i < 8; i++)
+    {
+        text[i] = static_cast<char>(characters >> (8 * i));
+    }
+}
+
+/*
+ *  Base64DecodeBlock()
+ *
+ *  Description:
+ *      Decode 8 base64 characters into 6 octets.
+ *
+ *  Parameters:
+ *      text [in]
+ *          Pointer to the 8 characters to decode.
+ *
+ *      data [out]
+ *          Pointer to the 6 octets to produce.
+ *
+ *  Returns:
+ *      A non-zero value if any character is invalid.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::uint64_t Base64DecodeBlock(const char *text,
+                                       std::uint8_t *data) noexcept
+{
+    std::uint64_t characters = 0;
+    std::uint64_t bits = 0;
+
+    for (unsigned i = 0; i < 8; i++)
+    {
+        characters |= static_cast<std::uint64_t>(
+                          static_cast<unsigned char>(text[i]))
+                      << (8 * i);
+    }
+
+    // Characters outside of the ASCII range are invalid
+    const std::uint64_t high_bits = (characters >> 7) & Lanes(1);
+    const std::uint64_t lanes = characters & Lanes(0x7f);
+
+    // Classify each character
+    const std::uint64_t upper = LanesInRange(lanes, 'A', 'Z');
+    const std::uint64_t lower = LanesInRange(lanes, 'a', 'z');
+    const std::uint64_t digit = LanesInRange(lanes, '0', '9');
+    const std::uint64_t plus = LanesInRange(lanes, '+', '+');
+    const std::uint64_t slash = LanesInRange(lanes, '/', '/');
+    const std::uint64_t valid = upper | lower | digit | plus | slash;
+
+    // Map the characters to values; no lane underflows or exceeds 255
+    const std::uint64_t values =
+        ((lanes - upper * 65 - lower * 71) + digit * 4 + plus * 19 +
+         slash * 16) &
+        (valid * 0xff);
+
+    // Assemble the 6-bit values into 48 bits in big endian order
+    for (unsigned i = 0; i < 8; i++)
+    {
+        bits = (bits << 6) | ((values >> (8 * i)) & 0x3f);
+    }
+
+    for (unsigned i = 0; i < 6; i++)
+    {
+        data[i] = static_cast<std::uint8_t>(bits >> (40 - 8 * i));
+    }
+
+    return (valid ^ Lanes(1)) | high_bits;
+}
+
+} // namespace
+
+/*
+ *  HexEncode()
+ *
+ *  Description:
+ *      Encode the given data as hexadecimal text into the given buffer.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to encode.
+ *
+ *      text [out]
+ *          The buffer into which the text is written, which must be exactly
+ *          twice the length of the data.
+ *
+ *      uppercase [in]
+ *          True if uppercase hexadecimal digits should be produced.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text buffer is not the
+ *      required size.
+ */
+void HexEncode(std::span<const std::uint8_t> data,
+               std::span<char> text,
+               bool uppercase)
+{
+    if (text.size() != data.size() * 2)
+    {
+        throw std::invalid_argument("Text buffer has the wrong length");
+    }
+
+    const std::uint8_t *p = data.data();
+    char *q = text.data();
+    std::size_t length = data.size();
+    const unsigned alpha_offset = uppercase ? 7 : 39;
+
+#if defined(SECUTIL_ENCODING_SSE2)
+    const __m128i low_nibbles = _mm_set1_epi8(0x0f);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero_digit = _mm_set1_epi8('0');
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(alpha_offset));
+
+    for (; length >= 16; length -= 16, p += 16, q += 32)
+    {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(in, 4), low_nibbles);
+        const __m128i low = _mm_and_si128(in, low_nibbles);
+
+        __m128i first = _mm_unpacklo_epi8(high, low);
+        __m128i second = _mm_unpackhi_epi8(high, low);
+
+        first = _mm_add_epi8(
+            _mm_add_epi8(first, zero_digit),
+            _mm_and_si128(_mm_cmpgt_epi8(first, nine), alpha));
+        second = _mm_add_epi8(
+            _mm_add_epi8(second, zero_digit),
+            _mm_and_si128(_mm_cmpgt_epi8(second, nine), alpha));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(q), first);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(q + 16), second);
+    }
+#elif defined(SECUTIL_ENCODING_NEON)
+    const uint8x16_t nine = vdupq_n_u8(9);
+    const uint8x16_t zero_digit = vdupq_n_u8('0');
+    const uint8x16_t alpha = vdupq_n_u8(static_cast<std::uint8_t>(alpha_offset));
+
+    for (; length >= 16; length -= 16, p += 16, q += 32)
+    {
+        const uint8x16_t in = vld1q_u8(p);
+        uint8x16x2_t digits;
+
+        digits.val[0] = vshrq_n_u8(in, 4);
+        digits.val[1] = vandq_u8(in, vdupq_n_u8(0x0f));
+
+        for (auto &digit : digits.val)
+        {
+            digit = vaddq_u8(vaddq_u8(digit, zero_digit),
+                             vandq_u8(vcgtq_u8(digit, nine), alpha));
+        }
+
+        // Store the high and low digits interleaved
+        vst2q_u8(reinterpret_cast<std::uint8_t *>(q), digits);
+    }
+#endif
+
+    for (; length > 0; length--, p++)
+    {
+        *q++ = HexDigit(*p >> 4, alpha_offset);
+        *q++ = HexDigit(*p & 0x0f, alpha_offset);
+    }
+}
+
+/*
+ *  HexEncode()
+ *
+ *  Description:
+ *      Encode the given data as hexadecimal text.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to encode.
+ *
+ *      uppercase [in]
+ *          True if uppercase hexadecimal digits should be produced.
+ *
+ *  Returns:
+ *      A SecureString holding the hexadecimal text.
+ *
+ *  Comments:
+ *      None.
+ */
+SecureString HexEncode(std::span<const std::uint8_t> data, bool uppercase)
+{
+    SecureString text(data.size() * 2, '\0');
+
+    HexEncode(data, text, uppercase);
+
+    return text;
+}
+
+/*
+ *  HexDecode()
+ *
+ *  Description:
+ *      Decode the given hexadecimal text into the given buffer.  Both
+ *      uppercase and lowercase digits are accepted.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The hexadecimal text to decode.
+ *
+ *      data [out]
+ *          The buffer into which the data is written, which must be exactly
+ *          half the length of the text.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text has an odd length,
+ *      if the data buffer is not the required size, or if the text contains
+ *      an invalid character.  In the latter case, the data buffer is erased.
+ */
+void HexDecode(std::string_view text, std::span<std::uint8_t> data)
+{
+    if (text.size() % 2)
+    {
+        throw std::invalid_argument("Hexadecimal text has an odd length");
+    }
+    if (data.size() != text.size() / 2)
+    {
+        throw std::invalid_argument("Data buffer has the wrong length");
+    }
+
+    const char *p = text.data();
+    std::uint8_t *q = data.data();
+    std::size_t length = data.size();
+    unsigned invalid = 0;
+
+#if defined(SECUTIL_ENCODING_SSE2)
+    const __m128i all_ones = _mm_set1_epi8(-1);
+    const __m128i ten = _mm_set1_epi8(10);
+    const __m128i six = _mm_set1_epi8(6);
+    const __m128i zero_digit = _mm_set1_epi8('0');
+    const __m128i lower_a = _mm_set1_epi8('a');
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i high_nibble = _mm_set1_epi16(0x00f0);
+    __m128i errors = _mm_setzero_si128();
+
+    // Convert 16 characters into 16 4-bit values
+    auto values = [&](__m128i c) -> __m128i
+    {
+        // Any wrap-around lands outside of the tested ranges
+        const __m128i number = _mm_sub_epi8(c, zero_digit);
+        const __m128i letter = _mm_sub_epi8(_mm_or_si128(c, case_bit),
+                                            lower_a);
+        const __m128i is_number =
+            _mm_and_si128(_mm_cmpgt_epi8(number, all_ones),
+                          _mm_cmplt_epi8(number, ten));
+        const __m128i is_letter =
+            _mm_and_si128(_mm_cmpgt_epi8(letter, all_ones),
+                          _mm_cmplt_epi8(letter, six));
+
+        errors = _mm_or_si128(
+            errors,
+            _mm_xor_si128(_mm_or_si128(is_number, is_letter), all_ones));
+
+        return _mm_or_si128(_mm_and_si128(number, is_number),
+                            _mm_and_si128(_mm_add_epi8(letter, ten),
+                                          is_letter));
+    };
+
+    // Combine pairs of 4-bit values held in 16-bit lanes into octets
+    auto octets = [&](__m128i v) -> __m128i
+    {
+        return _mm_or_si128(_mm_and_si128(_mm_slli_epi16(v, 4), high_nibble),
+                            _mm_srli_epi16(v, 8));
+    };
+
+    for (; length >= 16; length -= 16, p += 32, q += 16)
+    {
+        const __m128i first = octets(values(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p))));
+        const __m128i second = octets(values(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16))));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(q),
+                         _mm_packus_epi16(first, second));
+    }
+
+    invalid |= static_cast<unsigned>(_mm_movemask_epi8(errors));
+#elif defined(SECUTIL_ENCODING_NEON)
+    const uint8x16_t ten = vdupq_n_u8(10);
+    const uint8x16_t six = vdupq_n_u8(6);
+    const uint8x16_t zero_digit = vdupq_n_u8('0');
+    const uint8x16_t lower_a = vdupq_n_u8('a');
+    const uint8x16_t case_bit = vdupq_n_u8(0x20);
+    uint8x16_t errors = vdupq_n_u8(0);
+
+    for (; length >= 16; length -= 16, p += 32, q += 16)
+    {
+        // Load the characters with high and low digits separated
+        uint8x16x2_t digits = vld2q_u8(reinterpret_cast<const std::uint8_t *>(p));
+
+        for (auto &digit : digits.val)
+        {
+            // Any wrap-around lands outside of the tested ranges
+            const uint8x16_t number = vsubq_u8(digit, zero_digit);
+            const uint8x16_t letter = vsubq_u8(vorrq_u8(digit, case_bit),
+                                               lower_a);
+            const uint8x16_t is_number = vcltq_u8(number, ten);
+            const uint8x16_t is_letter = vcltq_u8(letter, six);
+
+            errors = vorrq_u8(errors,
+                              vmvnq_u8(vorrq_u8(is_number, is_letter)));
+            digit = vbslq_u8(is_number, number, vaddq_u8(letter, ten));
+        }
+
+        vst1q_u8(q, vorrq_u8(vshlq_n_u8(digits.val[0], 4), digits.val[1]));
+    }
+
+    const uint64x2_t error_words = vreinterpretq_u64_u8(errors);
+    invalid |= static_cast<unsigned>((vgetq_lane_u64(error_words, 0) |
+                                      vgetq_lane_u64(error_words, 1)) != 0);
+#endif
+
+    for (; length > 0; length--, p += 2)
+    {
+        const unsigned high = HexValue(p[0], invalid);
+        const unsigned low = HexValue(p[1], invalid);
+
+        *q++ = static_cast<std::uint8_t>((high << 4) | low);
+    }
+
+    if (invalid)
+    {
+        SecureErase(data);
+        throw std::invalid_argument("Invalid hexadecimal character");
+    }
+}
+
+/*
+ *  HexDecode()
+ *
+ *  Description:
+ *      Decode the given hexadecimal text.  Both uppercase and lowercase
+ *      digits are accepted.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The hexadecimal text to decode.
+ *
+ *  Returns:
+ *      A SecureVector holding the decoded data.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text is not valid.
+ */
+SecureVector<std::uint8_t> HexDecode(std::string_view text)
+{
+    SecureVector<std::uint8_t> data(text.size() / 2);
+
+    HexDecode(text, data);
+
+    return data;
+}
+
+/*
+ *  Base64DecodedLength()
+ *
+ *  Description:
+ *      Return the length of the data produced when decoding the given base64
+ *      text.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The base64 text to be decoded.
+ *
+ *  Returns:
+ *      The length of the decoded data.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the length of the text is
+ *      not a multiple of four.  Only the padding characters are examined.
+ */
+std::size_t Base64DecodedLength(std::string_view text)
+{
+    if (text.size() % 4)
+    {
+        throw std::invalid_argument("Base64 text has an invalid length");
+    }
+
+    std::size_t padding = 0;
+
+    if (!text.empty() && (text.back() == '='))
+    {
+        padding = (text[text.size() - 2] == '=') ? 2 : 1;
+    }
+
+    return (text.size() / 4) * 3 - padding;
+}
+
+/*
+ *  Base64Encode()
+ *
+ *  Description:
+ *      Encode the given data as base64 text into the given buffer.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to encode.
+ *
+ *      text [out]
+ *          The buffer into which the text is written, which must be exactly
+ *          Base64EncodedLength(data.size()) octets in length.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text buffer is not the
+ *      required size.
+ */
+void Base64Encode(std::span<const std::uint8_t> data, std::span<char> text)
+{
+    if (text.size() != Base64EncodedLength(data.size()))
+    {
+        throw std::invalid_argument("Text buffer has the wrong length");
+    }
+
+    const std::uint8_t *p = data.data();
+    char *q = text.data();
+    std::size_t length = data.size();
+
+    for (; length >= 6; length -= 6, p += 6, q += 8) Base64EncodeBlock(p, q);
+
+    // Encode any remaining octets via a zero-padded block
+    if (length > 0)
+    {
+        std::uint8_t block[6]{};
+        char characters[8];
+
+        std::memcpy(block, p, length);
+        Base64EncodeBlock(block, characters);
+
+        const std::size_t produced = (length * 4 + 2) / 3;
+        const std::size_t total = Base64EncodedLength(length);
+
+        std::memcpy(q, characters, produced);
+        std::fill(q + produced, q + total, '=');
+
+        SecureErase(block, sizeof(block));
+        SecureErase(characters, sizeof(characters));
+    }
+}
+
+/*
+ *  Base64Encode()
+ *
+ *  Description:
+ *      Encode the given data as base64 text.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to encode.
+ *
+ *  Returns:
+ *      A SecureString holding the base64 text.
+ *
+ *  Comments:
+ *      None.
+ */
+SecureString Base64Encode(std::span<const std::uint8_t> data)
+{
+    SecureString text(Base64EncodedLength(data.size()), '\0');
+
+    Base64Encode(data, text);
+
+    return text;
+}
+
+/*
+ *  Base64Decode()
+ *
+ *  Description:
+ *      Decode the given base64 text into the given buffer.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The base64 text to decode.
+ *
+ *      data [out]
+ *          The buffer into which the data is written, which must be exactly
+ *          Base64DecodedLength(text) octets in length.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text is malformed, if
+ *      the data buffer is not the required size, or if the text contains
+ *      an invalid character.  In the latter case, the data buffer is erased.
+ */
+void Base64Decode(std::string_view text, std::span<std::uint8_t> data)
+{
+    if (data.size() != Base64DecodedLength(text))
+    {
+        throw std::invalid_argument("Data buffer has the wrong length");
+    }
+
+    // Only the characters up to the padding carry data
+    const std::size_t padding = (text.size() / 4) * 3 - data.size();
+    const char *p = text.data();
+    std::uint8_t *q = data.data();
+    std::size_t length = text.size() - padding;
+    std::uint64_t invalid = 0;
+
+    for (; length >= 8; length -= 8, p += 8, q += 6)
+    {
+        invalid |= Base64DecodeBlock(p, q);
+    }
+
+    // Decode any remaining characters via a block padded with 'A' (zero)
+    if (length > 0)
+    {
+        char characters[8];
+        std::uint8_t block[6];
+
+        std::memset(characters, 'A', sizeof(characters));
+        std::memcpy(characters, p, length);
+        invalid |= Base64DecodeBlock(characters, block);
+
+        std::memcpy(q, block, (length * 3) / 4);
+
+        SecureErase(characters, sizeof(characters));
+        SecureErase(block, sizeof(block));
+    }
+
+    if (invalid)
+    {
+        SecureErase(data);
+        throw std::invalid_argument("Invalid base64 character");
+    }
+}
+
+/*
+ *  Base64Decode()
+ *
+ *  Description:
+ *      Decode the given base64 text.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The base64 text to decode.
+ *
+ *  Returns:
+ *      A SecureVector holding the decoded data.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text is not valid.
+ */
+SecureVector<std::uint8_t> Base64Decode(std::string_view text)
+{
+    SecureVector<std::uint8_t> data(Base64DecodedLength(text));
+
+    Base64Decode(text, data);
+
+    return data;
+}
+
+} // namespace Terra::SecUtil
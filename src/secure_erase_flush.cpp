@@ -0,0 +1,471 @@
+/*
+ *  secure_erase_flush.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements functions that erase memory and flush the
+ *      zeros to main memory.
+ *
+ *      Each region is divided into the whole cache lines it spans and the
+ *      partial lines at either end.  Partial lines are erased normally and
+ *      flushed, since non-temporal stores to part of a line would merge
+ *      with the cached remainder of the line.  Neither non-temporal stores
+ *      nor clflushopt are ordered with respect to other stores, so a store
+ *      fence is issued once all regions have been erased.
+ *
+ *  Portability Issues:
+ *      The x86 cache line size is assumed to be 64 octets.  On ARM, the
+ *      line size is read from CTR_EL0.
+ */
+
+#include <cstdint>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#define SECUTIL_ERASE_FLUSH_X86
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define SECUTIL_ERASE_FLUSH_ARM64
+#endif
+#include <terra/secutil/secure_erase_flush.h>
+#include <terra/secutil/secure_erase.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Regions at least this large are written using non-temporal stores when
+// the method is Automatic
+constexpr std::size_t Non_Temporal_Threshold = 256;
+
+#if defined(SECUTIL_ERASE_FLUSH_X86)
+
+// Size of a cache line
+constexpr std::size_t Cache_Line_Size = 64;
+
+/*
+ *  HasClflushopt()
+ *
+ *  Description:
+ *      Determine whether the processor supports clflushopt.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if clflushopt is supported.
+ *
+ *  Comments:
+ *      This is CPUID leaf 7, EBX bit 23.
+ */
+bool HasClflushopt() noexcept
+{
+#if defined(_MSC_VER)
+    int registers[4];
+
+    __cpuid(registers, 0);
+    if (registers[0] < 7) return false;
+
+    __cpuidex(registers, 7, 0);
+
+    return (registers[1] & (1 << 23)) != 0;
+#else
+    unsigned eax, ebx, ecx, edx;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+
+    return (ebx & (1U << 23)) != 0;
+#endif
+}
+
+/*
+ *  FlushLinesOptimized()
+ *
+ *  Description:
+ *      Write back and evict the cache lines spanning the given range using
+ *      clflushopt.
+ *
+ *  Parameters:
+ *      begin [in]
+ *          The first octet of the range, which is aligned to a cache line.
+ *
+ *      end [in]
+ *          The end of the range.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The processor must support clflushopt.  A store fence must follow.
+ */
+#if !defined(_MSC_VER)
+__attribute__((target("clflushopt")))
+#endif
+void FlushLinesOptimized(std::uint8_t *begin, std::uint8_t *end) noexcept
+{
+    for (std::uint8_t *line = begin; line < end; line += Cache_Line_Size)
+    {
+        _mm_clflushopt(line);
+    }
+}
+
+/*
+ *  FlushLines()
+ *
+ *  Description:
+ *      Write back and evict the cache lines spanning the given range.
+ *
+ *  Parameters:
+ *      begin [in]
+ *          The first octet of the range.
+ *
+ *      end [in]
+ *          The end of the range.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The processor is queried on first use rather than during static
+ *      initialization, so this may be called from other static initializers.
+ */
+void FlushLines(std::uint8_t *begin, std::uint8_t *end) noexcept
+{
+    static const bool has_clflushopt = HasClflushopt();
+    const auto address = reinterpret_cast<std::uintptr_t>(begin);
+    auto *line = begin - (address % Cache_Line_Size);
+
+    if (has_clflushopt)
+    {
+        FlushLinesOptimized(line, end);
+        return;
+    }
+
+    for (; line < end; line += Cache_Line_Size) _mm_clflush(line);
+}
+
+/*
+ *  StreamZeros()
+ *
+ *  Description:
+ *      Write zeros to whole cache lines using non-temporal stores.
+ *
+ *  Parameters:
+ *      begin [in]
+ *          The first octet to erase, which is aligned to a cache line.
+ *
+ *      end [in]
+ *          The end of the lines to erase, which is aligned to a cache line.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      A store fence must follow.
+ */
+void StreamZeros(std::uint8_t *begin, std::uint8_t *end) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    for (std::uint8_t *line = begin; line < end; line += Cache_Line_Size)
+    {
+        _mm_stream_si128(reinterpret_cast<__m128i *>(line), zero);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(line + 16), zero);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(line + 32), zero);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(line + 48), zero);
+    }
+
+#if !defined(_MSC_VER)
+    // Ensure the stores are not removed as dead, like explicit_bzero()
+    asm volatile("" : : "r"(begin) : "memory");
+#endif
+}
+
+/*
+ *  Fence()
+ *
+ *  Description:
+ *      Wait for all preceding stores and flushes to complete.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Fence() noexcept
+{
+    _mm_sfence();
+}
+
+#elif defined(SECUTIL_ERASE_FLUSH_ARM64)
+
+/*
+ *  CacheLineSize()
+ *
+ *  Description:
+ *      Determine the size of the smallest data cache line.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The line size in octets.
+ *
+ *  Comments:
+ *      This is given as a power of two in words by CTR_EL0.DminLine.
+ */
+std::size_t CacheLineSize() noexcept
+{
+    std::uint64_t ctr;
+
+    asm volatile("mrs %0, ctr_el0" : "=r"(ctr));
+
+    return std::size_t{4} << ((ctr >> 16) & 0xf);
+}
+
+/*
+ *  FlushLines()
+ *
+ *  Description:
+ *      Clean and invalidate the cache lines spanning the given range to the
+ *      point of coherency.
+ *
+ *  Parameters:
+ *      begin [in]
+ *          The first octet of the range.
+ *
+ *      end [in]
+ *          The end of the range.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      A data synchronization barrier must follow.  The line size is read on
+ *      first use rather than during static initialization, so this may be
+ *      called from other static initializers.
+ */
+void FlushLines(std::uint8_t *begin, std::uint8_t *end) noexcept
+{
+    static const std::size_t line_size = CacheLineSize();
+    const auto address = reinterpret_cast<std::uintptr_t>(begin);
+
+    for (auto *line = begin - (address % line_size); line < end;
+         line += line_size)
+    {
+        asm volatile("dc civac, %0" : : "r"(line) : "memory");
+    }
+}
+
+/*
+ *  Fence()
+ *
+ *  Description:
+ *      Wait for all preceding stores and cache maintenance to complete.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Fence() noexcept
+{
+    asm volatile("dsb sy" : : : "memory");
+}
+
+#endif
+
+/*
+ *  EraseRegionFlush()
+ *
+ *  Description:
+ *      Erase one region and begin flushing it to main memory.
+ *
+ *  Parameters:
+ *      buffer [in]
+ *          Pointer to buffer to erase.
+ *
+ *      length [in]
+ *          Number of octets to set to zero.
+ *
+ *      method [in]
+ *          The method used to bypass or flush the cache.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The caller must call Fence() once all regions are erased.
+ */
+void EraseRegionFlush(void *buffer,
+                      std::size_t length,
+                      [[maybe_unused]] EraseFlushMethod method) noexcept
+{
+    if ((buffer == nullptr) || (length == 0)) return;
+
+#if defined(SECUTIL_ERASE_FLUSH_X86)
+    auto *begin = static_cast<std::uint8_t *>(buffer);
+    auto *end = begin + length;
+
+    if (method == EraseFlushMethod::Automatic)
+    {
+        method = (length >= Non_Temporal_Threshold)
+                     ? EraseFlushMethod::NonTemporal
+                     : EraseFlushMethod::CacheFlush;
+    }
+
+    // Determine the whole cache lines within the region
+    const auto address = reinterpret_cast<std::uintptr_t>(begin);
+    const std::size_t head =
+        (Cache_Line_Size - (address % Cache_Line_Size)) % Cache_Line_Size;
+    const std::size_t lines = (length > head)
+                                  ? (length - head) / Cache_Line_Size
+                                  : 0;
+
+    if ((method == EraseFlushMethod::CacheFlush) || (lines == 0))
+    {
+        SecureErase(begin, length);
+        FlushLines(begin, end);
+        return;
+    }
+
+    std::uint8_t *first_line = begin + head;
+    std::uint8_t *last_line = first_line + lines * Cache_Line_Size;
+
+    if (head > 0)
+    {
+        SecureErase(begin, head);
+        FlushLines(begin, first_line);
+    }
+
+    StreamZeros(first_line, last_line);
+
+    if (last_line < end)
+    {
+        SecureErase(last_line, static_cast<std::size_t>(end - last_line));
+        FlushLines(last_line, end);
+    }
+#elif defined(SECUTIL_ERASE_FLUSH_ARM64)
+    SecureErase(buffer, length);
+    FlushLines(static_cast<std::uint8_t *>(buffer),
+               static_cast<std::uint8_t *>(buffer) + length);
+#else
+    SecureErase(buffer, length);
+#endif
+}
+
+} // namespace
+
+/*
+ *  SecureEraseFlush()
+ *
+ *  Description:
+ *      Erase memory and flush the zeros from the cache to main memory.
+ *
+ *  Parameters:
+ *      buffer [in]
+ *          Pointer to buffer to erase.
+ *
+ *      length [in]
+ *          Number of octets to set to zero.
+ *
+ *      method [in]
+ *          The method used to bypass or flush the cache.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SecureEraseFlush(void *buffer, std::size_t length, EraseFlushMethod method)
+{
+    if ((buffer == nullptr) || (length == 0)) return;
+
+    EraseRegionFlush(buffer, length, method);
+
+#if defined(SECUTIL_ERASE_FLUSH_X86) || defined(SECUTIL_ERASE_FLUSH_ARM64)
+    Fence();
+#endif
+}
+
+/*
+ *  SecureEraseFlush()
+ *
+ *  Description:
+ *      Erase several regions of memory and flush the zeros from the cache to
+ *      main memory, issuing a single fence once all are erased.
+ *
+ *  Parameters:
+ *      regions [in]
+ *          The regions to erase.
+ *
+ *      method [in]
+ *          The method used to bypass or flush the cache.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SecureEraseFlush(std::span<const EraseRegion> regions,
+                      EraseFlushMethod method)
+{
+    for (const auto &region : regions)
+    {
+        EraseRegionFlush(region.buffer, region.length, method);
+    }
+
+#if defined(SECUTIL_ERASE_FLUSH_X86) || defined(SECUTIL_ERASE_FLUSH_ARM64)
+    if (!regions.empty()) Fence();
+#endif
+}
+
+/*
+ *  EraseFlushSupported()
+ *
+ *  Description:
+ *      Determine whether SecureEraseFlush() is able to flush the cache on
+ *      this platform.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if erased memory is flushed to main memory, false if it is only
+ *      erased.
+ *
+ *  Comments:
+ *      None.
+ */
+bool EraseFlushSupported() noexcept
+{
+#if defined(SECUTIL_ERASE_FLUSH_X86) || defined(SECUTIL_ERASE_FLUSH_ARM64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace Terra::SecUtil
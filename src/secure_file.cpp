@@ -0,0 +1,744 @@
+/*
+ *  secure_file.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module contains functions and an object that read files directly
+ *      into secure storage.  The operating system interfaces are wrapped by
+ *      a few small functions so that the loading logic is shared between
+ *      Unix-like systems and Windows.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <terra/secutil/secure_file.h>
+#include <terra/secutil/secure_erase.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Value of a handle that does not refer to an open file
+constexpr std::intptr_t Invalid_Handle = -1;
+
+// Growth increment when reading files of unknown size
+constexpr std::size_t Unknown_Size_Chunk = 65536;
+
+/*
+ *  ThrowSystemError()
+ *
+ *  Description:
+ *      Throw a std::system_error for the most recent operating system error.
+ *
+ *  Parameters:
+ *      what [in]
+ *          Description of the operation that failed.
+ *
+ *  Returns:
+ *      Does not return.
+ *
+ *  Comments:
+ *      None.
+ */
+[[noreturn]] void ThrowSystemError(const char *what)
+{
+#if defined(_WIN32)
+    throw std::system_error(static_cast<int>(GetLastError()),
+                            std::system_category(),
+                            what);
+#else
+    throw std::system_error(errno, std::generic_category(), what);
+#endif
+}
+
+/*
+ *  OpenFile()
+ *
+ *  Description:
+ *      Open the given file for reading.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to open.
+ *
+ *      direct [in/out]
+ *          On input, whether direct I/O is requested.  On output, whether
+ *          the file was opened for direct I/O.
+ *
+ *  Returns:
+ *      The handle of the open file.
+ *
+ *  Comments:
+ *      If direct I/O is refused by the file system, the file is opened
+ *      without it.  This will throw std::system_error on failure.
+ */
+std::intptr_t OpenFile(const std::filesystem::path &path, bool &direct)
+{
+#if defined(_WIN32)
+    const DWORD flags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN;
+    HANDLE handle = INVALID_HANDLE_VALUE;
+
+    if (direct)
+    {
+        handle = CreateFileW(path.c_str(),
+                             GENERIC_READ,
+                             FILE_SHARE_READ,
+                             nullptr,
+                             OPEN_EXISTING,
+                             flags | FILE_FLAG_NO_BUFFERING,
+                             nullptr);
+        if (handle == INVALID_HANDLE_VALUE) direct = false;
+    }
+
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        handle = CreateFileW(path.c_str(),
+                             GENERIC_READ,
+                             FILE_SHARE_READ,
+                             nullptr,
+                             OPEN_EXISTING,
+                             flags,
+                             nullptr);
+    }
+
+    if (handle == INVALID_HANDLE_VALUE) ThrowSystemError("Unable to open file");
+
+    return reinterpret_cast<std::intptr_t>(handle);
+#else
+    int fd = -1;
+
+#if defined(O_DIRECT)
+    if (direct)
+    {
+        fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+        if ((fd < 0) && (errno != EINVAL)) ThrowSystemError("Unable to open file");
+    }
+#endif
+
+    if (fd < 0)
+    {
+        direct = false;
+        fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+
+    if (fd < 0) ThrowSystemError("Unable to open file");
+
+    return fd;
+#endif
+}
+
+/*
+ *  CloseFile()
+ *
+ *  Description:
+ *      Close the given file, first advising the operating system that any
+ *      of its pages held in the page cache are no longer needed.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The file to close.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Dropping cached pages is best effort.
+ */
+void CloseFile(std::intptr_t handle) noexcept
+{
+    if (handle == Invalid_Handle) return;
+
+#if defined(_WIN32)
+    CloseHandle(reinterpret_cast<HANDLE>(handle));
+#else
+    const int fd = static_cast<int>(handle);
+
+#if defined(POSIX_FADV_DONTNEED)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+
+    close(fd);
+#endif
+}
+
+/*
+ *  RegularFileSize()
+ *
+ *  Description:
+ *      Determine the size of the given file if it is a regular file.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      size [out]
+ *          The size of the file in octets.
+ *
+ *  Returns:
+ *      True if the file is a regular file, false otherwise.
+ *
+ *  Comments:
+ *      This will throw std::system_error on failure.
+ */
+bool RegularFileSize(std::intptr_t handle, std::uint64_t &size)
+{
+#if defined(_WIN32)
+    HANDLE file = reinterpret_cast<HANDLE>(handle);
+    LARGE_INTEGER file_size;
+
+    if (GetFileType(file) != FILE_TYPE_DISK) return false;
+    if (!GetFileSizeEx(file, &file_size)) ThrowSystemError("Unable to stat file");
+
+    size = static_cast<std::uint64_t>(file_size.QuadPart);
+#else
+    struct stat status;
+
+    if (fstat(static_cast<int>(handle), &status) != 0)
+    {
+        ThrowSystemError("Unable to stat file");
+    }
+    if (!S_ISREG(status.st_mode)) return false;
+
+    size = static_cast<std::uint64_t>(status.st_size);
+#endif
+
+    return true;
+}
+
+/*
+ *  ReadFully()
+ *
+ *  Description:
+ *      Read from the file until the buffer is full or the end of the file
+ *      is reached.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      buffer [out]
+ *          The buffer into which data is read.
+ *
+ *      length [in]
+ *          The length of the buffer.
+ *
+ *      direct [in/out]
+ *          Whether the file is open for direct I/O.  This is cleared if the
+ *          file system rejects a direct read and the read is retried through
+ *          the page cache.
+ *
+ *  Returns:
+ *      The number of octets read, which is less than length only at the end
+ *      of the file.
+ *
+ *  Comments:
+ *      For direct I/O, the buffer address and length must be page aligned.
+ *      This will throw std::system_error on failure.
+ */
+std::size_t ReadFully(std::intptr_t handle,
+                      std::uint8_t *buffer,
+                      std::size_t length,
+                      bool &direct)
+{
+    std::size_t total = 0;
+
+    while (total < length)
+    {
+#if defined(_WIN32)
+        const DWORD request = static_cast<DWORD>(
+            std::min<std::size_t>(length - total, 0x40000000));
+        DWORD result = 0;
+
+        if (!::ReadFile(reinterpret_cast<HANDLE>(handle),
+                        buffer + total,
+                        request,
+                        &result,
+                        nullptr))
+        {
+            ThrowSystemError("Unable to read file");
+        }
+        static_cast<void>(direct);
+#else
+        const int fd = static_cast<int>(handle);
+        const ssize_t result = read(fd, buffer + total, length - total);
+
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+
+#if defined(O_DIRECT)
+            // Some file systems accept O_DIRECT on open but not on read
+            if (direct && (errno == EINVAL))
+            {
+                const int flags = fcntl(fd, F_GETFL);
+                if ((flags >= 0) &&
+                    (fcntl(fd, F_SETFL, flags & ~O_DIRECT) == 0))
+                {
+                    direct = false;
+                    continue;
+                }
+            }
+#endif
+
+            ThrowSystemError("Unable to read file");
+        }
+#endif
+
+        if (result == 0) break;
+
+        total += static_cast<std::size_t>(result);
+    }
+
+    return total;
+}
+
+/*
+ *  ReadRegularFile()
+ *
+ *  Description:
+ *      Read the entire contents of an open regular file of known size into
+ *      the given buffer.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      buffer [out]
+ *          The buffer into which data is read.
+ *
+ *      size [in]
+ *          The size of the file.
+ *
+ *      capacity [in]
+ *          The length of the buffer, which is at least size and (for direct
+ *          I/O) a multiple of the page size.
+ *
+ *      direct [in/out]
+ *          Whether the file is open for direct I/O.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::system_error if the file cannot be read or if
+ *      its size changes while being read.  On failure, the buffer is erased.
+ */
+void ReadRegularFile(std::intptr_t handle,
+                     std::uint8_t *buffer,
+                     std::size_t size,
+                     std::size_t capacity,
+                     bool &direct)
+{
+    std::size_t total = 0;
+
+    try
+    {
+        // Reading beyond the expected size (when there is room in the buffer)
+        // detects a file that has grown
+        total = ReadFully(handle, buffer, direct ? capacity : size, direct);
+        if ((total == size) && !direct && (size < capacity))
+        {
+            total += ReadFully(handle, buffer + size, 1, direct);
+        }
+    }
+    catch (...)
+    {
+        SecureErase(buffer, capacity);
+        throw;
+    }
+
+    if (total != size)
+    {
+        SecureErase(buffer, capacity);
+        throw std::system_error(std::make_error_code(std::errc::io_error),
+                                "File size changed while reading");
+    }
+}
+
+} // namespace
+
+/*
+ *  LoadSecureFile()
+ *
+ *  Description:
+ *      Read the entire contents of the given file into a SecureVector.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to read.
+ *
+ *  Returns:
+ *      The contents of the file.
+ *
+ *  Comments:
+ *      This will throw std::system_error if the file cannot be read.
+ */
+SecureVector<std::uint8_t> LoadSecureFile(const std::filesystem::path &path)
+{
+    bool direct = false;
+    std::intptr_t handle = OpenFile(path, direct);
+    SecureVector<std::uint8_t> contents;
+
+    try
+    {
+        std::uint64_t size = 0;
+
+        if (RegularFileSize(handle, size))
+        {
+            if (size >= contents.max_size())
+            {
+                throw std::system_error(
+                    std::make_error_code(std::errc::file_too_large),
+                    "File is too large");
+            }
+
+            // One extra octet detects a file that has grown
+            contents.resize(static_cast<std::size_t>(size) + 1);
+            ReadRegularFile(handle,
+                            contents.data(),
+                            static_cast<std::size_t>(size),
+                            contents.size(),
+                            direct);
+            contents.resize(static_cast<std::size_t>(size));
+        }
+        else
+        {
+            std::size_t total = 0;
+
+            while (true)
+            {
+                contents.resize(total + Unknown_Size_Chunk);
+
+                const std::size_t result = ReadFully(handle,
+                                                     contents.data() + total,
+                                                     Unknown_Size_Chunk,
+                                                     direct);
+                total += result;
+
+                if (result < Unknown_Size_Chunk) break;
+            }
+
+            contents.resize(total);
+        }
+    }
+    catch (...)
+    {
+        CloseFile(handle);
+        throw;
+    }
+
+    CloseFile(handle);
+
+    return contents;
+}
+
+/*
+ *  LoadSecureFilePages()
+ *
+ *  Description:
+ *      Read the entire contents of the given regular file into SecurePages.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to read.
+ *
+ *      lock [in]
+ *          If true, the memory is locked before reading.
+ *
+ *      direct [in]
+ *          If true, attempt to read the file using direct I/O.
+ *
+ *  Returns:
+ *      The contents of the file.
+ *
+ *  Comments:
+ *      This will throw std::system_error if the file cannot be read or the
+ *      memory cannot be locked, or std::invalid_argument if the path does not
+ *      refer to a regular file.
+ */
+SecurePages LoadSecureFilePages(const std::filesystem::path &path,
+                                bool lock,
+                                bool direct)
+{
+    std::intptr_t handle = OpenFile(path, direct);
+    SecurePages pages;
+
+    try
+    {
+        std::uint64_t size = 0;
+
+        if (!RegularFileSize(handle, size))
+        {
+            throw std::invalid_argument("Path does not refer to a regular file");
+        }
+
+        if (size > (SIZE_MAX - SecurePages::PageSize()))
+        {
+            throw std::system_error(
+                std::make_error_code(std::errc::file_too_large),
+                "File is too large");
+        }
+
+        pages = SecurePages(static_cast<std::size_t>(size));
+
+        if (lock && !pages.Lock())
+        {
+            throw std::system_error(
+                std::make_error_code(std::errc::not_enough_memory),
+                "Unable to lock memory");
+        }
+
+        if (size > 0)
+        {
+            ReadRegularFile(handle,
+                            pages.data(),
+                            pages.size(),
+                            pages.capacity(),
+                            direct);
+        }
+    }
+    catch (...)
+    {
+        CloseFile(handle);
+        throw;
+    }
+
+    CloseFile(handle);
+
+    return pages;
+}
+
+/*
+ *  SecureFileReader::SecureFileReader()
+ *
+ *  Description:
+ *      Open the given file for reading in chunks.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to read.
+ *
+ *      chunk_size [in]
+ *          The maximum number of octets returned by each call to Next().
+ *          When using direct I/O, this is rounded up to a multiple of the
+ *          page size.
+ *
+ *      lock [in]
+ *          If true, the chunk buffer is locked in memory.
+ *
+ *      direct [in]
+ *          If true, attempt to read the file using direct I/O.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if chunk_size is zero, or
+ *      std::system_error if the file cannot be opened or the buffer cannot
+ *      be locked.
+ */
+SecureFileReader::SecureFileReader(const std::filesystem::path &path,
+                                   std::size_t chunk_size,
+                                   bool lock,
+                                   bool direct) :
+    handle{Invalid_Handle},
+    valid{0},
+    position{0},
+    direct_io{direct},
+    end_of_file{false}
+{
+    if (chunk_size == 0)
+    {
+        throw std::invalid_argument("Chunk size must be greater than zero");
+    }
+
+    buffer = SecurePages(chunk_size);
+
+    if (lock && !buffer.Lock())
+    {
+        throw std::system_error(
+            std::make_error_code(std::errc::not_enough_memory),
+            "Unable to lock memory");
+    }
+
+    handle = OpenFile(path, direct_io);
+}
+
+/*
+ *  SecureFileReader::SecureFileReader()
+ *
+ *  Description:
+ *      Move constructor.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The reader from which the open file and buffer are taken.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The other reader is left at the end of file.
+ */
+SecureFileReader::SecureFileReader(SecureFileReader &&other) noexcept :
+    handle{std::exchange(other.handle, Invalid_Handle)},
+    buffer{std::move(other.buffer)},
+    valid{std::exchange(other.valid, 0)},
+    position{other.position},
+    direct_io{other.direct_io},
+    end_of_file{std::exchange(other.end_of_file, true)}
+{
+}
+
+/*
+ *  SecureFileReader::~SecureFileReader()
+ *
+ *  Description:
+ *      Close the file.  The chunk buffer is erased as it is released.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SecureFileReader::~SecureFileReader()
+{
+    Close();
+}
+
+/*
+ *  SecureFileReader::operator=()
+ *
+ *  Description:
+ *      Move assignment operator.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The reader from which the open file and buffer are taken.
+ *
+ *  Returns:
+ *      A reference to this object.
+ *
+ *  Comments:
+ *      The other reader is left at the end of file.
+ */
+SecureFileReader &SecureFileReader::operator=(SecureFileReader &&other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+
+        handle = std::exchange(other.handle, Invalid_Handle);
+        buffer = std::move(other.buffer);
+        valid = std::exchange(other.valid, 0);
+        position = other.position;
+        direct_io = other.direct_io;
+        end_of_file = std::exchange(other.end_of_file, true);
+    }
+
+    return *this;
+}
+
+/*
+ *  SecureFileReader::Next()
+ *
+ *  Description:
+ *      Read the next chunk of the file.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A span over the chunk, which is empty at the end of the file.  The
+ *      span remains valid until the next call to Next() or until the reader
+ *      is destroyed.
+ *
+ *  Comments:
+ *      The previous chunk is overwritten or erased.  This will throw
+ *      std::system_error if the file cannot be read.
+ */
+std::span<const std::uint8_t> SecureFileReader::Next()
+{
+    if (end_of_file)
+    {
+        SecureErase(buffer.data(), valid);
+        valid = 0;
+        return {};
+    }
+
+    const std::size_t request = direct_io ? buffer.capacity() : buffer.size();
+    std::size_t result = 0;
+
+    try
+    {
+        result = ReadFully(handle, buffer.data(), request, direct_io);
+    }
+    catch (...)
+    {
+        SecureErase(buffer.data(), buffer.capacity());
+        valid = 0;
+        throw;
+    }
+
+    // Erase any portion of the previous chunk that was not overwritten
+    if (result < valid) SecureErase(buffer.data() + result, valid - result);
+
+    valid = result;
+    position += result;
+
+    if (result < request)
+    {
+        end_of_file = true;
+        Close();
+    }
+
+    return {buffer.data(), valid};
+}
+
+/*
+ *  SecureFileReader::Close()
+ *
+ *  Description:
+ *      Close the file if it is open.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SecureFileReader::Close() noexcept
+{
+    CloseFile(handle);
+    handle = Invalid_Handle;
+}
+
+} // namespace Terra::SecUtil
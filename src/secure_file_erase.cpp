@@ -0,0 +1,804 @@
+/*
+ *  secure_file_erase.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements functions that erase files.  As in
+ *      secure_file.cpp, the operating system interfaces are wrapped by a few
+ *      small functions so that the erasing logic is shared between Unix-like
+ *      systems and Windows.
+ *
+ *      The regions of the file to overwrite are divided into pieces that do
+ *      not cross a multiple of File_Erase_Chunk_Size, and each thread takes
+ *      the next piece from a shared counter.  All threads write from the same
+ *      zeroed buffer, which is never modified.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/vfs.h>
+#endif
+#include <terra/secutil/secure_file_erase.h>
+#include <terra/secutil/secure_erase.h>
+#include <terra/secutil/secure_pages.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Value of a handle that does not refer to an open file
+constexpr std::intptr_t Invalid_Handle = -1;
+
+#if defined(__linux__)
+// File system types whose files reside only in memory
+constexpr std::uint32_t Tmpfs_Magic = 0x01021994;
+constexpr std::uint32_t Hugetlbfs_Magic = 0x958458f6;
+#endif
+
+// A region of a file
+struct Extent
+{
+    std::uint64_t offset;
+    std::uint64_t length;
+};
+
+/*
+ *  ThrowSystemError()
+ *
+ *  Description:
+ *      Throw a std::system_error for the most recent operating system error.
+ *
+ *  Parameters:
+ *      what [in]
+ *          Description of the operation that failed.
+ *
+ *  Returns:
+ *      Does not return.
+ *
+ *  Comments:
+ *      None.
+ */
+[[noreturn]] void ThrowSystemError(const char *what)
+{
+#if defined(_WIN32)
+    throw std::system_error(static_cast<int>(GetLastError()),
+                            std::system_category(),
+                            what);
+#else
+    throw std::system_error(errno, std::generic_category(), what);
+#endif
+}
+
+/*
+ *  OpenFile()
+ *
+ *  Description:
+ *      Open the given file for writing.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to open.
+ *
+ *  Returns:
+ *      The handle of the open file.
+ *
+ *  Comments:
+ *      This will throw std::system_error on failure.
+ */
+std::intptr_t OpenFile(const std::filesystem::path &path)
+{
+#if defined(_WIN32)
+    HANDLE handle = CreateFileW(path.c_str(),
+                                GENERIC_READ | GENERIC_WRITE,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE |
+                                    FILE_SHARE_DELETE,
+                                nullptr,
+                                OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL,
+                                nullptr);
+
+    if (handle == INVALID_HANDLE_VALUE) ThrowSystemError("Unable to open file");
+
+    return reinterpret_cast<std::intptr_t>(handle);
+#else
+    const int fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+
+    if (fd < 0) ThrowSystemError("Unable to open file");
+
+    return fd;
+#endif
+}
+
+/*
+ *  CloseFile()
+ *
+ *  Description:
+ *      Close the given file.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The file to close.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void CloseFile(std::intptr_t handle) noexcept
+{
+    if (handle == Invalid_Handle) return;
+
+#if defined(_WIN32)
+    CloseHandle(reinterpret_cast<HANDLE>(handle));
+#else
+    close(static_cast<int>(handle));
+#endif
+}
+
+/*
+ *  RegularFileSize()
+ *
+ *  Description:
+ *      Determine the size of the given file, which must be a regular file.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *  Returns:
+ *      The size of the file in octets.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the file is not a regular
+ *      file or std::system_error on failure.
+ */
+std::uint64_t RegularFileSize(std::intptr_t handle)
+{
+#if defined(_WIN32)
+    HANDLE file = reinterpret_cast<HANDLE>(handle);
+    LARGE_INTEGER file_size;
+
+    if (GetFileType(file) != FILE_TYPE_DISK)
+    {
+        throw std::invalid_argument("Not a regular file");
+    }
+    if (!GetFileSizeEx(file, &file_size)) ThrowSystemError("Unable to stat file");
+
+    return static_cast<std::uint64_t>(file_size.QuadPart);
+#else
+    struct stat status;
+
+    if (fstat(static_cast<int>(handle), &status) != 0)
+    {
+        ThrowSystemError("Unable to stat file");
+    }
+    if (!S_ISREG(status.st_mode))
+    {
+        throw std::invalid_argument("Not a regular file");
+    }
+
+    return static_cast<std::uint64_t>(status.st_size);
+#endif
+}
+
+/*
+ *  FileSystemType()
+ *
+ *  Description:
+ *      Determine the type of file system on which the given file resides.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *  Returns:
+ *      The file system's magic number, or zero if it cannot be determined.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint32_t FileSystemType([[maybe_unused]] std::intptr_t handle) noexcept
+{
+#if defined(__linux__)
+    struct statfs status;
+
+    if (fstatfs(static_cast<int>(handle), &status) != 0) return 0;
+
+    return static_cast<std::uint32_t>(status.f_type);
+#else
+    return 0;
+#endif
+}
+
+/*
+ *  IsMemoryBacked()
+ *
+ *  Description:
+ *      Determine whether a file system's files reside only in memory.
+ *
+ *  Parameters:
+ *      type [in]
+ *          The file system's magic number.
+ *
+ *  Returns:
+ *      True if the file system is tmpfs or hugetlbfs, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool IsMemoryBacked([[maybe_unused]] std::uint32_t type) noexcept
+{
+#if defined(__linux__)
+    return (type == Tmpfs_Magic) || (type == Hugetlbfs_Magic);
+#else
+    return false;
+#endif
+}
+
+/*
+ *  DataExtents()
+ *
+ *  Description:
+ *      Determine the regions of the file that hold data.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      size [in]
+ *          The size of the file.
+ *
+ *  Returns:
+ *      The regions holding data, in order.
+ *
+ *  Comments:
+ *      If the file system cannot report holes, the entire file is returned.
+ */
+std::vector<Extent> DataExtents([[maybe_unused]] std::intptr_t handle,
+                                std::uint64_t size)
+{
+    std::vector<Extent> extents;
+
+    if (size == 0) return extents;
+
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+    const int fd = static_cast<int>(handle);
+    off_t offset = 0;
+
+    while (static_cast<std::uint64_t>(offset) < size)
+    {
+        const off_t data = lseek(fd, offset, SEEK_DATA);
+        if (data < 0)
+        {
+            // ENXIO indicates there is no more data
+            if (errno == ENXIO) return extents;
+
+            // Otherwise, assume holes are not supported
+            break;
+        }
+
+        const off_t hole = lseek(fd, data, SEEK_HOLE);
+        if (hole < 0) break;
+
+        const std::uint64_t end =
+            std::min(static_cast<std::uint64_t>(hole), size);
+        if (end > static_cast<std::uint64_t>(data))
+        {
+            extents.push_back({static_cast<std::uint64_t>(data),
+                               end - static_cast<std::uint64_t>(data)});
+        }
+        offset = hole;
+    }
+
+    if (static_cast<std::uint64_t>(offset) >= size) return extents;
+
+    extents.clear();
+#endif
+
+    extents.push_back({0, size});
+
+    return extents;
+}
+
+/*
+ *  WriteAt()
+ *
+ *  Description:
+ *      Write the given buffer to the file at the given offset.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      buffer [in]
+ *          The data to write.
+ *
+ *      length [in]
+ *          The number of octets to write.
+ *
+ *      offset [in]
+ *          The file offset at which to write.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The file position is not used, so several threads may write to the
+ *      file at once.  This will throw std::system_error on failure.
+ */
+void WriteAt(std::intptr_t handle,
+             const std::uint8_t *buffer,
+             std::size_t length,
+             std::uint64_t offset)
+{
+    std::size_t total = 0;
+
+    while (total < length)
+    {
+#if defined(_WIN32)
+        const std::uint64_t position = offset + total;
+        OVERLAPPED overlapped{};
+        DWORD result = 0;
+
+        overlapped.Offset = static_cast<DWORD>(position & 0xffffffff);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+
+        if (!::WriteFile(reinterpret_cast<HANDLE>(handle),
+                         buffer + total,
+                         static_cast<DWORD>(length - total),
+                         &result,
+                         &overlapped))
+        {
+            ThrowSystemError("Unable to write file");
+        }
+#else
+        const ssize_t result = pwrite(static_cast<int>(handle),
+                                      buffer + total,
+                                      length - total,
+                                      static_cast<off_t>(offset + total));
+
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            ThrowSystemError("Unable to write file");
+        }
+#endif
+
+        if (result == 0)
+        {
+            throw std::system_error(std::make_error_code(std::errc::io_error),
+                                    "Unable to write file");
+        }
+
+        total += static_cast<std::size_t>(result);
+    }
+}
+
+/*
+ *  Overwrite()
+ *
+ *  Description:
+ *      Overwrite the given regions of the file with zeros.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      extents [in]
+ *          The regions to overwrite.
+ *
+ *      threads [in/out]
+ *          The number of threads requested, which is updated to the number
+ *          used.
+ *
+ *  Returns:
+ *      The number of octets written.
+ *
+ *  Comments:
+ *      The calling thread is one of the threads used.  If any write fails,
+ *      the remaining pieces are abandoned and the first exception thrown is
+ *      rethrown.
+ */
+std::uint64_t Overwrite(std::intptr_t handle,
+                        const std::vector<Extent> &extents,
+                        unsigned &threads)
+{
+    std::vector<Extent> pieces;
+    std::uint64_t total = 0;
+
+    for (const auto &extent : extents)
+    {
+        std::uint64_t offset = extent.offset;
+        const std::uint64_t end = extent.offset + extent.length;
+
+        while (offset < end)
+        {
+            const std::uint64_t boundary =
+                (offset / File_Erase_Chunk_Size + 1) * File_Erase_Chunk_Size;
+            const std::uint64_t length = std::min(boundary, end) - offset;
+
+            pieces.push_back({offset, length});
+            offset += length;
+        }
+        total += extent.length;
+    }
+
+    threads = static_cast<unsigned>(
+        std::clamp<std::size_t>(pieces.size(), 1, std::max(threads, 1U)));
+
+    if (pieces.empty()) return 0;
+
+    const SecurePages zeros(File_Erase_Chunk_Size);
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    auto worker = [&]()
+    {
+        try
+        {
+            std::size_t index;
+
+            while (!failed.load(std::memory_order_relaxed) &&
+                   ((index = next.fetch_add(1, std::memory_order_relaxed)) <
+                    pieces.size()))
+            {
+                WriteAt(handle,
+                        zeros.data(),
+                        static_cast<std::size_t>(pieces[index].length),
+                        pieces[index].offset);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+            failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> workers;
+
+    try
+    {
+        for (unsigned i = 1; i < threads; i++) workers.emplace_back(worker);
+    }
+    catch (...)
+    {
+        // Continue with the threads that were started
+        threads = static_cast<unsigned>(workers.size() + 1);
+    }
+
+    worker();
+    for (auto &thread : workers) thread.join();
+
+    if (error) std::rethrow_exception(error);
+
+    return total;
+}
+
+#if defined(__linux__)
+
+/*
+ *  OverwriteMapped()
+ *
+ *  Description:
+ *      Overwrite the file with zeros through a shared mapping of it.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      size [in]
+ *          The size of the file.
+ *
+ *  Returns:
+ *      The number of octets written.
+ *
+ *  Comments:
+ *      This is used for hugetlbfs, which does not support write().  The
+ *      size of such a file is always a multiple of its huge page size, so
+ *      the whole file can be mapped.  This will throw std::system_error if
+ *      the file cannot be mapped.
+ */
+std::uint64_t OverwriteMapped(std::intptr_t handle, std::uint64_t size)
+{
+    if (size == 0) return 0;
+
+    void *p = mmap(nullptr,
+                   static_cast<std::size_t>(size),
+                   PROT_READ | PROT_WRITE,
+                   MAP_SHARED,
+                   static_cast<int>(handle),
+                   0);
+    if (p == MAP_FAILED) ThrowSystemError("Unable to map file");
+
+    SecureErase(p, static_cast<std::size_t>(size));
+    munmap(p, static_cast<std::size_t>(size));
+
+    return size;
+}
+
+#endif
+
+/*
+ *  Flush()
+ *
+ *  Description:
+ *      Flush the file's data to storage.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::system_error on failure.
+ */
+void Flush(std::intptr_t handle)
+{
+#if defined(_WIN32)
+    if (!FlushFileBuffers(reinterpret_cast<HANDLE>(handle)))
+    {
+        ThrowSystemError("Unable to flush file");
+    }
+#else
+    while (fsync(static_cast<int>(handle)) != 0)
+    {
+        if (errno != EINTR) ThrowSystemError("Unable to flush file");
+    }
+#endif
+}
+
+/*
+ *  PunchHole()
+ *
+ *  Description:
+ *      Deallocate the storage holding the file's data, retaining its size.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      size [in]
+ *          The size of the file.
+ *
+ *  Returns:
+ *      True if the storage was deallocated, false if the file system does
+ *      not support doing so.
+ *
+ *  Comments:
+ *      None.
+ */
+bool PunchHole([[maybe_unused]] std::intptr_t handle,
+               [[maybe_unused]] std::uint64_t size) noexcept
+{
+#if defined(__linux__) && defined(FALLOC_FL_PUNCH_HOLE)
+    if (size == 0) return true;
+
+    return fallocate(static_cast<int>(handle),
+                     FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                     0,
+                     static_cast<off_t>(size)) == 0;
+#else
+    return false;
+#endif
+}
+
+/*
+ *  Truncate()
+ *
+ *  Description:
+ *      Truncate the file to zero length.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::system_error on failure.
+ */
+void Truncate(std::intptr_t handle)
+{
+#if defined(_WIN32)
+    FILE_END_OF_FILE_INFO information{};
+
+    if (!SetFileInformationByHandle(reinterpret_cast<HANDLE>(handle),
+                                    FileEndOfFileInfo,
+                                    &information,
+                                    sizeof(information)))
+    {
+        ThrowSystemError("Unable to truncate file");
+    }
+#else
+    while (ftruncate(static_cast<int>(handle), 0) != 0)
+    {
+        if (errno != EINTR) ThrowSystemError("Unable to truncate file");
+    }
+#endif
+}
+
+/*
+ *  EraseOpenFile()
+ *
+ *  Description:
+ *      Overwrite and deallocate the contents of an open file.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file.
+ *
+ *      threads [in]
+ *          The number of threads to use, or zero for the number of hardware
+ *          threads.
+ *
+ *      truncate [in]
+ *          Whether to truncate a file that is not memory-backed.  Memory-
+ *          backed files are always truncated to release their pages.
+ *
+ *  Returns:
+ *      A description of the work performed.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the file is not a regular
+ *      file or std::system_error on failure.
+ */
+FileEraseResult EraseOpenFile(std::intptr_t handle,
+                              unsigned threads,
+                              bool truncate)
+{
+    const auto start = std::chrono::steady_clock::now();
+    FileEraseResult result{};
+
+    if (threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1U);
+
+    const std::uint64_t size = RegularFileSize(handle);
+
+    const std::uint32_t type = FileSystemType(handle);
+
+    result.memory_backed = IsMemoryBacked(type);
+
+#if defined(__linux__)
+    // Files on hugetlbfs cannot be written, only mapped
+    if (type == Hugetlbfs_Magic)
+    {
+        result.bytes_overwritten = OverwriteMapped(handle, size);
+        threads = 1;
+    }
+    else
+#endif
+    {
+        result.bytes_overwritten =
+            Overwrite(handle, DataExtents(handle, size), threads);
+    }
+    result.threads = threads;
+
+    if (result.memory_backed)
+    {
+        Truncate(handle);
+    }
+    else
+    {
+        Flush(handle);
+        result.hole_punched = PunchHole(handle, size);
+        if (truncate) Truncate(handle);
+    }
+
+    result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    return result;
+}
+
+} // namespace
+
+/*
+ *  SecureEraseFile()
+ *
+ *  Description:
+ *      Overwrite the contents of the given file with zeros, deallocate its
+ *      storage, and remove it.
+ *
+ *  Parameters:
+ *      path [in]
+ *          The file to erase.
+ *
+ *      threads [in]
+ *          The number of threads to use to overwrite the file, or zero for
+ *          the number of hardware threads.
+ *
+ *  Returns:
+ *      A description of the work performed.
+ *
+ *  Comments:
+ *      The file is not truncated before removal (other than on tmpfs), so
+ *      that remaining links to it show zeros rather than an empty file.
+ */
+FileEraseResult SecureEraseFile(const std::filesystem::path &path,
+                                unsigned threads)
+{
+    const std::intptr_t handle = OpenFile(path);
+    FileEraseResult result;
+
+    try
+    {
+        result = EraseOpenFile(handle, threads, false);
+    }
+    catch (...)
+    {
+        CloseFile(handle);
+        throw;
+    }
+
+    CloseFile(handle);
+
+    std::error_code error;
+    if (!std::filesystem::remove(path, error) && error)
+    {
+        throw std::system_error(error, "Unable to remove file");
+    }
+
+    return result;
+}
+
+/*
+ *  SecureEraseFileContents()
+ *
+ *  Description:
+ *      Overwrite the contents of an open file with zeros, deallocate its
+ *      storage, and truncate it to zero length.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The open file, which remains open.
+ *
+ *      threads [in]
+ *          The number of threads to use to overwrite the file, or zero for
+ *          the number of hardware threads.
+ *
+ *  Returns:
+ *      A description of the work performed.
+ *
+ *  Comments:
+ *      None.
+ */
+FileEraseResult SecureEraseFileContents(std::intptr_t handle, unsigned threads)
+{
+    return EraseOpenFile(handle, threads, true);
+}
+
+} // namespace Terra::SecUtil
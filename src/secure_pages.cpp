@@ -0,0 +1,374 @@
+/*
+ *  secure_pages.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the SecurePages object, which owns a block of
+ *      page-aligned memory mapped directly from the operating system.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <terra/secutil/secure_pages.h>
+#include <terra/secutil/secure_erase.h>
+#include <terra/secutil/wipe_registry.h>
+
+namespace Terra::SecUtil
+{
+
+/*
+ *  SecurePages::SecurePages()
+ *
+ *  Description:
+ *      Default constructor, which creates an empty object owning no memory.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SecurePages::SecurePages() noexcept :
+    buffer{nullptr},
+    length{0},
+    mapped_length{0},
+    locked{false},
+    erase_method{PageEraseMethod::Overwrite}
+{
+}
+
+/*
+ *  SecurePages::SecurePages()
+ *
+ *  Description:
+ *      Map a block of zero-filled memory of at least the given size.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The number of octets required.  The mapping is rounded up to a
+ *          multiple of the system page size.
+ *
+ *      method [in]
+ *          How the memory is to be erased.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::system_error if the memory cannot be mapped.
+ *      The memory is not locked; call Lock() to lock it.
+ */
+SecurePages::SecurePages(std::size_t size, PageEraseMethod method) :
+    SecurePages()
+{
+    erase_method = method;
+
+    if (size == 0) return;
+
+    const std::size_t page_size = PageSize();
+    const std::size_t rounded = ((size + page_size - 1) / page_size) *
+                                page_size;
+
+    if (rounded < size)
+    {
+        throw std::system_error(std::make_error_code(std::errc::not_enough_memory),
+                                "Requested size is too large");
+    }
+
+#if defined(_WIN32)
+    void *p = VirtualAlloc(nullptr,
+                           rounded,
+                           MEM_COMMIT | MEM_RESERVE,
+                           PAGE_READWRITE);
+    if (p == nullptr)
+    {
+        throw std::system_error(static_cast<int>(GetLastError()),
+                                std::system_category(),
+                                "VirtualAlloc failed");
+    }
+#else
+    void *p = mmap(nullptr,
+                   rounded,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS,
+                   -1,
+                   0);
+    if (p == MAP_FAILED)
+    {
+        throw std::system_error(errno, std::generic_category(), "mmap failed");
+    }
+
+#if defined(MADV_DONTDUMP)
+    // Exclude the memory from core dumps; failure is not fatal
+    madvise(p, rounded, MADV_DONTDUMP);
+#endif
+#endif
+
+    buffer = static_cast<std::uint8_t *>(p);
+    length = size;
+    mapped_length = rounded;
+
+    RegisterSecureRegion(buffer, mapped_length);
+}
+
+/*
+ *  SecurePages::SecurePages()
+ *
+ *  Description:
+ *      Move constructor.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The object from which memory ownership is taken.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The other object is left empty.
+ */
+SecurePages::SecurePages(SecurePages &&other) noexcept :
+    buffer{std::exchange(other.buffer, nullptr)},
+    length{std::exchange(other.length, 0)},
+    mapped_length{std::exchange(other.mapped_length, 0)},
+    locked{std::exchange(other.locked, false)},
+    erase_method{other.erase_method}
+{
+}
+
+/*
+ *  SecurePages::~SecurePages()
+ *
+ *  Description:
+ *      Erase, unlock, and unmap the memory.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SecurePages::~SecurePages()
+{
+    Release();
+}
+
+/*
+ *  SecurePages::operator=()
+ *
+ *  Description:
+ *      Move assignment operator.  Any memory presently owned is erased and
+ *      unmapped before taking ownership of the other object's memory.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The object from which memory ownership is taken.
+ *
+ *  Returns:
+ *      A reference to this object.
+ *
+ *  Comments:
+ *      The other object is left empty.
+ */
+SecurePages &SecurePages::operator=(SecurePages &&other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+
+        buffer = std::exchange(other.buffer, nullptr);
+        length = std::exchange(other.length, 0);
+        mapped_length = std::exchange(other.mapped_length, 0);
+        locked = std::exchange(other.locked, false);
+        erase_method = other.erase_method;
+    }
+
+    return *this;
+}
+
+/*
+ *  SecurePages::Lock()
+ *
+ *  Description:
+ *      Lock the memory so that it is not written to swap.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if the memory is locked, false if the operating system refused
+ *      the request (e.g., because the locked memory limit was reached).
+ *
+ *  Comments:
+ *      Locking an empty object trivially succeeds.
+ */
+bool SecurePages::Lock() noexcept
+{
+    if (locked || (buffer == nullptr)) return true;
+
+#if defined(_WIN32)
+    locked = (VirtualLock(buffer, mapped_length) != 0);
+#else
+    locked = (mlock(buffer, mapped_length) == 0);
+#endif
+
+    return locked;
+}
+
+/*
+ *  SecurePages::Unlock()
+ *
+ *  Description:
+ *      Unlock the memory so that it may again be written to swap.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SecurePages::Unlock() noexcept
+{
+    if (!locked) return;
+
+#if defined(_WIN32)
+    VirtualUnlock(buffer, mapped_length);
+#else
+    munlock(buffer, mapped_length);
+#endif
+
+    locked = false;
+}
+
+/*
+ *  SecurePages::Erase()
+ *
+ *  Description:
+ *      Erase the entire mapping, including octets beyond size(), while
+ *      retaining ownership of it.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      With PageEraseMethod::Discard, the pages are dropped using
+ *      madvise(MADV_DONTNEED) and are faulted in again as zero-filled pages
+ *      when next touched.  That is only possible on Linux and only for
+ *      unlocked memory; otherwise, the memory is overwritten.
+ */
+void SecurePages::Erase() noexcept
+{
+    if (buffer == nullptr) return;
+
+#if defined(__linux__)
+    if ((erase_method == PageEraseMethod::Discard) && !locked &&
+        (madvise(buffer, mapped_length, MADV_DONTNEED) == 0))
+    {
+        return;
+    }
+#endif
+
+    SecureErase(buffer, mapped_length);
+}
+
+/*
+ *  SecurePages::PageSize()
+ *
+ *  Description:
+ *      Return the system page size.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The page size in octets.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t SecurePages::PageSize() noexcept
+{
+    static const std::size_t page_size = []() -> std::size_t
+    {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+#else
+        const long result = sysconf(_SC_PAGESIZE);
+        return (result > 0) ? static_cast<std::size_t>(result) : 4096;
+#endif
+    }();
+
+    return page_size;
+}
+
+/*
+ *  SecurePages::Release()
+ *
+ *  Description:
+ *      Erase, unlock, and unmap any memory owned by this object, leaving
+ *      the object empty.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The entire mapping is erased, including octets beyond size().  With
+ *      PageEraseMethod::Discard, the memory is not overwritten, as
+ *      unmapping it returns the pages to the kernel.
+ */
+void SecurePages::Release() noexcept
+{
+    if (buffer == nullptr) return;
+
+    DeregisterSecureRegion(buffer, mapped_length);
+    if (erase_method == PageEraseMethod::Overwrite)
+    {
+        SecureErase(buffer, mapped_length);
+    }
+    Unlock();
+
+#if defined(_WIN32)
+    VirtualFree(buffer, 0, MEM_RELEASE);
+#else
+    munmap(buffer, mapped_length);
+#endif
+
+    buffer = nullptr;
+    length = 0;
+    mapped_length = 0;
+}
+
+} // namespace Terra::SecUtil
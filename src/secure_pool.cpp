@@ -0,0 +1,668 @@
+/*
+ *  secure_pool.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the SecurePool object.
+ *
+ *      Each chunk hands out blocks by first advancing through space never
+ *      used ("carving") and then from its free list, so pages are touched
+ *      only as the pool grows.  A freed block's first word links it into the
+ *      free list; that word is zeroed again when the block is reused.
+ *
+ *      A chunk becomes idle when its last block is freed.  To keep reading
+ *      the clock out of Deallocate(), the time is recorded by the first
+ *      Trim() to find the chunk idle, and the chunk's idle time is measured
+ *      from then.  Since every block was erased as it was freed, an idle
+ *      chunk holds only erased memory, free list links, and block headers,
+ *      so it is unmapped without being overwritten again.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <system_error>
+#include <terra/secutil/secure_pool.h>
+#include <terra/secutil/secure_allocator.h>
+#include <terra/secutil/secure_erase.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+/*
+ *  Add()
+ *
+ *  Description:
+ *      Add to a counter that is only modified while holding a mutex.
+ *
+ *  Parameters:
+ *      counter [in/out]
+ *          The counter to modify.
+ *
+ *      value [in]
+ *          The value to add, which wraps to subtract.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The counter is atomic only so that it may be read without the mutex,
+ *      so a locked read-modify-write instruction is not required.
+ */
+void Add(std::atomic<std::size_t> &counter, std::size_t value) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+}
+
+} // namespace
+
+/*
+ *  SecurePool::SecurePool()
+ *
+ *  Description:
+ *      Constructor for the SecurePool object.
+ *
+ *  Parameters:
+ *      chunk_size [in]
+ *          The size in octets of the chunks from which blocks are carved.
+ *          Chunks are always large enough to hold at least one block.
+ *
+ *      decay [in]
+ *          The time a chunk must remain idle before Trim() or the scavenger
+ *          returns it to the operating system.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      No memory is reserved until the first allocation.
+ */
+SecurePool::SecurePool(std::size_t chunk_size,
+                       std::chrono::nanoseconds decay) :
+    chunk_size{chunk_size},
+    decay{decay},
+    classes{},
+    large_bytes{0},
+    scavenger_stopping{false}
+{
+}
+
+/*
+ *  SecurePool::~SecurePool()
+ *
+ *  Description:
+ *      Stop the scavenger thread, if running, and release all chunks.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SecurePool::~SecurePool()
+{
+    StopScavenger();
+}
+
+/*
+ *  SecurePool::Allocate()
+ *
+ *  Description:
+ *      Allocate a block of secure memory.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the block in octets.
+ *
+ *  Returns:
+ *      A pointer to the block, aligned to alignof(std::max_align_t).
+ *
+ *  Comments:
+ *      This will throw std::bad_alloc if memory cannot be allocated.
+ */
+void *SecurePool::Allocate(std::size_t size)
+{
+    // Large requests are served by the SecureAllocator
+    if (size > Max_Pool_Block)
+    {
+        if (size > std::numeric_limits<std::size_t>::max() - sizeof(BlockHeader))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        std::uint8_t *block =
+            SecureAllocator<std::uint8_t>().allocate(sizeof(BlockHeader) + size);
+        ::new (block) BlockHeader{nullptr, size};
+
+        large_bytes.fetch_add(size, std::memory_order_relaxed);
+
+        return block + sizeof(BlockHeader);
+    }
+
+    const std::size_t index = ClassIndex(size);
+    const std::size_t stride = sizeof(BlockHeader) + ClassSize(index);
+    SizeClass &size_class = classes[index];
+    std::uint8_t *block;
+    Chunk *chunk;
+
+    {
+        std::lock_guard<std::mutex> lock(size_class.mutex);
+
+        // Create a new chunk if no existing chunk has space
+        if (size_class.available.empty())
+        {
+            auto new_chunk = std::make_unique<Chunk>();
+
+            try
+            {
+                new_chunk->pages = SecurePages(std::max(chunk_size, stride));
+            }
+            catch (const std::system_error &)
+            {
+                throw std::bad_alloc();
+            }
+            new_chunk->pages.Lock();
+            new_chunk->size_class = index;
+            new_chunk->capacity = new_chunk->pages.capacity() / stride;
+            new_chunk->carved = 0;
+            new_chunk->outstanding = 0;
+            new_chunk->free_list = nullptr;
+            new_chunk->available = true;
+            new_chunk->idle_since = {};
+
+            size_class.chunks.reserve(size_class.chunks.size() + 1);
+            size_class.available.reserve(size_class.available.size() + 1);
+            size_class.available.push_back(new_chunk.get());
+            size_class.chunks.push_back(std::move(new_chunk));
+
+            // A new chunk is counted as idle until its first block is taken
+            Add(size_class.reserved_bytes,
+                size_class.chunks.back()->pages.capacity());
+            Add(size_class.retained_bytes,
+                size_class.chunks.back()->pages.capacity());
+        }
+
+        chunk = size_class.available.back();
+
+        if (chunk->outstanding == 0)
+        {
+            Add(size_class.retained_bytes, 0 - chunk->pages.capacity());
+        }
+
+        // Reuse a freed block, else carve a new one
+        if (chunk->free_list != nullptr)
+        {
+            block = chunk->free_list;
+            std::memcpy(&chunk->free_list,
+                        block + sizeof(BlockHeader),
+                        sizeof(chunk->free_list));
+            std::uint8_t *const no_link = nullptr;
+            std::memcpy(block + sizeof(BlockHeader),
+                        &no_link,
+                        sizeof(no_link));
+        }
+        else
+        {
+            block = chunk->pages.data() + chunk->carved * stride;
+            chunk->carved++;
+        }
+
+        chunk->outstanding++;
+        Add(size_class.in_use_bytes, size);
+
+        if ((chunk->free_list == nullptr) && (chunk->carved == chunk->capacity))
+        {
+            chunk->available = false;
+            size_class.available.pop_back();
+        }
+    }
+
+    ::new (block) BlockHeader{chunk, size};
+
+    return block + sizeof(BlockHeader);
+}
+
+/*
+ *  SecurePool::Deallocate()
+ *
+ *  Description:
+ *      Erase a block and return it to the pool.
+ *
+ *  Parameters:
+ *      p [in]
+ *          A pointer returned by Allocate(), or nullptr.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Only the octets requested when the block was allocated are erased,
+ *      since the remainder was erased when the block was last freed.
+ */
+void SecurePool::Deallocate(void *p) noexcept
+{
+    if (p == nullptr) return;
+
+    std::uint8_t *block = static_cast<std::uint8_t *>(p) - sizeof(BlockHeader);
+    const BlockHeader *header =
+        std::launder(reinterpret_cast<BlockHeader *>(block));
+    Chunk *chunk = header->chunk;
+    const std::size_t size = header->size;
+
+    // The SecureAllocator erases large blocks as they are freed
+    if (chunk == nullptr)
+    {
+        large_bytes.fetch_sub(size, std::memory_order_relaxed);
+        SecureAllocator<std::uint8_t>().deallocate(block,
+                                                   sizeof(BlockHeader) + size);
+        return;
+    }
+
+    SecureErase(p, size);
+
+    SizeClass &size_class = classes[chunk->size_class];
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+
+    std::memcpy(p, &chunk->free_list, sizeof(chunk->free_list));
+    chunk->free_list = block;
+    chunk->outstanding--;
+    Add(size_class.in_use_bytes, 0 - size);
+
+    if (chunk->outstanding == 0)
+    {
+        chunk->idle_since = {};
+        Add(size_class.retained_bytes, chunk->pages.capacity());
+    }
+
+    if (!chunk->available)
+    {
+        chunk->available = true;
+        size_class.available.push_back(chunk);
+    }
+}
+
+/*
+ *  SecurePool::ReservedBytes()
+ *
+ *  Description:
+ *      Return the amount of memory reserved by the pool.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of octets in chunks plus the size of large blocks.
+ *
+ *  Comments:
+ *      The result is approximate while other threads use the pool.
+ */
+std::size_t SecurePool::ReservedBytes() const noexcept
+{
+    std::size_t total = large_bytes.load(std::memory_order_relaxed);
+
+    for (const auto &size_class : classes)
+    {
+        total += size_class.reserved_bytes.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+/*
+ *  SecurePool::InUseBytes()
+ *
+ *  Description:
+ *      Return the amount of memory allocated from the pool.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The sum of the sizes requested for blocks not yet freed.
+ *
+ *  Comments:
+ *      The result is approximate while other threads use the pool.
+ */
+std::size_t SecurePool::InUseBytes() const noexcept
+{
+    std::size_t total = large_bytes.load(std::memory_order_relaxed);
+
+    for (const auto &size_class : classes)
+    {
+        total += size_class.in_use_bytes.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+/*
+ *  SecurePool::RetainedBytes()
+ *
+ *  Description:
+ *      Return the amount of memory held in idle chunks.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of octets in chunks in which every block is free.
+ *
+ *  Comments:
+ *      This is the memory that Trim() would release once the chunks have
+ *      been idle long enough.  The result is approximate while other
+ *      threads use the pool.
+ */
+std::size_t SecurePool::RetainedBytes() const noexcept
+{
+    std::size_t total = 0;
+
+    for (const auto &size_class : classes)
+    {
+        total += size_class.retained_bytes.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+/*
+ *  SecurePool::ReleasedBytes()
+ *
+ *  Description:
+ *      Return the amount of memory returned to the operating system.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The total number of octets in chunks released by Trim() and the
+ *      scavenger over the life of the pool.
+ *
+ *  Comments:
+ *      The result is approximate while other threads use the pool.
+ */
+std::size_t SecurePool::ReleasedBytes() const noexcept
+{
+    std::size_t total = 0;
+
+    for (const auto &size_class : classes)
+    {
+        total += size_class.released_bytes.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+/*
+ *  SecurePool::Trim()
+ *
+ *  Description:
+ *      Return to the operating system the chunks that have been idle for at
+ *      least the pool's decay time.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of octets released.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t SecurePool::Trim() noexcept
+{
+    return Trim(decay);
+}
+
+/*
+ *  SecurePool::Trim()
+ *
+ *  Description:
+ *      Return to the operating system the chunks that have been idle for at
+ *      least the given time.
+ *
+ *  Parameters:
+ *      idle [in]
+ *          How long a chunk must have been idle.  Zero releases every idle
+ *          chunk.
+ *
+ *  Returns:
+ *      The number of octets released.
+ *
+ *  Comments:
+ *      A chunk's idle time is measured from the first call to find it
+ *      idle, so a non-zero idle time releases nothing on the first call
+ *      after a chunk becomes idle.  Released chunks are not erased again, since each block was erased
+ *      when freed.  Chunks are unmapped while holding the size class mutex,
+ *      which briefly delays allocations of that size class.
+ */
+std::size_t SecurePool::Trim(std::chrono::nanoseconds idle) noexcept
+{
+    const auto now = std::chrono::steady_clock::now();
+    std::size_t released = 0;
+
+    for (auto &size_class : classes)
+    {
+        std::lock_guard<std::mutex> lock(size_class.mutex);
+
+        for (std::size_t i = 0; i < size_class.chunks.size();)
+        {
+            Chunk *chunk = size_class.chunks[i].get();
+
+            if (chunk->outstanding != 0)
+            {
+                i++;
+                continue;
+            }
+
+            if (chunk->idle_since == std::chrono::steady_clock::time_point{})
+            {
+                chunk->idle_since = now;
+            }
+
+            if (now - chunk->idle_since < idle)
+            {
+                i++;
+                continue;
+            }
+
+            const std::size_t capacity = chunk->pages.capacity();
+
+            // An idle chunk has free blocks, so it is in the available list
+            std::erase(size_class.available, chunk);
+
+            chunk->pages.SetEraseMethod(PageEraseMethod::Discard);
+            std::swap(size_class.chunks[i], size_class.chunks.back());
+            size_class.chunks.pop_back();
+
+            Add(size_class.reserved_bytes, 0 - capacity);
+            Add(size_class.retained_bytes, 0 - capacity);
+            Add(size_class.released_bytes, capacity);
+            released += capacity;
+        }
+    }
+
+    return released;
+}
+
+/*
+ *  SecurePool::StartScavenger()
+ *
+ *  Description:
+ *      Start a thread that periodically returns idle chunks to the
+ *      operating system.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The thread runs Trim() every half decay time (but no more often than
+ *      every millisecond) until StopScavenger() is called or the pool is
+ *      destroyed.  Calling this while the thread is running has no effect.
+ *      This will throw std::system_error if the thread cannot be started.
+ */
+void SecurePool::StartScavenger()
+{
+    std::lock_guard<std::mutex> lock(scavenger_mutex);
+
+    if (scavenger.joinable()) return;
+
+    scavenger_stopping = false;
+    scavenger = std::thread(&SecurePool::Scavenge, this);
+}
+
+/*
+ *  SecurePool::StopScavenger()
+ *
+ *  Description:
+ *      Stop the thread started by StartScavenger().
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SecurePool::StopScavenger() noexcept
+{
+    std::thread thread;
+
+    {
+        std::lock_guard<std::mutex> lock(scavenger_mutex);
+
+        scavenger_stopping = true;
+        thread.swap(scavenger);
+    }
+
+    scavenger_wake.notify_all();
+
+    if (thread.joinable()) thread.join();
+}
+
+/*
+ *  SecurePool::Scavenge()
+ *
+ *  Description:
+ *      Body of the scavenger thread, which trims the pool periodically.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SecurePool::Scavenge() noexcept
+{
+    const auto interval =
+        std::max<std::chrono::nanoseconds>(decay / 2,
+                                           std::chrono::milliseconds(1));
+    std::unique_lock<std::mutex> lock(scavenger_mutex);
+
+    while (!scavenger_wake.wait_for(lock,
+                                    interval,
+                                    [&]() { return scavenger_stopping; }))
+    {
+        lock.unlock();
+        Trim();
+        lock.lock();
+    }
+}
+
+/*
+ *  SecurePool::ClassIndex()
+ *
+ *  Description:
+ *      Return the index of the smallest size class holding the given size.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The requested size in octets, which must not exceed
+ *          Max_Pool_Block.
+ *
+ *  Returns:
+ *      The size class index.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t SecurePool::ClassIndex(std::size_t size) noexcept
+{
+    std::size_t index = 0;
+
+    while (ClassSize(index) < size) index++;
+
+    return index;
+}
+
+/*
+ *  SecurePool::ClassSize()
+ *
+ *  Description:
+ *      Return the block size of the given size class.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The size class index.
+ *
+ *  Returns:
+ *      The block size in octets.
+ *
+ *  Comments:
+ *      Sizes alternate between powers of two and the midpoints between them
+ *      (32, 48, 64, 96, ...), so no more than a third of a block is unused.
+ */
+std::size_t SecurePool::ClassSize(std::size_t index) noexcept
+{
+    const std::size_t base = std::size_t{32} << (index / 2);
+
+    return (index % 2 == 0) ? base : base + base / 2;
+}
+
+/*
+ *  DefaultSecurePool()
+ *
+ *  Description:
+ *      Return the process-wide secure pool.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the pool.
+ *
+ *  Comments:
+ *      None.
+ */
+SecurePool &DefaultSecurePool()
+{
+    static SecurePool pool;
+
+    return pool;
+}
+
+} // namespace Terra::SecUtil
@@ -0,0 +1,279 @@
+/*
+ *  secure_random.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module contains code that will fill memory with random octets
+ *      obtained from the operating system.  Small requests are satisfied
+ *      from a per-thread buffer held in a SecureArray, which is refilled with
+ *      a single call to the operating system when exhausted.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <atomic>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#if defined(_WIN32)
+#include <Windows.h>
+#include <bcrypt.h>
+#else
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(HAVE_GETRANDOM)
+#include <sys/random.h>
+#else
+#include <cstdlib>
+#endif
+#endif
+#include <terra/secutil/secure_random.h>
+#include <terra/secutil/secure_array.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Size of the per-thread buffer of random octets
+constexpr std::size_t Random_Pool_Size = 4096;
+
+// Requests at least this large bypass the per-thread buffer
+constexpr std::size_t Direct_Request_Size = Random_Pool_Size / 2;
+
+// Incremented in the child process each time the process forks
+std::atomic<std::uint64_t> fork_generation{0};
+
+// Per-thread buffer of random octets
+struct RandomPool
+{
+    SecureArray<std::uint8_t, Random_Pool_Size> buffer{};
+    std::size_t available{0};
+    std::uint64_t generation{0};
+};
+
+thread_local RandomPool random_pool;
+
+/*
+ *  SystemRandom()
+ *
+ *  Description:
+ *      Fill the given buffer with random octets from the operating system.
+ *
+ *  Parameters:
+ *      buffer [out]
+ *          Pointer to buffer to fill.
+ *
+ *      length [in]
+ *          Number of random octets to produce.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function will throw std::system_error on failure.
+ */
+void SystemRandom(void *buffer, std::size_t length)
+{
+    auto *p = static_cast<std::uint8_t *>(buffer);
+
+#if defined(_WIN32)
+    while (length > 0)
+    {
+        const ULONG chunk = static_cast<ULONG>(
+            std::min<std::size_t>(length, 0x40000000));
+
+        if (!BCRYPT_SUCCESS(BCryptGenRandom(nullptr,
+                                            p,
+                                            chunk,
+                                            BCRYPT_USE_SYSTEM_PREFERRED_RNG)))
+        {
+            throw std::system_error(
+                std::make_error_code(std::errc::io_error),
+                "BCryptGenRandom failed");
+        }
+
+        p += chunk;
+        length -= chunk;
+    }
+#elif defined(HAVE_GETRANDOM)
+    while (length > 0)
+    {
+        const ssize_t result = getrandom(p, length, 0);
+
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno,
+                                    std::generic_category(),
+                                    "getrandom failed");
+        }
+
+        p += result;
+        length -= static_cast<std::size_t>(result);
+    }
+#elif defined(__APPLE__) || defined(__OpenBSD__) || defined(__NetBSD__)
+    arc4random_buf(p, length);
+#else
+    const int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::system_error(errno,
+                                std::generic_category(),
+                                "Unable to open /dev/urandom");
+    }
+
+    while (length > 0)
+    {
+        const ssize_t result = read(fd, p, length);
+
+        if (result <= 0)
+        {
+            if ((result < 0) && (errno == EINTR)) continue;
+            const int error = (result < 0) ? errno : EIO;
+            close(fd);
+            throw std::system_error(error,
+                                    std::generic_category(),
+                                    "Unable to read /dev/urandom");
+        }
+
+        p += result;
+        length -= static_cast<std::size_t>(result);
+    }
+
+    close(fd);
+#endif
+}
+
+#if !defined(_WIN32)
+/*
+ *  ForkChildHandler()
+ *
+ *  Description:
+ *      Called in the child process after a fork to invalidate the octets
+ *      buffered by every thread.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ForkChildHandler()
+{
+    fork_generation.fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
+/*
+ *  RegisterForkHandler()
+ *
+ *  Description:
+ *      Register the fork handler exactly once.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void RegisterForkHandler()
+{
+#if !defined(_WIN32)
+    static const int registered =
+        pthread_atfork(nullptr, nullptr, ForkChildHandler);
+
+    static_cast<void>(registered);
+#endif
+}
+
+} // namespace
+
+/*
+ *  SecureRandom()
+ *
+ *  Description:
+ *      This function will fill the given buffer with random octets.
+ *
+ *  Parameters:
+ *      buffer [out]
+ *          Pointer to buffer to fill.
+ *
+ *      length [in]
+ *          Number of random octets to produce.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function will throw std::system_error if the operating system
+ *      fails to provide random data.
+ */
+void SecureRandom(void *buffer, std::size_t length)
+{
+    auto *p = static_cast<std::uint8_t *>(buffer);
+
+    // Nothing to do if pointer is null or if the length is zero
+    if ((buffer == nullptr) || (length == 0)) return;
+
+    // Large requests are satisfied directly by the operating system
+    if (length >= Direct_Request_Size)
+    {
+        SystemRandom(p, length);
+        return;
+    }
+
+    RegisterForkHandler();
+
+    RandomPool &pool = random_pool;
+
+    // If the process forked, discard octets also held by the parent
+    const std::uint64_t generation =
+        fork_generation.load(std::memory_order_relaxed);
+    if (pool.generation != generation)
+    {
+        SecureErase(pool.buffer);
+        pool.available = 0;
+        pool.generation = generation;
+    }
+
+    while (length > 0)
+    {
+        // Refill the pool when exhausted
+        if (pool.available == 0)
+        {
+            SystemRandom(pool.buffer.data(), pool.buffer.size());
+            pool.available = pool.buffer.size();
+        }
+
+        // Consume octets from the front of the unused region
+        const std::size_t offset = pool.buffer.size() - pool.available;
+        const std::size_t count = std::min(length, pool.available);
+
+        std::memcpy(p, pool.buffer.data() + offset, count);
+        SecureErase(pool.buffer.data() + offset, count);
+
+        pool.available -= count;
+        p += count;
+        length -= count;
+    }
+}
+
+} // namespace Terra::SecUtil
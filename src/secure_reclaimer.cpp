@@ -0,0 +1,471 @@
+/*
+ *  secure_reclaimer.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the SecureReclaimer.  The background thread
+ *      erases queued blocks in the order received and records the rate at
+ *      which it erases memory.  Reclaim() uses that rate to estimate how
+ *      long the queued blocks will take to erase and, if the new block
+ *      could not be erased within the deadline, erases it immediately.
+ *
+ *      Erased blocks kept for reuse are not registered with the wipe
+ *      registry, since they hold no secrets, until handed out again.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <utility>
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#include <terra/secutil/secure_reclaimer.h>
+#include <terra/secutil/wipe_registry.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Erase rate assumed before any block is erased, in octets per nanosecond
+constexpr double Initial_Erase_Rate = 1.0;
+
+// Weight given to each new erase rate measurement
+constexpr double Erase_Rate_Weight = 0.25;
+
+} // namespace
+
+/*
+ *  SecureReclaimer::SecureReclaimer()
+ *
+ *  Description:
+ *      Start the background thread that erases reclaimed blocks.
+ *
+ *  Parameters:
+ *      deadline [in]
+ *          The longest a reclaimed block should await erasure.
+ *
+ *      cache_limit [in]
+ *          The number of octets of erased blocks to keep for reuse.  Blocks
+ *          beyond this are returned to the operating system.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::system_error if the thread cannot be started.
+ */
+SecureReclaimer::SecureReclaimer(std::chrono::nanoseconds deadline,
+                                 std::size_t cache_limit) :
+    deadline{deadline},
+    cache_limit{cache_limit},
+    erase_rate{Initial_Erase_Rate},
+    stopping{false},
+    erasing{false},
+    statistics{},
+    thread{&SecureReclaimer::Run, this}
+{
+}
+
+/*
+ *  SecureReclaimer::~SecureReclaimer()
+ *
+ *  Description:
+ *      Erase any queued blocks, stop the background thread, and return all
+ *      cached blocks to the operating system.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SecureReclaimer::~SecureReclaimer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work.notify_one();
+    thread.join();
+
+    Trim();
+}
+
+/*
+ *  SecureReclaimer::Reclaim()
+ *
+ *  Description:
+ *      Queue a block to be erased by the background thread.
+ *
+ *  Parameters:
+ *      pages [in]
+ *          The block to reclaim, which is left empty.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The block is erased by the calling thread if blocks already queued
+ *      would prevent it from being erased within the deadline or if it
+ *      cannot be queued.
+ */
+void SecureReclaimer::Reclaim(SecurePages &&pages) noexcept
+{
+    SecurePages block = std::move(pages);
+
+    if (block.buffer == nullptr) return;
+
+    const auto now = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        const double backlog =
+            static_cast<double>(statistics.queued_bytes + block.mapped_length) /
+            erase_rate;
+
+        // With nothing queued, the block is erased as soon as it would be
+        // if erased now
+        if (!stopping &&
+            (queue.empty() || (backlog <= static_cast<double>(deadline.count()))))
+        {
+            const std::size_t length = block.mapped_length;
+
+            try
+            {
+                queue.push_back({std::move(block), now});
+            }
+            catch (...)
+            {
+                // The block is erased when the failed entry is destroyed
+                statistics.inline_erasures++;
+                return;
+            }
+
+            // Stale pointers into the block must not reach the secret
+            Entry &entry = queue.back();
+            DeregisterSecureRegion(entry.pages.buffer, length);
+            Protect(entry.pages, false);
+
+            statistics.queue_depth++;
+            statistics.queued_bytes += length;
+            work.notify_one();
+
+            return;
+        }
+
+        statistics.inline_erasures++;
+    }
+
+    block = SecurePages();
+}
+
+/*
+ *  SecureReclaimer::Acquire()
+ *
+ *  Description:
+ *      Obtain a block of at least the given size, reusing an erased block
+ *      if a suitable one is cached.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The number of octets required.
+ *
+ *  Returns:
+ *      The block, which is zero-filled.
+ *
+ *  Comments:
+ *      A cached block is reused only if it is no more than twice the size
+ *      required.  A reused block remains locked if it was locked and keeps
+ *      the erase method it was given by its previous owner.  This
+ *      will throw std::system_error if a new block cannot be mapped.
+ */
+SecurePages SecureReclaimer::Acquire(std::size_t size)
+{
+    if (size == 0) return SecurePages();
+
+    SecurePages pages;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto best = cache.end();
+        for (auto it = cache.begin(); it != cache.end(); ++it)
+        {
+            if ((it->mapped_length >= size) &&
+                (it->mapped_length / 2 <= size) &&
+                ((best == cache.end()) ||
+                 (it->mapped_length < best->mapped_length)))
+            {
+                best = it;
+            }
+        }
+
+        if (best != cache.end())
+        {
+            pages = std::move(*best);
+            std::swap(*best, cache.back());
+            cache.pop_back();
+
+            statistics.cached_blocks--;
+            statistics.cached_bytes -= pages.mapped_length;
+            statistics.reused_blocks++;
+        }
+    }
+
+    if (pages.buffer == nullptr) return SecurePages(size);
+
+    pages.length = size;
+    RegisterSecureRegion(pages.buffer, pages.mapped_length);
+
+    return pages;
+}
+
+/*
+ *  SecureReclaimer::Drain()
+ *
+ *  Description:
+ *      Wait until every queued block has been erased.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SecureReclaimer::Drain()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    idle.wait(lock, [&]() { return queue.empty() && !erasing; });
+}
+
+/*
+ *  SecureReclaimer::Trim()
+ *
+ *  Description:
+ *      Return all cached blocks to the operating system.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SecureReclaimer::Trim() noexcept
+{
+    std::vector<SecurePages> released;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        released.swap(cache);
+        statistics.cached_blocks = 0;
+        statistics.cached_bytes = 0;
+    }
+
+    for (auto &pages : released) Unmap(pages);
+}
+
+/*
+ *  SecureReclaimer::Statistics()
+ *
+ *  Description:
+ *      Return the counters describing the reclaimer's work.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A snapshot of the statistics.
+ *
+ *  Comments:
+ *      None.
+ */
+ReclaimerStatistics SecureReclaimer::Statistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return statistics;
+}
+
+/*
+ *  SecureReclaimer::Run()
+ *
+ *  Description:
+ *      Erase queued blocks until the reclaimer is destroyed.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Blocks still queued when the reclaimer is destroyed are erased
+ *      before this returns.
+ */
+void SecureReclaimer::Run() noexcept
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true)
+    {
+        work.wait(lock, [&]() { return stopping || !queue.empty(); });
+
+        if (queue.empty()) break;
+
+        Entry entry = std::move(queue.front());
+        queue.pop_front();
+        erasing = true;
+
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        Protect(entry.pages, true);
+        entry.pages.Erase();
+        const auto finish = std::chrono::steady_clock::now();
+
+        lock.lock();
+
+        const std::size_t length = entry.pages.mapped_length;
+        const auto residency = finish - entry.queued;
+        const double elapsed = static_cast<double>(
+            std::max<std::chrono::nanoseconds::rep>(
+                std::chrono::nanoseconds(finish - start).count(),
+                1));
+
+        statistics.queue_depth--;
+        statistics.queued_bytes -= length;
+        statistics.reclaimed_blocks++;
+        statistics.reclaimed_bytes += length;
+        statistics.total_residency += residency;
+        statistics.max_residency =
+            std::max<std::chrono::nanoseconds>(statistics.max_residency,
+                                               residency);
+        if (residency > deadline) statistics.deadline_misses++;
+
+        erase_rate = (1.0 - Erase_Rate_Weight) * erase_rate +
+                     Erase_Rate_Weight * (static_cast<double>(length) / elapsed);
+
+        // Keep the erased block for reuse if there is room
+        if (!stopping && (statistics.cached_bytes + length <= cache_limit))
+        {
+            try
+            {
+                cache.push_back(std::move(entry.pages));
+                statistics.cached_blocks++;
+                statistics.cached_bytes += length;
+            }
+            catch (...)
+            {
+                // The block is returned to the operating system below
+            }
+        }
+
+        if (entry.pages.buffer != nullptr)
+        {
+            lock.unlock();
+            Unmap(entry.pages);
+            lock.lock();
+        }
+
+        erasing = false;
+        if (queue.empty()) idle.notify_all();
+    }
+
+    idle.notify_all();
+}
+
+/*
+ *  SecureReclaimer::Protect()
+ *
+ *  Description:
+ *      Change whether a block may be accessed.
+ *
+ *  Parameters:
+ *      pages [in]
+ *          The block.
+ *
+ *      accessible [in]
+ *          True to permit reading and writing, false to permit neither.
+ *
+ *  Returns:
+ *      True if the protection was changed.
+ *
+ *  Comments:
+ *      None.
+ */
+bool SecureReclaimer::Protect(SecurePages &pages, bool accessible) noexcept
+{
+#if defined(_WIN32)
+    DWORD previous;
+
+    return VirtualProtect(pages.buffer,
+                          pages.mapped_length,
+                          accessible ? PAGE_READWRITE : PAGE_NOACCESS,
+                          &previous) != 0;
+#else
+    return mprotect(pages.buffer,
+                    pages.mapped_length,
+                    accessible ? (PROT_READ | PROT_WRITE) : PROT_NONE) == 0;
+#endif
+}
+
+/*
+ *  SecureReclaimer::Unmap()
+ *
+ *  Description:
+ *      Return an erased block to the operating system.
+ *
+ *  Parameters:
+ *      pages [in]
+ *          The block, which must already be erased and deregistered.  It is
+ *          left empty.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This avoids erasing the block a second time, as destroying the
+ *      SecurePages object would.
+ */
+void SecureReclaimer::Unmap(SecurePages &pages) noexcept
+{
+    if (pages.buffer == nullptr) return;
+
+    pages.Unlock();
+
+#if defined(_WIN32)
+    VirtualFree(pages.buffer, 0, MEM_RELEASE);
+#else
+    munmap(pages.buffer, pages.mapped_length);
+#endif
+
+    pages.buffer = nullptr;
+    pages.length = 0;
+    pages.mapped_length = 0;
+}
+
+} // namespace Terra::SecUtil
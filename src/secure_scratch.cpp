@@ -0,0 +1,402 @@
+/*
+ *  secure_scratch.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the per-thread secure scratch arena and the
+ *      ScratchBuffer object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+#include <terra/secutil/secure_scratch.h>
+#include <terra/secutil/secure_erase.h>
+#include <terra/secutil/secure_pages.h>
+
+namespace Terra::SecUtil
+{
+
+struct ScratchArena
+{
+    explicit ScratchArena(std::size_t capacity);
+    ~ScratchArena();
+
+    SecurePages pages;
+    std::size_t offset;
+    std::size_t outstanding;
+};
+
+namespace
+{
+
+// Size of arenas created by threads that have not yet used scratch memory
+std::atomic<std::size_t> scratch_capacity{Default_Scratch_Capacity};
+
+// These have trivial destructors, so they remain valid during thread exit
+thread_local ScratchArena *current_arena = nullptr;
+thread_local bool arena_destroyed = false;
+
+} // namespace
+
+/*
+ *  ScratchArena::ScratchArena()
+ *
+ *  Description:
+ *      Constructor for the ScratchArena object.
+ *
+ *  Parameters:
+ *      capacity [in]
+ *          The size of the arena in octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The arena is locked into memory if possible; failure is not fatal.
+ */
+ScratchArena::ScratchArena(std::size_t capacity) :
+    pages(capacity),
+    offset{0},
+    outstanding{0}
+{
+    pages.Lock();
+}
+
+/*
+ *  ScratchArena::~ScratchArena()
+ *
+ *  Description:
+ *      Destructor for the ScratchArena object, which runs as the thread
+ *      exits.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The SecurePages destructor erases the entire arena at once,
+ *      including any buffers that are still outstanding.
+ */
+ScratchArena::~ScratchArena()
+{
+    arena_destroyed = true;
+    current_arena = nullptr;
+}
+
+namespace
+{
+
+/*
+ *  Arena()
+ *
+ *  Description:
+ *      Return the calling thread's arena, creating it if necessary.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The calling thread's arena.
+ *
+ *  Comments:
+ *      This must not be called once the arena has been destroyed.
+ */
+ScratchArena &Arena()
+{
+    if (current_arena == nullptr)
+    {
+        thread_local ScratchArena arena(
+            scratch_capacity.load(std::memory_order_relaxed));
+        current_arena = &arena;
+    }
+
+    return *current_arena;
+}
+
+} // namespace
+
+/*
+ *  ScratchBuffer::ScratchBuffer()
+ *
+ *  Description:
+ *      Default constructor for the ScratchBuffer object, which produces an
+ *      empty buffer.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+ScratchBuffer::ScratchBuffer() noexcept :
+    arena{nullptr},
+    buffer{nullptr},
+    length{0},
+    previous_offset{0}
+{
+}
+
+/*
+ *  ScratchBuffer::ScratchBuffer()
+ *
+ *  Description:
+ *      Move constructor.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The buffer from which to move.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The other buffer is left empty.
+ */
+ScratchBuffer::ScratchBuffer(ScratchBuffer &&other) noexcept :
+    arena{std::exchange(other.arena, nullptr)},
+    buffer{std::exchange(other.buffer, nullptr)},
+    length{std::exchange(other.length, 0)},
+    previous_offset{other.previous_offset},
+    overflow{std::move(other.overflow)}
+{
+}
+
+/*
+ *  ScratchBuffer::~ScratchBuffer()
+ *
+ *  Description:
+ *      Destructor for the ScratchBuffer object.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+ScratchBuffer::~ScratchBuffer()
+{
+    Release();
+}
+
+/*
+ *  ScratchBuffer::operator=()
+ *
+ *  Description:
+ *      Move assignment operator.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The buffer from which to move.
+ *
+ *  Returns:
+ *      A reference to this object.
+ *
+ *  Comments:
+ *      This buffer is released first.  The other buffer is left empty.
+ */
+ScratchBuffer &ScratchBuffer::operator=(ScratchBuffer &&other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        arena = std::exchange(other.arena, nullptr);
+        buffer = std::exchange(other.buffer, nullptr);
+        length = std::exchange(other.length, 0);
+        previous_offset = other.previous_offset;
+        overflow = std::move(other.overflow);
+        other.overflow.clear();
+    }
+
+    return *this;
+}
+
+/*
+ *  ScratchBuffer::Release()
+ *
+ *  Description:
+ *      Erase the buffer and return it to the arena.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The space is returned to the arena that issued the buffer and is
+ *      reclaimed if this is the most recently acquired buffer or the last
+ *      outstanding buffer.  A buffer released on a thread other than the
+ *      one that acquired it is abandoned, as is one whose arena has been
+ *      destroyed, since the issuing arena may no longer exist; it is erased
+ *      along with that arena when the issuing thread exits.
+ */
+void ScratchBuffer::Release() noexcept
+{
+    if (buffer == nullptr) return;
+
+    if (!overflow.empty())
+    {
+        // The SecureAllocator erases the storage as it is freed
+        SecureVector<std::uint8_t>().swap(overflow);
+    }
+    else if (!arena_destroyed && (arena == current_arena))
+    {
+        SecureErase(buffer, length);
+
+        if (buffer + length == arena->pages.data() + arena->offset)
+        {
+            arena->offset = previous_offset;
+        }
+        if (--arena->outstanding == 0) arena->offset = 0;
+    }
+
+    arena = nullptr;
+    buffer = nullptr;
+    length = 0;
+}
+
+/*
+ *  AcquireScratch()
+ *
+ *  Description:
+ *      Acquire a buffer from the calling thread's scratch arena.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the buffer in octets.
+ *
+ *      alignment [in]
+ *          The required alignment of the buffer, which must be a power of
+ *          two.
+ *
+ *  Returns:
+ *      A buffer of the requested size whose contents are zero.
+ *
+ *  Comments:
+ *      Arena memory is zero when mapped and erased as each buffer is
+ *      released, so buffers need not be cleared here.
+ */
+ScratchBuffer AcquireScratch(std::size_t size, std::size_t alignment)
+{
+    if ((alignment == 0) || ((alignment & (alignment - 1)) != 0))
+    {
+        throw std::invalid_argument("Alignment must be a power of two");
+    }
+
+    ScratchBuffer result;
+
+    if (size == 0) return result;
+
+    // Take space from the arena unless it was destroyed as the thread exits
+    if (!arena_destroyed)
+    {
+        ScratchArena &arena = Arena();
+        const auto base = reinterpret_cast<std::uintptr_t>(arena.pages.data());
+        const std::size_t start =
+            ((base + arena.offset + alignment - 1) & ~(alignment - 1)) - base;
+
+        if ((start <= arena.pages.capacity()) &&
+            (arena.pages.capacity() - start >= size))
+        {
+            result.arena = &arena;
+            result.buffer = arena.pages.data() + start;
+            result.length = size;
+            result.previous_offset = arena.offset;
+            arena.offset = start + size;
+            arena.outstanding++;
+
+            return result;
+        }
+    }
+
+    // Satisfy the request from the heap, aligning within the allocation
+    result.overflow.resize(size + alignment - 1);
+    const auto address =
+        reinterpret_cast<std::uintptr_t>(result.overflow.data());
+    result.buffer = result.overflow.data() +
+                    (((address + alignment - 1) & ~(alignment - 1)) - address);
+    result.length = size;
+
+    return result;
+}
+
+/*
+ *  SetScratchCapacity()
+ *
+ *  Description:
+ *      Set the size of scratch arenas created after this call.
+ *
+ *  Parameters:
+ *      capacity [in]
+ *          The arena size in octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SetScratchCapacity(std::size_t capacity) noexcept
+{
+    scratch_capacity.store(capacity, std::memory_order_relaxed);
+}
+
+/*
+ *  ScratchCapacity()
+ *
+ *  Description:
+ *      Return the size of the calling thread's scratch arena.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The arena size in octets, or zero if there is no arena.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t ScratchCapacity() noexcept
+{
+    return (current_arena != nullptr) ? current_arena->pages.capacity() : 0;
+}
+
+/*
+ *  ScratchInUse()
+ *
+ *  Description:
+ *      Return the amount of the calling thread's scratch arena in use.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of octets in use.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t ScratchInUse() noexcept
+{
+    return (current_arena != nullptr) ? current_arena->offset : 0;
+}
+
+} // namespace Terra::SecUtil
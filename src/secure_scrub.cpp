@@ -0,0 +1,359 @@
+/*
+ *  secure_scrub.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements functions that erase the stack below the
+ *      caller's frame and clear vector registers.
+ *
+ *      The stack is reached by allocating the requested number of octets
+ *      with alloca() in a function that is never inlined, so the allocation
+ *      lies immediately below the caller's frame.  Vector registers are
+ *      cleared with inline assembly whose clobber list names each register,
+ *      so the compiler saves and restores any register the calling
+ *      convention requires to be preserved.
+ *
+ *  Portability Issues:
+ *      Microsoft Visual C++ does not support inline assembly on x64 or ARM64,
+ *      so with that compiler registers are cleared only on x64 processors
+ *      supporting AVX.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#if defined(_WIN32)
+#include <malloc.h>
+#elif __has_include(<alloca.h>)
+#include <alloca.h>
+#else
+#include <cstdlib>
+#endif
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+#include <terra/secutil/secure_scrub.h>
+#include <terra/secutil/secure_erase.h>
+
+#if defined(_MSC_VER)
+#define SECUTIL_NOINLINE __declspec(noinline)
+#define SECUTIL_ALLOCA(bytes) _alloca(bytes)
+#else
+#define SECUTIL_NOINLINE __attribute__((noinline))
+#define SECUTIL_ALLOCA(bytes) alloca(bytes)
+#endif
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Pattern written by PaintStack()
+constexpr std::uint8_t Paint_Pattern = 0xa7;
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+/*
+ *  ClearSseRegisters()
+ *
+ *  Description:
+ *      Zero xmm0 through xmm15.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ClearSseRegisters() noexcept
+{
+    asm volatile("pxor %%xmm0, %%xmm0\n\t"
+                 "pxor %%xmm1, %%xmm1\n\t"
+                 "pxor %%xmm2, %%xmm2\n\t"
+                 "pxor %%xmm3, %%xmm3\n\t"
+                 "pxor %%xmm4, %%xmm4\n\t"
+                 "pxor %%xmm5, %%xmm5\n\t"
+                 "pxor %%xmm6, %%xmm6\n\t"
+                 "pxor %%xmm7, %%xmm7\n\t"
+                 "pxor %%xmm8, %%xmm8\n\t"
+                 "pxor %%xmm9, %%xmm9\n\t"
+                 "pxor %%xmm10, %%xmm10\n\t"
+                 "pxor %%xmm11, %%xmm11\n\t"
+                 "pxor %%xmm12, %%xmm12\n\t"
+                 "pxor %%xmm13, %%xmm13\n\t"
+                 "pxor %%xmm14, %%xmm14\n\t"
+                 "pxor %%xmm15, %%xmm15"
+                 :
+                 :
+                 : "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+                   "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13",
+                   "xmm14", "xmm15");
+}
+
+/*
+ *  ClearAvxRegisters()
+ *
+ *  Description:
+ *      Zero ymm0 through ymm15 (and zmm0 through zmm15, if present).
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The processor must support AVX.
+ */
+__attribute__((target("avx"))) void ClearAvxRegisters() noexcept
+{
+    asm volatile("vzeroall"
+                 :
+                 :
+                 : "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+                   "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13",
+                   "xmm14", "xmm15");
+}
+
+/*
+ *  ClearAvx512Registers()
+ *
+ *  Description:
+ *      Zero zmm16 through zmm31, which vzeroall does not affect.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The processor must support AVX-512F.  Writing the xmm form of each
+ *      register with an EVEX-encoded instruction zeroes the entire register.
+ */
+__attribute__((target("avx512f"))) void ClearAvx512Registers() noexcept
+{
+    asm volatile("vpxord %%xmm16, %%xmm16, %%xmm16\n\t"
+                 "vpxord %%xmm17, %%xmm17, %%xmm17\n\t"
+                 "vpxord %%xmm18, %%xmm18, %%xmm18\n\t"
+                 "vpxord %%xmm19, %%xmm19, %%xmm19\n\t"
+                 "vpxord %%xmm20, %%xmm20, %%xmm20\n\t"
+                 "vpxord %%xmm21, %%xmm21, %%xmm21\n\t"
+                 "vpxord %%xmm22, %%xmm22, %%xmm22\n\t"
+                 "vpxord %%xmm23, %%xmm23, %%xmm23\n\t"
+                 "vpxord %%xmm24, %%xmm24, %%xmm24\n\t"
+                 "vpxord %%xmm25, %%xmm25, %%xmm25\n\t"
+                 "vpxord %%xmm26, %%xmm26, %%xmm26\n\t"
+                 "vpxord %%xmm27, %%xmm27, %%xmm27\n\t"
+                 "vpxord %%xmm28, %%xmm28, %%xmm28\n\t"
+                 "vpxord %%xmm29, %%xmm29, %%xmm29\n\t"
+                 "vpxord %%xmm30, %%xmm30, %%xmm30\n\t"
+                 "vpxord %%xmm31, %%xmm31, %%xmm31"
+                 :
+                 :
+                 : "xmm16", "xmm17", "xmm18", "xmm19", "xmm20", "xmm21",
+                   "xmm22", "xmm23", "xmm24", "xmm25", "xmm26", "xmm27",
+                   "xmm28", "xmm29", "xmm30", "xmm31");
+}
+
+#elif defined(_MSC_VER) && defined(_M_X64)
+
+/*
+ *  SupportsAvx()
+ *
+ *  Description:
+ *      Determine whether the processor and operating system support AVX.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if AVX may be used, false otherwise.
+ *
+ *  Comments:
+ *      Both the AVX and OSXSAVE feature bits must be set and the operating
+ *      system must save the AVX state (XCR0 bits 1 and 2).
+ */
+bool SupportsAvx() noexcept
+{
+    int info[4]{};
+
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+
+    return (_xgetbv(0) & 0x06) == 0x06;
+}
+
+#endif
+
+} // namespace
+
+/*
+ *  ScrubStack()
+ *
+ *  Description:
+ *      Erase the given number of octets of stack below the caller's frame.
+ *
+ *  Parameters:
+ *      bytes [in]
+ *          The number of octets to erase.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This function is never inlined, so the memory allocated lies below
+ *      the caller's frame.  SecureErase() cannot be optimized away.
+ */
+SECUTIL_NOINLINE void ScrubStack(std::size_t bytes) noexcept
+{
+    bytes = std::min(bytes, Max_Stack_Scrub);
+    if (bytes == 0) return;
+
+    SecureErase(SECUTIL_ALLOCA(bytes), bytes);
+}
+
+/*
+ *  ClearVectorRegisters()
+ *
+ *  Description:
+ *      Zero the vector registers that are not preserved across calls.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Processor features are determined on first use rather than during
+ *      static initialization, so this may be called from other static
+ *      initializers.  Microsoft Visual C++ cannot name registers on x64, so
+ *      with that compiler the registers are cleared with _mm256_zeroall()
+ *      and nothing is cleared on processors without AVX.
+ */
+SECUTIL_NOINLINE void ClearVectorRegisters() noexcept
+{
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    // The CPU model must be initialized if called before constructors run
+    static const bool has_avx = []()
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx") != 0;
+    }();
+    static const bool has_avx512 = __builtin_cpu_supports("avx512f") != 0;
+
+    if (has_avx)
+    {
+        ClearAvxRegisters();
+    }
+    else
+    {
+        ClearSseRegisters();
+    }
+    if (has_avx512) ClearAvx512Registers();
+#elif defined(_MSC_VER) && defined(_M_X64)
+    static const bool has_avx = SupportsAvx();
+
+    if (has_avx) _mm256_zeroall();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    // v8-v15 are callee-saved, so they hold the caller's values
+    asm volatile("movi v0.16b, #0\n\t"
+                 "movi v1.16b, #0\n\t"
+                 "movi v2.16b, #0\n\t"
+                 "movi v3.16b, #0\n\t"
+                 "movi v4.16b, #0\n\t"
+                 "movi v5.16b, #0\n\t"
+                 "movi v6.16b, #0\n\t"
+                 "movi v7.16b, #0\n\t"
+                 "movi v16.16b, #0\n\t"
+                 "movi v17.16b, #0\n\t"
+                 "movi v18.16b, #0\n\t"
+                 "movi v19.16b, #0\n\t"
+                 "movi v20.16b, #0\n\t"
+                 "movi v21.16b, #0\n\t"
+                 "movi v22.16b, #0\n\t"
+                 "movi v23.16b, #0\n\t"
+                 "movi v24.16b, #0\n\t"
+                 "movi v25.16b, #0\n\t"
+                 "movi v26.16b, #0\n\t"
+                 "movi v27.16b, #0\n\t"
+                 "movi v28.16b, #0\n\t"
+                 "movi v29.16b, #0\n\t"
+                 "movi v30.16b, #0\n\t"
+                 "movi v31.16b, #0"
+                 :
+                 :
+                 : "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v16",
+                   "v17", "v18", "v19", "v20", "v21", "v22", "v23", "v24",
+                   "v25", "v26", "v27", "v28", "v29", "v30", "v31");
+#endif
+}
+
+/*
+ *  PaintStack()
+ *
+ *  Description:
+ *      Fill octets below the caller's frame with a known pattern or
+ *      determine how many were overwritten.
+ *
+ *  Parameters:
+ *      bytes [in]
+ *          The number of octets to paint or examine.
+ *
+ *      measure [in]
+ *          False to paint the stack, true to measure.
+ *
+ *  Returns:
+ *      When measuring, the depth in octets of the lowest octet overwritten;
+ *      otherwise, zero.
+ *
+ *  Comments:
+ *      A single function both paints and measures so that the allocated
+ *      region is at the same location in both calls.  The region is
+ *      accessed through a volatile pointer so the writes are not elided.
+ */
+SECUTIL_NOINLINE std::size_t PaintStack(std::size_t bytes,
+                                        bool measure) noexcept
+{
+    // Nothing may be called before the region is examined, as the frame of
+    // the function called would overwrite part of the painted region
+    if (bytes > Max_Stack_Scrub) bytes = Max_Stack_Scrub;
+    if (bytes == 0) return 0;
+
+    volatile std::uint8_t *region =
+        static_cast<volatile std::uint8_t *>(SECUTIL_ALLOCA(bytes));
+
+    if (!measure)
+    {
+        for (std::size_t i = 0; i < bytes; i++) region[i] = Paint_Pattern;
+        return 0;
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    // The region was written by the previous call, which the compiler cannot
+    // see, so indicate that its contents may have changed
+    asm volatile("" : : "r"(region) : "memory");
+#endif
+
+    // The stack grows downward, so the lowest octet touched is the deepest
+    std::size_t untouched = 0;
+    while ((untouched < bytes) && (region[untouched] == Paint_Pattern))
+    {
+        untouched++;
+    }
+
+    return bytes - untouched;
+}
+
+} // namespace Terra::SecUtil
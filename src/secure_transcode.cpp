@@ -0,0 +1,752 @@
+/*
+ *  secure_transcode.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module contains the functions that convert text between the
+ *      UTF-8, UTF-16, and UTF-32 encodings.  The source text is walked once
+ *      to validate it and compute the exact output length, then walked again
+ *      to produce the output.  Runs of ASCII characters are detected a word
+ *      at a time and converted 16 characters at a time using SSE2 (x86) or
+ *      NEON (ARM) instructions; other characters are converted one code
+ *      point at a time.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SECUTIL_TRANSCODE_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SECUTIL_TRANSCODE_NEON
+#endif
+#include <terra/secutil/secure_transcode.h>
+#include <terra/secutil/secure_erase.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+/*
+ *  ASCIIRun()
+ *
+ *  Description:
+ *      Determine the number of consecutive ASCII code units at the start of
+ *      the given text.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to the text.
+ *
+ *      length [in]
+ *          Number of code units in the text.
+ *
+ *  Returns:
+ *      The number of leading ASCII code units.
+ *
+ *  Comments:
+ *      Code units are tested 8 octets at a time.
+ */
+template<typename Unit>
+std::size_t ASCIIRun(const Unit *p, std::size_t length) noexcept
+{
+    // A mask of the bits that are clear in every ASCII code unit
+    constexpr std::uint64_t Non_ASCII_Bits =
+        (sizeof(Unit) == 1) ? 0x8080808080808080ULL :
+        (sizeof(Unit) == 2) ? 0xff80ff80ff80ff80ULL :
+                              0xffffff80ffffff80ULL;
+    constexpr std::size_t Units_Per_Word = 8 / sizeof(Unit);
+
+    std::size_t count = 0;
+
+    // Most non-ASCII characters are isolated, so test one unit first
+    if ((length == 0) || (static_cast<std::uint32_t>(p[0]) > 0x7f)) return 0;
+
+    while (length - count >= Units_Per_Word)
+    {
+        std::uint64_t word;
+
+        std::memcpy(&word, p + count, sizeof(word));
+        if (word & Non_ASCII_Bits) break;
+        count += Units_Per_Word;
+    }
+
+    while ((count < length) && (static_cast<std::uint32_t>(p[count]) <= 0x7f))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ *  CopyASCII()
+ *
+ *  Description:
+ *      Copy ASCII code units from one encoding to another, widening or
+ *      narrowing each code unit as required.
+ *
+ *  Parameters:
+ *      source [in]
+ *          Pointer to the ASCII code units.
+ *
+ *      target [out]
+ *          Pointer to the target buffer.
+ *
+ *      count [in]
+ *          Number of code units to copy.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Since ASCII values are below 128, signed and unsigned saturating packs
+ *      produce identical results.
+ */
+template<typename Source, typename Target>
+void CopyASCII(const Source *source, Target *target, std::size_t count) noexcept
+{
+    if constexpr (sizeof(Source) == sizeof(Target))
+    {
+        std::memcpy(target, source, count * sizeof(Source));
+        return;
+    }
+    else
+    {
+#if defined(SECUTIL_TRANSCODE_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; count >= 16; count -= 16, source += 16, target += 16)
+        {
+            const auto *in = reinterpret_cast<const __m128i *>(source);
+            auto *out = reinterpret_cast<__m128i *>(target);
+
+            if constexpr (sizeof(Source) == 1)
+            {
+                const __m128i v = _mm_loadu_si128(in);
+                const __m128i low = _mm_unpacklo_epi8(v, zero);
+                const __m128i high = _mm_unpackhi_epi8(v, zero);
+
+                if constexpr (sizeof(Target) == 2)
+                {
+                    _mm_storeu_si128(out, low);
+                    _mm_storeu_si128(out + 1, high);
+                }
+                else
+                {
+                    _mm_storeu_si128(out, _mm_unpacklo_epi16(low, zero));
+                    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, zero));
+                    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high, zero));
+                    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high, zero));
+                }
+            }
+            else if constexpr (sizeof(Source) == 2)
+            {
+                const __m128i a = _mm_loadu_si128(in);
+                const __m128i b = _mm_loadu_si128(in + 1);
+
+                if constexpr (sizeof(Target) == 1)
+                {
+                    _mm_storeu_si128(out, _mm_packus_epi16(a, b));
+                }
+                else
+                {
+                    _mm_storeu_si128(out, _mm_unpacklo_epi16(a, zero));
+                    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(a, zero));
+                    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(b, zero));
+                    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(b, zero));
+                }
+            }
+            else
+            {
+                const __m128i a = _mm_packs_epi32(_mm_loadu_si128(in),
+                                                  _mm_loadu_si128(in + 1));
+                const __m128i b = _mm_packs_epi32(_mm_loadu_si128(in + 2),
+                                                  _mm_loadu_si128(in + 3));
+
+                if constexpr (sizeof(Target) == 1)
+                {
+                    _mm_storeu_si128(out, _mm_packus_epi16(a, b));
+                }
+                else
+                {
+                    _mm_storeu_si128(out, a);
+                    _mm_storeu_si128(out + 1, b);
+                }
+            }
+        }
+#elif defined(SECUTIL_TRANSCODE_NEON)
+        for (; count >= 16; count -= 16, source += 16, target += 16)
+        {
+            if constexpr (sizeof(Source) == 1)
+            {
+                const uint8x16_t v =
+                    vld1q_u8(reinterpret_cast<const std::uint8_t *>(source));
+                const uint16x8_t low = vmovl_u8(vget_low_u8(v));
+                const uint16x8_t high = vmovl_u8(vget_high_u8(v));
+
+                if constexpr (sizeof(Target) == 2)
+                {
+                    auto *out = reinterpret_cast<std::uint16_t *>(target);
+                    vst1q_u16(out, low);
+                    vst1q_u16(out + 8, high);
+                }
+                else
+                {
+                    auto *out = reinterpret_cast<std::uint32_t *>(target);
+                    vst1q_u32(out, vmovl_u16(vget_low_u16(low)));
+                    vst1q_u32(out + 4, vmovl_u16(vget_high_u16(low)));
+                    vst1q_u32(out + 8, vmovl_u16(vget_low_u16(high)));
+                    vst1q_u32(out + 12, vmovl_u16(vget_high_u16(high)));
+                }
+            }
+            else if constexpr (sizeof(Source) == 2)
+            {
+                const auto *in = reinterpret_cast<const std::uint16_t *>(source);
+                const uint16x8_t a = vld1q_u16(in);
+                const uint16x8_t b = vld1q_u16(in + 8);
+
+                if constexpr (sizeof(Target) == 1)
+                {
+                    vst1q_u8(reinterpret_cast<std::uint8_t *>(target),
+                             vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+                }
+                else
+                {
+                    auto *out = reinterpret_cast<std::uint32_t *>(target);
+                    vst1q_u32(out, vmovl_u16(vget_low_u16(a)));
+                    vst1q_u32(out + 4, vmovl_u16(vget_high_u16(a)));
+                    vst1q_u32(out + 8, vmovl_u16(vget_low_u16(b)));
+                    vst1q_u32(out + 12, vmovl_u16(vget_high_u16(b)));
+                }
+            }
+            else
+            {
+                const auto *in = reinterpret_cast<const std::uint32_t *>(source);
+                const uint16x8_t a = vcombine_u16(vmovn_u32(vld1q_u32(in)),
+                                                  vmovn_u32(vld1q_u32(in + 4)));
+                const uint16x8_t b = vcombine_u16(vmovn_u32(vld1q_u32(in + 8)),
+                                                  vmovn_u32(vld1q_u32(in + 12)));
+
+                if constexpr (sizeof(Target) == 1)
+                {
+                    vst1q_u8(reinterpret_cast<std::uint8_t *>(target),
+                             vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+                }
+                else
+                {
+                    auto *out = reinterpret_cast<std::uint16_t *>(target);
+                    vst1q_u16(out, a);
+                    vst1q_u16(out + 8, b);
+                }
+            }
+        }
+#endif
+
+        for (; count > 0; count--) *target++ = static_cast<Target>(*source++);
+    }
+}
+
+/*
+ *  DecodeCodePoint()
+ *
+ *  Description:
+ *      Decode a single code point from the given text and advance the
+ *      pointer past it.
+ *
+ *  Parameters:
+ *      p [in/out]
+ *          Pointer to the text, updated to point past the code point.
+ *
+ *      end [in]
+ *          Pointer to the end of the text.
+ *
+ *  Returns:
+ *      The code point.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the text is invalid.
+ */
+char32_t DecodeCodePoint(const char8_t *&p, const char8_t *end)
+{
+    const char32_t lead = *p++;
+    std::size_t trailing;
+    char32_t code_point;
+    char32_t minimum;
+
+    if (lead < 0x80) return lead;
+
+    if ((lead & 0xe0) == 0xc0)
+    {
+        trailing = 1;
+        code_point = lead & 0x1f;
+        minimum = 0x80;
+    }
+    else if ((lead & 0xf0) == 0xe0)
+    {
+        trailing = 2;
+        code_point = lead & 0x0f;
+        minimum = 0x800;
+    }
+    else if ((lead & 0xf8) == 0xf0)
+    {
+        trailing = 3;
+        code_point = lead & 0x07;
+        minimum = 0x10000;
+    }
+    else
+    {
+        throw std::invalid_argument("Invalid UTF-8 lead octet");
+    }
+
+    if (static_cast<std::size_t>(end - p) < trailing)
+    {
+        throw std::invalid_argument("Truncated UTF-8 sequence");
+    }
+
+    for (; trailing > 0; trailing--, p++)
+    {
+        if ((*p & 0xc0) != 0x80)
+        {
+            throw std::invalid_argument("Invalid UTF-8 continuation octet");
+        }
+        code_point = (code_point << 6) | (*p & 0x3f);
+    }
+
+    if ((code_point < minimum) || (code_point > 0x10ffff) ||
+        ((code_point >= 0xd800) && (code_point <= 0xdfff)))
+    {
+        throw std::invalid_argument("Invalid UTF-8 sequence");
+    }
+
+    return code_point;
+}
+
+char32_t DecodeCodePoint(const char16_t *&p, const char16_t *end)
+{
+    const char32_t unit = *p++;
+
+    if ((unit < 0xd800) || (unit > 0xdfff)) return unit;
+
+    if ((unit > 0xdbff) || (p == end) || (*p < 0xdc00) || (*p > 0xdfff))
+    {
+        throw std::invalid_argument("Unpaired UTF-16 surrogate");
+    }
+
+    return 0x10000 + ((unit - 0xd800) << 10) + (*p++ - 0xdc00);
+}
+
+char32_t DecodeCodePoint(const char32_t *&p, const char32_t *)
+{
+    const char32_t code_point = *p++;
+
+    if ((code_point > 0x10ffff) ||
+        ((code_point >= 0xd800) && (code_point <= 0xdfff)))
+    {
+        throw std::invalid_argument("Invalid UTF-32 code point");
+    }
+
+    return code_point;
+}
+
+/*
+ *  EncodedLength()
+ *
+ *  Description:
+ *      Return the number of code units required to encode the given code
+ *      point using the encoding with the given code unit type.
+ *
+ *  Parameters:
+ *      code_point [in]
+ *          The code point to encode.
+ *
+ *  Returns:
+ *      The number of code units.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename Target>
+constexpr std::size_t EncodedLength(char32_t code_point) noexcept
+{
+    if constexpr (sizeof(Target) == 1)
+    {
+        return (code_point < 0x80)    ? 1 :
+               (code_point < 0x800)   ? 2 :
+               (code_point < 0x10000) ? 3 : 4;
+    }
+    else if constexpr (sizeof(Target) == 2)
+    {
+        return (code_point < 0x10000) ? 1 : 2;
+    }
+    else
+    {
+        return 1;
+    }
+}
+
+/*
+ *  EncodeCodePoint()
+ *
+ *  Description:
+ *      Encode the given code point and advance the target pointer.
+ *
+ *  Parameters:
+ *      code_point [in]
+ *          The code point to encode.
+ *
+ *      q [in/out]
+ *          Pointer to the target buffer, updated to point past the output.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void EncodeCodePoint(char32_t code_point, char8_t *&q) noexcept
+{
+    if (code_point < 0x80)
+    {
+        *q++ = static_cast<char8_t>(code_point);
+    }
+    else if (code_point < 0x800)
+    {
+        *q++ = static_cast<char8_t>(0xc0 | (code_point >> 6));
+        *q++ = static_cast<char8_t>(0x80 | (code_point & 0x3f));
+    }
+    else if (code_point < 0x10000)
+    {
+        *q++ = static_cast<char8_t>(0xe0 | (code_point >> 12));
+        *q++ = static_cast<char8_t>(0x80 | ((code_point >> 6) & 0x3f));
+        *q++ = static_cast<char8_t>(0x80 | (code_point & 0x3f));
+    }
+    else
+    {
+        *q++ = static_cast<char8_t>(0xf0 | (code_point >> 18));
+        *q++ = static_cast<char8_t>(0x80 | ((code_point >> 12) & 0x3f));
+        *q++ = static_cast<char8_t>(0x80 | ((code_point >> 6) & 0x3f));
+        *q++ = static_cast<char8_t>(0x80 | (code_point & 0x3f));
+    }
+}
+
+void EncodeCodePoint(char32_t code_point, char16_t *&q) noexcept
+{
+    if (code_point < 0x10000)
+    {
+        *q++ = static_cast<char16_t>(code_point);
+    }
+    else
+    {
+        code_point -= 0x10000;
+        *q++ = static_cast<char16_t>(0xd800 | (code_point >> 10));
+        *q++ = static_cast<char16_t>(0xdc00 | (code_point & 0x3ff));
+    }
+}
+
+void EncodeCodePoint(char32_t code_point, char32_t *&q) noexcept
+{
+    *q++ = code_point;
+}
+
+/*
+ *  MeasureText()
+ *
+ *  Description:
+ *      Validate the source text and compute the number of code units of type
+ *      Target required to represent it.
+ *
+ *  Parameters:
+ *      source [in]
+ *          Pointer to the source text.
+ *
+ *      length [in]
+ *          Number of code units in the source text.
+ *
+ *  Returns:
+ *      The number of target code units.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the source is invalid.
+ */
+template<typename Source, typename Target>
+std::size_t MeasureText(const Source *source, std::size_t length)
+{
+    const Source *end = source + length;
+    std::size_t count = 0;
+
+    while (source < end)
+    {
+        // Each ASCII character is one code unit in every encoding
+        const std::size_t run =
+            ASCIIRun(source, static_cast<std::size_t>(end - source));
+        if (run > 0)
+        {
+            source += run;
+            count += run;
+            continue;
+        }
+
+        count += EncodedLength<Target>(DecodeCodePoint(source, end));
+    }
+
+    return count;
+}
+
+/*
+ *  ConvertText()
+ *
+ *  Description:
+ *      Convert the source text into the target buffer.
+ *
+ *  Parameters:
+ *      source [in]
+ *          Pointer to the source text.
+ *
+ *      length [in]
+ *          Number of code units in the source text.
+ *
+ *      target [out]
+ *          Pointer to the target buffer.
+ *
+ *      target_length [in]
+ *          Number of code units in the target buffer, which must be exactly
+ *          the number required.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the source is invalid or if
+ *      the target buffer is not the required length.  Any output already
+ *      written is erased before the exception is thrown.
+ */
+template<typename Source, typename Target>
+void ConvertText(const Source *source,
+                 std::size_t length,
+                 Target *target,
+                 std::size_t target_length)
+{
+    const Source *end = source + length;
+    Target *q = target;
+    const Target *target_end = target + target_length;
+
+    try
+    {
+        while (source < end)
+        {
+            const auto remaining = static_cast<std::size_t>(target_end - q);
+            const std::size_t run =
+                ASCIIRun(source, static_cast<std::size_t>(end - source));
+
+            if (run > 0)
+            {
+                if (run > remaining)
+                {
+                    throw std::invalid_argument(
+                        "Target buffer has the wrong length");
+                }
+
+                CopyASCII(source, q, run);
+                source += run;
+                q += run;
+                continue;
+            }
+
+            const char32_t code_point = DecodeCodePoint(source, end);
+
+            if (EncodedLength<Target>(code_point) > remaining)
+            {
+                throw std::invalid_argument(
+                    "Target buffer has the wrong length");
+            }
+
+            EncodeCodePoint(code_point, q);
+        }
+
+        if (q != target_end)
+        {
+            throw std::invalid_argument("Target buffer has the wrong length");
+        }
+    }
+    catch (...)
+    {
+        SecureErase(target, static_cast<std::size_t>(q - target) *
+                                sizeof(Target));
+        throw;
+    }
+}
+
+/*
+ *  Dispatch()
+ *
+ *  Description:
+ *      Call the given function with null pointers of the source and target
+ *      code unit types corresponding to the given encodings.
+ *
+ *  Parameters:
+ *      source_encoding [in]
+ *          The encoding of the source text.
+ *
+ *      target_encoding [in]
+ *          The encoding of the target text.
+ *
+ *      function [in]
+ *          The function to call.
+ *
+ *  Returns:
+ *      The value returned by the function.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename Function>
+auto Dispatch(UnicodeEncoding source_encoding,
+              UnicodeEncoding target_encoding,
+              Function &&function)
+{
+    auto with_target = [&](auto *source_type)
+    {
+        switch (target_encoding)
+        {
+            case UnicodeEncoding::UTF8:
+                return function(source_type,
+                                static_cast<char8_t *>(nullptr));
+            case UnicodeEncoding::UTF16:
+                return function(source_type,
+                                static_cast<char16_t *>(nullptr));
+            default:
+                return function(source_type,
+                                static_cast<char32_t *>(nullptr));
+        }
+    };
+
+    switch (source_encoding)
+    {
+        case UnicodeEncoding::UTF8:
+            return with_target(static_cast<const char8_t *>(nullptr));
+        case UnicodeEncoding::UTF16:
+            return with_target(static_cast<const char16_t *>(nullptr));
+        default:
+            return with_target(static_cast<const char32_t *>(nullptr));
+    }
+}
+
+} // namespace
+
+/*
+ *  TranscodedLength()
+ *
+ *  Description:
+ *      Validate the given text and compute the number of code units required
+ *      to represent it in the target encoding.
+ *
+ *  Parameters:
+ *      source [in]
+ *          Pointer to the text to convert.
+ *
+ *      source_length [in]
+ *          Number of code units in the source text.
+ *
+ *      source_encoding [in]
+ *          The encoding of the source text.
+ *
+ *      target_encoding [in]
+ *          The encoding into which the text is to be converted.
+ *
+ *  Returns:
+ *      The number of code units required in the target encoding.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the source is invalid.
+ */
+std::size_t TranscodedLength(const void *source,
+                             std::size_t source_length,
+                             UnicodeEncoding source_encoding,
+                             UnicodeEncoding target_encoding)
+{
+    return Dispatch(
+        source_encoding,
+        target_encoding,
+        [&](auto *source_type, auto *target_type) -> std::size_t
+        {
+            using Source = std::remove_cv_t<
+                std::remove_pointer_t<decltype(source_type)>>;
+            using Target = std::remove_pointer_t<decltype(target_type)>;
+
+            return MeasureText<Source, Target>(
+                static_cast<const Source *>(source),
+                source_length);
+        });
+}
+
+/*
+ *  Transcode()
+ *
+ *  Description:
+ *      Convert the given text into the target encoding.
+ *
+ *  Parameters:
+ *      source [in]
+ *          Pointer to the text to convert.
+ *
+ *      source_length [in]
+ *          Number of code units in the source text.
+ *
+ *      source_encoding [in]
+ *          The encoding of the source text.
+ *
+ *      target [out]
+ *          Pointer to the buffer into which the converted text is written.
+ *
+ *      target_length [in]
+ *          Number of code units in the target buffer, which must be exactly
+ *          the value returned by TranscodedLength().
+ *
+ *      target_encoding [in]
+ *          The encoding into which the text is to be converted.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the source is invalid or if
+ *      the target buffer is not the required length.
+ */
+void Transcode(const void *source,
+               std::size_t source_length,
+               UnicodeEncoding source_encoding,
+               void *target,
+               std::size_t target_length,
+               UnicodeEncoding target_encoding)
+{
+    Dispatch(source_encoding,
+             target_encoding,
+             [&](auto *source_type, auto *target_type)
+             {
+                 using Source = std::remove_cv_t<
+                     std::remove_pointer_t<decltype(source_type)>>;
+                 using Target = std::remove_pointer_t<decltype(target_type)>;
+
+                 ConvertText(static_cast<const Source *>(source),
+                             source_length,
+                             static_cast<Target *>(target),
+                             target_length);
+             });
+}
+
+} // namespace Terra::SecUtil
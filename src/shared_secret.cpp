@@ -0,0 +1,558 @@
+/*
+ *  shared_secret.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the SharedSecret object.  The memory file
+ *      consists of a header page holding the reference count, followed by
+ *      the secret itself.  The header page is mapped read-write by each
+ *      owner so the reference count can be updated; the secret is mapped
+ *      read-only and is only mapped writable by the last owner in order to
+ *      erase it.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#if defined(HAVE_MEMFD_CREATE)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <terra/secutil/shared_secret.h>
+#include <terra/secutil/secure_erase.h>
+#include <terra/secutil/secure_pages.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+#if defined(HAVE_MEMFD_CREATE)
+
+// Identifies a memory file created by SharedSecret::Create()
+constexpr std::uint64_t Shared_Secret_Magic = 0x5465727261535353ULL;
+
+// Seals applied to the memory file; there is no write seal, as owners must
+// update the reference count and the last owner must erase the secret
+constexpr int Required_Seals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+// Contents of the header page at the start of the memory file
+struct SharedHeader
+{
+    std::atomic<std::uint64_t> references;
+    std::uint64_t magic;
+    std::uint64_t length;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Cross-process reference count requires lock-free atomics");
+
+/*
+ *  RoundToPages()
+ *
+ *  Description:
+ *      Round the given length up to a multiple of the page size.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length to round.
+ *
+ *  Returns:
+ *      The rounded length.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t RoundToPages(std::size_t length) noexcept
+{
+    const std::size_t page_size = SecurePages::PageSize();
+
+    return ((length + page_size - 1) / page_size) * page_size;
+}
+
+/*
+ *  ThrowSystemError()
+ *
+ *  Description:
+ *      Throw a std::system_error for the current value of errno.
+ *
+ *  Parameters:
+ *      what [in]
+ *          Description of the operation that failed.
+ *
+ *  Returns:
+ *      Does not return.
+ *
+ *  Comments:
+ *      None.
+ */
+[[noreturn]] void ThrowSystemError(const char *what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+/*
+ *  MapRegion()
+ *
+ *  Description:
+ *      Map a region of the memory file, excluding it from core dumps.
+ *
+ *  Parameters:
+ *      fd [in]
+ *          The memory file.
+ *
+ *      length [in]
+ *          Length of the region to map.
+ *
+ *      offset [in]
+ *          Offset of the region within the file.
+ *
+ *      protection [in]
+ *          The memory protection flags.
+ *
+ *  Returns:
+ *      A pointer to the mapped region, or nullptr on failure.
+ *
+ *  Comments:
+ *      None.
+ */
+void *MapRegion(int fd,
+                std::size_t length,
+                std::size_t offset,
+                int protection) noexcept
+{
+    void *p = mmap(nullptr,
+                   length,
+                   protection,
+                   MAP_SHARED,
+                   fd,
+                   static_cast<off_t>(offset));
+
+    if (p == MAP_FAILED) return nullptr;
+
+#if defined(MADV_DONTDUMP)
+    madvise(p, length, MADV_DONTDUMP);
+#endif
+
+    return p;
+}
+
+#endif
+
+} // namespace
+
+/*
+ *  SharedSecret::SharedSecret()
+ *
+ *  Description:
+ *      Default constructor, which creates an empty object.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SharedSecret::SharedSecret() noexcept :
+    fd{-1},
+    header{nullptr},
+    secret{nullptr},
+    length{0},
+    mapped_length{0}
+{
+}
+
+/*
+ *  SharedSecret::SharedSecret()
+ *
+ *  Description:
+ *      Move constructor.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The object from which ownership is taken.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The other object is left empty.
+ */
+SharedSecret::SharedSecret(SharedSecret &&other) noexcept :
+    fd{std::exchange(other.fd, -1)},
+    header{std::exchange(other.header, nullptr)},
+    secret{std::exchange(other.secret, nullptr)},
+    length{std::exchange(other.length, 0)},
+    mapped_length{std::exchange(other.mapped_length, 0)}
+{
+}
+
+/*
+ *  SharedSecret::~SharedSecret()
+ *
+ *  Description:
+ *      Release this owner's reference to the secret, erasing the secret if
+ *      this is the last owner.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+SharedSecret::~SharedSecret()
+{
+    Release();
+}
+
+/*
+ *  SharedSecret::operator=()
+ *
+ *  Description:
+ *      Move assignment operator.
+ *
+ *  Parameters:
+ *      other [in]
+ *          The object from which ownership is taken.
+ *
+ *  Returns:
+ *      A reference to this object.
+ *
+ *  Comments:
+ *      Any secret presently owned is released first.
+ */
+SharedSecret &SharedSecret::operator=(SharedSecret &&other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+
+        fd = std::exchange(other.fd, -1);
+        header = std::exchange(other.header, nullptr);
+        secret = std::exchange(other.secret, nullptr);
+        length = std::exchange(other.length, 0);
+        mapped_length = std::exchange(other.mapped_length, 0);
+    }
+
+    return *this;
+}
+
+/*
+ *  SharedSecret::Create()
+ *
+ *  Description:
+ *      Create a sealed memory file holding a copy of the given secret.
+ *
+ *  Parameters:
+ *      secret [in]
+ *          The secret to share.  The caller remains responsible for erasing
+ *          the original.
+ *
+ *  Returns:
+ *      The SharedSecret, which is the sole owner of the secret.
+ *
+ *  Comments:
+ *      This will throw std::system_error on failure.
+ */
+SharedSecret SharedSecret::Create(std::span<const std::uint8_t> secret)
+{
+#if defined(HAVE_MEMFD_CREATE)
+    const std::size_t page_size = SecurePages::PageSize();
+    const std::size_t data_length = RoundToPages(secret.size());
+    SharedSecret result;
+
+    result.fd = memfd_create("secutil_shared_secret",
+                             MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (result.fd < 0) ThrowSystemError("memfd_create failed");
+
+    if (ftruncate(result.fd, static_cast<off_t>(page_size + data_length)) != 0)
+    {
+        ThrowSystemError("Unable to size memory file");
+    }
+
+    if (fcntl(result.fd, F_ADD_SEALS, Required_Seals) != 0)
+    {
+        ThrowSystemError("Unable to seal memory file");
+    }
+
+    result.header = MapRegion(result.fd,
+                              page_size,
+                              0,
+                              PROT_READ | PROT_WRITE);
+    if (result.header == nullptr) ThrowSystemError("Unable to map memory file");
+
+    auto *shared_header = new (result.header) SharedHeader{};
+    shared_header->references.store(1, std::memory_order_relaxed);
+    shared_header->magic = Shared_Secret_Magic;
+    shared_header->length = secret.size();
+
+    if (secret.empty()) return result;
+
+    // Write the secret through a temporary writable mapping
+    void *p = MapRegion(result.fd,
+                        data_length,
+                        page_size,
+                        PROT_READ | PROT_WRITE);
+    if (p == nullptr) ThrowSystemError("Unable to map memory file");
+
+    mlock(p, data_length);
+    std::memcpy(p, secret.data(), secret.size());
+
+    if (mprotect(p, data_length, PROT_READ) != 0)
+    {
+        const int error = errno;
+        SecureErase(p, data_length);
+        munmap(p, data_length);
+        throw std::system_error(error,
+                                std::generic_category(),
+                                "Unable to protect memory file");
+    }
+
+    result.secret = static_cast<const std::uint8_t *>(p);
+    result.length = secret.size();
+    result.mapped_length = data_length;
+
+    return result;
+#else
+    static_cast<void>(secret);
+    throw std::system_error(
+        std::make_error_code(std::errc::function_not_supported),
+        "Shared secrets are not supported on this platform");
+#endif
+}
+
+/*
+ *  SharedSecret::Import()
+ *
+ *  Description:
+ *      Take ownership of a file descriptor returned by Export(), typically
+ *      received from another process, and map the secret it refers to.
+ *
+ *  Parameters:
+ *      fd [in]
+ *          The file descriptor.  Ownership is taken even if an exception is
+ *          thrown.
+ *
+ *  Returns:
+ *      The SharedSecret.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the descriptor does not
+ *      refer to a sealed memory file created by Create(), or
+ *      std::system_error if the secret cannot be mapped.
+ */
+SharedSecret SharedSecret::Import(int fd)
+{
+#if defined(HAVE_MEMFD_CREATE)
+    const std::size_t page_size = SecurePages::PageSize();
+    SharedSecret result;
+    struct stat status;
+
+    if (fd < 0) throw std::invalid_argument("Invalid file descriptor");
+
+    // Until the header is validated, close without touching the count
+    auto reject = [fd](const char *what)
+    {
+        close(fd);
+        throw std::invalid_argument(what);
+    };
+
+    // Descriptors that cannot be sealed fail with -1, which has every bit set
+    const int seals = fcntl(fd, F_GET_SEALS);
+    if ((seals < 0) || ((seals & Required_Seals) != Required_Seals))
+    {
+        reject("File descriptor is not a sealed memory file");
+    }
+
+    if ((fstat(fd, &status) != 0) ||
+        (static_cast<std::size_t>(status.st_size) < page_size))
+    {
+        reject("File descriptor is not a shared secret");
+    }
+
+    void *p = MapRegion(fd, page_size, 0, PROT_READ | PROT_WRITE);
+    if (p == nullptr)
+    {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error,
+                                std::generic_category(),
+                                "Unable to map memory file");
+    }
+
+    const auto *shared_header = static_cast<const SharedHeader *>(p);
+    const std::uint64_t secret_length = shared_header->length;
+
+    if ((shared_header->magic != Shared_Secret_Magic) ||
+        (secret_length > static_cast<std::uint64_t>(status.st_size)) ||
+        (RoundToPages(static_cast<std::size_t>(secret_length)) + page_size !=
+         static_cast<std::size_t>(status.st_size)))
+    {
+        munmap(p, page_size);
+        reject("File descriptor is not a shared secret");
+    }
+
+    // From here, the object owns a reference and releases it on failure
+    result.fd = fd;
+    result.header = p;
+
+    if (secret_length == 0) return result;
+
+    const std::size_t data_length =
+        RoundToPages(static_cast<std::size_t>(secret_length));
+
+    void *data = MapRegion(fd, data_length, page_size, PROT_READ);
+    if (data == nullptr) ThrowSystemError("Unable to map memory file");
+
+    // Locking is best effort, as the creator's lock already pins the pages
+    mlock(data, data_length);
+
+    result.secret = static_cast<const std::uint8_t *>(data);
+    result.length = static_cast<std::size_t>(secret_length);
+    result.mapped_length = data_length;
+
+    return result;
+#else
+    static_cast<void>(fd);
+    throw std::system_error(
+        std::make_error_code(std::errc::function_not_supported),
+        "Shared secrets are not supported on this platform");
+#endif
+}
+
+/*
+ *  SharedSecret::Export()
+ *
+ *  Description:
+ *      Create a new file descriptor referring to the secret, counted as an
+ *      additional owner, for transfer to another process.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The new file descriptor, which the caller must close once it has been
+ *      sent.  The receiver must pass the descriptor it receives to Import().
+ *
+ *  Comments:
+ *      This will throw std::logic_error if this object is empty, or
+ *      std::system_error if the descriptor cannot be duplicated.
+ */
+int SharedSecret::Export() const
+{
+#if defined(HAVE_MEMFD_CREATE)
+    if (fd < 0) throw std::logic_error("No shared secret to export");
+
+    auto *shared_header = static_cast<SharedHeader *>(header);
+
+    // Count the new owner first so the secret survives this owner's release
+    shared_header->references.fetch_add(1, std::memory_order_relaxed);
+
+    const int new_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (new_fd < 0)
+    {
+        const int error = errno;
+        shared_header->references.fetch_sub(1, std::memory_order_relaxed);
+        throw std::system_error(error,
+                                std::generic_category(),
+                                "Unable to duplicate file descriptor");
+    }
+
+    return new_fd;
+#else
+    throw std::logic_error("No shared secret to export");
+#endif
+}
+
+/*
+ *  SharedSecret::Release()
+ *
+ *  Description:
+ *      Release this owner's reference, erasing the secret and releasing its
+ *      pages if this is the last owner, and leave this object empty.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SharedSecret::Release() noexcept
+{
+#if defined(HAVE_MEMFD_CREATE)
+    if (fd < 0) return;
+
+    const std::size_t page_size = SecurePages::PageSize();
+
+    if (secret != nullptr) munmap(const_cast<std::uint8_t *>(secret), mapped_length);
+
+    if (header != nullptr)
+    {
+        auto *shared_header = static_cast<SharedHeader *>(header);
+
+        if (shared_header->references.fetch_sub(1, std::memory_order_acq_rel) ==
+            1)
+        {
+            const std::size_t data_length = RoundToPages(
+                static_cast<std::size_t>(shared_header->length));
+
+            if (data_length > 0)
+            {
+                void *p = MapRegion(fd,
+                                    data_length,
+                                    page_size,
+                                    PROT_READ | PROT_WRITE);
+                if (p != nullptr)
+                {
+                    SecureErase(p, data_length);
+                    munmap(p, data_length);
+                }
+
+#if defined(FALLOC_FL_PUNCH_HOLE)
+                fallocate(fd,
+                          FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                          static_cast<off_t>(page_size),
+                          static_cast<off_t>(data_length));
+#endif
+            }
+        }
+
+        munmap(header, page_size);
+    }
+
+    close(fd);
+#endif
+
+    fd = -1;
+    header = nullptr;
+    secret = nullptr;
+    length = 0;
+    mapped_length = 0;
+}
+
+} // namespace Terra::SecUtil
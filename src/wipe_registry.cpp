@@ -0,0 +1,546 @@
+/*
+ *  wipe_registry.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This module implements the registry of live secure memory regions and
+ *      the signal handlers that erase those regions on abnormal termination.
+ *
+ *      Each slot in the registry holds an address and a length.  A slot is
+ *      empty (address 0), holds a region, is a tombstone (address 1) left
+ *      when a region is deregistered, or is busy (address 2) while being
+ *      claimed.  Empty slots never reappear, so a region is always found
+ *      before the first empty slot in its probe sequence.  Tombstones are
+ *      reused by later registrations.
+ *
+ *      The address and length cannot be read together atomically, so each
+ *      slot also has a sequence number, which is odd while the slot is being
+ *      written.  A wipe uses a slot only if the sequence number is even and
+ *      unchanged after reading both fields (a sequence lock), so it never
+ *      pairs the address of one region with the length of another.  Only
+ *      the thread that claimed a slot writes to it, so writers never
+ *      contend.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <terra/secutil/wipe_registry.h>
+#include <terra/secutil/secure_erase.h>
+
+namespace Terra::SecUtil
+{
+
+namespace
+{
+
+// Values of a slot address that do not refer to a region
+constexpr std::uintptr_t Empty_Slot = 0;
+constexpr std::uintptr_t Tombstone_Slot = 1;
+constexpr std::uintptr_t Busy_Slot = 2;
+
+// Number of slots examined when registering or deregistering a region
+constexpr std::size_t Max_Probes = 16;
+
+struct RegistrySlot
+{
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uintptr_t> address;
+    std::atomic<std::size_t> length;
+};
+
+struct Registry
+{
+    std::size_t mask;
+    unsigned shift;
+    std::unique_ptr<RegistrySlot[]> slots;
+};
+
+// The registry is never freed, as it may be used until the process exits
+std::atomic<Registry *> registry{nullptr};
+std::atomic<std::size_t> dropped{0};
+std::once_flag enable_once;
+std::once_flag install_once;
+
+// Signals for which handlers are installed
+constexpr std::array Wipe_Signals = {
+    SIGABRT,
+#if defined(SIGBUS)
+    SIGBUS,
+#endif
+    SIGFPE,
+#if defined(SIGHUP)
+    SIGHUP,
+#endif
+    SIGILL,
+    SIGINT,
+#if defined(SIGQUIT)
+    SIGQUIT,
+#endif
+    SIGSEGV,
+    SIGTERM,
+#if defined(SIGTRAP)
+    SIGTRAP,
+#endif
+};
+
+
+/*
+ *  SlotIndex()
+ *
+ *  Description:
+ *      Compute the first slot to examine for the given address.
+ *
+ *  Parameters:
+ *      table [in]
+ *          The registry.
+ *
+ *      address [in]
+ *          The address of the region.
+ *
+ *  Returns:
+ *      The index of the first slot in the probe sequence.
+ *
+ *  Comments:
+ *      Fibonacci hashing spreads allocations, which are typically aligned
+ *      to 16 octets, across the table.
+ */
+std::size_t SlotIndex(const Registry &table, std::uintptr_t address) noexcept
+{
+    const std::uint64_t hash =
+        (static_cast<std::uint64_t>(address) >> 4) * 0x9e3779b97f4a7c15ULL;
+
+    return static_cast<std::size_t>(hash >> table.shift) & table.mask;
+}
+
+/*
+ *  WipeSignalHandler()
+ *
+ *  Description:
+ *      Erase all registered regions, then restore the default disposition
+ *      of the signal and raise it again to terminate the process.
+ *
+ *  Parameters:
+ *      signal_number [in]
+ *          The signal received.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The handler is installed only where the default disposition was in
+ *      place, and the default disposition of every handled signal
+ *      terminates the process.  The signal is delivered again once this
+ *      handler returns, since it is blocked while the handler executes.
+ *      For faults, the faulting instruction is simply executed again.
+ */
+void WipeSignalHandler(int signal_number)
+{
+    WipeRegisteredRegions();
+
+    std::signal(signal_number, SIG_DFL);
+    std::raise(signal_number);
+}
+
+/*
+ *  WipeAtQuickExit()
+ *
+ *  Description:
+ *      Erase all registered regions when std::quick_exit() is called.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void WipeAtQuickExit()
+{
+    WipeRegisteredRegions();
+}
+
+} // namespace
+
+namespace Internal
+{
+
+std::atomic<bool> wipe_registry_enabled{false};
+
+} // namespace Internal
+
+/*
+ *  EnableWipeRegistry()
+ *
+ *  Description:
+ *      Allocate the registry and begin registering secure memory regions.
+ *
+ *  Parameters:
+ *      capacity [in]
+ *          The number of slots in the registry, which is rounded up to a
+ *          power of two.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Calls after the first have no effect.  This will throw
+ *      std::bad_alloc if the registry cannot be allocated.
+ */
+void EnableWipeRegistry(std::size_t capacity)
+{
+    std::call_once(enable_once,
+                   [capacity]()
+                   {
+                       auto table = std::make_unique<Registry>();
+                       unsigned bits = 1;
+
+                       while ((bits < 32) &&
+                              ((std::size_t{1} << bits) < capacity))
+                       {
+                           bits++;
+                       }
+
+                       table->mask = (std::size_t{1} << bits) - 1;
+                       table->shift = 64 - bits;
+                       table->slots =
+                           std::make_unique<RegistrySlot[]>(table->mask + 1);
+
+                       registry.store(table.release(),
+                                      std::memory_order_release);
+                       Internal::wipe_registry_enabled.store(
+                           true,
+                           std::memory_order_release);
+                   });
+}
+
+/*
+ *  WipeRegistryEnabled()
+ *
+ *  Description:
+ *      Determine whether the registry has been enabled.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if the registry is enabled, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool WipeRegistryEnabled() noexcept
+{
+    return registry.load(std::memory_order_acquire) != nullptr;
+}
+
+/*
+ *  Internal::RegisterRegion()
+ *
+ *  Description:
+ *      Register a region of memory to be erased by WipeRegisteredRegions().
+ *
+ *  Parameters:
+ *      address [in]
+ *          The start of the region.
+ *
+ *      length [in]
+ *          The length of the region in octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The first empty or tombstone slot in the probe sequence is claimed
+ *      by marking it busy, after which the region is written under the
+ *      slot's sequence lock.
+ */
+void Internal::RegisterRegion(std::uintptr_t address,
+                              std::size_t length) noexcept
+{
+    Registry *table = registry.load(std::memory_order_acquire);
+
+    if ((table == nullptr) || (address == 0) || (length == 0)) return;
+
+    const std::size_t start = SlotIndex(*table, address);
+
+    for (std::size_t probe = 0; probe < Max_Probes; probe++)
+    {
+        RegistrySlot &slot = table->slots[(start + probe) & table->mask];
+        std::uintptr_t current = slot.address.load(std::memory_order_relaxed);
+
+        if ((current <= Tombstone_Slot) &&
+            slot.address.compare_exchange_strong(current,
+                                                 Busy_Slot,
+                                                 std::memory_order_acquire))
+        {
+            const std::uint64_t sequence =
+                slot.sequence.load(std::memory_order_relaxed);
+
+            slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.length.store(length, std::memory_order_relaxed);
+            slot.address.store(address, std::memory_order_relaxed);
+            slot.sequence.store(sequence + 2, std::memory_order_release);
+            return;
+        }
+    }
+
+    dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+ *  Internal::DeregisterRegion()
+ *
+ *  Description:
+ *      Remove a region previously registered with RegisterSecureRegion().
+ *
+ *  Parameters:
+ *      address [in]
+ *          The start of the region.
+ *
+ *      length [in]
+ *          The length of the region in octets.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The length is compared as well as the address, since a region may
+ *      begin at the same address as an enclosing region (e.g., a SecureArray
+ *      held within a SecureVector).
+ */
+void Internal::DeregisterRegion(std::uintptr_t address,
+                                std::size_t length) noexcept
+{
+    Registry *table = registry.load(std::memory_order_acquire);
+
+    if ((table == nullptr) || (address == 0) || (length == 0)) return;
+
+    const std::size_t start = SlotIndex(*table, address);
+
+    for (std::size_t probe = 0; probe < Max_Probes; probe++)
+    {
+        RegistrySlot &slot = table->slots[(start + probe) & table->mask];
+        const std::uintptr_t current =
+            slot.address.load(std::memory_order_acquire);
+
+        if (current == Empty_Slot) return;
+
+        if ((current == address) &&
+            (slot.length.load(std::memory_order_relaxed) == length))
+        {
+            const std::uint64_t sequence =
+                slot.sequence.load(std::memory_order_relaxed);
+
+            slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.length.store(0, std::memory_order_relaxed);
+            slot.address.store(Tombstone_Slot, std::memory_order_relaxed);
+            slot.sequence.store(sequence + 2, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+/*
+ *  WipeRegisteredRegions()
+ *
+ *  Description:
+ *      Erase every registered region.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Only atomic loads and SecureErase() are used, so this function is
+ *      async-signal-safe.  A slot being written concurrently is skipped.
+ */
+void WipeRegisteredRegions() noexcept
+{
+    Registry *table = registry.load(std::memory_order_acquire);
+
+    if (table == nullptr) return;
+
+    for (std::size_t i = 0; i <= table->mask; i++)
+    {
+        const RegistrySlot &slot = table->slots[i];
+        const std::uint64_t sequence =
+            slot.sequence.load(std::memory_order_acquire);
+
+        if ((sequence & 1) != 0) continue;
+
+        const std::uintptr_t address =
+            slot.address.load(std::memory_order_relaxed);
+        const std::size_t length = slot.length.load(std::memory_order_relaxed);
+
+        // Discard the values if the slot changed while being read
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+        if ((address > Busy_Slot) && (length > 0))
+        {
+            SecureErase(reinterpret_cast<void *>(address), length);
+        }
+    }
+}
+
+/*
+ *  InstallWipeHandlers()
+ *
+ *  Description:
+ *      Install signal handlers that call WipeRegisteredRegions() and register
+ *      it with std::at_quick_exit().
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      A handler is installed only for signals whose disposition is the
+ *      default, since an ignored or application-handled signal does not
+ *      terminate the process and the secrets must then remain intact.  All
+ *      handled signals are blocked while a handler executes, so a second
+ *      signal cannot interrupt the wipe.  Calls after the first have no
+ *      effect.  This will throw std::system_error if a handler cannot be
+ *      installed.
+ */
+void InstallWipeHandlers()
+{
+    std::call_once(
+        install_once,
+        []()
+        {
+#if defined(_WIN32)
+            for (const int signal_number : Wipe_Signals)
+            {
+                const auto previous =
+                    std::signal(signal_number, WipeSignalHandler);
+                if (previous == SIG_ERR)
+                {
+                    throw std::system_error(errno,
+                                            std::generic_category(),
+                                            "Failed to install signal handler");
+                }
+
+                // Leave ignored or application-handled signals alone
+                if (previous != SIG_DFL) std::signal(signal_number, previous);
+            }
+#else
+            struct sigaction action{};
+
+            action.sa_handler = WipeSignalHandler;
+            sigemptyset(&action.sa_mask);
+            for (const int signal_number : Wipe_Signals)
+            {
+                sigaddset(&action.sa_mask, signal_number);
+            }
+
+            for (const int signal_number : Wipe_Signals)
+            {
+                struct sigaction previous{};
+
+                if (sigaction(signal_number, nullptr, &previous) < 0)
+                {
+                    throw std::system_error(errno,
+                                            std::generic_category(),
+                                            "Failed to query signal handler");
+                }
+
+                // Leave ignored or application-handled signals alone
+                if (((previous.sa_flags & SA_SIGINFO) != 0) ||
+                    (previous.sa_handler != SIG_DFL))
+                {
+                    continue;
+                }
+
+                if (sigaction(signal_number, &action, nullptr) < 0)
+                {
+                    throw std::system_error(errno,
+                                            std::generic_category(),
+                                            "Failed to install signal handler");
+                }
+            }
+#endif
+
+            std::at_quick_exit(WipeAtQuickExit);
+        });
+}
+
+/*
+ *  RegisteredRegions()
+ *
+ *  Description:
+ *      Count the regions presently registered.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of registered regions.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t RegisteredRegions() noexcept
+{
+    Registry *table = registry.load(std::memory_order_acquire);
+    std::size_t count = 0;
+
+    if (table == nullptr) return 0;
+
+    for (std::size_t i = 0; i <= table->mask; i++)
+    {
+        if (table->slots[i].address.load(std::memory_order_relaxed) >
+            Busy_Slot)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*
+ *  DroppedRegions()
+ *
+ *  Description:
+ *      Return the number of regions that could not be registered.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of dropped registrations.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t DroppedRegions() noexcept
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace Terra::SecUtil
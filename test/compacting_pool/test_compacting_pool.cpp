@@ -0,0 +1,260 @@
+/*
+ *  test_compacting_pool.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the CompactingPool and SecretHandle objects.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <terra/secutil/compacting_pool.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+bool AllZero(const void *data, std::size_t length)
+{
+    const auto *p = static_cast<const std::uint8_t *>(data);
+
+    return std::all_of(p, p + length, [](std::uint8_t c) { return c == 0; });
+}
+
+// Fill an object with a pattern derived from the given value
+void Fill(SecUtil::SecretHandle &handle, std::size_t value)
+{
+    auto view = handle.Pin();
+
+    for (std::size_t i = 0; i < view.size(); i++)
+    {
+        view.data()[i] = static_cast<std::uint8_t>(value + i);
+    }
+}
+
+// Verify the pattern written by Fill()
+bool Check(SecUtil::SecretHandle &handle, std::size_t value)
+{
+    auto view = handle.Pin();
+
+    for (std::size_t i = 0; i < view.size(); i++)
+    {
+        if (view.data()[i] != static_cast<std::uint8_t>(value + i)) return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+STF_TEST(CompactingPool, AllocateAndRelease)
+{
+    SecUtil::CompactingPool pool;
+
+    SecUtil::SecretHandle empty = pool.Allocate(0);
+    STF_ASSERT_TRUE(empty.empty());
+    STF_ASSERT_EQ(nullptr, empty.Pin().data());
+    STF_ASSERT_EQ(0, pool.ReservedBytes());
+
+    SecUtil::SecretHandle key = pool.Allocate(40);
+    STF_ASSERT_EQ(40, key.size());
+    STF_ASSERT_EQ(40, pool.InUseBytes());
+    STF_ASSERT_EQ(SecUtil::Default_Pool_Chunk_Size, pool.ReservedBytes());
+    {
+        auto view = key.Pin();
+        STF_ASSERT_EQ(40, view.size());
+        STF_ASSERT_TRUE(AllZero(view.data(), view.size()));
+        STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(view.data()) % 16);
+    }
+    Fill(key, 7);
+
+    // Moving the handle does not move the object
+    SecUtil::SecretHandle other(std::move(key));
+    STF_ASSERT_TRUE(key.empty());
+    STF_ASSERT_TRUE(Check(other, 7));
+
+    // The released block is erased and handed out again
+    std::uint8_t *address = other.Pin().data();
+    other.Reset();
+    STF_ASSERT_EQ(0, pool.InUseBytes());
+    key = pool.Allocate(48);
+    STF_ASSERT_EQ(address, key.Pin().data());
+    STF_ASSERT_TRUE(AllZero(key.Pin().data(), 48));
+
+    bool exception_thrown = false;
+    try
+    {
+        [[maybe_unused]] auto handle =
+            pool.Allocate(SecUtil::Max_Pool_Block + 1);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+}
+
+STF_TEST(CompactingPool, ReleaseWhilePinned)
+{
+    SecUtil::CompactingPool pool;
+
+    // The handle is destroyed at once, but the view keeps the object alive
+    std::uint8_t *address = nullptr;
+    {
+        auto view = pool.Allocate(32).Pin();
+        address = view.data();
+        std::memset(view.data(), 0x5a, view.size());
+        STF_ASSERT_EQ(32, pool.InUseBytes());
+
+        // The object is neither moved nor its block reused
+        pool.Compact();
+        SecUtil::SecretHandle other = pool.Allocate(32);
+        STF_ASSERT_NE(address, other.Pin().data());
+        STF_ASSERT_EQ(0x5a, view.data()[31]);
+    }
+    STF_ASSERT_EQ(0, pool.InUseBytes());
+
+    // The block was erased and freed when the view was destroyed
+    SecUtil::SecretHandle reused = pool.Allocate(32);
+    STF_ASSERT_EQ(address, reused.Pin().data());
+    STF_ASSERT_TRUE(AllZero(reused.Pin().data(), 32));
+    STF_ASSERT_EQ(0, pool.Compact().pinned_objects);
+}
+
+STF_TEST(CompactingPool, CompactReleasesChunks)
+{
+    SecUtil::CompactingPool pool(4096);
+    std::vector<SecUtil::SecretHandle> handles;
+
+    for (std::size_t i = 0; i < 1000; i++)
+    {
+        handles.push_back(pool.Allocate(64));
+        Fill(handles.back(), i);
+    }
+    const std::size_t reserved = pool.ReservedBytes();
+    STF_ASSERT_GE(reserved, 1000 * 64);
+    STF_ASSERT_EQ(reserved, pool.LockedBytes());
+
+    // Keep every tenth object, leaving each chunk sparsely occupied
+    for (std::size_t i = 0; i < handles.size(); i++)
+    {
+        if (i % 10 != 0) handles[i].Reset();
+    }
+    STF_ASSERT_EQ(reserved, pool.ReservedBytes());
+
+    const auto statistics = pool.Compact();
+    STF_ASSERT_GT(statistics.moved_objects, 0);
+    STF_ASSERT_EQ(statistics.moved_objects * 64, statistics.moved_bytes);
+    STF_ASSERT_EQ(0, statistics.pinned_objects);
+    STF_ASSERT_GT(statistics.released_chunks, 0);
+    STF_ASSERT_EQ(reserved - statistics.released_bytes, pool.ReservedBytes());
+    STF_ASSERT_EQ(pool.ReservedBytes(), pool.LockedBytes());
+
+    // The 100 remaining objects fit in two chunks
+    STF_ASSERT_EQ(2 * 4096, pool.ReservedBytes());
+
+    for (std::size_t i = 0; i < handles.size(); i += 10)
+    {
+        STF_ASSERT_TRUE(Check(handles[i], i));
+    }
+
+    // A second compaction has nothing to do
+    const auto again = pool.Compact();
+    STF_ASSERT_EQ(0, again.moved_objects);
+    STF_ASSERT_EQ(0, again.released_chunks);
+
+    handles.clear();
+    STF_ASSERT_EQ(2 * 4096, pool.Compact().released_bytes);
+    STF_ASSERT_EQ(0, pool.ReservedBytes());
+}
+
+STF_TEST(CompactingPool, PinnedObjectsNotMoved)
+{
+    SecUtil::CompactingPool pool(4096);
+    std::vector<SecUtil::SecretHandle> handles;
+
+    // Two chunks of 32 128-octet blocks, plus one object in a third chunk
+    for (std::size_t i = 0; i < 65; i++)
+    {
+        handles.push_back(pool.Allocate(128));
+        Fill(handles.back(), i);
+    }
+    STF_ASSERT_EQ(3 * 4096, pool.ReservedBytes());
+    for (std::size_t i = 1; i < 64; i++) handles[i].Reset();
+
+    // The first object is pinned, so its chunk is kept and receives the last
+    auto view = handles[0].Pin();
+    std::uint8_t *address = view.data();
+
+    const auto statistics = pool.Compact();
+    STF_ASSERT_EQ(1, statistics.moved_objects);
+    STF_ASSERT_EQ(1, statistics.pinned_objects);
+    STF_ASSERT_EQ(2, statistics.released_chunks);
+    STF_ASSERT_EQ(4096, pool.ReservedBytes());
+    STF_ASSERT_EQ(address, handles[0].Pin().data());
+    STF_ASSERT_TRUE(Check(handles[64], 64));
+}
+
+STF_TEST(CompactingPool, Threads)
+{
+    SecUtil::CompactingPool pool(4096);
+    std::atomic<bool> running{true};
+    std::atomic<bool> intact{true};
+    std::vector<std::thread> threads;
+
+    // Threads allocate, verify, and release objects while the pool is
+    // compacted
+    for (std::size_t t = 0; t < 4; t++)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                std::vector<SecUtil::SecretHandle> handles;
+
+                for (std::size_t i = 0; running; i++)
+                {
+                    handles.push_back(pool.Allocate(32 + (t * 16)));
+                    Fill(handles.back(), i);
+
+                    if (handles.size() == 200)
+                    {
+                        for (std::size_t j = 0; j < handles.size(); j++)
+                        {
+                            if (!Check(handles[j], i - 199 + j)) intact = false;
+                        }
+                        handles.clear();
+                    }
+                }
+            });
+    }
+
+    for (unsigned i = 0; i < 200; i++)
+    {
+        pool.Compact();
+        std::this_thread::yield();
+    }
+    running = false;
+    for (auto &thread : threads) thread.join();
+
+    STF_ASSERT_TRUE(intact);
+    STF_ASSERT_EQ(0, pool.InUseBytes());
+    pool.Compact();
+    STF_ASSERT_EQ(0, pool.ReservedBytes());
+}
@@ -0,0 +1,208 @@
+/*
+ *  test_constant_time.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the constant-time select, conditional copy, conditional
+ *      swap, and table lookup functions.
+ *
+ *      When built with the Valgrind headers available and run under Memcheck,
+ *      the secret inputs are marked as undefined.  Memcheck then reports an
+ *      error for any conditional branch or memory address that depends on a
+ *      secret, verifying that no data-dependent branches are emitted.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <terra/secutil/constant_time.h>
+#include <terra/secutil/secure_array.h>
+#include <terra/secutil/secure_vector.h>
+#include <terra/stf/stf.h>
+#if defined(HAVE_VALGRIND_MEMCHECK_H)
+#include <valgrind/memcheck.h>
+#define MarkSecret(p, n) VALGRIND_MAKE_MEM_UNDEFINED(p, n)
+#define MarkPublic(p, n) VALGRIND_MAKE_MEM_DEFINED(p, n)
+#else
+#define MarkSecret(p, n)
+#define MarkPublic(p, n)
+#endif
+
+using namespace Terra;
+
+STF_TEST(ConstantTime, Select)
+{
+    bool condition = true;
+
+    MarkSecret(&condition, sizeof(condition));
+    std::uint32_t a = SecUtil::ConstantTimeSelect<std::uint32_t>(condition,
+                                                                 0x12345678,
+                                                                 0x9abcdef0);
+    MarkPublic(&a, sizeof(a));
+    STF_ASSERT_EQ(0x12345678, a);
+
+    condition = false;
+
+    MarkSecret(&condition, sizeof(condition));
+    std::uint8_t b = SecUtil::ConstantTimeSelect<std::uint8_t>(condition,
+                                                               0x12,
+                                                               0x34);
+    MarkPublic(&b, sizeof(b));
+    STF_ASSERT_EQ(0x34, b);
+}
+
+STF_TEST(ConstantTime, ConditionalCopy)
+{
+    // Exercise the vector, word, and octet paths
+    for (std::size_t length = 0; length <= 70; length++)
+    {
+        std::vector<std::uint8_t> source(length, 0xaa);
+        std::vector<std::uint8_t> original(length, 0x55);
+
+        for (bool condition : {false, true})
+        {
+            std::vector<std::uint8_t> destination = original;
+
+            MarkSecret(&condition, sizeof(condition));
+            MarkSecret(source.data(), source.size());
+            MarkSecret(destination.data(), destination.size());
+
+            SecUtil::ConditionalCopy(condition,
+                                     destination.data(),
+                                     source.data(),
+                                     length);
+
+            MarkPublic(&condition, sizeof(condition));
+            MarkPublic(source.data(), source.size());
+            MarkPublic(destination.data(), destination.size());
+
+            STF_ASSERT_EQ(condition ? source : original, destination);
+        }
+    }
+}
+
+STF_TEST(ConstantTime, ConditionalCopyContainers)
+{
+    SecUtil::SecureArray<std::uint32_t, 8> destination{};
+    SecUtil::SecureVector<std::uint32_t> source(8, 0xdeadbeef);
+
+    SecUtil::ConditionalCopy(false, destination, source);
+    STF_ASSERT_EQ(0, destination[7]);
+
+    SecUtil::ConditionalCopy(true, destination, source);
+    STF_ASSERT_EQ(0xdeadbeef, destination[7]);
+
+    // Copying into a span is permitted
+    SecUtil::ConditionalCopy(true,
+                             std::span<std::uint32_t>(destination),
+                             source);
+
+    // Differing sizes are rejected
+    bool exception_thrown = false;
+    source.resize(7);
+    try
+    {
+        SecUtil::ConditionalCopy(true, destination, source);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+}
+
+STF_TEST(ConstantTime, ConditionalSwap)
+{
+    for (std::size_t length = 0; length <= 70; length++)
+    {
+        for (bool condition : {false, true})
+        {
+            std::vector<std::uint8_t> a(length, 0x11);
+            std::vector<std::uint8_t> b(length, 0x22);
+
+            MarkSecret(&condition, sizeof(condition));
+            MarkSecret(a.data(), a.size());
+            MarkSecret(b.data(), b.size());
+
+            SecUtil::ConditionalSwap(condition, a.data(), b.data(), length);
+
+            MarkPublic(&condition, sizeof(condition));
+            MarkPublic(a.data(), a.size());
+            MarkPublic(b.data(), b.size());
+
+            STF_ASSERT_EQ(std::vector<std::uint8_t>(length,
+                                                    condition ? 0x22 : 0x11),
+                          a);
+            STF_ASSERT_EQ(std::vector<std::uint8_t>(length,
+                                                    condition ? 0x11 : 0x22),
+                          b);
+        }
+    }
+}
+
+STF_TEST(ConstantTime, ConditionalSwapContainers)
+{
+    SecUtil::SecureArray<std::uint8_t, 4> a = {1, 2, 3, 4};
+    SecUtil::SecureArray<std::uint8_t, 4> b = {5, 6, 7, 8};
+
+    SecUtil::ConditionalSwap(true, a, b);
+
+    STF_ASSERT_EQ(5, a[0]);
+    STF_ASSERT_EQ(4, b[3]);
+}
+
+STF_TEST(ConstantTime, Lookup)
+{
+    constexpr std::size_t Entries = 16;
+    constexpr std::size_t Entry_Size = 37;
+    std::vector<std::uint8_t> table(Entries * Entry_Size);
+
+    for (std::size_t i = 0; i < table.size(); i++)
+    {
+        table[i] = static_cast<std::uint8_t>(i / Entry_Size + 1);
+    }
+
+    for (std::size_t index = 0; index <= Entries; index++)
+    {
+        std::vector<std::uint8_t> entry(Entry_Size, 0xff);
+        std::size_t secret_index = index;
+
+        MarkSecret(&secret_index, sizeof(secret_index));
+        MarkSecret(table.data(), table.size());
+
+        SecUtil::ConstantTimeLookup(entry.data(),
+                                    table.data(),
+                                    Entry_Size,
+                                    Entries,
+                                    secret_index);
+
+        MarkPublic(table.data(), table.size());
+        MarkPublic(entry.data(), entry.size());
+
+        // An out of range index produces zeros
+        const auto expected = static_cast<std::uint8_t>(
+            index < Entries ? index + 1 : 0);
+        STF_ASSERT_EQ(std::vector<std::uint8_t>(Entry_Size, expected), entry);
+    }
+}
+
+STF_TEST(ConstantTime, LookupContainers)
+{
+    SecUtil::SecureVector<std::uint16_t> table = {1, 2, 3, 4, 5, 6};
+    SecUtil::SecureArray<std::uint16_t, 2> entry{};
+
+    SecUtil::ConstantTimeLookup(entry, table, 2);
+
+    STF_ASSERT_EQ(5, entry[0]);
+    STF_ASSERT_EQ(6, entry[1]);
+}
@@ -0,0 +1,173 @@
+/*
+ *  test_keystore.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the keystore writer and reader.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <terra/secutil/keystore.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// Keystore file that is removed when the object is destroyed
+class TemporaryKeystore
+{
+    public:
+        explicit TemporaryKeystore(const std::string &name) :
+            path{std::filesystem::temp_directory_path() /
+                 (name + "_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)))}
+        {
+        }
+
+        ~TemporaryKeystore()
+        {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+
+        std::filesystem::path path;
+};
+
+std::vector<std::uint8_t> TestRecord(std::uint64_t key_id)
+{
+    return std::vector<std::uint8_t>(static_cast<std::size_t>(key_id % 50),
+                                     static_cast<std::uint8_t>(key_id));
+}
+
+template<typename F>
+bool ThrowsInvalidArgument(F function)
+{
+    try
+    {
+        function();
+    }
+    catch (const std::invalid_argument &)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace
+
+STF_TEST(Keystore, WriteAndFind)
+{
+    TemporaryKeystore file("secutil_keystore");
+    SecUtil::KeystoreWriter writer;
+
+    for (std::uint64_t key_id = 1000; key_id < 3000; key_id++)
+    {
+        writer.Add(key_id, TestRecord(key_id));
+    }
+    writer.Write(file.path);
+
+    SecUtil::Keystore keystore(file.path);
+
+    STF_ASSERT_EQ(2000, keystore.size());
+    STF_ASSERT_EQ(0, keystore.CachedRecords());
+
+    for (std::uint64_t key_id = 1000; key_id < 3000; key_id += 7)
+    {
+        auto record = keystore.Find(key_id);
+        STF_ASSERT_NE(nullptr, record);
+
+        const auto expected = TestRecord(key_id);
+        STF_ASSERT_EQ(expected,
+                      std::vector<std::uint8_t>(record->begin(), record->end()));
+    }
+
+    STF_ASSERT_FALSE(keystore.Contains(999));
+    STF_ASSERT_TRUE(keystore.Contains(2999));
+    STF_ASSERT_EQ(nullptr, keystore.Find(3000));
+}
+
+STF_TEST(Keystore, LeastRecentlyUsedEviction)
+{
+    TemporaryKeystore file("secutil_keystore_lru");
+    SecUtil::KeystoreWriter writer;
+
+    for (std::uint64_t key_id = 1; key_id <= 10; key_id++)
+    {
+        writer.Add(key_id, TestRecord(key_id));
+    }
+    writer.Write(file.path);
+
+    SecUtil::Keystore keystore(file.path, 3);
+
+    auto first = keystore.Find(1);
+    keystore.Find(2);
+    keystore.Find(3);
+
+    // Touching record 1 makes record 2 the least recently used
+    STF_ASSERT_EQ(first, keystore.Find(1));
+    keystore.Find(4);
+
+    STF_ASSERT_EQ(3, keystore.CachedRecords());
+    STF_ASSERT_EQ(first, keystore.Find(1));
+
+    // Record 2 was evicted, so it is loaded anew
+    auto second = keystore.Find(2);
+    STF_ASSERT_EQ(TestRecord(2),
+                  std::vector<std::uint8_t>(second->begin(), second->end()));
+
+    // An evicted record remains valid while referenced
+    keystore.ClearCache();
+    STF_ASSERT_EQ(0, keystore.CachedRecords());
+    STF_ASSERT_EQ(TestRecord(1),
+                  std::vector<std::uint8_t>(first->begin(), first->end()));
+
+    keystore.Find(5);
+    keystore.Evict(5);
+    STF_ASSERT_EQ(0, keystore.CachedRecords());
+}
+
+STF_TEST(Keystore, Empty)
+{
+    TemporaryKeystore file("secutil_keystore_empty");
+    SecUtil::KeystoreWriter().Write(file.path);
+
+    SecUtil::Keystore keystore(file.path);
+
+    STF_ASSERT_EQ(0, keystore.size());
+    STF_ASSERT_EQ(nullptr, keystore.Find(0));
+}
+
+STF_TEST(Keystore, Errors)
+{
+    SecUtil::KeystoreWriter writer;
+    const std::vector<std::uint8_t> record(4, 1);
+
+    writer.Add(42, record);
+    STF_ASSERT_TRUE(ThrowsInvalidArgument([&]() { writer.Add(42, record); }));
+
+    TemporaryKeystore file("secutil_keystore_invalid");
+    {
+        std::ofstream invalid(file.path, std::ios::binary);
+        invalid << "This is not a keystore file at all";
+    }
+
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { SecUtil::Keystore keystore(file.path); }));
+}
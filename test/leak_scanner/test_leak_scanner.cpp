@@ -0,0 +1,425 @@
+/*
+ *  test_leak_scanner.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the LeakScanner.
+ *
+ *  Portability Issues:
+ *      The process scan test runs only on Linux.  It is skipped when built
+ *      with AddressSanitizer, whose shadow memory spans terabytes.
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <terra/secutil/leak_scanner.h>
+#include <terra/secutil/secure_erase.h>
+#include <terra/secutil/secure_pages.h>
+#include <terra/secutil/secure_random.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+#if defined(__SANITIZE_ADDRESS__)
+#define SECUTIL_TEST_ASAN
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define SECUTIL_TEST_ASAN
+#endif
+#endif
+
+namespace
+{
+
+// Names a temporary file, which is removed when the object is destroyed
+class TemporaryPath
+{
+    public:
+        TemporaryPath(const std::string &name) :
+            path{std::filesystem::temp_directory_path() /
+                 (name + "_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)))}
+        {
+        }
+
+        ~TemporaryPath()
+        {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+
+        std::filesystem::path path;
+};
+
+void WriteFile(const std::filesystem::path &path,
+               const std::vector<std::uint8_t> &contents)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(contents.data()),
+               static_cast<std::streamsize>(contents.size()));
+}
+
+void StoreLE(std::vector<std::uint8_t> &buffer,
+             std::size_t offset,
+             std::uint64_t value,
+             std::size_t length)
+{
+    for (std::size_t i = 0; i < length; i++, value >>= 8)
+    {
+        buffer[offset + i] = static_cast<std::uint8_t>(value);
+    }
+}
+
+} // namespace
+
+STF_TEST(LeakScanner, ScanBuffer)
+{
+    const std::vector<std::uint8_t> pattern1 = {0x11, 0x22, 0x33, 0x44, 0x55};
+    const std::vector<std::uint8_t> pattern2 = {0x11, 0x99, 0x99, 0x55};
+    SecUtil::LeakScanner scanner;
+
+    STF_ASSERT_EQ(0, scanner.AddPattern(pattern1));
+    STF_ASSERT_EQ(1, scanner.AddPattern(pattern2));
+    STF_ASSERT_EQ(2, scanner.PatternCount());
+
+    std::vector<std::uint8_t> data(100, 0x11);
+    std::memcpy(data.data(), pattern1.data(), pattern1.size());
+    std::memcpy(data.data() + 40, pattern2.data(), pattern2.size());
+    std::memcpy(data.data() + 95, pattern1.data(), pattern1.size());
+
+    auto matches = scanner.Scan(data, 1000);
+
+    STF_ASSERT_EQ(3, matches.size());
+    STF_ASSERT_EQ(0, matches[0].pattern);
+    STF_ASSERT_EQ(1000, matches[0].address);
+    STF_ASSERT_EQ(1, matches[1].pattern);
+    STF_ASSERT_EQ(1040, matches[1].address);
+    STF_ASSERT_EQ(0, matches[2].pattern);
+    STF_ASSERT_EQ(1095, matches[2].address);
+
+    // Check every alignment, including those handled without SIMD
+    for (std::size_t offset = 0; offset + pattern1.size() <= 64; offset++)
+    {
+        std::vector<std::uint8_t> buffer(64, 0);
+        std::memcpy(buffer.data() + offset, pattern1.data(), pattern1.size());
+
+        matches = scanner.Scan(buffer);
+        STF_ASSERT_EQ(1, matches.size());
+        STF_ASSERT_EQ(offset, matches[0].address);
+    }
+
+    // Buffers shorter than a pattern contain no matches
+    STF_ASSERT_TRUE(scanner.Scan(std::span(pattern1.data(), 4)).empty());
+}
+
+STF_TEST(LeakScanner, OverlappingMatches)
+{
+    const std::vector<std::uint8_t> pattern = {0xaa, 0xbb, 0xaa, 0xbb};
+    SecUtil::LeakScanner scanner;
+
+    scanner.AddPattern(pattern);
+
+    const std::vector<std::uint8_t> data = {0xaa, 0xbb, 0xaa, 0xbb, 0xaa, 0xbb};
+    auto matches = scanner.Scan(data);
+
+    STF_ASSERT_EQ(2, matches.size());
+    STF_ASSERT_EQ(0, matches[0].address);
+    STF_ASSERT_EQ(2, matches[1].address);
+}
+
+STF_TEST(LeakScanner, ManyPatterns)
+{
+    std::vector<std::vector<std::uint8_t>> patterns;
+    SecUtil::LeakScanner scanner;
+
+    // Enough patterns that the table of prefixes is used
+    for (std::size_t i = 0; i < 40; i++)
+    {
+        std::vector<std::uint8_t> pattern(8 + i % 5);
+        for (std::size_t j = 0; j < pattern.size(); j++)
+        {
+            pattern[j] = static_cast<std::uint8_t>(i * 7 + j * 31 + 1);
+        }
+        STF_ASSERT_EQ(i, scanner.AddPattern(pattern));
+        patterns.push_back(pattern);
+    }
+
+    std::vector<std::uint8_t> data(20000, 0);
+    for (std::size_t i = 0; i < patterns.size(); i += 3)
+    {
+        std::memcpy(data.data() + i * 450, patterns[i].data(), patterns[i].size());
+    }
+    std::memcpy(data.data() + data.size() - patterns[5].size(),
+                patterns[5].data(),
+                patterns[5].size());
+
+    auto matches = scanner.Scan(data);
+
+    STF_ASSERT_EQ((patterns.size() + 2) / 3 + 1, matches.size());
+    for (std::size_t i = 0; i + 1 < matches.size(); i++)
+    {
+        STF_ASSERT_EQ(i * 3, matches[i].pattern);
+        STF_ASSERT_EQ(i * 3 * 450, matches[i].address);
+    }
+    STF_ASSERT_EQ(5, matches.back().pattern);
+    STF_ASSERT_EQ(data.size() - patterns[5].size(), matches.back().address);
+}
+
+STF_TEST(LeakScanner, ShortPattern)
+{
+    const std::vector<std::uint8_t> pattern = {1, 2, 3};
+    SecUtil::LeakScanner scanner;
+
+    bool exception_thrown = false;
+    try
+    {
+        scanner.AddPattern(pattern);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+    STF_ASSERT_EQ(0, scanner.PatternCount());
+}
+
+STF_TEST(LeakScanner, ScanFile)
+{
+    std::array<std::uint8_t, 32> canary;
+    SecUtil::SecureRandom(canary);
+
+    SecUtil::LeakScanner scanner;
+    scanner.AddPattern(canary);
+
+    // Place the canary across the boundary between the first two pieces
+    std::vector<std::uint8_t> contents(10 * 1048576, 0);
+    const std::size_t offset = 4 * 1048576 - 10;
+    std::memcpy(contents.data() + offset, canary.data(), canary.size());
+    std::memcpy(contents.data() + contents.size() - canary.size(),
+                canary.data(),
+                canary.size());
+
+    TemporaryPath file("secutil_leak_scan");
+    WriteFile(file.path, contents);
+    SecUtil::SecureErase(canary);
+
+    for (unsigned threads : {1U, 3U, 0U})
+    {
+        auto report = scanner.ScanFile(file.path, threads);
+
+        STF_ASSERT_FALSE(report.Clean());
+        STF_ASSERT_EQ(1, report.regions.size());
+        STF_ASSERT_EQ(2, report.regions[0].matches);
+        STF_ASSERT_EQ(contents.size(), report.bytes_scanned);
+        STF_ASSERT_EQ(2, report.matches.size());
+        STF_ASSERT_EQ(offset, report.matches[0].address);
+        STF_ASSERT_EQ(contents.size() - canary.size(),
+                      report.matches[1].address);
+        STF_ASSERT_GE(report.Throughput(), 0.0);
+    }
+
+    // An empty file contains no matches
+    WriteFile(file.path, {});
+    auto report = scanner.ScanFile(file.path);
+    STF_ASSERT_TRUE(report.Clean());
+    STF_ASSERT_EQ(0, report.bytes_scanned);
+}
+
+STF_TEST(LeakScanner, ScanCoreFile)
+{
+    const std::vector<std::uint8_t> pattern = {0xde, 0xad, 0xbe, 0xef, 0x42};
+    const std::string name = "/usr/lib/secret.so";
+    SecUtil::LeakScanner scanner;
+
+    scanner.AddPattern(pattern);
+
+    // Build a core file with a note and two loadable segments
+    const std::size_t note_offset = 64 + 3 * 56;
+    const std::size_t note_length = 12 + 8 + 16 + 2 * 24 + 24;
+    const std::size_t data_offset = note_offset + note_length;
+    std::vector<std::uint8_t> core(data_offset + 8192, 0);
+
+    std::memcpy(core.data(), "\x7f" "ELF", 4);
+    core[4] = 2;
+    core[5] = 1;
+    core[6] = 1;
+    StoreLE(core, 16, 4, 2);
+    StoreLE(core, 32, 64, 8);
+    StoreLE(core, 54, 56, 2);
+    StoreLE(core, 56, 3, 2);
+
+    // PT_NOTE
+    StoreLE(core, 64, 4, 4);
+    StoreLE(core, 64 + 8, note_offset, 8);
+    StoreLE(core, 64 + 32, note_length, 8);
+
+    // PT_LOAD at 0x10000, r-x, present in the file
+    StoreLE(core, 120, 1, 4);
+    StoreLE(core, 120 + 4, 5, 4);
+    StoreLE(core, 120 + 8, data_offset, 8);
+    StoreLE(core, 120 + 16, 0x10000, 8);
+    StoreLE(core, 120 + 32, 8192, 8);
+    StoreLE(core, 120 + 40, 8192, 8);
+
+    // PT_LOAD at 0x20000, rw-, not present in the file
+    StoreLE(core, 176, 1, 4);
+    StoreLE(core, 176 + 4, 6, 4);
+    StoreLE(core, 176 + 16, 0x20000, 8);
+    StoreLE(core, 176 + 40, 4096, 8);
+
+    // NT_FILE note naming the first segment
+    StoreLE(core, note_offset, 5, 4);
+    StoreLE(core, note_offset + 4, 16 + 24 + name.size() + 1, 4);
+    StoreLE(core, note_offset + 8, 0x46494c45, 4);
+    std::memcpy(core.data() + note_offset + 12, "CORE", 5);
+    StoreLE(core, note_offset + 20, 1, 8);
+    StoreLE(core, note_offset + 28, 4096, 8);
+    StoreLE(core, note_offset + 36, 0x10000, 8);
+    StoreLE(core, note_offset + 44, 0x12000, 8);
+    std::memcpy(core.data() + note_offset + 60, name.c_str(), name.size() + 1);
+
+    std::memcpy(core.data() + data_offset + 5000, pattern.data(), pattern.size());
+
+    TemporaryPath file("secutil_leak_core");
+    WriteFile(file.path, core);
+
+    auto report = scanner.ScanCoreFile(file.path, 2);
+
+    STF_ASSERT_EQ(2, report.regions.size());
+    STF_ASSERT_EQ(0x10000, report.regions[0].start);
+    STF_ASSERT_EQ(0x12000, report.regions[0].end);
+    STF_ASSERT_EQ(std::string("r-x"), report.regions[0].permissions);
+    STF_ASSERT_EQ(name, report.regions[0].name);
+    STF_ASSERT_TRUE(report.regions[0].readable);
+    STF_ASSERT_EQ(1, report.regions[0].matches);
+    STF_ASSERT_EQ(std::string("rw-"), report.regions[1].permissions);
+    STF_ASSERT_FALSE(report.regions[1].readable);
+    STF_ASSERT_EQ(8192, report.bytes_scanned);
+    STF_ASSERT_EQ(1, report.matches.size());
+    STF_ASSERT_EQ(0x10000 + 5000, report.matches[0].address);
+
+    // A segment extending beyond the file is rejected
+    StoreLE(core, 120 + 32, core.size(), 8);
+    WriteFile(file.path, core);
+
+    bool exception_thrown = false;
+    try
+    {
+        scanner.ScanCoreFile(file.path);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+
+    // A file that is not a core file is rejected
+    WriteFile(file.path, std::vector<std::uint8_t>(100, 0));
+
+    exception_thrown = false;
+    try
+    {
+        scanner.ScanCoreFile(file.path);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+}
+
+#if defined(__linux__) && !defined(SECUTIL_TEST_ASAN)
+
+STF_TEST(LeakScanner, ScanProcess)
+{
+    std::array<std::uint8_t, 32> canary;
+    SecUtil::SecureRandom(canary);
+
+    SecUtil::LeakScanner scanner;
+    scanner.AddPattern(canary);
+
+    // Plant the canary in secure storage and erase the original
+    SecUtil::SecurePages pages(4096);
+    std::memcpy(pages.data() + 100, canary.data(), canary.size());
+    SecUtil::SecureErase(canary);
+
+    auto report = scanner.ScanProcess(getpid(), 2);
+
+    STF_ASSERT_EQ(1, report.matches.size());
+    STF_ASSERT_EQ(reinterpret_cast<std::uint64_t>(pages.data() + 100),
+                  report.matches[0].address);
+    STF_ASSERT_GT(report.bytes_scanned, 0);
+
+    const auto &region = report.regions[report.matches[0].region];
+    STF_ASSERT_LE(region.start, report.matches[0].address);
+    STF_ASSERT_GT(region.end, report.matches[0].address);
+    STF_ASSERT_EQ(1, region.matches);
+
+    // Once erased, the canary should no longer be found
+    SecUtil::SecureErase(pages.data(), pages.size());
+
+    report = scanner.ScanProcess(getpid(), 2);
+    STF_ASSERT_TRUE(report.Clean());
+}
+
+STF_TEST(LeakScanner, ScanProcessNamedMapping)
+{
+    std::array<std::uint8_t, 32> canary;
+    SecUtil::SecureRandom(canary);
+
+    SecUtil::LeakScanner scanner;
+    scanner.AddPattern(canary);
+
+    // Plant the canary in a mapping of a file with a known name
+    TemporaryPath file("secutil_leak_mapping");
+    WriteFile(file.path, std::vector<std::uint8_t>(4096, 0));
+    const std::string name = std::filesystem::canonical(file.path).string();
+
+    int fd = open(name.c_str(), O_RDWR | O_CLOEXEC);
+    STF_ASSERT_GE(fd, 0);
+    void *mapping =
+        mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    STF_ASSERT_NE(MAP_FAILED, mapping);
+
+    auto *octets = static_cast<std::uint8_t *>(mapping);
+    std::memcpy(octets + 200, canary.data(), canary.size());
+    SecUtil::SecureErase(canary);
+
+    auto report = scanner.ScanProcess(getpid(), 2);
+
+    STF_ASSERT_EQ(1, report.matches.size());
+    STF_ASSERT_EQ(reinterpret_cast<std::uint64_t>(octets + 200),
+                  report.matches[0].address);
+    STF_ASSERT_EQ(name, report.regions[report.matches[0].region].name);
+
+    // Pseudo-mappings such as the stack are named too
+    bool found_stack = false;
+    for (const auto &region : report.regions)
+    {
+        if (region.name == "[stack]") found_stack = true;
+    }
+    STF_ASSERT_TRUE(found_stack);
+
+    SecUtil::SecureErase(octets, 4096);
+    munmap(mapping, 4096);
+}
+
+#endif
@@ -0,0 +1,237 @@
+/*
+ *  test_masked_secret.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the MaskedSecret object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <terra/secutil/masked_secret.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// Exposes the masked representation for inspection
+class InspectableSecret : public SecUtil::MaskedSecret
+{
+    public:
+        using MaskedSecret::MaskedSecret;
+
+        std::vector<std::uint8_t> Masked() const
+        {
+            if (!state) return {};
+            return {state->masked.begin(), state->masked.end()};
+        }
+};
+
+std::vector<std::uint8_t> TestSecret(std::size_t length)
+{
+    std::vector<std::uint8_t> secret(length);
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        secret[i] = static_cast<std::uint8_t>(i * 7 + 1);
+    }
+
+    return secret;
+}
+
+} // namespace
+
+STF_TEST(MaskedSecret, UnmaskView)
+{
+    // Lengths exercise each XOR path and wrapping around the pad
+    for (std::size_t length : {0, 1, 15, 16, 70, 4096, 10000})
+    {
+        const auto secret = TestSecret(length);
+        InspectableSecret masked(secret);
+
+        STF_ASSERT_EQ(length, masked.size());
+        if (length >= 16) STF_ASSERT_NE(secret, masked.Masked());
+
+        {
+            auto view = masked.Unmask();
+
+            STF_ASSERT_TRUE(masked.IsUnmasked());
+            STF_ASSERT_EQ(length, view.size());
+            STF_ASSERT_EQ(secret,
+                          std::vector<std::uint8_t>(view.data(),
+                                                    view.data() + view.size()));
+        }
+
+        STF_ASSERT_FALSE(masked.IsUnmasked());
+        if (length >= 16) STF_ASSERT_NE(secret, masked.Masked());
+    }
+}
+
+STF_TEST(MaskedSecret, RemaskChangesRepresentation)
+{
+    const auto secret = TestSecret(256);
+    InspectableSecret masked(secret);
+
+    const auto before = masked.Masked();
+    {
+        auto view = masked.Unmask();
+    }
+
+    // The probability of selecting the same pad offset is 1 in 4096; try
+    // twice so a spurious failure is negligible
+    if (before == masked.Masked())
+    {
+        auto view = masked.Unmask();
+    }
+    STF_ASSERT_NE(before, masked.Masked());
+}
+
+STF_TEST(MaskedSecret, ModifyThroughView)
+{
+    SecUtil::MaskedSecret masked(TestSecret(32));
+
+    {
+        auto view = masked.Unmask();
+        std::memset(view.data(), 0x5a, view.size());
+    }
+
+    std::vector<std::uint8_t> plaintext(32);
+    masked.UnmaskTo(plaintext);
+
+    STF_ASSERT_EQ(std::vector<std::uint8_t>(32, 0x5a), plaintext);
+}
+
+STF_TEST(MaskedSecret, UnmaskTo)
+{
+    const auto secret = TestSecret(100);
+    SecUtil::MaskedSecret masked(secret);
+    std::vector<std::uint8_t> plaintext(100);
+
+    masked.UnmaskTo(plaintext);
+    STF_ASSERT_EQ(secret, plaintext);
+
+    bool exception_thrown = false;
+    plaintext.resize(99);
+    try
+    {
+        masked.UnmaskTo(plaintext);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+}
+
+STF_TEST(MaskedSecret, NestedUnmask)
+{
+    SecUtil::MaskedSecret masked(TestSecret(8));
+    auto view = masked.Unmask();
+
+    bool exception_thrown = false;
+    try
+    {
+        auto second = masked.Unmask();
+    }
+    catch (const std::logic_error &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+}
+
+STF_TEST(MaskedSecret, CopyAndMove)
+{
+    const auto secret = TestSecret(48);
+    InspectableSecret original(secret);
+
+    // The copy holds the same secret under a different mask
+    InspectableSecret copy(original);
+    std::vector<std::uint8_t> plaintext(48);
+    copy.UnmaskTo(plaintext);
+    STF_ASSERT_EQ(secret, plaintext);
+
+    SecUtil::MaskedSecret moved(std::move(original));
+    STF_ASSERT_TRUE(original.empty());
+    moved.UnmaskTo(plaintext);
+    STF_ASSERT_EQ(secret, plaintext);
+
+    moved.Clear();
+    STF_ASSERT_TRUE(moved.empty());
+}
+
+STF_TEST(MaskedSecret, MoveWhileUnmasked)
+{
+    const auto secret = TestSecret(32);
+    SecUtil::MaskedSecret original(secret);
+    SecUtil::MaskedSecret target;
+
+    STF_ASSERT_TRUE(
+        std::is_nothrow_move_constructible_v<SecUtil::MaskedSecret>);
+    STF_ASSERT_TRUE(std::is_nothrow_move_assignable_v<SecUtil::MaskedSecret>);
+
+    {
+        auto view = original.Unmask();
+
+        // The view follows the secret through each move
+        SecUtil::MaskedSecret moved(std::move(original));
+        STF_ASSERT_TRUE(original.empty());
+        STF_ASSERT_FALSE(original.IsUnmasked());
+        STF_ASSERT_TRUE(moved.IsUnmasked());
+
+        target = std::move(moved);
+        STF_ASSERT_TRUE(moved.empty());
+        STF_ASSERT_TRUE(target.IsUnmasked());
+
+        STF_ASSERT_EQ(32, view.size());
+        STF_ASSERT_TRUE(std::equal(secret.begin(), secret.end(), view.data()));
+    }
+
+    STF_ASSERT_FALSE(target.IsUnmasked());
+
+    std::vector<std::uint8_t> plaintext(32);
+    target.UnmaskTo(plaintext);
+    STF_ASSERT_EQ(secret, plaintext);
+}
+
+STF_TEST(MaskedSecret, VectorReallocation)
+{
+    const auto secret = TestSecret(24);
+    std::vector<InspectableSecret> secrets;
+
+    secrets.emplace_back(secret);
+    const auto representation = secrets[0].Masked();
+
+    // Elements are moved, not copied and remasked, as the vector grows
+    for (std::size_t i = 0; i < 32; i++) secrets.emplace_back(secret);
+
+    STF_ASSERT_EQ(representation, secrets[0].Masked());
+
+    std::vector<std::uint8_t> plaintext(24);
+    for (const auto &element : secrets)
+    {
+        element.UnmaskTo(plaintext);
+        STF_ASSERT_EQ(secret, plaintext);
+    }
+}
+
+STF_TEST(MaskedSecret, PadLocked)
+{
+    // Locking a single page is permitted under any usual limit
+    STF_ASSERT_TRUE(SecUtil::MaskedSecret::IsPadLocked());
+}
@@ -0,0 +1,301 @@
+/*
+ *  test_pem_der.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the PemDecoder and DerReader objects.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <terra/secutil/pem_der.h>
+#include <terra/secutil/secure_encoding.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+template<typename F>
+bool ThrowsInvalidArgument(F function)
+{
+    try
+    {
+        function();
+    }
+    catch (const std::invalid_argument &)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+std::vector<std::uint8_t> TestData(std::size_t length)
+{
+    std::vector<std::uint8_t> data(length);
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        data[i] = static_cast<std::uint8_t>((i * 131) ^ (i >> 8));
+    }
+
+    return data;
+}
+
+// Produce a PEM block with 64-character lines and CRLF line endings
+std::string MakePem(const std::string &label,
+                    const std::vector<std::uint8_t> &data)
+{
+    const SecUtil::SecureString text = SecUtil::Base64Encode(data);
+    std::string pem = "-----BEGIN " + label + "-----\r\n";
+
+    for (std::size_t i = 0; i < text.size(); i += 64)
+    {
+        pem.append(text.substr(i, 64)).append("\r\n");
+    }
+
+    return pem + "-----END " + label + "-----\r\n";
+}
+
+} // namespace
+
+STF_TEST(PemDer, DecodeSingle)
+{
+    const auto data = TestData(1218);
+    const auto blocks = SecUtil::DecodePem("Comment\n" + MakePem("PRIVATE KEY",
+                                                                 data));
+
+    STF_ASSERT_EQ(1, blocks.size());
+    STF_ASSERT_EQ(std::string("PRIVATE KEY"), blocks[0].label);
+    STF_ASSERT_TRUE(std::vector<std::uint8_t>(blocks[0].data.begin(),
+                                              blocks[0].data.end()) == data);
+}
+
+STF_TEST(PemDer, DecodeMultipleInChunks)
+{
+    std::string text;
+    std::vector<std::vector<std::uint8_t>> expected;
+
+    // Sizes exercise every padding length and the staging buffer boundary
+    for (std::size_t length : {0, 1, 2, 3, 3071, 3072, 3073, 20000})
+    {
+        expected.push_back(TestData(length));
+        text += MakePem("KEY " + std::to_string(length), expected.back());
+    }
+
+    for (std::size_t chunk_size : {1, 7, 64, 4096, 1000000})
+    {
+        SecUtil::PemDecoder decoder;
+        std::string copy = text;
+
+        for (std::size_t i = 0; i < copy.size(); i += chunk_size)
+        {
+            const std::size_t length = std::min(chunk_size, copy.size() - i);
+            decoder.Consume({copy.data() + i, length});
+        }
+        decoder.Finish();
+
+        // Consumed input is erased
+        STF_ASSERT_EQ(std::string(text.size(), '\0'), copy);
+
+        STF_ASSERT_EQ(expected.size(), decoder.Available());
+        for (const auto &data : expected)
+        {
+            auto block = decoder.Next();
+            STF_ASSERT_TRUE(block.has_value());
+            STF_ASSERT_EQ("KEY " + std::to_string(data.size()), block->label);
+            STF_ASSERT_TRUE(std::vector<std::uint8_t>(block->data.begin(),
+                                                      block->data.end()) ==
+                            data);
+        }
+        STF_ASSERT_FALSE(decoder.Next().has_value());
+    }
+}
+
+STF_TEST(PemDer, FinalLineWithoutTerminator)
+{
+    std::string text = MakePem("KEY", TestData(10));
+    text.resize(text.size() - 2);
+
+    const auto blocks = SecUtil::DecodePem(text);
+
+    STF_ASSERT_EQ(1, blocks.size());
+    STF_ASSERT_EQ(10, blocks[0].data.size());
+}
+
+STF_TEST(PemDer, Malformed)
+{
+    const std::string good = MakePem("KEY", TestData(100));
+
+    // Truncated block
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { SecUtil::DecodePem(good.substr(0, good.size() / 2)); }));
+
+    // Mismatched label
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]()
+        {
+            std::string text = good;
+            text.replace(text.find("END KEY"), 7, "END KEX");
+            SecUtil::DecodePem(text);
+        }));
+
+    // Invalid base64 character
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]()
+        {
+            std::string text = good;
+            text[30] = '*';
+            SecUtil::DecodePem(text);
+        }));
+
+    // Encapsulated headers
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        []()
+        {
+            SecUtil::DecodePem("-----BEGIN KEY-----\nProc-Type: 4,ENCRYPTED\n"
+                               "AAAA\n-----END KEY-----\n");
+        }));
+
+    // Data following padding
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        []()
+        {
+            SecUtil::DecodePem("-----BEGIN KEY-----\nAA==\nAAAA\n"
+                               "-----END KEY-----\n");
+        }));
+
+    // Excessively long line
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        []()
+        {
+            SecUtil::PemDecoder decoder;
+            decoder.Update(std::string(SecUtil::PemDecoder::Max_Line_Length + 1,
+                                       'A'));
+        }));
+
+    // The decoder may be reused after an error
+    SecUtil::PemDecoder decoder;
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { decoder.Update("-----BEGIN KEY-----\n*\n-----END KEY-----\n"); }));
+    decoder.Update(good);
+    decoder.Finish();
+    STF_ASSERT_EQ(1, decoder.Available());
+}
+
+STF_TEST(PemDer, LoadFile)
+{
+    const auto data = TestData(200000);
+    const std::string text = MakePem("PRIVATE KEY", data);
+    const auto path = std::filesystem::temp_directory_path() /
+                      "test_pem_der.pem";
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << text << text;
+    }
+
+    const auto blocks = SecUtil::LoadPemFile(path);
+    std::filesystem::remove(path);
+
+    STF_ASSERT_EQ(2, blocks.size());
+    for (const auto &block : blocks)
+    {
+        STF_ASSERT_TRUE(std::vector<std::uint8_t>(block.data.begin(),
+                                                  block.data.end()) == data);
+    }
+
+    bool exception_thrown = false;
+    try
+    {
+        SecUtil::LoadPemFile(path);
+    }
+    catch (const std::system_error &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+}
+
+STF_TEST(PemDer, DerReader)
+{
+    // SEQUENCE { INTEGER 0, SEQUENCE { OID 1.3.101.112 },
+    //            OCTET STRING { OCTET STRING (32 octets) } }
+    std::vector<std::uint8_t> der = {
+        0x30, 0x2e, 0x02, 0x01, 0x00, 0x30, 0x05, 0x06, 0x03, 0x2b, 0x65, 0x70,
+        0x04, 0x22, 0x04, 0x20};
+    for (std::uint8_t i = 0; i < 32; i++) der.push_back(i);
+
+    SecUtil::DerReader reader(der);
+    SecUtil::DerReader key_info = reader.Enter();
+    STF_ASSERT_TRUE(reader.AtEnd());
+
+    const auto version = key_info.Next(SecUtil::Der_Integer);
+    STF_ASSERT_EQ(1, version.value.size());
+    STF_ASSERT_EQ(0, version.value[0]);
+
+    SecUtil::DerReader algorithm = key_info.Enter(SecUtil::Der_Sequence);
+    const auto oid = algorithm.Next(SecUtil::Der_Object_Identifier);
+    STF_ASSERT_EQ(3, oid.value.size());
+    STF_ASSERT_TRUE(algorithm.AtEnd());
+
+    // Wrong tag leaves the position unchanged
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { key_info.Next(SecUtil::Der_Integer); }));
+    STF_ASSERT_EQ(SecUtil::Der_Octet_String, key_info.Peek().tag);
+
+    const auto wrapped = key_info.Next(SecUtil::Der_Octet_String);
+    SecUtil::DerReader inner(wrapped.value);
+    const auto key = inner.Next(SecUtil::Der_Octet_String);
+    STF_ASSERT_EQ(32, key.value.size());
+    STF_ASSERT_TRUE(key.value.data() == der.data() + 16);
+    STF_ASSERT_TRUE(key_info.AtEnd());
+}
+
+STF_TEST(PemDer, DerLengths)
+{
+    std::vector<std::uint8_t> der = {0x04, 0x82, 0x01, 0x00};
+    der.resize(4 + 256);
+
+    SecUtil::DerReader reader(der);
+    STF_ASSERT_EQ(256, reader.Next().value.size());
+    STF_ASSERT_TRUE(reader.AtEnd());
+
+    const std::vector<std::vector<std::uint8_t>> invalid = {
+        {0x04},                         // Truncated header
+        {0x04, 0x02, 0x00},             // Truncated value
+        {0x30, 0x80, 0x00, 0x00},       // Indefinite length
+        {0x04, 0x81, 0x01, 0x00},       // Long form for a short length
+        {0x04, 0x82, 0x00, 0x80},       // Leading zero in length
+        {0x1f, 0x81, 0x00, 0x00},       // High tag number
+        {0x04, 0x89, 0x01, 0x00}};      // Length of length too large
+
+    for (const auto &encoding : invalid)
+    {
+        SecUtil::DerReader bad(encoding);
+        STF_ASSERT_TRUE(ThrowsInvalidArgument([&]() { bad.Next(); }));
+        STF_ASSERT_EQ(encoding.size(), bad.Remaining());
+    }
+
+    // Primitive tags may not be entered
+    std::vector<std::uint8_t> integer = {0x02, 0x01, 0x05};
+    SecUtil::DerReader primitive(integer);
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { primitive.Enter(SecUtil::Der_Integer); }));
+}
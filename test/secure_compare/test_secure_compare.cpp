@@ -0,0 +1,135 @@
+/*
+ *  test_secure_compare.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the SecureCompare functions.
+ *
+ *      When built with the Valgrind headers available and run under Memcheck,
+ *      the compared inputs are marked as undefined.  Memcheck then reports
+ *      an error for any conditional branch or memory address that depends on
+ *      their contents, verifying that the comparison runs in constant time.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <terra/secutil/secure_compare.h>
+#include <terra/secutil/secure_array.h>
+#include <terra/secutil/secure_vector.h>
+#include <terra/secutil/secure_string.h>
+#include <terra/stf/stf.h>
+#if defined(HAVE_VALGRIND_MEMCHECK_H)
+#include <valgrind/memcheck.h>
+#define MarkSecret(p, n) VALGRIND_MAKE_MEM_UNDEFINED(p, n)
+#define MarkPublic(p, n) VALGRIND_MAKE_MEM_DEFINED(p, n)
+#else
+#define MarkSecret(p, n)
+#define MarkPublic(p, n)
+#endif
+
+using namespace Terra;
+
+STF_TEST(SecureCompare, EmptyBuffers)
+{
+    STF_ASSERT_TRUE(SecUtil::SecureCompare(nullptr, nullptr, 0));
+}
+
+STF_TEST(SecureCompare, AllLengthsAndPositions)
+{
+    // Exercise the vector, word, and octet paths with a difference at
+    // every possible position
+    for (std::size_t length = 1; length <= 200; length++)
+    {
+        std::vector<std::uint8_t> a(length);
+        std::vector<std::uint8_t> b(length);
+
+        for (std::size_t i = 0; i < length; i++)
+        {
+            a[i] = b[i] = static_cast<std::uint8_t>(i * 7 + 3);
+        }
+
+        STF_ASSERT_TRUE(SecUtil::SecureCompare(a.data(), b.data(), length));
+
+        for (std::size_t i = 0; i < length; i++)
+        {
+            b[i] ^= 0x80;
+            STF_ASSERT_FALSE(
+                SecUtil::SecureCompare(a.data(), b.data(), length));
+            b[i] ^= 0x80;
+        }
+    }
+}
+
+STF_TEST(SecureCompare, SecureArray)
+{
+    SecUtil::SecureArray<std::uint8_t, 32> a{};
+    SecUtil::SecureArray<std::uint8_t, 32> b{};
+
+    STF_ASSERT_TRUE(SecUtil::SecureCompare(a, b));
+
+    b[31] = 1;
+
+    STF_ASSERT_FALSE(SecUtil::SecureCompare(a, b));
+}
+
+STF_TEST(SecureCompare, SecureVector)
+{
+    SecUtil::SecureVector<std::uint32_t> a(100, 0xdeadbeef);
+    SecUtil::SecureVector<std::uint32_t> b(100, 0xdeadbeef);
+
+    STF_ASSERT_TRUE(SecUtil::SecureCompare(a, b));
+
+    b[50] = 0xdeadbeee;
+
+    STF_ASSERT_FALSE(SecUtil::SecureCompare(a, b));
+
+    // Vectors of differing length are never equal
+    b.resize(99);
+
+    STF_ASSERT_FALSE(SecUtil::SecureCompare(a, b));
+}
+
+STF_TEST(SecureCompare, SecureString)
+{
+    SecUtil::SecureString a = "This is a secret token";
+    SecUtil::SecureString b = "This is a secret token";
+    SecUtil::SecureString c = "This is a secret tokeN";
+
+    STF_ASSERT_TRUE(SecUtil::SecureCompare(a, b));
+    STF_ASSERT_FALSE(SecUtil::SecureCompare(a, c));
+}
+
+STF_TEST(SecureCompare, MixedTypes)
+{
+    SecUtil::SecureVector<std::uint8_t> a = {1, 2, 3, 4};
+    SecUtil::SecureArray<std::uint8_t, 4> b = {1, 2, 3, 4};
+    std::span<const std::uint8_t> c(a);
+
+    STF_ASSERT_TRUE(SecUtil::SecureCompare(a, b));
+    STF_ASSERT_TRUE(SecUtil::SecureCompare(c, b));
+}
+
+STF_TEST(SecureCompare, ConstantTime)
+{
+    std::vector<std::uint8_t> a(100, 0x42);
+    std::vector<std::uint8_t> b(100, 0x42);
+
+    MarkSecret(a.data(), a.size());
+    MarkSecret(b.data(), b.size());
+
+    bool result = SecUtil::SecureCompare(a, b);
+
+    MarkPublic(&result, sizeof(result));
+    STF_ASSERT_TRUE(result);
+}
@@ -0,0 +1,228 @@
+/*
+ *  test_secure_encoding.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the hexadecimal and base64 encoding functions.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <terra/secutil/secure_encoding.h>
+#include <terra/secutil/secure_array.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// Simple reference encoder used to check the optimized implementation
+std::string ReferenceBase64(const std::vector<std::uint8_t> &data)
+{
+    const char *alphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string text;
+
+    for (std::size_t i = 0; i < data.size(); i += 3)
+    {
+        std::uint32_t block = data[i] << 16;
+        if (i + 1 < data.size()) block |= data[i + 1] << 8;
+        if (i + 2 < data.size()) block |= data[i + 2];
+
+        text += alphabet[(block >> 18) & 0x3f];
+        text += alphabet[(block >> 12) & 0x3f];
+        text += (i + 1 < data.size()) ? alphabet[(block >> 6) & 0x3f] : '=';
+        text += (i + 2 < data.size()) ? alphabet[block & 0x3f] : '=';
+    }
+
+    return text;
+}
+
+template<typename F>
+bool ThrowsInvalidArgument(F function)
+{
+    try
+    {
+        function();
+    }
+    catch (const std::invalid_argument &)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace
+
+STF_TEST(SecureEncoding, HexEncode)
+{
+    SecUtil::SecureArray<std::uint8_t, 4> data = {0x01, 0xab, 0xcd, 0xef};
+
+    STF_ASSERT_EQ(SecUtil::SecureString("01abcdef"), SecUtil::HexEncode(data));
+    STF_ASSERT_EQ(SecUtil::SecureString("01ABCDEF"),
+                  SecUtil::HexEncode(data, true));
+}
+
+STF_TEST(SecureEncoding, HexRoundTrip)
+{
+    // Exercise the vector and scalar paths with every octet value
+    for (std::size_t length = 0; length <= 300; length += 13)
+    {
+        std::vector<std::uint8_t> data(length);
+        for (std::size_t i = 0; i < length; i++)
+        {
+            data[i] = static_cast<std::uint8_t>(i * 31 + 7);
+        }
+
+        for (bool uppercase : {false, true})
+        {
+            SecUtil::SecureString text = SecUtil::HexEncode(data, uppercase);
+
+            STF_ASSERT_EQ(length * 2, text.size());
+
+            SecUtil::SecureVector<std::uint8_t> decoded =
+                SecUtil::HexDecode(text);
+
+            STF_ASSERT_EQ(length, decoded.size());
+            STF_ASSERT_TRUE(std::equal(data.begin(),
+                                       data.end(),
+                                       decoded.begin()));
+        }
+    }
+}
+
+STF_TEST(SecureEncoding, HexDecodeInvalid)
+{
+    // Invalid characters are detected in both the vector and scalar paths
+    for (std::size_t position : {0, 15, 31, 32, 33})
+    {
+        for (char c : {'g', 'G', '/', ':', '@', '`', ' ', '\x80', '\xb0'})
+        {
+            SecUtil::SecureString text(34, 'a');
+            text[position] = c;
+
+            STF_ASSERT_TRUE(
+                ThrowsInvalidArgument([&]() { SecUtil::HexDecode(text); }));
+        }
+    }
+
+    // Odd length
+    STF_ASSERT_TRUE(
+        ThrowsInvalidArgument([]() { SecUtil::HexDecode("abc"); }));
+}
+
+STF_TEST(SecureEncoding, HexDecodeErasesOutput)
+{
+    SecUtil::SecureArray<std::uint8_t, 4> data{};
+
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { SecUtil::HexDecode("ffffffzz", data); }));
+
+    for (auto octet : data) STF_ASSERT_EQ(0, octet);
+}
+
+STF_TEST(SecureEncoding, Base64Vectors)
+{
+    // Test vectors from RFC 4648
+    const std::vector<std::pair<std::string, std::string>> vectors = {
+        {"", ""},
+        {"f", "Zg=="},
+        {"fo", "Zm8="},
+        {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="},
+        {"fooba", "Zm9vYmE="},
+        {"foobar", "Zm9vYmFy"}};
+
+    for (const auto &[plain, encoded] : vectors)
+    {
+        const std::vector<std::uint8_t> data(plain.begin(), plain.end());
+
+        STF_ASSERT_EQ(SecUtil::SecureString(encoded.c_str()),
+                      SecUtil::Base64Encode(data));
+
+        SecUtil::SecureVector<std::uint8_t> decoded =
+            SecUtil::Base64Decode(encoded);
+
+        STF_ASSERT_EQ(plain, std::string(decoded.begin(), decoded.end()));
+    }
+}
+
+STF_TEST(SecureEncoding, Base64RoundTrip)
+{
+    // Every 6-bit value is produced across these inputs
+    for (std::size_t length = 0; length <= 200; length++)
+    {
+        std::vector<std::uint8_t> data(length);
+        for (std::size_t i = 0; i < length; i++)
+        {
+            data[i] = static_cast<std::uint8_t>(i * 73 + length);
+        }
+
+        SecUtil::SecureString text = SecUtil::Base64Encode(data);
+
+        STF_ASSERT_EQ(ReferenceBase64(data), std::string(text.c_str()));
+
+        SecUtil::SecureVector<std::uint8_t> decoded =
+            SecUtil::Base64Decode(text);
+
+        STF_ASSERT_EQ(length, decoded.size());
+        STF_ASSERT_TRUE(std::equal(data.begin(), data.end(), decoded.begin()));
+    }
+}
+
+STF_TEST(SecureEncoding, Base64DecodeInvalid)
+{
+    for (std::size_t position : {0, 7, 8, 13})
+    {
+        for (char c : {'-', '_', '*', '@', '[', '`', '{', '=', '\x80', '\xc1'})
+        {
+            SecUtil::SecureString text(16, 'Q');
+            text[position] = c;
+
+            STF_ASSERT_TRUE(
+                ThrowsInvalidArgument([&]() { SecUtil::Base64Decode(text); }));
+        }
+    }
+
+    // Lengths that are not a multiple of four are rejected
+    STF_ASSERT_TRUE(
+        ThrowsInvalidArgument([]() { SecUtil::Base64Decode("Zm9vY"); }));
+
+    // Too much padding is rejected
+    STF_ASSERT_TRUE(
+        ThrowsInvalidArgument([]() { SecUtil::Base64Decode("Z==="); }));
+}
+
+STF_TEST(SecureEncoding, Base64IntoBuffer)
+{
+    SecUtil::SecureArray<std::uint8_t, 5> data = {1, 2, 3, 4, 5};
+    SecUtil::SecureArray<char, 8> text{};
+    SecUtil::SecureArray<std::uint8_t, 5> decoded{};
+
+    SecUtil::Base64Encode(data, text);
+
+    STF_ASSERT_EQ(std::string("AQIDBAU="), std::string(text.begin(), text.end()));
+
+    SecUtil::Base64Decode(std::string_view(text.data(), text.size()), decoded);
+
+    STF_ASSERT_EQ(data, decoded);
+
+    // Buffers of the wrong size are rejected
+    SecUtil::SecureArray<char, 7> short_text{};
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { SecUtil::Base64Encode(data, short_text); }));
+}
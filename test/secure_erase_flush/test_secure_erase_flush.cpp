@@ -0,0 +1,119 @@
+/*
+ *  test_secure_erase_flush.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the SecureEraseFlush functions.  Whether the zeros
+ *      reach main memory cannot be observed, so these verify that exactly
+ *      the requested octets are erased by each method.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <terra/secutil/secure_erase_flush.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// Octets on either side of each erased region that must be preserved
+constexpr std::size_t Guard_Size = 80;
+
+void Fill(std::vector<std::uint8_t> &buffer)
+{
+    for (std::size_t i = 0; i < buffer.size(); i++)
+    {
+        buffer[i] = static_cast<std::uint8_t>(i % 251 + 1);
+    }
+}
+
+bool ErasedExactly(const std::vector<std::uint8_t> &buffer,
+                   std::size_t offset,
+                   std::size_t length)
+{
+    for (std::size_t i = 0; i < buffer.size(); i++)
+    {
+        const bool erased = (i >= offset) && (i < offset + length);
+
+        if (erased && (buffer[i] != 0)) return false;
+        if (!erased && (buffer[i] != static_cast<std::uint8_t>(i % 251 + 1)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+STF_TEST(SecureEraseFlush, EraseBuffer)
+{
+    for (auto method : {SecUtil::EraseFlushMethod::Automatic,
+                        SecUtil::EraseFlushMethod::NonTemporal,
+                        SecUtil::EraseFlushMethod::CacheFlush})
+    {
+        // Cover partial lines at either end at every alignment
+        for (std::size_t length : {1, 15, 63, 64, 65, 127, 200, 4096, 10000})
+        {
+            for (std::size_t offset = Guard_Size; offset < Guard_Size + 64;
+                 offset += 7)
+            {
+                std::vector<std::uint8_t> buffer(length + 2 * Guard_Size + 64);
+                Fill(buffer);
+
+                SecUtil::SecureEraseFlush(buffer.data() + offset, length, method);
+
+                STF_ASSERT_TRUE(ErasedExactly(buffer, offset, length));
+            }
+        }
+    }
+}
+
+STF_TEST(SecureEraseFlush, EraseRegions)
+{
+    std::vector<std::uint8_t> buffer1(5000);
+    std::vector<std::uint8_t> buffer2(300);
+    std::vector<std::uint8_t> buffer3(70000);
+    Fill(buffer1);
+    Fill(buffer2);
+    Fill(buffer3);
+
+    const SecUtil::EraseRegion regions[] = {{buffer1.data() + 3, 4000},
+                                            {nullptr, 100},
+                                            {buffer2.data() + 10, 0},
+                                            {buffer2.data() + 10, 17},
+                                            {buffer3.data() + 1, 65536}};
+
+    SecUtil::SecureEraseFlush(regions);
+
+    STF_ASSERT_TRUE(ErasedExactly(buffer1, 3, 4000));
+    STF_ASSERT_TRUE(ErasedExactly(buffer2, 10, 17));
+    STF_ASSERT_TRUE(ErasedExactly(buffer3, 1, 65536));
+
+    // Nothing happens for empty inputs
+    SecUtil::SecureEraseFlush(nullptr, 10);
+    SecUtil::SecureEraseFlush(std::span<const SecUtil::EraseRegion>{});
+}
+
+STF_TEST(SecureEraseFlush, Supported)
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__)
+    STF_ASSERT_TRUE(SecUtil::EraseFlushSupported());
+#else
+    // The result depends on the platform, but must not fail
+    [[maybe_unused]] const bool supported = SecUtil::EraseFlushSupported();
+#endif
+}
@@ -0,0 +1,176 @@
+/*
+ *  test_secure_file.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the secure file loading functions.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <terra/secutil/secure_file.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// Temporary file that is removed when the object is destroyed
+class TemporaryFile
+{
+    public:
+        TemporaryFile(const std::string &name,
+                      const std::vector<std::uint8_t> &contents) :
+            path{std::filesystem::temp_directory_path() /
+                 (name + "_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)))}
+        {
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<const char *>(contents.data()),
+                       static_cast<std::streamsize>(contents.size()));
+        }
+
+        ~TemporaryFile()
+        {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+
+        std::filesystem::path path;
+};
+
+std::vector<std::uint8_t> TestContents(std::size_t length)
+{
+    std::vector<std::uint8_t> contents(length);
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        contents[i] = static_cast<std::uint8_t>(i * 13 + 5);
+    }
+
+    return contents;
+}
+
+} // namespace
+
+STF_TEST(SecureFile, LoadSecureFile)
+{
+    for (std::size_t length : {0, 1, 4095, 4096, 100000})
+    {
+        const auto contents = TestContents(length);
+        TemporaryFile file("secutil_load", contents);
+
+        auto loaded = SecUtil::LoadSecureFile(file.path);
+
+        STF_ASSERT_EQ(contents,
+                      std::vector<std::uint8_t>(loaded.begin(), loaded.end()));
+    }
+}
+
+STF_TEST(SecureFile, LoadSecureFilePages)
+{
+    for (std::size_t length : {0, 1, 4095, 4096, 100000})
+    {
+        const auto contents = TestContents(length);
+        TemporaryFile file("secutil_pages", contents);
+
+        // Direct I/O falls back to buffered reads where unsupported
+        for (bool direct : {false, true})
+        {
+            auto pages = SecUtil::LoadSecureFilePages(file.path, false, direct);
+
+            STF_ASSERT_EQ(length, pages.size());
+            STF_ASSERT_EQ(contents,
+                          std::vector<std::uint8_t>(pages.Span().begin(),
+                                                    pages.Span().end()));
+        }
+    }
+}
+
+STF_TEST(SecureFile, LoadSecureFilePagesLocked)
+{
+    const auto contents = TestContents(1000);
+    TemporaryFile file("secutil_locked", contents);
+
+    auto pages = SecUtil::LoadSecureFilePages(file.path);
+
+    STF_ASSERT_TRUE(pages.IsLocked());
+    STF_ASSERT_EQ(contents,
+                  std::vector<std::uint8_t>(pages.Span().begin(),
+                                            pages.Span().end()));
+}
+
+STF_TEST(SecureFile, SecureFileReader)
+{
+    const auto contents = TestContents(10000);
+    TemporaryFile file("secutil_reader", contents);
+
+    for (bool direct : {false, true})
+    {
+        SecUtil::SecureFileReader reader(file.path, 3000, false, direct);
+        std::vector<std::uint8_t> result;
+
+        while (true)
+        {
+            auto chunk = reader.Next();
+            if (chunk.empty()) break;
+
+            // Chunks are 3000 octets unless rounded up for direct I/O
+            if (!reader.IsDirect() && (result.size() + 3000 <= contents.size()))
+            {
+                STF_ASSERT_EQ(3000, chunk.size());
+            }
+
+            result.insert(result.end(), chunk.begin(), chunk.end());
+        }
+
+        STF_ASSERT_EQ(contents, result);
+        STF_ASSERT_EQ(contents.size(), reader.Position());
+        STF_ASSERT_TRUE(reader.Next().empty());
+    }
+}
+
+STF_TEST(SecureFile, Errors)
+{
+    const std::filesystem::path missing =
+        std::filesystem::temp_directory_path() / "secutil_does_not_exist";
+
+    bool exception_thrown = false;
+    try
+    {
+        SecUtil::LoadSecureFile(missing);
+    }
+    catch (const std::system_error &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+
+    // A directory is not a regular file
+    exception_thrown = false;
+    try
+    {
+        SecUtil::LoadSecureFilePages(std::filesystem::temp_directory_path(),
+                                     false,
+                                     false);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+}
@@ -0,0 +1,219 @@
+/*
+ *  test_secure_file_erase.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the secure file erasure functions.
+ *
+ *  Portability Issues:
+ *      The memfd and device tests run only on Linux.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <terra/secutil/secure_file_erase.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// Names a temporary file, which is removed when the object is destroyed
+class TemporaryPath
+{
+    public:
+        TemporaryPath(const std::filesystem::path &directory,
+                      const std::string &name) :
+            path{directory /
+                 (name + "_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)))}
+        {
+        }
+
+        ~TemporaryPath()
+        {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+
+        std::filesystem::path path;
+};
+
+void WriteFile(const std::filesystem::path &path, std::size_t length)
+{
+    std::vector<char> contents(length);
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        contents[i] = static_cast<char>(i * 13 + 5);
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+std::vector<char> ReadFile(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    return {std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>()};
+}
+
+bool AllZero(const std::vector<char> &data)
+{
+    return std::all_of(data.begin(), data.end(), [](char c) { return c == 0; });
+}
+
+} // namespace
+
+STF_TEST(SecureFileErase, EraseFile)
+{
+    for (unsigned threads : {1U, 4U, 0U})
+    {
+        for (std::size_t length : {0, 1, 4096, 3000000})
+        {
+            TemporaryPath file(std::filesystem::temp_directory_path(),
+                               "secutil_erase");
+            TemporaryPath link(std::filesystem::temp_directory_path(),
+                               "secutil_erase_link");
+
+            WriteFile(file.path, length);
+
+            // A second link allows the contents to be examined after removal
+            std::filesystem::create_hard_link(file.path, link.path);
+
+            auto result = SecUtil::SecureEraseFile(file.path, threads);
+
+            STF_ASSERT_FALSE(std::filesystem::exists(file.path));
+            STF_ASSERT_EQ(length, result.bytes_overwritten);
+            STF_ASSERT_GE(result.threads, 1);
+            STF_ASSERT_GE(result.Throughput(), 0.0);
+
+            auto contents = ReadFile(link.path);
+            if (result.memory_backed)
+            {
+                STF_ASSERT_TRUE(contents.empty());
+            }
+            else
+            {
+                STF_ASSERT_EQ(length, contents.size());
+                STF_ASSERT_TRUE(AllZero(contents));
+            }
+        }
+    }
+}
+
+STF_TEST(SecureFileErase, ThreadCount)
+{
+    TemporaryPath file(std::filesystem::temp_directory_path(), "secutil_erase");
+
+    // Threads are limited to the number of chunks to write
+    WriteFile(file.path, 100);
+    auto result = SecUtil::SecureEraseFile(file.path, 8);
+    STF_ASSERT_EQ(1, result.threads);
+
+    WriteFile(file.path, SecUtil::File_Erase_Chunk_Size * 3);
+    result = SecUtil::SecureEraseFile(file.path, 8);
+    STF_ASSERT_EQ(3, result.threads);
+    STF_ASSERT_EQ(SecUtil::File_Erase_Chunk_Size * 3, result.bytes_overwritten);
+}
+
+STF_TEST(SecureFileErase, SparseFile)
+{
+    TemporaryPath file(std::filesystem::temp_directory_path(), "secutil_erase");
+
+    // Write data only at the end of a large file
+    {
+        std::ofstream stream(file.path, std::ios::binary);
+        stream.seekp(64 * 1048576);
+        stream.write("secret", 6);
+    }
+
+    auto result = SecUtil::SecureEraseFile(file.path, 2);
+
+    STF_ASSERT_FALSE(std::filesystem::exists(file.path));
+    STF_ASSERT_GE(result.bytes_overwritten, 6);
+    STF_ASSERT_LE(result.bytes_overwritten, 64 * 1048576 + 6);
+}
+
+STF_TEST(SecureFileErase, Errors)
+{
+    const std::filesystem::path missing =
+        std::filesystem::temp_directory_path() / "secutil_does_not_exist";
+
+    bool exception_thrown = false;
+    try
+    {
+        SecUtil::SecureEraseFile(missing);
+    }
+    catch (const std::system_error &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+
+#if defined(__linux__)
+    // A device is not a regular file
+    int fd = open("/dev/null", O_RDWR | O_CLOEXEC);
+    STF_ASSERT_GE(fd, 0);
+
+    exception_thrown = false;
+    try
+    {
+        SecUtil::SecureEraseFileContents(fd);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+
+    close(fd);
+#endif
+}
+
+#if defined(__linux__)
+
+STF_TEST(SecureFileErase, MemoryFile)
+{
+    int fd = memfd_create("secutil_erase", MFD_CLOEXEC);
+    STF_ASSERT_GE(fd, 0);
+
+    std::vector<char> contents(1048576 + 100, 'x');
+    STF_ASSERT_EQ(static_cast<ssize_t>(contents.size()),
+                  write(fd, contents.data(), contents.size()));
+
+    auto result = SecUtil::SecureEraseFileContents(fd, 2);
+
+    STF_ASSERT_TRUE(result.memory_backed);
+    STF_ASSERT_FALSE(result.hole_punched);
+    STF_ASSERT_EQ(contents.size(), result.bytes_overwritten);
+
+    struct stat status;
+    STF_ASSERT_EQ(0, fstat(fd, &status));
+    STF_ASSERT_EQ(0, status.st_size);
+
+    close(fd);
+}
+
+#endif
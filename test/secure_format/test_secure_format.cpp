@@ -0,0 +1,92 @@
+/*
+ *  test_secure_format.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the secure format functions and formatters.
+ *
+ *  Portability Issues:
+ *      These tests are built only if the standard library provides <format>;
+ *      otherwise, the test is registered as disabled and reported as not
+ *      run.
+ */
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <terra/secutil/secure_format.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+STF_TEST(SecureFormat, SecureFormat)
+{
+    SecUtil::SecureString token = "abc123";
+
+    SecUtil::SecureString header = SecUtil::SecureFormat("Bearer {}", token);
+    STF_ASSERT_EQ(SecUtil::SecureString("Bearer abc123"), header);
+
+    SecUtil::SecureWString wide = SecUtil::SecureFormat(L"{}:{}", 42, L"x");
+    STF_ASSERT_TRUE(wide == L"42:x");
+}
+
+STF_TEST(SecureFormat, SecureFormatToAppends)
+{
+    SecUtil::SecureString connection = "host=db";
+    SecUtil::SecureString password = "s3cret";
+
+    SecUtil::SecureFormatTo(connection, ";password={};port={}", password, 5432);
+
+    STF_ASSERT_EQ(SecUtil::SecureString("host=db;password=s3cret;port=5432"),
+                  connection);
+}
+
+STF_TEST(SecureFormat, SecureFormatToBuffer)
+{
+    std::vector<char> buffer(8, '*');
+
+    STF_ASSERT_EQ(5, SecUtil::SecureFormatTo(buffer, "{}-{}", 12, 34));
+    STF_ASSERT_EQ(std::string("12-34***"),
+                  std::string(buffer.begin(), buffer.end()));
+
+    bool exception_thrown = false;
+    try
+    {
+        SecUtil::SecureFormatTo(buffer, "{}", 123456789);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+}
+
+STF_TEST(SecureFormat, Redaction)
+{
+    SecUtil::SecureString password = "hunter2";
+
+    STF_ASSERT_EQ(std::string("password=[REDACTED]"),
+                  std::format("password={:r}", password));
+    STF_ASSERT_EQ(std::string("password=hunter2"),
+                  std::format("password={}", password));
+    STF_ASSERT_EQ(std::string("[hunter2  ]"),
+                  std::format("[{:<9}]", password));
+}
+
+STF_TEST(SecureFormat, Octets)
+{
+    SecUtil::SecureVector<std::uint8_t> key = {0x01, 0xab, 0xff};
+    SecUtil::SecureArray<std::uint8_t, 2> id = {0x9c, 0x0e};
+
+    STF_ASSERT_EQ(std::string("01abff"), std::format("{}", key));
+    STF_ASSERT_EQ(std::string("01ABFF"), std::format("{:X}", key));
+    STF_ASSERT_EQ(std::string("[REDACTED]"), std::format("{:r}", key));
+    STF_ASSERT_EQ(std::string("9c0e"), std::format("{}", id));
+}
@@ -0,0 +1,194 @@
+/*
+ *  test_secure_function.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the SecureFunction object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <terra/secutil/secure_function.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+int Twice(int value) { return value * 2; }
+
+// Counts the number of live instances
+struct Counted
+{
+    static inline int live = 0;
+
+    Counted() { live++; }
+    Counted(const Counted &) { live++; }
+    Counted(Counted &&) noexcept { live++; }
+    ~Counted() { live--; }
+
+    int operator()() const { return 7; }
+};
+
+} // namespace
+
+STF_TEST(SecureFunction, Empty)
+{
+    SecUtil::SecureFunction<int(int)> function;
+    STF_ASSERT_FALSE(function);
+    STF_ASSERT_FALSE(function.IsInline());
+
+    bool caught = false;
+    try
+    {
+        function(1);
+    }
+    catch (const std::bad_function_call &)
+    {
+        caught = true;
+    }
+    STF_ASSERT_TRUE(caught);
+
+    // A null function pointer produces an empty object
+    int (*pointer)(int) = nullptr;
+    SecUtil::SecureFunction<int(int)> null_function = pointer;
+    STF_ASSERT_FALSE(null_function);
+}
+
+STF_TEST(SecureFunction, Inline)
+{
+    std::array<std::uint8_t, 32> key{};
+    key.fill(0x11);
+
+    SecUtil::SecureFunction<int(int)> function = [key](int value)
+    {
+        return key[0] + value;
+    };
+
+    STF_ASSERT_TRUE(function);
+    STF_ASSERT_TRUE(function.IsInline());
+    STF_ASSERT_EQ(0x12, function(1));
+
+    SecUtil::SecureFunction<int(int)> pointer = Twice;
+    STF_ASSERT_TRUE(pointer.IsInline());
+    STF_ASSERT_EQ(8, pointer(4));
+}
+
+STF_TEST(SecureFunction, Large)
+{
+    std::array<std::uint8_t, 1024> key{};
+    key.fill(0x22);
+
+    SecUtil::SecureFunction<int()> function = [key]() { return key[1023]; };
+
+    STF_ASSERT_TRUE(function);
+    STF_ASSERT_FALSE(function.IsInline());
+    STF_ASSERT_EQ(0x22, function());
+
+    // A larger inline buffer may be requested
+    SecUtil::SecureFunction<int(), 2048> larger = [key]() { return key[0]; };
+    STF_ASSERT_TRUE(larger.IsInline());
+    STF_ASSERT_EQ(0x22, larger());
+}
+
+STF_TEST(SecureFunction, MoveOnly)
+{
+    auto value = std::make_unique<std::string>("secret");
+
+    SecUtil::SecureFunction<std::string()> function =
+        [value = std::move(value)]() { return *value; };
+    STF_ASSERT_EQ(std::string("secret"), function());
+
+    SecUtil::SecureFunction<std::string()> other = std::move(function);
+    STF_ASSERT_FALSE(function);
+    STF_ASSERT_EQ(std::string("secret"), other());
+
+    function = std::move(other);
+    STF_ASSERT_FALSE(other);
+    STF_ASSERT_EQ(std::string("secret"), function());
+}
+
+STF_TEST(SecureFunction, Lifetime)
+{
+    {
+        SecUtil::SecureFunction<int()> function = Counted();
+        STF_ASSERT_EQ(1, Counted::live);
+
+        SecUtil::SecureFunction<int()> other = std::move(function);
+        STF_ASSERT_EQ(1, Counted::live);
+        STF_ASSERT_EQ(7, other());
+
+        other = [] { return 8; };
+        STF_ASSERT_EQ(0, Counted::live);
+        STF_ASSERT_EQ(8, other());
+
+        other = Counted();
+        STF_ASSERT_EQ(1, Counted::live);
+
+        other = nullptr;
+        STF_ASSERT_EQ(0, Counted::live);
+        STF_ASSERT_FALSE(other);
+    }
+    STF_ASSERT_EQ(0, Counted::live);
+}
+
+STF_TEST(SecureFunction, Arguments)
+{
+    SecUtil::SecureFunction<void(std::string &, std::unique_ptr<int>)> function =
+        [](std::string &text, std::unique_ptr<int> value)
+        {
+            text += std::to_string(*value);
+        };
+
+    std::string text = "value=";
+    function(text, std::make_unique<int>(5));
+    STF_ASSERT_EQ(std::string("value=5"), text);
+
+    // The result is converted to the declared return type
+    SecUtil::SecureFunction<long(int)> convert = Twice;
+    STF_ASSERT_EQ(6L, convert(3));
+
+    // Mutable callables may be called through a const object
+    const SecUtil::SecureFunction<int()> counter = [n = 0]() mutable
+    {
+        return ++n;
+    };
+    STF_ASSERT_EQ(1, counter());
+    STF_ASSERT_EQ(2, counter());
+}
+
+STF_TEST(SecureFunction, Erased)
+{
+    using Function = SecUtil::SecureFunction<int()>;
+
+    alignas(Function) std::uint8_t buffer[sizeof(Function)]{};
+    std::array<std::uint8_t, 64> key{};
+    key.fill(0xa5);
+
+    auto *function = ::new (buffer) Function([key]() { return key[0]; });
+    STF_ASSERT_EQ(0xa5, (*function)());
+
+    // Moving from the object erases the captured key
+    Function other = std::move(*function);
+    for (auto octet : buffer) STF_ASSERT_NE(0xa5, octet);
+
+    // As does destruction
+    *function = std::move(other);
+    function->~Function();
+    for (auto octet : buffer) STF_ASSERT_NE(0xa5, octet);
+}
@@ -0,0 +1,145 @@
+/*
+ *  test_secure_pages.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the SecurePages object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <terra/secutil/secure_pages.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+STF_TEST(SecurePages, Empty)
+{
+    SecUtil::SecurePages pages;
+
+    STF_ASSERT_TRUE(pages.empty());
+    STF_ASSERT_EQ(nullptr, pages.data());
+    STF_ASSERT_EQ(0, pages.capacity());
+    STF_ASSERT_TRUE(pages.Lock());
+}
+
+STF_TEST(SecurePages, PageAligned)
+{
+    const std::size_t page_size = SecUtil::SecurePages::PageSize();
+    SecUtil::SecurePages pages(page_size + 1);
+
+    STF_ASSERT_EQ(page_size + 1, pages.size());
+    STF_ASSERT_EQ(2 * page_size, pages.capacity());
+    STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(pages.data()) % page_size);
+
+    // Newly mapped memory is zero-filled and writable
+    for (std::size_t i = 0; i < pages.size(); i++)
+    {
+        STF_ASSERT_EQ(0, pages.data()[i]);
+    }
+    std::memset(pages.data(), 0xa5, pages.size());
+    STF_ASSERT_EQ(0xa5, pages.Span().back());
+}
+
+STF_TEST(SecurePages, Lock)
+{
+    SecUtil::SecurePages pages(100);
+
+    // Locking a single page should be permitted under default limits
+    STF_ASSERT_TRUE(pages.Lock());
+    STF_ASSERT_TRUE(pages.IsLocked());
+
+    pages.Unlock();
+    STF_ASSERT_FALSE(pages.IsLocked());
+}
+
+STF_TEST(SecurePages, Move)
+{
+    SecUtil::SecurePages pages(64);
+    pages.data()[0] = 42;
+    pages.Lock();
+
+    SecUtil::SecurePages other(std::move(pages));
+
+    STF_ASSERT_TRUE(pages.empty());
+    STF_ASSERT_FALSE(pages.IsLocked());
+    STF_ASSERT_EQ(64, other.size());
+    STF_ASSERT_EQ(42, other.data()[0]);
+
+    SecUtil::SecurePages third(16);
+    third = std::move(other);
+
+    STF_ASSERT_TRUE(other.empty());
+    STF_ASSERT_EQ(42, third.data()[0]);
+}
+
+STF_TEST(SecurePages, EraseOverwrite)
+{
+    SecUtil::SecurePages pages(3 * SecUtil::SecurePages::PageSize());
+    const std::uint8_t *buffer = pages.data();
+
+    STF_ASSERT_EQ(SecUtil::PageEraseMethod::Overwrite, pages.EraseMethod());
+
+    std::memset(pages.data(), 0x5a, pages.size());
+    pages.Erase();
+
+    // The mapping is retained and every octet is zero
+    STF_ASSERT_EQ(buffer, pages.data());
+    for (std::size_t i = 0; i < pages.capacity(); i++)
+    {
+        STF_ASSERT_EQ(0, pages.data()[i]);
+    }
+}
+
+STF_TEST(SecurePages, EraseDiscard)
+{
+    SecUtil::SecurePages pages(3 * SecUtil::SecurePages::PageSize(),
+                               SecUtil::PageEraseMethod::Discard);
+    const std::uint8_t *buffer = pages.data();
+
+    STF_ASSERT_EQ(SecUtil::PageEraseMethod::Discard, pages.EraseMethod());
+
+    std::memset(pages.data(), 0x5a, pages.size());
+    pages.Erase();
+
+    STF_ASSERT_EQ(buffer, pages.data());
+    for (std::size_t i = 0; i < pages.capacity(); i++)
+    {
+        STF_ASSERT_EQ(0, pages.data()[i]);
+    }
+
+    // Discarded pages remain usable
+    std::memset(pages.data(), 0xa5, pages.size());
+    STF_ASSERT_EQ(0xa5, pages.Span().back());
+
+    // The method moves with the memory
+    SecUtil::SecurePages other(std::move(pages));
+    STF_ASSERT_EQ(SecUtil::PageEraseMethod::Discard, other.EraseMethod());
+}
+
+STF_TEST(SecurePages, EraseDiscardLocked)
+{
+    SecUtil::SecurePages pages(100, SecUtil::PageEraseMethod::Discard);
+
+    STF_ASSERT_TRUE(pages.Lock());
+    std::memset(pages.data(), 0x5a, pages.size());
+
+    // Locked memory is overwritten instead
+    pages.Erase();
+
+    STF_ASSERT_TRUE(pages.IsLocked());
+    for (std::size_t i = 0; i < pages.capacity(); i++)
+    {
+        STF_ASSERT_EQ(0, pages.data()[i]);
+    }
+}
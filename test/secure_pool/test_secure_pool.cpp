@@ -0,0 +1,318 @@
+/*
+ *  test_secure_pool.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the SecurePool object and SecureCoroutinePromise.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <terra/secutil/secure_pool.h>
+#include <terra/secutil/secure_coroutine.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+bool AllZero(const void *data, std::size_t length)
+{
+    const auto *p = static_cast<const std::uint8_t *>(data);
+
+    return std::all_of(p, p + length, [](std::uint8_t c) { return c == 0; });
+}
+
+// Minimal coroutine type whose frames are allocated from the secure pool
+struct Task
+{
+    struct promise_type : SecUtil::SecureCoroutinePromise
+    {
+        int value = 0;
+
+        Task get_return_object()
+        {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(int v) { value = v; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle{handle}
+    {
+    }
+    Task(Task &&other) noexcept : handle{std::exchange(other.handle, {})} {}
+    ~Task()
+    {
+        if (handle) handle.destroy();
+    }
+
+    int Run()
+    {
+        handle.resume();
+        return handle.promise().value;
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+Task Compute(int a, int b)
+{
+    std::uint8_t key[256];
+
+    for (std::size_t i = 0; i < sizeof(key); i++)
+    {
+        key[i] = static_cast<std::uint8_t>(a + i);
+    }
+
+    int sum = b;
+    for (auto octet : key) sum += octet;
+
+    co_return sum;
+}
+
+} // namespace
+
+STF_TEST(SecurePool, AllocateAndDeallocate)
+{
+    SecUtil::SecurePool pool;
+
+    STF_ASSERT_EQ(0, pool.ReservedBytes());
+    STF_ASSERT_EQ(0, pool.InUseBytes());
+
+    for (std::size_t size : {0, 1, 16, 33, 100, 1000, 4097, 8192})
+    {
+        void *p = pool.Allocate(size);
+        STF_ASSERT_TRUE(p != nullptr);
+        STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(p) %
+                             alignof(std::max_align_t));
+        STF_ASSERT_EQ(size, pool.InUseBytes());
+        STF_ASSERT_GE(pool.ReservedBytes(), size);
+
+        std::memset(p, 0xa5, size);
+        pool.Deallocate(p);
+        STF_ASSERT_EQ(0, pool.InUseBytes());
+    }
+
+    // Freeing nullptr has no effect
+    pool.Deallocate(nullptr);
+}
+
+STF_TEST(SecurePool, ErasedAndReused)
+{
+    SecUtil::SecurePool pool;
+
+    auto *first = static_cast<std::uint8_t *>(pool.Allocate(200));
+    STF_ASSERT_TRUE(AllZero(first, 200));
+    std::memset(first, 0xa5, 200);
+    pool.Deallocate(first);
+
+    // A block of the same size class is reused and has been erased
+    auto *second = static_cast<std::uint8_t *>(pool.Allocate(250));
+    STF_ASSERT_TRUE(first == second);
+    STF_ASSERT_TRUE(AllZero(second, 200));
+    pool.Deallocate(second);
+}
+
+STF_TEST(SecurePool, ManyBlocks)
+{
+    SecUtil::SecurePool pool(4096);
+    std::vector<std::uint8_t *> blocks;
+
+    // Use several chunks of one size class
+    for (std::size_t i = 0; i < 200; i++)
+    {
+        auto *p = static_cast<std::uint8_t *>(pool.Allocate(64));
+        std::memset(p, static_cast<int>(i), 64);
+        blocks.push_back(p);
+    }
+    STF_ASSERT_EQ(200 * 64, pool.InUseBytes());
+    const std::size_t reserved = pool.ReservedBytes();
+    STF_ASSERT_GE(reserved, 200 * 64);
+
+    // Blocks do not overlap
+    for (std::size_t i = 0; i < blocks.size(); i++)
+    {
+        STF_ASSERT_EQ(static_cast<std::uint8_t>(i), blocks[i][0]);
+        STF_ASSERT_EQ(static_cast<std::uint8_t>(i), blocks[i][63]);
+    }
+
+    // Free every other block, then allocate again without growing
+    for (std::size_t i = 0; i < blocks.size(); i += 2) pool.Deallocate(blocks[i]);
+    for (std::size_t i = 0; i < blocks.size(); i += 2)
+    {
+        blocks[i] = static_cast<std::uint8_t *>(pool.Allocate(64));
+        STF_ASSERT_TRUE(AllZero(blocks[i], 64));
+    }
+    STF_ASSERT_EQ(reserved, pool.ReservedBytes());
+
+    for (auto *p : blocks) pool.Deallocate(p);
+    STF_ASSERT_EQ(0, pool.InUseBytes());
+}
+
+STF_TEST(SecurePool, LargeBlocks)
+{
+    SecUtil::SecurePool pool;
+
+    auto *p = static_cast<std::uint8_t *>(pool.Allocate(100000));
+    STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(p) %
+                         alignof(std::max_align_t));
+    STF_ASSERT_EQ(100000, pool.InUseBytes());
+    std::memset(p, 0xa5, 100000);
+
+    pool.Deallocate(p);
+    STF_ASSERT_EQ(0, pool.InUseBytes());
+    STF_ASSERT_EQ(0, pool.ReservedBytes());
+}
+
+STF_TEST(SecurePool, Trim)
+{
+    SecUtil::SecurePool pool(4096, 1h);
+    std::vector<void *> blocks;
+
+    for (std::size_t i = 0; i < 200; i++) blocks.push_back(pool.Allocate(64));
+    const std::size_t reserved = pool.ReservedBytes();
+    STF_ASSERT_EQ(0, pool.RetainedBytes());
+
+    // Free all but the last block, leaving one chunk in use
+    for (std::size_t i = 0; i + 1 < blocks.size(); i++)
+    {
+        pool.Deallocate(blocks[i]);
+    }
+    const std::size_t retained = pool.RetainedBytes();
+    STF_ASSERT_GT(retained, 0);
+    STF_ASSERT_LT(retained, reserved);
+
+    // Chunks have not been idle for the decay time
+    STF_ASSERT_EQ(0, pool.Trim());
+    STF_ASSERT_EQ(reserved, pool.ReservedBytes());
+
+    STF_ASSERT_EQ(retained, pool.Trim(0ns));
+    STF_ASSERT_EQ(0, pool.RetainedBytes());
+    STF_ASSERT_EQ(retained, pool.ReleasedBytes());
+    STF_ASSERT_EQ(reserved - retained, pool.ReservedBytes());
+
+    // The remaining chunk still serves allocations, and the pool grows again
+    for (std::size_t i = 0; i + 1 < blocks.size(); i++)
+    {
+        blocks[i] = pool.Allocate(64);
+        STF_ASSERT_TRUE(AllZero(blocks[i], 64));
+    }
+    STF_ASSERT_EQ(reserved, pool.ReservedBytes());
+
+    for (auto *p : blocks) pool.Deallocate(p);
+    STF_ASSERT_EQ(reserved, pool.RetainedBytes());
+    STF_ASSERT_EQ(reserved, pool.Trim(0ns));
+    STF_ASSERT_EQ(0, pool.ReservedBytes());
+    STF_ASSERT_EQ(reserved + retained, pool.ReleasedBytes());
+}
+
+STF_TEST(SecurePool, Scavenger)
+{
+    SecUtil::SecurePool pool(4096, 10ms);
+
+    pool.StartScavenger();
+    pool.StartScavenger();
+
+    std::vector<void *> blocks;
+    for (std::size_t i = 0; i < 100; i++) blocks.push_back(pool.Allocate(500));
+    const std::size_t reserved = pool.ReservedBytes();
+    for (auto *p : blocks) pool.Deallocate(p);
+
+    // Idle chunks are released within twice the decay time
+    for (unsigned i = 0; (i < 500) && (pool.ReservedBytes() != 0); i++)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    STF_ASSERT_EQ(0, pool.ReservedBytes());
+    STF_ASSERT_EQ(0, pool.RetainedBytes());
+    STF_ASSERT_EQ(reserved, pool.ReleasedBytes());
+
+    pool.StopScavenger();
+    pool.StopScavenger();
+}
+
+STF_TEST(SecurePool, Threads)
+{
+    SecUtil::SecurePool pool;
+    std::vector<std::thread> threads;
+    std::vector<void *> handoff(4000);
+
+    // Blocks allocated by one thread are freed by another
+    for (std::size_t t = 0; t < 4; t++)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (std::size_t i = 0; i < 1000; i++)
+                {
+                    std::size_t size = 16 + ((i * 37 + t) % 2000);
+                    void *p = pool.Allocate(size);
+                    std::memset(p, 0xcc, size);
+                    handoff[t * 1000 + i] = p;
+                }
+            });
+    }
+    for (auto &thread : threads) thread.join();
+    threads.clear();
+
+    for (std::size_t t = 0; t < 4; t++)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (std::size_t i = 0; i < 1000; i++)
+                {
+                    pool.Deallocate(handoff[((t + 1) % 4) * 1000 + i]);
+                }
+            });
+    }
+    for (auto &thread : threads) thread.join();
+
+    STF_ASSERT_EQ(0, pool.InUseBytes());
+}
+
+STF_TEST(SecurePool, CoroutineFrames)
+{
+    const std::size_t in_use = SecUtil::DefaultSecurePool().InUseBytes();
+
+    {
+        Task task = Compute(1, 2);
+
+        // The suspended coroutine's frame is held in the pool
+        STF_ASSERT_GT(SecUtil::DefaultSecurePool().InUseBytes(), in_use);
+        // Octets 1 through 255 and then 0, plus 2
+        STF_ASSERT_EQ(32642, task.Run());
+    }
+
+    STF_ASSERT_EQ(in_use, SecUtil::DefaultSecurePool().InUseBytes());
+
+    // Frames are recycled
+    const std::size_t reserved = SecUtil::DefaultSecurePool().ReservedBytes();
+    for (int i = 0; i < 100; i++)
+    {
+        Task task = Compute(i, i);
+        task.Run();
+    }
+    STF_ASSERT_EQ(reserved, SecUtil::DefaultSecurePool().ReservedBytes());
+}
@@ -0,0 +1,160 @@
+/*
+ *  test_secure_random.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the SecureRandom functions.
+ *
+ *  Portability Issues:
+ *      The fork test is only performed on Unix-like systems.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <thread>
+#include <vector>
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include <terra/secutil/secure_random.h>
+#include <terra/secutil/secure_array.h>
+#include <terra/secutil/secure_vector.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+bool IsZero(std::span<const std::uint8_t> block)
+{
+    for (const auto i : block) if (i != 0) return false;
+
+    return true;
+}
+
+} // namespace
+
+STF_TEST(SecureRandom, FillBuffer)
+{
+    std::uint8_t buffer[32]{};
+
+    SecUtil::SecureRandom(buffer, sizeof(buffer));
+
+    STF_ASSERT_FALSE(IsZero(buffer));
+}
+
+STF_TEST(SecureRandom, SecureArray)
+{
+    SecUtil::SecureArray<std::uint8_t, 32> a{};
+    SecUtil::SecureArray<std::uint8_t, 32> b{};
+
+    SecUtil::SecureRandom(a);
+    SecUtil::SecureRandom(b);
+
+    STF_ASSERT_FALSE(IsZero(a));
+    STF_ASSERT_FALSE(IsZero(b));
+    STF_ASSERT_NE(a, b);
+}
+
+STF_TEST(SecureRandom, SecureVector)
+{
+    // Sizes both smaller and larger than the per-thread buffer
+    for (std::size_t size : {1, 16, 100, 4095, 4096, 10000, 100000})
+    {
+        SecUtil::SecureVector<std::uint8_t> vector(size, 0);
+
+        SecUtil::SecureRandom(vector);
+
+        STF_ASSERT_EQ(size, vector.size());
+        if (size >= 16) STF_ASSERT_FALSE(IsZero(vector));
+    }
+}
+
+STF_TEST(SecureRandom, Span)
+{
+    std::vector<std::uint32_t> values(64, 0);
+
+    SecUtil::SecureRandom(std::span<std::uint32_t>(values).subspan(32));
+
+    // Only the second half is filled
+    for (std::size_t i = 0; i < 32; i++) STF_ASSERT_EQ(0, values[i]);
+}
+
+STF_TEST(SecureRandom, ManySmallRequests)
+{
+    // Consume the per-thread buffer several times over
+    std::vector<std::uint8_t> previous(12);
+    std::vector<std::uint8_t> current(12);
+
+    SecUtil::SecureRandom(previous.data(), previous.size());
+
+    for (std::size_t i = 0; i < 2000; i++)
+    {
+        SecUtil::SecureRandom(current.data(), current.size());
+        STF_ASSERT_NE(previous, current);
+        previous = current;
+    }
+}
+
+STF_TEST(SecureRandom, Threads)
+{
+    SecUtil::SecureArray<std::uint8_t, 32> a{};
+    SecUtil::SecureArray<std::uint8_t, 32> b{};
+
+    std::thread thread1([&]() { SecUtil::SecureRandom(a); });
+    std::thread thread2([&]() { SecUtil::SecureRandom(b); });
+
+    thread1.join();
+    thread2.join();
+
+    STF_ASSERT_NE(a, b);
+}
+
+#if !defined(_WIN32)
+STF_TEST(SecureRandom, Fork)
+{
+    std::uint8_t parent[32];
+    std::uint8_t child[32];
+    int fds[2];
+
+    // Ensure the per-thread buffer holds octets before forking
+    SecUtil::SecureRandom(parent, 1);
+
+    STF_ASSERT_EQ(0, pipe(fds));
+
+    const pid_t pid = fork();
+    STF_ASSERT_NE(-1, pid);
+
+    if (pid == 0)
+    {
+        SecUtil::SecureRandom(child, sizeof(child));
+        const bool written =
+            write(fds[1], child, sizeof(child)) ==
+            static_cast<ssize_t>(sizeof(child));
+        _exit(written ? 0 : 1);
+    }
+
+    SecUtil::SecureRandom(parent, sizeof(parent));
+
+    STF_ASSERT_EQ(static_cast<ssize_t>(sizeof(child)),
+                  read(fds[0], child, sizeof(child)));
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    close(fds[0]);
+    close(fds[1]);
+
+    // The child must not have reproduced the parent's buffered octets
+    STF_ASSERT_NE(0, std::memcmp(parent, child, sizeof(parent)));
+}
+#endif
@@ -0,0 +1,164 @@
+/*
+ *  test_secure_reclaimer.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the SecureReclaimer object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <terra/secutil/secure_reclaimer.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+bool AllZero(const SecUtil::SecurePages &pages)
+{
+    return std::all_of(pages.data(),
+                       pages.data() + pages.capacity(),
+                       [](std::uint8_t octet) { return octet == 0; });
+}
+
+} // namespace
+
+STF_TEST(SecureReclaimer, ReclaimAndReuse)
+{
+    SecUtil::SecureReclaimer reclaimer(1s);
+
+    SecUtil::SecurePages pages = reclaimer.Acquire(1048576);
+    STF_ASSERT_EQ(1048576, pages.size());
+    std::fill(pages.data(), pages.data() + pages.size(), 0xaa);
+    const std::uint8_t *buffer = pages.data();
+
+    reclaimer.Reclaim(std::move(pages));
+    STF_ASSERT_TRUE(pages.empty());
+
+    reclaimer.Drain();
+
+    auto statistics = reclaimer.Statistics();
+    STF_ASSERT_EQ(0, statistics.queue_depth);
+    STF_ASSERT_EQ(0, statistics.queued_bytes);
+    STF_ASSERT_EQ(1, statistics.reclaimed_blocks);
+    STF_ASSERT_EQ(1048576, statistics.reclaimed_bytes);
+    STF_ASSERT_EQ(0, statistics.inline_erasures);
+    STF_ASSERT_EQ(1, statistics.cached_blocks);
+    STF_ASSERT_EQ(1048576, statistics.cached_bytes);
+    STF_ASSERT_GT(statistics.max_residency.count(), 0);
+    STF_ASSERT_EQ(statistics.max_residency, statistics.MeanResidency());
+
+    // The erased block is handed out again
+    pages = reclaimer.Acquire(1048576 - 100);
+    STF_ASSERT_EQ(buffer, pages.data());
+    STF_ASSERT_EQ(1048576 - 100, pages.size());
+    STF_ASSERT_TRUE(AllZero(pages));
+
+    statistics = reclaimer.Statistics();
+    STF_ASSERT_EQ(1, statistics.reused_blocks);
+    STF_ASSERT_EQ(0, statistics.cached_blocks);
+    STF_ASSERT_EQ(0, statistics.cached_bytes);
+}
+
+STF_TEST(SecureReclaimer, OversizedBlockNotReused)
+{
+    SecUtil::SecureReclaimer reclaimer(1s);
+
+    reclaimer.Reclaim(SecUtil::SecurePages(2097152));
+    reclaimer.Drain();
+
+    SecUtil::SecurePages pages = reclaimer.Acquire(4096);
+    STF_ASSERT_EQ(4096, pages.size());
+    STF_ASSERT_EQ(0, reclaimer.Statistics().reused_blocks);
+    STF_ASSERT_EQ(1, reclaimer.Statistics().cached_blocks);
+
+    reclaimer.Trim();
+    STF_ASSERT_EQ(0, reclaimer.Statistics().cached_blocks);
+    STF_ASSERT_EQ(0, reclaimer.Statistics().cached_bytes);
+}
+
+STF_TEST(SecureReclaimer, InlineErasure)
+{
+    // No backlog can be erased within a zero deadline, so only blocks
+    // reclaimed while the queue is empty are queued
+    SecUtil::SecureReclaimer reclaimer(0ns);
+
+    for (unsigned i = 0; i < 20; i++)
+    {
+        reclaimer.Reclaim(SecUtil::SecurePages(1048576));
+    }
+    reclaimer.Drain();
+
+    const auto statistics = reclaimer.Statistics();
+    STF_ASSERT_EQ(20, statistics.inline_erasures + statistics.reclaimed_blocks);
+    STF_ASSERT_GE(statistics.reclaimed_blocks, 1);
+    STF_ASSERT_EQ(statistics.reclaimed_blocks, statistics.deadline_misses);
+}
+
+STF_TEST(SecureReclaimer, CacheLimit)
+{
+    SecUtil::SecureReclaimer reclaimer(1s, 0);
+
+    reclaimer.Reclaim(SecUtil::SecurePages(65536));
+    reclaimer.Reclaim(SecUtil::SecurePages());
+    reclaimer.Drain();
+
+    const auto statistics = reclaimer.Statistics();
+    STF_ASSERT_EQ(1, statistics.reclaimed_blocks);
+    STF_ASSERT_EQ(0, statistics.cached_blocks);
+}
+
+STF_TEST(SecureReclaimer, ConcurrentReclaim)
+{
+    constexpr unsigned Thread_Count = 4;
+    constexpr unsigned Blocks_Per_Thread = 50;
+    std::vector<std::thread> threads;
+
+    {
+        SecUtil::SecureReclaimer reclaimer(1s, 1048576);
+
+        for (unsigned i = 0; i < Thread_Count; i++)
+        {
+            threads.emplace_back(
+                [&]()
+                {
+                    for (unsigned j = 0; j < Blocks_Per_Thread; j++)
+                    {
+                        auto pages = reclaimer.Acquire(65536 + j * 4096);
+                        std::fill(pages.data(), pages.data() + pages.size(), 0x5a);
+                        reclaimer.Reclaim(std::move(pages));
+                    }
+                });
+        }
+        for (auto &thread : threads) thread.join();
+
+        reclaimer.Drain();
+
+        const auto statistics = reclaimer.Statistics();
+        STF_ASSERT_EQ(Thread_Count * Blocks_Per_Thread,
+                      statistics.reclaimed_blocks + statistics.inline_erasures);
+        STF_ASSERT_LE(statistics.cached_bytes, 1048576);
+        STF_ASSERT_EQ(0, statistics.queue_depth);
+
+        // Queue more blocks; destroying the reclaimer erases them
+        for (unsigned i = 0; i < 10; i++)
+        {
+            reclaimer.Reclaim(SecUtil::SecurePages(65536));
+        }
+    }
+}
@@ -0,0 +1,185 @@
+/*
+ *  test_secure_scratch.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the per-thread secure scratch arena.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <terra/secutil/secure_scratch.h>
+#include <terra/secutil/secure_pages.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+bool AllZero(std::span<const std::uint8_t> data)
+{
+    return std::all_of(data.begin(),
+                       data.end(),
+                       [](std::uint8_t c) { return c == 0; });
+}
+
+} // namespace
+
+// This test must execute first, before this thread creates its arena
+STF_TEST(SecureScratch, Capacity)
+{
+    STF_ASSERT_EQ(0, SecUtil::ScratchCapacity());
+
+    SecUtil::SetScratchCapacity(8192);
+    auto buffer = SecUtil::AcquireScratch(16);
+
+    STF_ASSERT_GE(SecUtil::ScratchCapacity(), 8192);
+    STF_ASSERT_EQ(0, SecUtil::ScratchCapacity() % SecUtil::SecurePages::PageSize());
+}
+
+STF_TEST(SecureScratch, AcquireAndRelease)
+{
+    std::uint8_t *first_address = nullptr;
+
+    {
+        auto first = SecUtil::AcquireScratch(100);
+        auto second = SecUtil::AcquireScratch(200);
+
+        STF_ASSERT_EQ(100, first.size());
+        STF_ASSERT_EQ(200, second.size());
+        STF_ASSERT_FALSE(first.IsOverflow());
+        STF_ASSERT_TRUE(AllZero(first.Span()));
+        STF_ASSERT_TRUE(AllZero(second.Span()));
+        STF_ASSERT_GE(second.data(), first.data() + first.size());
+        STF_ASSERT_GE(SecUtil::ScratchInUse(), 300);
+
+        std::fill(first.Span().begin(), first.Span().end(), 0xaa);
+        std::fill(second.Span().begin(), second.Span().end(), 0xbb);
+        first_address = first.data();
+    }
+
+    STF_ASSERT_EQ(0, SecUtil::ScratchInUse());
+
+    // The space is reused and was erased on release
+    auto again = SecUtil::AcquireScratch(300);
+    STF_ASSERT_TRUE(again.data() == first_address);
+    STF_ASSERT_TRUE(AllZero(again.Span()));
+}
+
+STF_TEST(SecureScratch, ReleaseOrder)
+{
+    auto first = SecUtil::AcquireScratch(64);
+    auto second = SecUtil::AcquireScratch(64);
+    const std::size_t in_use = SecUtil::ScratchInUse();
+
+    // Releasing the most recent buffer reclaims its space
+    second = SecUtil::ScratchBuffer();
+    STF_ASSERT_LT(SecUtil::ScratchInUse(), in_use);
+
+    // Releasing out of order reclaims space once all are released
+    second = SecUtil::AcquireScratch(64);
+    first = SecUtil::ScratchBuffer();
+    STF_ASSERT_GT(SecUtil::ScratchInUse(), 0);
+    second = SecUtil::ScratchBuffer();
+    STF_ASSERT_EQ(0, SecUtil::ScratchInUse());
+}
+
+STF_TEST(SecureScratch, Alignment)
+{
+    auto pad = SecUtil::AcquireScratch(1);
+    auto aligned = SecUtil::AcquireScratch(64, 64);
+
+    STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(aligned.data()) % 64);
+
+    bool exception_thrown = false;
+    try
+    {
+        SecUtil::AcquireScratch(16, 3);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+
+    // Zero-length requests produce an empty buffer
+    auto empty = SecUtil::AcquireScratch(0);
+    STF_ASSERT_TRUE(empty.empty());
+}
+
+STF_TEST(SecureScratch, Overflow)
+{
+    auto large = SecUtil::AcquireScratch(SecUtil::ScratchCapacity() + 1, 32);
+
+    STF_ASSERT_TRUE(large.IsOverflow());
+    STF_ASSERT_EQ(SecUtil::ScratchCapacity() + 1, large.size());
+    STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(large.data()) % 32);
+    STF_ASSERT_TRUE(AllZero(large.Span()));
+    STF_ASSERT_EQ(0, SecUtil::ScratchInUse());
+
+    // Moving retains the storage
+    std::uint8_t *address = large.data();
+    SecUtil::ScratchBuffer moved(std::move(large));
+    STF_ASSERT_TRUE(moved.data() == address);
+    STF_ASSERT_TRUE(large.empty());
+}
+
+STF_TEST(SecureScratch, PerThread)
+{
+    auto buffer = SecUtil::AcquireScratch(128);
+    std::uintptr_t other_address = 0;
+    std::size_t other_in_use = 0;
+
+    std::thread thread(
+        [&]()
+        {
+            auto other = SecUtil::AcquireScratch(128);
+            std::fill(other.Span().begin(), other.Span().end(), 0xcc);
+            other_address = reinterpret_cast<std::uintptr_t>(other.data());
+            other_in_use = SecUtil::ScratchInUse();
+
+            // A buffer held by a thread_local object is released as the
+            // thread exits
+            thread_local SecUtil::ScratchBuffer leftover =
+                SecUtil::AcquireScratch(32);
+        });
+    thread.join();
+
+    STF_ASSERT_NE(reinterpret_cast<std::uintptr_t>(buffer.data()),
+                  other_address);
+    STF_ASSERT_EQ(128, other_in_use);
+    STF_ASSERT_EQ(128, SecUtil::ScratchInUse());
+}
+
+STF_TEST(SecureScratch, ReleasedOnOtherThread)
+{
+    auto held = SecUtil::AcquireScratch(64);
+    const std::size_t in_use = SecUtil::ScratchInUse();
+    SecUtil::ScratchBuffer foreign;
+
+    std::thread thread([&]() { foreign = SecUtil::AcquireScratch(16); });
+    thread.join();
+    STF_ASSERT_FALSE(foreign.IsOverflow());
+    STF_ASSERT_EQ(in_use, SecUtil::ScratchInUse());
+
+    // Releasing the other thread's buffer leaves this arena untouched
+    foreign = SecUtil::ScratchBuffer();
+    STF_ASSERT_EQ(in_use, SecUtil::ScratchInUse());
+
+    held = SecUtil::ScratchBuffer();
+    STF_ASSERT_EQ(0, SecUtil::ScratchInUse());
+}
@@ -0,0 +1,161 @@
+/*
+ *  test_secure_scrub.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for stack and vector register scrubbing.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <terra/secutil/secure_scrub.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// Use the given number of octets of stack
+#if defined(_MSC_VER)
+__declspec(noinline)
+#else
+__attribute__((noinline))
+#endif
+std::uint8_t UseStack(std::size_t bytes)
+{
+    volatile std::uint8_t buffer[16384];
+    std::uint8_t sum = 0;
+
+    for (std::size_t i = 0; (i < bytes) && (i < sizeof(buffer)); i++)
+    {
+        buffer[i] = static_cast<std::uint8_t>(i + 1);
+    }
+    for (std::size_t i = 0; (i < bytes) && (i < sizeof(buffer)); i++)
+    {
+        sum = static_cast<std::uint8_t>(sum + buffer[i]);
+    }
+
+    return sum;
+}
+
+} // namespace
+
+STF_TEST(SecureScrub, ScrubStack)
+{
+    // Nothing to verify other than that these complete
+    SecUtil::ScrubStack(0);
+    SecUtil::ScrubStack(1);
+    SecUtil::ScrubStack(4096);
+    SecUtil::ScrubStack(SecUtil::Max_Stack_Scrub * 4);
+}
+
+STF_TEST(SecureScrub, ScrubStackOverwrites)
+{
+    // Paint the stack, then scrub beyond the painted region
+    SecUtil::PaintStack(4096, false);
+    STF_ASSERT_EQ(0, SecUtil::PaintStack(4096, true));
+    SecUtil::ScrubStack(8192);
+
+    // Every painted octet should have been overwritten
+    STF_ASSERT_EQ(4096, SecUtil::PaintStack(4096, true));
+}
+
+STF_TEST(SecureScrub, ClearVectorRegisters)
+{
+    volatile double value = 1.5;
+    double result = value * 2.0;
+
+    SecUtil::ClearVectorRegisters();
+
+    // Values the compiler holds in registers must survive
+    STF_ASSERT_EQ(3.0, result);
+    STF_ASSERT_EQ(1.5, value);
+}
+
+STF_TEST(SecureScrub, ScrubAfterReturnsValue)
+{
+    auto result = SecUtil::ScrubAfter(4096, UseStack, 16);
+    STF_ASSERT_EQ(136, result);
+
+    std::string text = SecUtil::ScrubAfter(
+        1024,
+        [](const std::string &a, const std::string &b) { return a + b; },
+        std::string("secret"),
+        std::string("value"));
+    STF_ASSERT_EQ(std::string("secretvalue"), text);
+
+    // Move-only values are returned
+    auto pointer = SecUtil::ScrubAfter(1024,
+                                       []() { return std::make_unique<int>(5); });
+    STF_ASSERT_EQ(5, *pointer);
+}
+
+STF_TEST(SecureScrub, ScrubAfterReference)
+{
+    int value = 1;
+
+    int &reference = SecUtil::ScrubAfter(1024,
+                                         [&]() -> int & { return value; });
+    reference = 2;
+
+    STF_ASSERT_EQ(2, value);
+}
+
+STF_TEST(SecureScrub, ScrubAfterVoid)
+{
+    bool called = false;
+
+    SecUtil::ScrubAfter(1024, [&]() { called = true; });
+
+    STF_ASSERT_TRUE(called);
+}
+
+STF_TEST(SecureScrub, ScrubAfterException)
+{
+    bool caught = false;
+
+    try
+    {
+        SecUtil::ScrubAfter(
+            1024,
+            []() -> int { throw std::runtime_error("failure"); });
+    }
+    catch (const std::runtime_error &)
+    {
+        caught = true;
+    }
+
+    STF_ASSERT_TRUE(caught);
+}
+
+STF_TEST(SecureScrub, MeasureStackUsage)
+{
+    // A function using no significant stack
+    std::size_t small = SecUtil::MeasureStackUsage(65536, []() {});
+    STF_ASSERT_LT(small, 1024);
+
+    // A function using at least 16 KiB; the result may be low by the size
+    // of the painting function's own frame
+    std::size_t large =
+        SecUtil::MeasureStackUsage(65536, []() { UseStack(16384); });
+    STF_ASSERT_GE(large, 16384 - 256);
+    STF_ASSERT_LT(large, 65536);
+
+    // The limit is respected
+    std::size_t limited =
+        SecUtil::MeasureStackUsage(4096, []() { UseStack(16384); });
+    STF_ASSERT_LE(limited, 4096);
+}
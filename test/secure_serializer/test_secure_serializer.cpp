@@ -0,0 +1,186 @@
+/*
+ *  test_secure_serializer.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the SecureSerializer and SecureDeserializer objects.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include <terra/secutil/secure_serializer.h>
+#include <terra/secutil/secure_array.h>
+#include <terra/secutil/secure_string.h>
+#include <terra/secutil/secure_vector.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+template<typename F>
+bool ThrowsInvalidArgument(F function)
+{
+    try
+    {
+        function();
+    }
+    catch (const std::invalid_argument &)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace
+
+STF_TEST(SecureSerializer, RoundTrip)
+{
+    SecUtil::SecureArray<std::uint8_t, 4> key_id = {1, 2, 3, 4};
+    SecUtil::SecureVector<std::uint32_t> key = {0xdeadbeef, 0x01234567};
+    SecUtil::SecureString password = "correct horse battery staple";
+    SecUtil::SecureString empty;
+
+    SecUtil::SecureSerializer serializer;
+    serializer.Write(key_id, key, password);
+    serializer.Write(empty);
+
+    // Header of 16 octets, then 4 + 8 + 28 octets of data
+    STF_ASSERT_EQ(56 + 8, serializer.size());
+    STF_ASSERT_EQ(56, SecUtil::SecureSerializer::SerializedSize(key_id,
+                                                                key,
+                                                                password));
+
+    SecUtil::SecureArray<std::uint8_t, 4> key_id_read{};
+    SecUtil::SecureVector<std::uint32_t> key_read;
+    SecUtil::SecureString password_read = "x";
+    SecUtil::SecureString empty_read = "not empty";
+
+    SecUtil::SecureDeserializer deserializer(serializer.Span());
+    deserializer.Read(key_id_read, key_read, password_read);
+    deserializer.Read(empty_read);
+
+    STF_ASSERT_TRUE(deserializer.AtEnd());
+    STF_ASSERT_EQ(key_id, key_id_read);
+    STF_ASSERT_EQ(key, key_read);
+    STF_ASSERT_EQ(password, password_read);
+    STF_ASSERT_TRUE(empty_read.empty());
+}
+
+STF_TEST(SecureSerializer, ZeroCopyRead)
+{
+    SecUtil::SecureVector<std::uint8_t> a = {1, 2, 3};
+    SecUtil::SecureVector<std::uint8_t> b = {4, 5};
+
+    SecUtil::SecureSerializer serializer;
+    serializer.Write(a, b);
+    serializer.Write(std::span<const std::uint8_t>(a));
+
+    auto data = serializer.Release();
+    STF_ASSERT_EQ(0, serializer.size());
+
+    SecUtil::SecureDeserializer deserializer(data);
+    auto fields = deserializer.ReadBatch<2>();
+
+    // The fields refer directly to the serialized data
+    STF_ASSERT_EQ(data.data() + 12, fields[0].data());
+    STF_ASSERT_EQ(3, fields[0].size());
+    STF_ASSERT_EQ(4, fields[1][0]);
+
+    auto single = deserializer.Read();
+    STF_ASSERT_EQ(3, single.size());
+    STF_ASSERT_EQ(0, deserializer.Remaining());
+}
+
+STF_TEST(SecureSerializer, SerializeIntoBuffer)
+{
+    SecUtil::SecureString text = "abc";
+    std::vector<std::uint8_t> buffer(11);
+
+    STF_ASSERT_EQ(11, SecUtil::SecureSerializer::Serialize(buffer, text));
+    STF_ASSERT_EQ(std::vector<std::uint8_t>({1, 0, 0, 0, 3, 0, 0, 0,
+                                             'a', 'b', 'c'}),
+                  buffer);
+
+    buffer.resize(10);
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { SecUtil::SecureSerializer::Serialize(buffer, text); }));
+}
+
+STF_TEST(SecureSerializer, MalformedInput)
+{
+    SecUtil::SecureVector<std::uint8_t> value = {1, 2, 3};
+    SecUtil::SecureSerializer serializer;
+    serializer.Write(value);
+
+    auto data = serializer.Span();
+
+    // Truncated data
+    SecUtil::SecureDeserializer truncated(data.first(data.size() - 1));
+    STF_ASSERT_TRUE(ThrowsInvalidArgument([&]() { truncated.Read(); }));
+    STF_ASSERT_EQ(data.size() - 1, truncated.Remaining());
+
+    // Wrong field count
+    SecUtil::SecureDeserializer wrong_count(data);
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { wrong_count.ReadBatch<2>(); }));
+
+    // Field does not fit a fixed-size container, leaving it unchanged
+    SecUtil::SecureArray<std::uint8_t, 4> fixed = {9, 9, 9, 9};
+    SecUtil::SecureDeserializer mismatch(data);
+    STF_ASSERT_TRUE(ThrowsInvalidArgument([&]() { mismatch.Read(fixed); }));
+    STF_ASSERT_EQ(9, fixed[0]);
+    STF_ASSERT_EQ(data.size(), mismatch.Remaining());
+
+    // Field length is not a multiple of the element size
+    SecUtil::SecureVector<std::uint16_t> wide;
+    SecUtil::SecureDeserializer odd(data);
+    STF_ASSERT_TRUE(ThrowsInvalidArgument([&]() { odd.Read(wide); }));
+}
+
+STF_TEST(SecureSerializer, Clear)
+{
+    SecUtil::SecureString text = "secret";
+    SecUtil::SecureSerializer serializer(64);
+
+    serializer.Write(text);
+    serializer.Clear();
+
+    STF_ASSERT_EQ(0, serializer.size());
+}
+
+STF_TEST(SecureSerializer, OversizedField)
+{
+    // A field longer than 2^32 - 1 octets requires a 64-bit size_t
+    if constexpr (sizeof(std::size_t) > sizeof(std::uint32_t))
+    {
+        SecUtil::SecureVector<std::uint8_t> value = {1, 2, 3};
+        SecUtil::SecureSerializer serializer;
+        serializer.Write(value);
+        const std::size_t length = serializer.size();
+
+        // The field is rejected by its length alone and is never read
+        const std::uint64_t octets[1]{};
+        const std::span<const std::uint64_t> oversized(
+            octets,
+            SecUtil::SecureSerializer::Max_Field_Size / sizeof(std::uint64_t) +
+                1);
+
+        STF_ASSERT_TRUE(ThrowsInvalidArgument(
+            [&]() { serializer.Write(value, oversized); }));
+        STF_ASSERT_EQ(length, serializer.size());
+    }
+}
@@ -0,0 +1,187 @@
+/*
+ *  test_secure_stream.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the SecureBasicStreamBuf and secure string streams.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include <terra/secutil/secure_stream.h>
+#include <terra/secutil/secure_string.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+STF_TEST(SecureStream, WriteAndRead)
+{
+    SecUtil::SecureStringStream stream;
+
+    stream << "key=" << 42 << ' ' << "secret";
+
+    STF_ASSERT_EQ(std::string_view("key=42 secret"), stream.view());
+    STF_ASSERT_EQ(SecUtil::SecureString("key=42 secret"), stream.str());
+
+    SecUtil::SecureString key;
+    SecUtil::SecureString value;
+    STF_ASSERT_TRUE(static_cast<bool>(std::getline(stream, key, '=')));
+    STF_ASSERT_TRUE(static_cast<bool>(std::getline(stream, value)));
+    STF_ASSERT_EQ(SecUtil::SecureString("key"), key);
+    STF_ASSERT_EQ(SecUtil::SecureString("42 secret"), value);
+    STF_ASSERT_TRUE(stream.eof());
+}
+
+STF_TEST(SecureStream, ParseLines)
+{
+    SecUtil::SecureIStringStream stream(
+        "-----BEGIN KEY-----\nAAAA\nBBBB\n-----END KEY-----\n");
+    SecUtil::SecureString line;
+    SecUtil::SecureString body;
+    std::size_t count = 0;
+
+    while (std::getline(stream, line))
+    {
+        if (line.starts_with("-----")) continue;
+        body += line;
+        count++;
+    }
+
+    STF_ASSERT_EQ(2, count);
+    STF_ASSERT_EQ(SecUtil::SecureString("AAAABBBB"), body);
+}
+
+STF_TEST(SecureStream, Growth)
+{
+    SecUtil::SecureOStringStream stream;
+    std::string expected;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        stream << i << ',';
+        expected += std::to_string(i) + ',';
+    }
+
+    STF_ASSERT_EQ(std::string_view(expected), stream.view());
+    STF_ASSERT_GE(stream.rdbuf()->capacity(), expected.size());
+
+    // A large write grows the buffer once to fit
+    const std::string block(100000, 'x');
+    stream << block;
+    STF_ASSERT_EQ(expected.size() + block.size(), stream.view().size());
+}
+
+STF_TEST(SecureStream, Reserve)
+{
+    SecUtil::SecureStringStream stream;
+
+    stream.reserve(256);
+    const auto capacity = stream.rdbuf()->capacity();
+    STF_ASSERT_EQ(256, capacity);
+
+    const char *data = stream.view().data();
+    for (int i = 0; i < 256; i++) stream.put('a');
+
+    // The buffer did not move or grow
+    STF_ASSERT_EQ(capacity, stream.rdbuf()->capacity());
+    STF_ASSERT_TRUE(data == stream.view().data());
+    STF_ASSERT_EQ(256, stream.view().size());
+
+    // Reserving retains the read and write positions
+    char c{};
+    stream.get(c);
+    stream.reserve(1024);
+    stream.put('b');
+    STF_ASSERT_EQ(257, stream.view().size());
+    stream.get(c);
+    STF_ASSERT_EQ('a', c);
+}
+
+STF_TEST(SecureStream, Seek)
+{
+    SecUtil::SecureStringStream stream("0123456789");
+
+    stream.seekg(5);
+    char c{};
+    stream.get(c);
+    STF_ASSERT_EQ('5', c);
+
+    stream.seekg(-2, std::ios_base::end);
+    stream.get(c);
+    STF_ASSERT_EQ('8', c);
+
+    // Writing begins at the start unless opened with ate or app
+    stream.seekp(0, std::ios_base::beg);
+    stream << "ab";
+    STF_ASSERT_EQ(std::string_view("ab23456789"), stream.view());
+
+    stream.seekp(0, std::ios_base::end);
+    stream << "!";
+    STF_ASSERT_EQ(std::string_view("ab23456789!"), stream.view());
+
+    stream.seekg(20);
+    STF_ASSERT_TRUE(stream.fail());
+}
+
+STF_TEST(SecureStream, AppendMode)
+{
+    SecUtil::SecureOStringStream stream("header:", std::ios_base::ate);
+
+    stream << "value";
+
+    STF_ASSERT_EQ(std::string_view("header:value"), stream.view());
+}
+
+STF_TEST(SecureStream, Putback)
+{
+    SecUtil::SecureIStringStream stream("abc");
+    char c{};
+
+    stream.get(c);
+    STF_ASSERT_TRUE(static_cast<bool>(stream.unget()));
+    stream.get(c);
+    STF_ASSERT_EQ('a', c);
+
+    // The input-only buffer cannot be modified by putback
+    STF_ASSERT_FALSE(static_cast<bool>(stream.putback('z')));
+}
+
+STF_TEST(SecureStream, ReplaceAndClear)
+{
+    SecUtil::SecureStringStream stream("a long initial secret value");
+    const auto capacity = stream.rdbuf()->capacity();
+
+    stream.str("short");
+    STF_ASSERT_EQ(std::string_view("short"), stream.view());
+    STF_ASSERT_EQ(capacity, stream.rdbuf()->capacity());
+
+    // Replacing contents with a view of the contents is permitted
+    stream.str(stream.view().substr(1));
+    STF_ASSERT_EQ(std::string_view("hort"), stream.view());
+
+    stream.Clear();
+    STF_ASSERT_TRUE(stream.view().empty());
+    STF_ASSERT_EQ(capacity, stream.rdbuf()->capacity());
+
+    stream << "next";
+    STF_ASSERT_EQ(std::string_view("next"), stream.view());
+}
+
+STF_TEST(SecureStream, Wide)
+{
+    SecUtil::SecureWStringStream stream;
+
+    stream << L"wide " << 7;
+
+    STF_ASSERT_TRUE(stream.view() == L"wide 7");
+}
@@ -0,0 +1,167 @@
+/*
+ *  test_secure_transcode.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the Unicode transcoding functions.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <terra/secutil/secure_transcode.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+// The same text in each encoding, mixing ASCII runs of various lengths with
+// two, three, and four octet UTF-8 sequences
+const std::u8string_view UTF8_Text =
+    u8"Key: café €100 \U0001F511 and a long ASCII run of "
+    u8"characters exceeding sixteen units ü\U00010348!";
+const std::u16string_view UTF16_Text =
+    u"Key: café €100 \U0001F511 and a long ASCII run of "
+    u"characters exceeding sixteen units ü\U00010348!";
+const std::u32string_view UTF32_Text =
+    U"Key: café €100 \U0001F511 and a long ASCII run of "
+    U"characters exceeding sixteen units ü\U00010348!";
+
+template<typename F>
+bool ThrowsInvalidArgument(F function)
+{
+    try
+    {
+        function();
+    }
+    catch (const std::invalid_argument &)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace
+
+STF_TEST(SecureTranscode, UTF8Source)
+{
+    SecUtil::SecureU16String utf16 = SecUtil::SecureTranscode<char16_t>(UTF8_Text);
+    SecUtil::SecureU32String utf32 = SecUtil::SecureTranscode<char32_t>(UTF8_Text);
+
+    STF_ASSERT_TRUE(std::u16string_view(utf16) == UTF16_Text);
+    STF_ASSERT_TRUE(std::u32string_view(utf32) == UTF32_Text);
+}
+
+STF_TEST(SecureTranscode, UTF16Source)
+{
+    SecUtil::SecureU8String utf8 = SecUtil::SecureTranscode<char8_t>(UTF16_Text);
+    SecUtil::SecureU32String utf32 = SecUtil::SecureTranscode<char32_t>(UTF16_Text);
+
+    STF_ASSERT_TRUE(std::u8string_view(utf8) == UTF8_Text);
+    STF_ASSERT_TRUE(std::u32string_view(utf32) == UTF32_Text);
+}
+
+STF_TEST(SecureTranscode, UTF32Source)
+{
+    SecUtil::SecureU8String utf8 = SecUtil::SecureTranscode<char8_t>(UTF32_Text);
+    SecUtil::SecureU16String utf16 = SecUtil::SecureTranscode<char16_t>(UTF32_Text);
+
+    STF_ASSERT_TRUE(std::u8string_view(utf8) == UTF8_Text);
+    STF_ASSERT_TRUE(std::u16string_view(utf16) == UTF16_Text);
+}
+
+STF_TEST(SecureTranscode, SecureStringTypes)
+{
+    SecUtil::SecureString password = "p\xc3\xa4ssw\xc3\xb6rd";
+
+    SecUtil::SecureWString wide = SecUtil::SecureTranscode<wchar_t>(password);
+
+    STF_ASSERT_EQ(8, wide.size());
+    STF_ASSERT_TRUE(wide == L"pässwörd");
+
+    SecUtil::SecureString round_trip = SecUtil::SecureTranscode<char>(wide);
+
+    STF_ASSERT_EQ(password, round_trip);
+}
+
+STF_TEST(SecureTranscode, ExactLength)
+{
+    STF_ASSERT_EQ(UTF16_Text.size(),
+                  SecUtil::TranscodedLength<char16_t>(UTF8_Text));
+    STF_ASSERT_EQ(UTF32_Text.size(),
+                  SecUtil::TranscodedLength<char32_t>(UTF16_Text));
+    STF_ASSERT_EQ(UTF8_Text.size(),
+                  SecUtil::TranscodedLength<char8_t>(UTF32_Text));
+}
+
+STF_TEST(SecureTranscode, IntoBuffer)
+{
+    std::u16string buffer(UTF16_Text.size(), u'\0');
+
+    SecUtil::SecureTranscode(UTF8_Text, std::span<char16_t>(buffer));
+
+    STF_ASSERT_TRUE(buffer == UTF16_Text);
+
+    // A buffer of the wrong size is rejected and any output erased
+    std::u16string short_buffer(UTF16_Text.size() - 1, u'x');
+
+    STF_ASSERT_TRUE(ThrowsInvalidArgument([&]() {
+        SecUtil::SecureTranscode(UTF8_Text, std::span<char16_t>(short_buffer));
+    }));
+    STF_ASSERT_EQ(u'\0', short_buffer[0]);
+}
+
+STF_TEST(SecureTranscode, InvalidUTF8)
+{
+    const std::u8string invalid[] = {
+        u8"\x80",                   // Lone continuation octet
+        u8"abc\xc3",                // Truncated sequence
+        u8"\xc0\xaf",               // Overlong encoding
+        u8"\xe0\x80\xaf",           // Overlong encoding
+        u8"\xed\xa0\x80",           // Encoded surrogate
+        u8"\xf4\x90\x80\x80",       // Beyond U+10FFFF
+        u8"\xf8\x88\x80\x80\x80",   // Invalid lead octet
+        u8"\xc3\x28"};              // Invalid continuation octet
+
+    for (const auto &text : invalid)
+    {
+        STF_ASSERT_TRUE(ThrowsInvalidArgument(
+            [&]() { SecUtil::SecureTranscode<char16_t>(text); }));
+    }
+}
+
+STF_TEST(SecureTranscode, InvalidUTF16AndUTF32)
+{
+    const std::u16string lone_high(1, char16_t(0xd800));
+    const std::u16string lone_low(1, char16_t(0xdc00));
+    const std::u32string surrogate(1, char32_t(0xd800));
+    const std::u32string too_large(1, char32_t(0x110000));
+
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { SecUtil::SecureTranscode<char8_t>(lone_high); }));
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { SecUtil::SecureTranscode<char8_t>(lone_low); }));
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { SecUtil::SecureTranscode<char8_t>(surrogate); }));
+    STF_ASSERT_TRUE(ThrowsInvalidArgument(
+        [&]() { SecUtil::SecureTranscode<char16_t>(too_large); }));
+}
+
+STF_TEST(SecureTranscode, Empty)
+{
+    STF_ASSERT_TRUE(
+        SecUtil::SecureTranscode<char16_t>(std::u8string_view()).empty());
+}
@@ -0,0 +1,234 @@
+/*
+ *  test_shared_secret.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the SharedSecret object.
+ *
+ *  Portability Issues:
+ *      These tests are only performed on Linux, where memfd_create() is
+ *      available.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include <terra/secutil/shared_secret.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+#if defined(__linux__)
+
+namespace
+{
+
+std::vector<std::uint8_t> TestSecret(std::size_t length)
+{
+    std::vector<std::uint8_t> secret(length);
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        secret[i] = static_cast<std::uint8_t>(i * 3 + 11);
+    }
+
+    return secret;
+}
+
+bool SendDescriptor(int socket, int fd)
+{
+    char data = 0;
+    iovec io{&data, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr message{};
+
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    cmsghdr *header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(header), &fd, sizeof(int));
+
+    return sendmsg(socket, &message, 0) == 1;
+}
+
+int ReceiveDescriptor(int socket)
+{
+    char data = 0;
+    iovec io{&data, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr message{};
+    int fd = -1;
+
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    if (recvmsg(socket, &message, 0) != 1) return -1;
+
+    cmsghdr *header = CMSG_FIRSTHDR(&message);
+    if ((header == nullptr) || (header->cmsg_type != SCM_RIGHTS)) return -1;
+    std::memcpy(&fd, CMSG_DATA(header), sizeof(int));
+
+    return fd;
+}
+
+} // namespace
+
+STF_TEST(SharedSecret, CreateAndRead)
+{
+    const auto secret = TestSecret(5000);
+    auto shared = SecUtil::SharedSecret::Create(secret);
+
+    STF_ASSERT_EQ(secret.size(), shared.size());
+    STF_ASSERT_EQ(0, std::memcmp(secret.data(), shared.data(), secret.size()));
+
+    // The memory file cannot be resized
+    STF_ASSERT_NE(0, ftruncate(shared.Handle(), 0));
+}
+
+STF_TEST(SharedSecret, ShareWithChildProcess)
+{
+    const auto secret = TestSecret(100);
+    auto shared = SecUtil::SharedSecret::Create(secret);
+    int sockets[2];
+
+    STF_ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+
+    const pid_t pid = fork();
+    STF_ASSERT_NE(-1, pid);
+
+    if (pid == 0)
+    {
+        close(sockets[0]);
+        bool matches = false;
+        {
+            auto received =
+                SecUtil::SharedSecret::Import(ReceiveDescriptor(sockets[1]));
+            matches = (received.size() == secret.size()) &&
+                      (std::memcmp(received.data(),
+                                   secret.data(),
+                                   secret.size()) == 0);
+        }
+        _exit(matches ? 0 : 1);
+    }
+
+    close(sockets[1]);
+
+    const int fd = shared.Export();
+    STF_ASSERT_TRUE(SendDescriptor(sockets[0], fd));
+    close(fd);
+    close(sockets[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    STF_ASSERT_TRUE(WIFEXITED(status));
+    STF_ASSERT_EQ(0, WEXITSTATUS(status));
+
+    // The parent's reference keeps the secret intact
+    STF_ASSERT_EQ(0, std::memcmp(secret.data(), shared.data(), secret.size()));
+}
+
+STF_TEST(SharedSecret, LastOwnerErases)
+{
+    const auto secret = TestSecret(64);
+    auto first = SecUtil::SharedSecret::Create(secret);
+    auto second = SecUtil::SharedSecret::Import(first.Export());
+
+    // An uncounted descriptor used to inspect the memory file afterward
+    const int fd = dup(first.Handle());
+    const long page_size = sysconf(_SC_PAGESIZE);
+
+    first = SecUtil::SharedSecret();
+    STF_ASSERT_EQ(0, std::memcmp(secret.data(), second.data(), secret.size()));
+
+    second = SecUtil::SharedSecret();
+
+    void *p = mmap(nullptr, page_size, PROT_READ, MAP_SHARED, fd, page_size);
+    STF_ASSERT_NE(MAP_FAILED, p);
+
+    const std::vector<std::uint8_t> zeros(secret.size(), 0);
+    STF_ASSERT_EQ(0, std::memcmp(zeros.data(), p, zeros.size()));
+
+    munmap(p, page_size);
+    close(fd);
+}
+
+STF_TEST(SharedSecret, Empty)
+{
+    auto shared = SecUtil::SharedSecret::Create({});
+    STF_ASSERT_TRUE(shared.empty());
+
+    auto imported = SecUtil::SharedSecret::Import(shared.Export());
+    STF_ASSERT_TRUE(imported.empty());
+}
+
+STF_TEST(SharedSecret, ImportRejectsOtherFiles)
+{
+    int fds[2];
+    STF_ASSERT_EQ(0, pipe(fds));
+    close(fds[1]);
+
+    bool exception_thrown = false;
+    try
+    {
+        SecUtil::SharedSecret::Import(fds[0]);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+}
+
+STF_TEST(SharedSecret, ImportRejectsRegularFile)
+{
+    const std::size_t page_size =
+        static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+    // A regular file laid out like a shared secret, which cannot be sealed
+    char name[] = "/tmp/secutil_shared_XXXXXX";
+    int fd = mkstemp(name);
+    STF_ASSERT_GE(fd, 0);
+    unlink(name);
+
+    const std::uint64_t header[3] = {1, 0x5465727261535353ULL, 16};
+    std::vector<std::uint8_t> contents(2 * page_size, 0);
+    std::memcpy(contents.data(), header, sizeof(header));
+    STF_ASSERT_EQ(static_cast<ssize_t>(contents.size()),
+                  write(fd, contents.data(), contents.size()));
+
+    bool exception_thrown = false;
+    try
+    {
+        SecUtil::SharedSecret::Import(fd);
+    }
+    catch (const std::invalid_argument &)
+    {
+        exception_thrown = true;
+    }
+    STF_ASSERT_TRUE(exception_thrown);
+}
+
+#endif
@@ -0,0 +1,289 @@
+/*
+ *  test_wipe_registry.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Unit tests for the wipe registry.
+ *
+ *  Portability Issues:
+ *      The signal and quick_exit tests require fork() and are not built on
+ *      Windows.
+ */
+
+#include <algorithm>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include <terra/secutil/wipe_registry.h>
+#include <terra/secutil/secure_array.h>
+#include <terra/secutil/secure_deleter.h>
+#include <terra/secutil/secure_pages.h>
+#include <terra/secutil/secure_vector.h>
+#include <terra/stf/stf.h>
+
+using namespace Terra;
+
+namespace
+{
+
+bool AllZero(const std::uint8_t *p, std::size_t length)
+{
+    return std::all_of(p, p + length, [](std::uint8_t c) { return c == 0; });
+}
+
+#if !defined(_WIN32)
+/*
+ *  WipedInChild()
+ *
+ *  Description:
+ *      Fork a child that places a secret in a registered region of shared
+ *      memory and then terminates using the given function.
+ *
+ *  Parameters:
+ *      prepare [in]
+ *          Function called by the child before installing the wipe handlers.
+ *
+ *      terminate [in]
+ *          Function called by the child to terminate.
+ *
+ *      status [out]
+ *          The wait status of the child.
+ *
+ *  Returns:
+ *      True if the secret was erased, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename P, typename F>
+bool WipedInChild(P prepare, F terminate, int &status)
+{
+    constexpr std::size_t Length = 4096;
+    void *shared = mmap(nullptr,
+                        Length,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS,
+                        -1,
+                        0);
+    if (shared == MAP_FAILED) return false;
+    auto *secret = static_cast<std::uint8_t *>(shared);
+
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        // Avoid writing a core file when the child faults
+        rlimit limit{0, 0};
+        setrlimit(RLIMIT_CORE, &limit);
+
+        prepare();
+        SecUtil::InstallWipeHandlers();
+        std::fill(secret, secret + Length, std::uint8_t{0xa5});
+        SecUtil::RegisterSecureRegion(secret, Length);
+        terminate();
+        _exit(99);
+    }
+
+    waitpid(pid, &status, 0);
+    const bool wiped = AllZero(secret, Length);
+    munmap(shared, Length);
+
+    return wiped;
+}
+
+template<typename F>
+bool WipedInChild(F terminate, int &status)
+{
+    return WipedInChild([]() {}, terminate, status);
+}
+
+// Signal handler installed by the application
+volatile std::sig_atomic_t application_signal = 0;
+
+void ApplicationSignalHandler(int signal_number)
+{
+    application_signal = signal_number;
+}
+#endif
+
+} // namespace
+
+// This test must execute first, before the registry is enabled
+STF_TEST(WipeRegistry, Disabled)
+{
+    STF_ASSERT_FALSE(SecUtil::WipeRegistryEnabled());
+
+    SecUtil::SecureVector<std::uint8_t> vector(100);
+    STF_ASSERT_EQ(0, SecUtil::RegisteredRegions());
+
+    // Wiping does nothing while disabled
+    vector[0] = 1;
+    SecUtil::WipeRegisteredRegions();
+    STF_ASSERT_EQ(1, vector[0]);
+}
+
+STF_TEST(WipeRegistry, Registration)
+{
+    // Allocated before the registry is enabled and freed afterward
+    auto early = std::make_unique<SecUtil::SecureVector<std::uint8_t>>(64);
+
+    SecUtil::EnableWipeRegistry(1024);
+    STF_ASSERT_TRUE(SecUtil::WipeRegistryEnabled());
+
+    const std::size_t baseline = SecUtil::RegisteredRegions();
+    {
+        SecUtil::SecureVector<std::uint8_t> vector(100);
+        STF_ASSERT_EQ(baseline + 1, SecUtil::RegisteredRegions());
+
+        SecUtil::SecureArray<std::uint8_t, 32> array;
+        SecUtil::SecureArray<std::uint8_t, 32> copy = array;
+        STF_ASSERT_EQ(baseline + 3, SecUtil::RegisteredRegions());
+
+        auto unique = SecUtil::MakeUniqueSecureArray<char>(16);
+        auto shared = SecUtil::MakeSharedSecureObject<std::uint64_t>(7);
+        STF_ASSERT_EQ(baseline + 5, SecUtil::RegisteredRegions());
+
+        SecUtil::SecurePages pages(100);
+        STF_ASSERT_EQ(baseline + 6, SecUtil::RegisteredRegions());
+
+        // Growth registers the new buffer and deregisters the old one
+        vector.resize(10000);
+        STF_ASSERT_EQ(baseline + 6, SecUtil::RegisteredRegions());
+    }
+    STF_ASSERT_EQ(baseline, SecUtil::RegisteredRegions());
+
+    early.reset();
+    STF_ASSERT_EQ(baseline, SecUtil::RegisteredRegions());
+}
+
+STF_TEST(WipeRegistry, NestedRegions)
+{
+    SecUtil::EnableWipeRegistry();
+    const std::size_t baseline = SecUtil::RegisteredRegions();
+
+    {
+        // The first array begins at the same address as the vector storage
+        SecUtil::SecureVector<SecUtil::SecureArray<std::uint8_t, 16>> arrays(1);
+        STF_ASSERT_EQ(baseline + 2, SecUtil::RegisteredRegions());
+    }
+
+    STF_ASSERT_EQ(baseline, SecUtil::RegisteredRegions());
+}
+
+STF_TEST(WipeRegistry, Wipe)
+{
+    SecUtil::EnableWipeRegistry();
+
+    SecUtil::SecureVector<std::uint8_t> vector(1000, 0x5a);
+    SecUtil::SecureArray<std::uint8_t, 64> array;
+    array.fill(0x5a);
+
+    SecUtil::WipeRegisteredRegions();
+
+    STF_ASSERT_TRUE(AllZero(vector.data(), vector.size()));
+    STF_ASSERT_TRUE(AllZero(array.data(), array.size()));
+}
+
+STF_TEST(WipeRegistry, Dropped)
+{
+    SecUtil::EnableWipeRegistry();
+
+    // Register far more regions than there are slots
+    constexpr std::size_t Count = 4096;
+    std::vector<std::uint8_t> buffer(Count * 16);
+    const std::size_t baseline = SecUtil::RegisteredRegions();
+    const std::size_t dropped = SecUtil::DroppedRegions();
+
+    for (std::size_t i = 0; i < Count; i++)
+    {
+        SecUtil::RegisterSecureRegion(buffer.data() + i * 16, 1);
+    }
+
+    const std::size_t registered = SecUtil::RegisteredRegions() - baseline;
+    STF_ASSERT_GT(SecUtil::DroppedRegions(), dropped);
+    STF_ASSERT_EQ(Count, registered + SecUtil::DroppedRegions() - dropped);
+
+    for (std::size_t i = 0; i < Count; i++)
+    {
+        SecUtil::DeregisterSecureRegion(buffer.data() + i * 16, 1);
+    }
+    STF_ASSERT_EQ(baseline, SecUtil::RegisteredRegions());
+
+    // Slots left as tombstones are reused
+    SecUtil::SecureVector<std::uint8_t> vector(10);
+    STF_ASSERT_EQ(baseline + 1, SecUtil::RegisteredRegions());
+}
+
+#if !defined(_WIN32)
+
+STF_TEST(WipeRegistry, TerminationSignal)
+{
+    int status = 0;
+
+    STF_ASSERT_TRUE(WipedInChild([]() { std::raise(SIGTERM); }, status));
+    STF_ASSERT_TRUE(WIFSIGNALED(status));
+    STF_ASSERT_EQ(SIGTERM, WTERMSIG(status));
+}
+
+STF_TEST(WipeRegistry, FaultSignal)
+{
+    int status = 0;
+
+    STF_ASSERT_TRUE(WipedInChild([]() { std::raise(SIGSEGV); }, status));
+    STF_ASSERT_TRUE(WIFSIGNALED(status));
+    STF_ASSERT_EQ(SIGSEGV, WTERMSIG(status));
+}
+
+// An ignored signal does not terminate the process, so it must not wipe
+STF_TEST(WipeRegistry, IgnoredSignal)
+{
+    int status = 0;
+
+    STF_ASSERT_FALSE(WipedInChild([]() { std::signal(SIGHUP, SIG_IGN); },
+                                  []() { std::raise(SIGHUP); },
+                                  status));
+    STF_ASSERT_TRUE(WIFEXITED(status));
+    STF_ASSERT_EQ(99, WEXITSTATUS(status));
+}
+
+// A signal handled by the application must neither wipe nor be replaced
+STF_TEST(WipeRegistry, ApplicationHandler)
+{
+    int status = 0;
+
+    STF_ASSERT_FALSE(WipedInChild(
+        []() { std::signal(SIGTERM, ApplicationSignalHandler); },
+        []()
+        {
+            std::raise(SIGTERM);
+            std::raise(SIGTERM);
+            if (application_signal != SIGTERM) _exit(98);
+        },
+        status));
+    STF_ASSERT_TRUE(WIFEXITED(status));
+    STF_ASSERT_EQ(99, WEXITSTATUS(status));
+}
+
+STF_TEST(WipeRegistry, QuickExit)
+{
+    int status = 0;
+
+    STF_ASSERT_TRUE(WipedInChild([]() { std::quick_exit(3); }, status));
+    STF_ASSERT_TRUE(WIFEXITED(status));
+    STF_ASSERT_EQ(3, WEXITSTATUS(status));
+}
+
+#endif
@@ -0,0 +1,201 @@
+/*
+ *  leak_scan.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      Command-line tool that searches a process, core file, or other file
+ *      for canary values using the LeakScanner and lists the regions in
+ *      which any were found:
+ *
+ *          leak_scan [-t threads] -p pid | -c core | -f file pattern...
+ *
+ *      Each pattern is given in hexadecimal.  The exit status is 0 if no
+ *      pattern was found, 1 if any was found, and 2 on error, so the tool
+ *      may be used in automated tests.
+ *
+ *  Portability Issues:
+ *      Process scanning is supported only on Linux.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <terra/secutil/leak_scanner.h>
+
+using namespace Terra;
+
+namespace
+{
+
+/*
+ *  Usage()
+ *
+ *  Description:
+ *      Print the command syntax.
+ *
+ *  Parameters:
+ *      program [in]
+ *          The name of the program.
+ *
+ *  Returns:
+ *      The exit status to return.
+ *
+ *  Comments:
+ *      None.
+ */
+int Usage(const char *program)
+{
+    std::cerr << "usage: " << program
+              << " [-t threads] -p pid | -c core | -f file pattern..."
+              << std::endl;
+
+    return 2;
+}
+
+/*
+ *  ParseHex()
+ *
+ *  Description:
+ *      Convert a hexadecimal string to octets.
+ *
+ *  Parameters:
+ *      text [in]
+ *          The hexadecimal string.
+ *
+ *  Returns:
+ *      The octets.
+ *
+ *  Comments:
+ *      This will throw std::invalid_argument if the string is not valid.
+ */
+std::vector<std::uint8_t> ParseHex(const std::string &text)
+{
+    std::vector<std::uint8_t> octets;
+
+    if (text.size() % 2 != 0)
+    {
+        throw std::invalid_argument("Pattern has an odd number of digits");
+    }
+
+    for (std::size_t i = 0; i < text.size(); i += 2)
+    {
+        std::size_t used = 0;
+        const unsigned long value = std::stoul(text.substr(i, 2), &used, 16);
+
+        if (used != 2) throw std::invalid_argument("Invalid hexadecimal pattern");
+
+        octets.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    return octets;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    SecUtil::LeakScanner scanner;
+    std::vector<std::string> patterns;
+    unsigned threads = 0;
+    char mode = 0;
+    std::string target;
+
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string argument = argv[i];
+
+            if ((argument == "-t") || (argument == "-p") ||
+                (argument == "-c") || (argument == "-f"))
+            {
+                if (++i == argc) return Usage(argv[0]);
+
+                if (argument == "-t")
+                {
+                    threads = static_cast<unsigned>(std::stoul(argv[i]));
+                }
+                else
+                {
+                    if (mode != 0) return Usage(argv[0]);
+                    mode = argument[1];
+                    target = argv[i];
+                }
+            }
+            else
+            {
+                patterns.push_back(argument);
+            }
+        }
+
+        if ((mode == 0) || patterns.empty()) return Usage(argv[0]);
+
+        for (const auto &pattern : patterns) scanner.AddPattern(ParseHex(pattern));
+
+        SecUtil::LeakReport report;
+
+        switch (mode)
+        {
+            case 'p':
+                report = scanner.ScanProcess(std::stoi(target), threads);
+                break;
+
+            case 'c':
+                report = scanner.ScanCoreFile(target, threads);
+                break;
+
+            default:
+                report = scanner.ScanFile(target, threads);
+                break;
+        }
+
+        std::size_t unreadable = 0;
+
+        for (std::size_t i = 0; i < report.regions.size(); i++)
+        {
+            const auto &region = report.regions[i];
+
+            if (!region.readable) unreadable++;
+            if (region.matches == 0) continue;
+
+            std::cout << std::hex << std::setfill('0') << std::setw(16)
+                      << region.start << "-" << std::setw(16) << region.end
+                      << std::dec << std::setfill(' ') << " "
+                      << region.permissions << " " << region.name << ": "
+                      << region.matches << " match"
+                      << (region.matches == 1 ? "" : "es") << std::endl;
+
+            for (const auto &match : report.matches)
+            {
+                if (match.region != i) continue;
+
+                std::cout << "    pattern " << match.pattern << " at 0x"
+                          << std::hex << match.address << std::dec << std::endl;
+            }
+        }
+
+        std::cout << report.matches.size() << " matches in "
+                  << report.bytes_scanned << " octets scanned ("
+                  << unreadable << " regions unreadable) at " << std::fixed
+                  << std::setprecision(1) << report.Throughput() << " MiB/s"
+                  << std::endl;
+
+        return report.Clean() ? 0 : 1;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << argv[0] << ": " << e.what() << std::endl;
+    }
+
+    return 2;
+}